@@ -92,6 +92,7 @@ ofxBaseGui::ofxBaseGui(){
 
 	bRegisteredForMouseEvents = false;
 	needsRedraw = true;
+	fontVersion = 0;
 
 	/*if(!fontLoaded){
 	    loadFont(OF_TTF_MONO,10,true,true);
@@ -151,8 +152,13 @@ void ofxBaseGui::setEvents(ofCoreEvents & _events){
 }
 void ofxBaseGui::draw(){
 	setEvents(ofEvents());
-	if(needsRedraw){
-		generateDraw();
+	if(needsRedraw || (useTTF && font.getLayoutVersion() != fontVersion)){
+		// a glyph loaded on demand can grow the atlas while generating, which
+		// moves the texture coordinates of the text generated before it
+		do{
+			fontVersion = font.getLayoutVersion();
+			generateDraw();
+		}while(useTTF && font.getLayoutVersion() != fontVersion);
 		needsRedraw = false;
 	}
 	currentFrame = ofGetFrameNum();
@@ -144,6 +144,7 @@ class ofxBaseGui {
 		ofCoreEvents * events = nullptr;
 	private:
 		bool needsRedraw;
+		uint64_t fontVersion;
 		unsigned long currentFrame;
 		bool bRegisteredForMouseEvents;
 	
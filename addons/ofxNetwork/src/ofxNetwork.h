@@ -3,4 +3,5 @@
 #include "ofxTCPClient.h"
 #include "ofxTCPManager.h"
 #include "ofxTCPServer.h"
+#include "ofxTCPReactorServer.h"
 #include "ofxUDPManager.h"
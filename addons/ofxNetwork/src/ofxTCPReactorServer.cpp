@@ -0,0 +1,839 @@
+#include "ofxTCPReactorServer.h"
+
+#ifndef TARGET_WIN32
+
+#include "ofxNetworkUtils.h"
+#include "ofLog.h"
+#include "ofUtils.h"
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <cstring>
+
+#if defined(TARGET_LINUX) || defined(TARGET_ANDROID)
+	#define OFX_TCP_REACTOR_EPOLL
+	#include <sys/epoll.h>
+#else
+	#include <poll.h>
+#endif
+
+#ifdef MSG_NOSIGNAL
+	#define OFX_TCP_REACTOR_SEND_FLAGS MSG_NOSIGNAL
+#else
+	#define OFX_TCP_REACTOR_SEND_FLAGS 0
+#endif
+
+// ids used to tag the server sockets in the poller, clients use their id
+static const int LISTEN_ID = -1;
+static const int WAKEUP_ID = -2;
+
+//--------------------------
+ofxTCPRingBuffer::ofxTCPRingBuffer(size_t capacity)
+:buffer(capacity)
+,head(0)
+,tail(0){
+}
+
+//--------------------------
+ofxTCPRingBuffer::Regions ofxTCPRingBuffer::regions(size_t start, size_t size) const{
+	Regions regions;
+	size_t offset = start % buffer.size();
+	regions.data[0] = buffer.data() + offset;
+	regions.size[0] = std::min(size, buffer.size() - offset);
+	regions.data[1] = buffer.data();
+	regions.size[1] = size - regions.size[0];
+	return regions;
+}
+
+//--------------------------
+ofxTCPRingBuffer::Regions ofxTCPRingBuffer::readable() const{
+	size_t t = tail.load(std::memory_order_relaxed);
+	size_t h = head.load(std::memory_order_acquire);
+	return regions(t, h - t);
+}
+
+//--------------------------
+ofxTCPRingBuffer::Regions ofxTCPRingBuffer::writable() const{
+	size_t h = head.load(std::memory_order_relaxed);
+	size_t t = tail.load(std::memory_order_acquire);
+	return regions(h, buffer.size() - (h - t));
+}
+
+//--------------------------
+void ofxTCPRingBuffer::produce(size_t numBytes){
+	head.store(head.load(std::memory_order_relaxed) + numBytes, std::memory_order_release);
+}
+
+//--------------------------
+void ofxTCPRingBuffer::consume(size_t numBytes){
+	tail.store(tail.load(std::memory_order_relaxed) + numBytes, std::memory_order_release);
+}
+
+//--------------------------
+size_t ofxTCPRingBuffer::find(const std::string & pattern, size_t from) const{
+	auto data = readable();
+	auto total = data.total();
+	if(pattern.empty() || total < pattern.size()){
+		return std::string::npos;
+	}
+	auto at = [&data](size_t i){
+		return i < data.size[0] ? data.data[0][i] : data.data[1][i - data.size[0]];
+	};
+	size_t last = total - pattern.size();
+	size_t i = from;
+	while(i <= last){
+		// look for the first character with memchr in the contiguous part
+		// and then compare the rest, which might wrap around
+		int region = i < data.size[0] ? 0 : 1;
+		size_t offset = region == 0 ? i : i - data.size[0];
+		size_t available = std::min(data.size[region] - offset, last - i + 1);
+		auto start = data.data[region] + offset;
+		auto found = (const char*)memchr(start, pattern[0], available);
+		if(!found){
+			i += available;
+			continue;
+		}
+		i += found - start;
+		size_t j = 1;
+		while(j < pattern.size() && at(i + j) == pattern[j]){
+			j++;
+		}
+		if(j == pattern.size()){
+			return i;
+		}
+		i++;
+	}
+	return std::string::npos;
+}
+
+//--------------------------
+void ofxTCPRingBuffer::copy(char * dst, size_t numBytes) const{
+	auto data = readable();
+	size_t first = std::min(numBytes, data.size[0]);
+	memcpy(dst, data.data[0], first);
+	memcpy(dst + first, data.data[1], std::min(numBytes - first, data.size[1]));
+}
+
+//--------------------------
+size_t ofxTCPRingBuffer::size() const{
+	return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+}
+
+//--------------------------
+size_t ofxTCPRingBuffer::capacity() const{
+	return buffer.size();
+}
+
+//--------------------------
+bool ofxTCPRingBuffer::full() const{
+	return size() == buffer.size();
+}
+
+
+struct ofxTCPReactorServer::Client{
+	Client(int id, int socket, size_t bufferSize)
+	:id(id)
+	,socket(socket)
+	,received(bufferSize){}
+
+	int id;
+	int socket; // guarded by sendMutex so it's not closed while sending
+	std::string ip;
+	int port = 0;
+
+	// written by the server thread, consumed by the server thread when
+	// splitting delimited messages or by the application otherwise
+	ofxTCPRingBuffer received;
+	std::mutex receiveMutex; // only one consumer at a time
+	size_t scanned = 0; // bytes already searched for the delimiter
+	std::atomic<bool> dataNotified{false};
+	std::atomic<bool> stalled{false}; // receive buffer was full
+
+	std::mutex sendMutex;
+	std::string outgoing;
+
+	bool readInterest = false;
+	bool writeInterest = false;
+};
+
+//--------------------------
+static bool setNonBlocking(int socket){
+	int flags = fcntl(socket, F_GETFL, 0);
+	return flags != -1 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) != -1;
+}
+
+//--------------------------
+static bool wouldBlock(int err){
+	return err == EAGAIN || err == EWOULDBLOCK;
+}
+
+//--------------------------
+ofxTCPReactorServer::ofxTCPReactorServer()
+:settings(0)
+,listenSocket(-1)
+,poller(-1)
+,wakeUpPipe{-1, -1}
+,connected(false)
+,nextID(0)
+,nextEvent(0){
+}
+
+//--------------------------
+ofxTCPReactorServer::~ofxTCPReactorServer(){
+	close();
+}
+
+//--------------------------
+bool ofxTCPReactorServer::setup(int port){
+	return setup(ofxTCPReactorSettings(port));
+}
+
+//--------------------------
+bool ofxTCPReactorServer::setup(const ofxTCPReactorSettings & _settings){
+	close();
+	settings = _settings;
+	if(settings.messageDelimiter.empty()){
+		settings.messageDelimiter = "[/TCP]";
+	}
+	settings.receiveBufferSize = std::max(settings.receiveBufferSize, settings.messageDelimiter.size() + 1);
+
+	listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+	if(listenSocket == -1){
+		ofLogError("ofxTCPReactorServer") << "setup(): couldn't create server";
+		ofxNetworkLogLastError();
+		return false;
+	}
+	if(settings.reuse){
+		int enable = 1;
+		setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+	}
+	sockaddr_in address;
+	memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = settings.address.empty() ? htonl(INADDR_ANY) : inet_addr(settings.address.c_str());
+	address.sin_port = htons(settings.port);
+	if(bind(listenSocket, (sockaddr*)&address, sizeof(address)) == -1){
+		ofLogError("ofxTCPReactorServer") << "setup(): couldn't bind to port " << settings.port;
+		ofxNetworkLogLastError();
+		close();
+		return false;
+	}
+	socklen_t length = sizeof(address);
+	getsockname(listenSocket, (sockaddr*)&address, &length);
+	settings.port = ntohs(address.sin_port);
+
+	if(listen(listenSocket, SOMAXCONN) == -1 || !setNonBlocking(listenSocket)){
+		ofLogError("ofxTCPReactorServer") << "setup(): listening failed";
+		ofxNetworkLogLastError();
+		close();
+		return false;
+	}
+
+	if(pipe(wakeUpPipe) == -1 || !setNonBlocking(wakeUpPipe[0]) || !setNonBlocking(wakeUpPipe[1])){
+		ofLogError("ofxTCPReactorServer") << "setup(): couldn't create wake up pipe";
+		close();
+		return false;
+	}
+
+#ifdef OFX_TCP_REACTOR_EPOLL
+	poller = epoll_create1(0);
+	if(poller == -1){
+		ofLogError("ofxTCPReactorServer") << "setup(): couldn't create epoll instance";
+		ofxNetworkLogLastError();
+		close();
+		return false;
+	}
+	epoll_event event;
+	event.events = EPOLLIN;
+	event.data.u64 = uint64_t(int64_t(LISTEN_ID));
+	epoll_ctl(poller, EPOLL_CTL_ADD, listenSocket, &event);
+	event.data.u64 = uint64_t(int64_t(WAKEUP_ID));
+	epoll_ctl(poller, EPOLL_CTL_ADD, wakeUpPipe[0], &event);
+#endif
+
+	connected = true;
+	if(settings.notifyInUpdate){
+		ofAddListener(ofEvents().update, this, &ofxTCPReactorServer::update);
+	}
+	startThread();
+	return true;
+}
+
+//--------------------------
+void ofxTCPReactorServer::close(){
+	if(isThreadRunning()){
+		stopThread();
+		wakeUp();
+		waitForThread(false);
+	}
+	if(settings.notifyInUpdate){
+		ofRemoveListener(ofEvents().update, this, &ofxTCPReactorServer::update);
+	}
+
+	// the thread is stopped, clean up anything it left
+	{
+		std::unique_lock<std::mutex> lock(clientsMutex);
+		for(auto & client: clients){
+			std::unique_lock<std::mutex> sendLock(client.second->sendMutex);
+			::close(client.second->socket);
+			client.second->socket = -1;
+		}
+		clients.clear();
+	}
+	for(auto fd: {&listenSocket, &poller, &wakeUpPipe[0], &wakeUpPipe[1]}){
+		if(*fd != -1){
+			::close(*fd);
+			*fd = -1;
+		}
+	}
+	{
+		std::unique_lock<std::mutex> lock(requestsMutex);
+		pendingWrites.clear();
+		pendingResume.clear();
+		pendingDisconnect.clear();
+	}
+	events.clear();
+	receivedEvents.clear();
+	nextEvent = 0;
+	connected = false;
+}
+
+//--------------------------
+std::shared_ptr<ofxTCPReactorServer::Client> ofxTCPReactorServer::getClient(int clientID) const{
+	std::unique_lock<std::mutex> lock(clientsMutex);
+	auto client = clients.find(clientID);
+	if(client == clients.end()){
+		return nullptr;
+	}
+	return client->second;
+}
+
+//--------------------------
+bool ofxTCPReactorServer::send(int clientID, const std::string & message){
+	auto data = message + settings.messageDelimiter;
+	return sendRawBytes(clientID, data.c_str(), data.size());
+}
+
+//--------------------------
+bool ofxTCPReactorServer::sendToAll(const std::string & message){
+	std::vector<int> ids;
+	{
+		std::unique_lock<std::mutex> lock(clientsMutex);
+		for(auto & client: clients){
+			ids.push_back(client.first);
+		}
+	}
+	bool sent = !ids.empty();
+	for(auto id: ids){
+		sent &= send(id, message);
+	}
+	return sent;
+}
+
+//--------------------------
+bool ofxTCPReactorServer::sendRawBytes(int clientID, const char * rawBytes, size_t numBytes){
+	auto client = getClient(clientID);
+	if(!client){
+		ofLogWarning("ofxTCPReactorServer") << "sendRawBytes(): client " << clientID << " doesn't exist";
+		return false;
+	}
+	std::unique_lock<std::mutex> lock(client->sendMutex);
+	if(client->socket == -1){
+		return false;
+	}
+	size_t sent = 0;
+	// if nothing is queued try to send right away, whatever doesn't fit
+	// in the socket buffer is sent from the server thread
+	if(client->outgoing.empty()){
+		auto ret = ::send(client->socket, rawBytes, numBytes, OFX_TCP_REACTOR_SEND_FLAGS);
+		if(ret >= 0){
+			sent = ret;
+		}else if(!wouldBlock(errno)){
+			ofxNetworkLogLastError();
+			return false;
+		}
+	}
+	if(sent < numBytes){
+		client->outgoing.append(rawBytes + sent, numBytes - sent);
+		lock.unlock();
+		{
+			std::unique_lock<std::mutex> requestsLock(requestsMutex);
+			pendingWrites.insert(clientID);
+		}
+		wakeUp();
+	}
+	return true;
+}
+
+//--------------------------
+bool ofxTCPReactorServer::disconnectClient(int clientID){
+	if(!getClient(clientID)){
+		ofLogWarning("ofxTCPReactorServer") << "disconnectClient(): client " << clientID << " doesn't exist";
+		return false;
+	}
+	{
+		std::unique_lock<std::mutex> lock(requestsMutex);
+		pendingDisconnect.insert(clientID);
+	}
+	wakeUp();
+	return true;
+}
+
+//--------------------------
+bool ofxTCPReactorServer::isConnected() const{
+	return connected;
+}
+
+//--------------------------
+bool ofxTCPReactorServer::isClientConnected(int clientID) const{
+	return getClient(clientID) != nullptr;
+}
+
+//--------------------------
+size_t ofxTCPReactorServer::getNumClients() const{
+	std::unique_lock<std::mutex> lock(clientsMutex);
+	return clients.size();
+}
+
+//--------------------------
+int ofxTCPReactorServer::getPort() const{
+	return settings.port;
+}
+
+//--------------------------
+std::string ofxTCPReactorServer::getClientIP(int clientID) const{
+	auto client = getClient(clientID);
+	return client ? client->ip : "";
+}
+
+//--------------------------
+int ofxTCPReactorServer::getClientPort(int clientID) const{
+	auto client = getClient(clientID);
+	return client ? client->port : 0;
+}
+
+//--------------------------
+size_t ofxTCPReactorServer::receive(int clientID, const std::function<size_t(const char *, size_t)> & consumer){
+	if(settings.delimitedMessages){
+		ofLogWarning("ofxTCPReactorServer") << "receive(): the data is split in messages, use the messageReceived event or getNextEvent()";
+		return 0;
+	}
+	auto client = getClient(clientID);
+	if(!client){
+		return 0;
+	}
+	std::unique_lock<std::mutex> lock(client->receiveMutex);
+	// clear it before reading so new data is notified again
+	client->dataNotified = false;
+	auto data = client->received.readable();
+	size_t consumed = 0;
+	for(int i = 0; i < 2 && data.size[i] > 0; i++){
+		auto used = std::min(consumer(data.data[i], data.size[i]), data.size[i]);
+		consumed += used;
+		if(used < data.size[i]){
+			break;
+		}
+	}
+	client->received.consume(consumed);
+	if(consumed > 0 && client->stalled.exchange(false)){
+		// there's space again, tell the server thread to keep reading
+		{
+			std::unique_lock<std::mutex> requestsLock(requestsMutex);
+			pendingResume.insert(clientID);
+		}
+		wakeUp();
+	}
+	return consumed;
+}
+
+//--------------------------
+int ofxTCPReactorServer::receiveRawBytes(int clientID, char * receiveBytes, size_t numBytes){
+	return receive(clientID, [&](const char * data, size_t size){
+		auto used = std::min(size, numBytes);
+		memcpy(receiveBytes, data, used);
+		receiveBytes += used;
+		numBytes -= used;
+		return used;
+	});
+}
+
+//--------------------------
+size_t ofxTCPReactorServer::getNumReceivedBytes(int clientID) const{
+	auto client = getClient(clientID);
+	return client ? client->received.size() : 0;
+}
+
+//--------------------------
+bool ofxTCPReactorServer::hasWaitingEvents() const{
+	return nextEvent < receivedEvents.size() || !events.empty();
+}
+
+//--------------------------
+bool ofxTCPReactorServer::getNextEvent(ofxTCPReactorEvent & event){
+	if(nextEvent == receivedEvents.size()){
+		receivedEvents.clear();
+		nextEvent = 0;
+		if(!events.tryReceive(receivedEvents) || receivedEvents.empty()){
+			return false;
+		}
+	}
+	event = std::move(receivedEvents[nextEvent++]);
+	return true;
+}
+
+//--------------------------
+void ofxTCPReactorServer::update(ofEventArgs &){
+	ofxTCPReactorEvent event;
+	while(getNextEvent(event)){
+		switch(event.type){
+		case ofxTCPReactorEvent::CONNECTED:
+			ofNotifyEvent(clientConnected, event, this);
+			break;
+		case ofxTCPReactorEvent::DISCONNECTED:
+			ofNotifyEvent(clientDisconnected, event, this);
+			break;
+		case ofxTCPReactorEvent::DATA:
+			ofNotifyEvent(dataReceived, event, this);
+			break;
+		case ofxTCPReactorEvent::MESSAGE:
+			ofNotifyEvent(messageReceived, event, this);
+			break;
+		}
+	}
+}
+
+//--------------------------
+void ofxTCPReactorServer::wakeUp(){
+	if(wakeUpPipe[1] != -1){
+		char c = 0;
+		// if the pipe is full the thread is going to wake up anyway
+		auto ret = write(wakeUpPipe[1], &c, 1);
+		(void)ret;
+	}
+}
+
+//--------------------------
+void ofxTCPReactorServer::post(ofxTCPReactorEvent && event){
+	outgoingEvents.push_back(std::move(event));
+}
+
+//--------------------------
+void ofxTCPReactorServer::updateInterest(Client & client){
+	bool read = !client.received.full();
+	if(!read && !settings.delimitedMessages){
+		// stop reading until the application consumes some data. check
+		// again under the lock so a receive() right now doesn't miss that
+		// it has to resume the client
+		std::unique_lock<std::mutex> lock(client.receiveMutex);
+		read = !client.received.full();
+		client.stalled = !read;
+	}
+	bool write;
+	{
+		std::unique_lock<std::mutex> lock(client.sendMutex);
+		write = !client.outgoing.empty();
+	}
+	if(read == client.readInterest && write == client.writeInterest){
+		return;
+	}
+#ifdef OFX_TCP_REACTOR_EPOLL
+	epoll_event event;
+	event.events = (read ? uint32_t(EPOLLIN) : 0) | (write ? uint32_t(EPOLLOUT) : 0);
+	event.data.u64 = uint64_t(int64_t(client.id));
+	epoll_ctl(poller, EPOLL_CTL_MOD, client.socket, &event);
+#endif
+	client.readInterest = read;
+	client.writeInterest = write;
+}
+
+//--------------------------
+void ofxTCPReactorServer::acceptClients(){
+	while(true){
+		sockaddr_in address;
+		socklen_t length = sizeof(address);
+		int socket = accept(listenSocket, (sockaddr*)&address, &length);
+		if(socket == -1){
+			auto err = errno;
+			if(err == EINTR || err == ECONNABORTED){
+				continue;
+			}
+			if(!wouldBlock(err)){
+				ofLogError("ofxTCPReactorServer") << "couldn't accept client";
+				ofxNetworkLogError(err);
+				if(err == EMFILE || err == ENFILE){
+					// out of file descriptors, give the app some time to close some
+					ofSleepMillis(10);
+				}
+			}
+			return;
+		}
+		if(settings.maxClients > 0 && clients.size() >= settings.maxClients){
+			ofLogWarning("ofxTCPReactorServer") << "rejecting connection, maximum number of clients reached: " << settings.maxClients;
+			::close(socket);
+			continue;
+		}
+		setNonBlocking(socket);
+		int enable = 1;
+		setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+#ifdef SO_NOSIGPIPE
+		setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+#endif
+
+		auto client = std::make_shared<Client>(nextID++, socket, settings.receiveBufferSize);
+		client->ip = inet_ntoa(address.sin_addr);
+		client->port = ntohs(address.sin_port);
+		client->readInterest = true;
+#ifdef OFX_TCP_REACTOR_EPOLL
+		epoll_event event;
+		event.events = EPOLLIN;
+		event.data.u64 = uint64_t(int64_t(client->id));
+		if(epoll_ctl(poller, EPOLL_CTL_ADD, socket, &event) == -1){
+			ofLogError("ofxTCPReactorServer") << "couldn't add client to epoll";
+			ofxNetworkLogLastError();
+			::close(socket);
+			continue;
+		}
+#endif
+		{
+			std::unique_lock<std::mutex> lock(clientsMutex);
+			clients[client->id] = client;
+		}
+		ofLogVerbose("ofxTCPReactorServer") << "client " << client->id << " connected from " << client->ip << ":" << client->port;
+		post({ofxTCPReactorEvent::CONNECTED, client->id, ""});
+	}
+}
+
+//--------------------------
+void ofxTCPReactorServer::readClient(Client & client){
+	bool closed = false;
+	size_t received = 0;
+	while(true){
+		auto space = client.received.writable();
+		if(space.total() == 0){
+			if(settings.delimitedMessages){
+				ofLogError("ofxTCPReactorServer") << "client " << client.id << " sent a message bigger than the receive buffer size "
+					<< settings.receiveBufferSize << ", disconnecting it";
+				closed = true;
+			}
+			break;
+		}
+		iovec parts[2];
+		int numParts = space.size[1] > 0 ? 2 : 1;
+		for(int i = 0; i < numParts; i++){
+			parts[i].iov_base = space.data[i];
+			parts[i].iov_len = space.size[i];
+		}
+		auto ret = readv(client.socket, parts, numParts);
+		if(ret > 0){
+			client.received.produce(ret);
+			received += ret;
+		}else if(ret == 0){
+			closed = true;
+			break;
+		}else{
+			auto err = errno;
+			if(err == EINTR){
+				continue;
+			}
+			if(!wouldBlock(err)){
+				if(err != ECONNRESET){
+					ofxNetworkLogError(err);
+				}
+				closed = true;
+			}
+			break;
+		}
+
+		if(settings.delimitedMessages){
+			// split the complete messages, only searching the new data
+			auto & delimiter = settings.messageDelimiter;
+			size_t position;
+			while((position = client.received.find(delimiter, client.scanned)) != std::string::npos){
+				ofxTCPReactorEvent event{ofxTCPReactorEvent::MESSAGE, client.id, ""};
+				event.message.resize(position);
+				client.received.copy(&event.message[0], position);
+				client.received.consume(position + delimiter.size());
+				// ofxTCPClient sends a \0 after the delimiter
+				event.message.erase(0, event.message.find_first_not_of('\0'));
+				client.scanned = 0;
+				post(std::move(event));
+			}
+			auto size = client.received.size();
+			client.scanned = size >= delimiter.size() ? size - delimiter.size() + 1 : 0;
+		}
+	}
+
+	if(received > 0 && !settings.delimitedMessages && !client.dataNotified.exchange(true)){
+		post({ofxTCPReactorEvent::DATA, client.id, ""});
+	}
+	if(closed){
+		closeClient(client.id);
+	}else{
+		updateInterest(client);
+	}
+}
+
+//--------------------------
+void ofxTCPReactorServer::writeClient(Client & client){
+	std::unique_lock<std::mutex> lock(client.sendMutex);
+	size_t sent = 0;
+	while(sent < client.outgoing.size()){
+		auto ret = ::send(client.socket, client.outgoing.data() + sent, client.outgoing.size() - sent, OFX_TCP_REACTOR_SEND_FLAGS);
+		if(ret >= 0){
+			sent += ret;
+		}else if(errno != EINTR){
+			// on errors the socket is reported as readable and closed there
+			if(!wouldBlock(errno)){
+				ofxNetworkLogLastError();
+			}
+			break;
+		}
+	}
+	client.outgoing.erase(0, sent);
+	lock.unlock();
+	updateInterest(client);
+}
+
+//--------------------------
+void ofxTCPReactorServer::closeClient(int clientID){
+	std::shared_ptr<Client> client;
+	{
+		std::unique_lock<std::mutex> lock(clientsMutex);
+		auto it = clients.find(clientID);
+		if(it == clients.end()){
+			return;
+		}
+		client = it->second;
+		clients.erase(it);
+	}
+	{
+		std::unique_lock<std::mutex> lock(client->sendMutex);
+#ifdef OFX_TCP_REACTOR_EPOLL
+		epoll_ctl(poller, EPOLL_CTL_DEL, client->socket, nullptr);
+#endif
+		::close(client->socket);
+		client->socket = -1;
+	}
+	ofLogVerbose("ofxTCPReactorServer") << "client " << clientID << " disconnected";
+	post({ofxTCPReactorEvent::DISCONNECTED, clientID, ""});
+}
+
+//--------------------------
+void ofxTCPReactorServer::threadedFunction(){
+	setThreadName("ofxTCPReactorServer");
+	ofLogVerbose("ofxTCPReactorServer") << "server thread started on port " << settings.port;
+
+	auto handle = [this](int id, bool readable, bool writable){
+		if(id == WAKEUP_ID){
+			char buffer[256];
+			while(read(wakeUpPipe[0], buffer, sizeof(buffer)) > 0){}
+		}else if(id == LISTEN_ID){
+			acceptClients();
+		}else{
+			// the client might have been closed earlier in this same iteration
+			auto it = clients.find(id);
+			if(it == clients.end()){
+				return;
+			}
+			auto client = it->second;
+			if(writable){
+				writeClient(*client);
+			}
+			if(readable){
+				readClient(*client);
+			}
+		}
+	};
+
+#ifdef OFX_TCP_REACTOR_EPOLL
+	std::vector<epoll_event> ready(256);
+#else
+	std::vector<pollfd> polled;
+	std::vector<int> polledIds;
+#endif
+
+	std::set<int> writes, resumes, disconnects;
+	while(isThreadRunning()){
+#ifdef OFX_TCP_REACTOR_EPOLL
+		int numReady = epoll_wait(poller, ready.data(), ready.size(), 1000);
+		for(int i = 0; i < numReady; i++){
+			auto events = ready[i].events;
+			handle(int(int64_t(ready[i].data.u64)),
+				events & (EPOLLIN | EPOLLHUP | EPOLLERR),
+				events & EPOLLOUT);
+		}
+#else
+		polled.clear();
+		polledIds.clear();
+		polled.push_back({wakeUpPipe[0], POLLIN, 0});
+		polledIds.push_back(WAKEUP_ID);
+		polled.push_back({listenSocket, POLLIN, 0});
+		polledIds.push_back(LISTEN_ID);
+		for(auto & client: clients){
+			short interest = (client.second->readInterest ? POLLIN : 0) | (client.second->writeInterest ? POLLOUT : 0);
+			polled.push_back({client.second->socket, interest, 0});
+			polledIds.push_back(client.first);
+		}
+		int numReady = poll(polled.data(), polled.size(), 1000);
+		for(size_t i = 0; i < polled.size() && numReady > 0; i++){
+			auto events = polled[i].revents;
+			if(events){
+				handle(polledIds[i], events & (POLLIN | POLLHUP | POLLERR), events & POLLOUT);
+			}
+		}
+#endif
+		if(numReady == -1 && errno != EINTR){
+			ofLogError("ofxTCPReactorServer") << "waiting for events failed";
+			ofxNetworkLogLastError();
+		}
+
+		// requests from other threads
+		{
+			std::unique_lock<std::mutex> lock(requestsMutex);
+			writes.swap(pendingWrites);
+			resumes.swap(pendingResume);
+			disconnects.swap(pendingDisconnect);
+		}
+		for(auto id: writes){
+			auto it = clients.find(id);
+			if(it != clients.end()){
+				writeClient(*it->second);
+			}
+		}
+		for(auto id: resumes){
+			auto it = clients.find(id);
+			if(it != clients.end()){
+				// there might be data waiting already
+				readClient(*it->second);
+			}
+		}
+		for(auto id: disconnects){
+			closeClient(id);
+		}
+		writes.clear();
+		resumes.clear();
+		disconnects.clear();
+
+		if(!outgoingEvents.empty()){
+			events.send(std::move(outgoingEvents));
+			outgoingEvents.clear();
+		}
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(clientsMutex);
+		for(auto & client: clients){
+			std::unique_lock<std::mutex> sendLock(client.second->sendMutex);
+			::close(client.second->socket);
+			client.second->socket = -1;
+		}
+		clients.clear();
+	}
+	ofLogVerbose("ofxTCPReactorServer") << "server thread stopped";
+}
+
+#endif
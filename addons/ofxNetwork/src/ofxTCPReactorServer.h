@@ -0,0 +1,205 @@
+#pragma once
+
+#include "ofConstants.h"
+
+#ifndef TARGET_WIN32
+
+#include "ofEvents.h"
+#include "ofThread.h"
+#include "ofThreadChannel.h"
+#include "ofxTCPSettings.h"
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+/// \brief Single producer, single consumer ring buffer of bytes.
+///
+/// The producer writes directly into the free space returned by writable()
+/// and the consumer reads the data in place through readable(), so there's
+/// no copies in between. Both ends can run in different threads without
+/// locking.
+class ofxTCPRingBuffer{
+public:
+	ofxTCPRingBuffer(size_t capacity);
+
+	/// \brief Up to 2 contiguous parts of the buffer, the second one is only
+	/// used when the data wraps around the end of the buffer.
+	struct Regions{
+		char * data[2];
+		size_t size[2];
+		size_t total() const { return size[0] + size[1]; }
+	};
+
+	/// \brief Data ready to be read, only call from the consumer.
+	Regions readable() const;
+
+	/// \brief Free space to write to, only call from the producer.
+	Regions writable() const;
+
+	/// \brief Marks numBytes of the writable space as written.
+	void produce(size_t numBytes);
+
+	/// \brief Frees numBytes of the readable data.
+	void consume(size_t numBytes);
+
+	/// \brief Position of pattern in the readable data, starting at from.
+	/// \return the position or std::string::npos if it's not found
+	size_t find(const std::string & pattern, size_t from = 0) const;
+
+	/// \brief Copies numBytes of the readable data to dst without consuming it.
+	void copy(char * dst, size_t numBytes) const;
+
+	size_t size() const;
+	size_t capacity() const;
+	bool full() const;
+
+private:
+	Regions regions(size_t start, size_t size) const;
+
+	mutable std::vector<char> buffer;
+	std::atomic<size_t> head; // total bytes written
+	std::atomic<size_t> tail; // total bytes read
+};
+
+class ofxTCPReactorSettings: public ofxTCPSettings{
+public:
+	ofxTCPReactorSettings(int _port)
+	:ofxTCPSettings(_port){}
+
+	/// size of the receive ring buffer of each client. A delimited message
+	/// can't be bigger than this
+	size_t receiveBufferSize = 16 * 1024;
+
+	/// split the received data in messages ending in messageDelimiter.
+	/// If false dataReceived is notified instead and the data can be read
+	/// in place with receive()
+	bool delimitedMessages = true;
+
+	/// notify the events from ofEvents().update, if false the application
+	/// has to poll them with getNextEvent()
+	bool notifyInUpdate = true;
+
+	/// maximum number of clients connected at the same time, 0 for no limit
+	size_t maxClients = 0;
+};
+
+class ofxTCPReactorEvent{
+public:
+	enum Type{
+		CONNECTED,
+		DISCONNECTED,
+		DATA, ///< new data in the client receive buffer
+		MESSAGE, ///< a complete delimited message
+	};
+
+	Type type;
+	int clientID;
+	std::string message; ///< only for MESSAGE, without the delimiter
+};
+
+/// \brief TCP server that handles all its clients from a single thread
+/// waiting on epoll (poll on other systems).
+///
+/// Unlike ofxTCPServer the application doesn't need to poll every client,
+/// the server notifies connections, disconnections and complete messages
+/// through events or a queue, and it can handle thousands of clients.
+/// Client IDs are never reused.
+class ofxTCPReactorServer: public ofThread{
+public:
+	ofxTCPReactorServer();
+	~ofxTCPReactorServer();
+
+	ofxTCPReactorServer(const ofxTCPReactorServer & mom) = delete;
+	ofxTCPReactorServer & operator=(const ofxTCPReactorServer & mom) = delete;
+
+	/// port 0 chooses any free port, use getPort() to know which one
+	bool setup(int port);
+	bool setup(const ofxTCPReactorSettings & settings);
+	void close();
+
+	/// send a message followed by the message delimiter
+	bool send(int clientID, const std::string & message);
+	bool sendToAll(const std::string & message);
+
+	/// data that doesn't fit in the socket buffer is queued and sent by the
+	/// server thread, so this never blocks
+	bool sendRawBytes(int clientID, const char * rawBytes, size_t numBytes);
+
+	bool disconnectClient(int clientID);
+
+	bool isConnected() const;
+	bool isClientConnected(int clientID) const;
+	size_t getNumClients() const;
+	int getPort() const;
+	std::string getClientIP(int clientID) const;
+	int getClientPort(int clientID) const;
+
+	/// \brief Passes the received data of a client to consumer in place,
+	/// without copying it.
+	///
+	/// consumer returns how many bytes it used, the rest stays in the buffer
+	/// for the next call. When the data wraps around the end of the ring
+	/// buffer consumer is called a second time with the rest. Only for
+	/// servers without delimitedMessages.
+	///
+	/// \return the number of bytes consumed
+	size_t receive(int clientID, const std::function<size_t(const char * data, size_t size)> & consumer);
+
+	/// same as receive but copying up to numBytes into receiveBytes
+	int receiveRawBytes(int clientID, char * receiveBytes, size_t numBytes);
+
+	size_t getNumReceivedBytes(int clientID) const;
+
+	/// when notifyInUpdate is false the events are queued until retrieved
+	/// with getNextEvent
+	bool hasWaitingEvents() const;
+	bool getNextEvent(ofxTCPReactorEvent & event);
+
+	ofEvent<ofxTCPReactorEvent> clientConnected;
+	ofEvent<ofxTCPReactorEvent> clientDisconnected;
+	ofEvent<ofxTCPReactorEvent> dataReceived;
+	ofEvent<ofxTCPReactorEvent> messageReceived;
+
+private:
+	struct Client;
+
+	void threadedFunction();
+	void update(ofEventArgs & args);
+
+	void wakeUp();
+	void acceptClients();
+	void readClient(Client & client);
+	void writeClient(Client & client);
+	void closeClient(int clientID);
+	void updateInterest(Client & client);
+	void post(ofxTCPReactorEvent && event);
+	std::shared_ptr<Client> getClient(int clientID) const;
+
+	ofxTCPReactorSettings settings;
+	int listenSocket;
+	int poller;
+	int wakeUpPipe[2];
+	std::atomic<bool> connected;
+
+	// written only by the server thread, read by others under clientsMutex
+	mutable std::mutex clientsMutex;
+	std::unordered_map<int, std::shared_ptr<Client>> clients;
+	int nextID;
+
+	// requests from other threads, handled by the server thread
+	std::mutex requestsMutex;
+	std::set<int> pendingWrites;
+	std::set<int> pendingResume;
+	std::set<int> pendingDisconnect;
+
+	// events are sent in batches, one per iteration of the server loop
+	std::vector<ofxTCPReactorEvent> outgoingEvents;
+	ofThreadChannel<std::vector<ofxTCPReactorEvent>> events;
+	std::vector<ofxTCPReactorEvent> receivedEvents;
+	size_t nextEvent;
+};
+
+#endif
@@ -849,6 +849,34 @@ void ofxCvImage::setFromPixels( const ofPixels & pixels ){
 	setFromPixels(pixels.getData(),pixels.getWidth(),pixels.getHeight());
 }
 
+//--------------------------------------------------------------------------------
+void ofxCvImage::setFromPixels( const ofConstPixelsView & pixels ){
+	if( pixels.isContinuous() ){
+		setFromPixels(pixels.getData(),pixels.getWidth(),pixels.getHeight());
+		return;
+	}
+
+	// rows of 8 bit images with the same number of channels can go straight
+	// into the iplimage, anything else is converted by the subclasses
+	if( ipldepth == IPL_DEPTH_8U && pixels.getNumChannels() == (size_t)iplchannels && pixels.getPixelStep() == pixels.getNumChannels() ){
+		if( pixels.getWidth() == 0 || pixels.getHeight() == 0 ){
+			ofLogError("ofxCvImage") << "setFromPixels(): width and height are zero";
+			return;
+		}
+		if( !bAllocated || (int)pixels.getWidth() != width || (int)pixels.getHeight() != height ){
+			allocate(pixels.getWidth(),pixels.getHeight());
+		}
+		for( int i=0; i < height; i++ ){
+			memcpy( cvImage->imageData + (i*cvImage->widthStep), pixels.getLine(i), width*iplchannels );
+		}
+		flagImageChanged();
+	}else{
+		ofPixels packed;
+		pixels.copyTo(packed);
+		setFromPixels(packed);
+	}
+}
+
 //--------------------------------------------------------------------------------
 void ofxCvImage::setRoiFromPixels( const ofPixels & pixels ){
 	setRoiFromPixels(pixels.getData(),pixels.getWidth(),pixels.getHeight());
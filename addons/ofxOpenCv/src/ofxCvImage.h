@@ -61,6 +61,7 @@ public:
 
 	virtual void  setFromPixels( const unsigned char* _pixels, int w, int h ) = 0;
 	virtual void  setFromPixels( const ofPixels & pixels );
+	virtual void  setFromPixels( const ofConstPixelsView & pixels );
 	virtual void  setRoiFromPixels( const unsigned char* _pixels, int w, int h ) = 0;
 	virtual void  setRoiFromPixels( const ofPixels & pixels );
 	virtual void  operator = ( const ofxCvGrayscaleImage& mom ) = 0;
@@ -4,6 +4,8 @@
 #include "ofUtils.h"
 #include "ofxOscMessage.h"
 
+#include <cstring>
+
 //--------------------------------------------------------------
 ofxOscMessage::ofxOscMessage()
 	: remoteHost("")
@@ -11,7 +13,6 @@ ofxOscMessage::ofxOscMessage()
 
 //--------------------------------------------------------------
 ofxOscMessage::~ofxOscMessage() {
-	clear();
 }
 
 ofxOscMessage::ofxOscMessage(const std::string & address) { setAddress(address); }
@@ -21,83 +22,51 @@ ofxOscMessage::ofxOscMessage(const ofxOscMessage & other) {
 	copy(other);
 }
 
+//--------------------------------------------------------------
+ofxOscMessage::ofxOscMessage(ofxOscMessage && other) noexcept
+	: address(std::move(other.address))
+	, args(std::move(other.args))
+	, data(std::move(other.data))
+	, remoteHost(std::move(other.remoteHost))
+	, remotePort(other.remotePort) { }
+
 //--------------------------------------------------------------
 ofxOscMessage & ofxOscMessage::operator=(const ofxOscMessage & other) {
 	return copy(other);
 }
 
+//--------------------------------------------------------------
+ofxOscMessage & ofxOscMessage::operator=(ofxOscMessage && other) noexcept {
+	if (this == &other) return *this;
+	address = std::move(other.address);
+	args = std::move(other.args);
+	data = std::move(other.data);
+	remoteHost = std::move(other.remoteHost);
+	remotePort = other.remotePort;
+	return *this;
+}
+
 //--------------------------------------------------------------
 ofxOscMessage & ofxOscMessage::copy(const ofxOscMessage & other) {
 	if (this == &other) return *this;
-	clear();
 
-	// copy address & remote info
+	// arguments are plain values, copying reuses the memory already allocated
 	address = other.address;
+	args = other.args;
+	data = other.data;
 	remoteHost = other.remoteHost;
 	remotePort = other.remotePort;
 
-	// copy arguments
-	for (std::size_t i = 0; i < other.args.size(); ++i) {
-		switch (other.getArgType(i)) {
-		case OFXOSC_TYPE_TRUE:
-		case OFXOSC_TYPE_FALSE:
-			args.push_back(new ofxOscArgBool(other.getArgAsBool(i)));
-			break;
-		case OFXOSC_TYPE_INT32:
-			args.push_back(new ofxOscArgInt32(other.getArgAsInt32(i)));
-			break;
-		case OFXOSC_TYPE_INT64:
-			args.push_back(new ofxOscArgInt64(other.getArgAsInt64(i)));
-			break;
-		case OFXOSC_TYPE_FLOAT:
-			args.push_back(new ofxOscArgFloat(other.getArgAsFloat(i)));
-			break;
-		case OFXOSC_TYPE_DOUBLE:
-			args.push_back(new ofxOscArgDouble(other.getArgAsDouble(i)));
-			break;
-		case OFXOSC_TYPE_STRING:
-			args.push_back(new ofxOscArgString(other.getArgAsString(i)));
-			break;
-		case OFXOSC_TYPE_SYMBOL:
-			args.push_back(new ofxOscArgSymbol(other.getArgAsSymbol(i)));
-			break;
-		case OFXOSC_TYPE_CHAR:
-			args.push_back(new ofxOscArgChar(other.getArgAsChar(i)));
-			break;
-		case OFXOSC_TYPE_MIDI_MESSAGE:
-			args.push_back(new ofxOscArgMidiMessage(other.getArgAsMidiMessage(i)));
-			break;
-		case OFXOSC_TYPE_TRIGGER:
-			args.push_back(new ofxOscArgTrigger());
-			break;
-		case OFXOSC_TYPE_TIMETAG:
-			args.push_back(new ofxOscArgTimetag(other.getArgAsTimetag(i)));
-			break;
-		case OFXOSC_TYPE_BLOB:
-			args.push_back(new ofxOscArgBlob(other.getArgAsBlob(i)));
-			break;
-		case OFXOSC_TYPE_RGBA_COLOR:
-			args.push_back(new ofxOscArgRgbaColor(other.getArgAsRgbaColor(i)));
-			break;
-		default:
-			ofLogError("ofxOscMessage") << "copy(): bad argument type "
-										<< other.getArgType(i) << " '" << (char)other.getArgType(i) << "'";
-			break;
-		}
-	}
-
 	return *this;
 }
 
 //--------------------------------------------------------------
 void ofxOscMessage::clear() {
-	address = "";
-	remoteHost = "";
+	address.clear();
+	remoteHost.clear();
 	remotePort = 0;
-	for (unsigned int i = 0; i < args.size(); ++i) {
-		delete args[i];
-	}
 	args.clear();
+	data.clear();
 }
 
 //--------------------------------------------------------------
@@ -138,7 +107,7 @@ ofxOscArgType ofxOscMessage::getArgType(std::size_t index) const {
 									<< index << " out of bounds";
 		return OFXOSC_TYPE_INDEXOUTOFBOUNDS;
 	} else {
-		return args[index]->getType();
+		return args[index].type;
 	}
 }
 
@@ -149,15 +118,16 @@ std::string ofxOscMessage::getArgTypeName(std::size_t index) const {
 									<< index << " out of bounds";
 		return "INDEX OUT OF BOUNDS";
 	} else {
-		return args[index]->getTypeName();
+		return std::string(1, (char)args[index].type);
 	}
 }
 
 //--------------------------------------------------------------
 std::string ofxOscMessage::getTypeString() const {
-	std::string types = "";
-	for (std::size_t i = 0; i < args.size(); ++i) {
-		types += args[i]->getTypeName();
+	std::string types;
+	types.reserve(args.size());
+	for (auto & arg : args) {
+		types += (char)arg.type;
 	}
 	return types;
 }
@@ -175,24 +145,24 @@ std::int32_t ofxOscMessage::getArgAsInt32(std::size_t index) const {
 			ofLogWarning("ofxOscMessage")
 				<< "getArgAsInt32(): converting int64 to int32 for argument "
 				<< index;
-			return (std::int32_t)((ofxOscArgInt64 *)args[index])->get();
+			return (std::int32_t)args[index].int64Value;
 		} else if (getArgType(index) == OFXOSC_TYPE_FLOAT) {
-			return (std::int32_t)((ofxOscArgFloat *)args[index])->get();
+			return (std::int32_t)args[index].floatValue;
 		} else if (getArgType(index) == OFXOSC_TYPE_DOUBLE) {
 			// warn about possible lack of precision
 			ofLogWarning("ofxOscMessage")
 				<< "getArgAsInt32(): converting double to int32 for argument "
 				<< index;
-			return (std::int32_t)((ofxOscArgDouble *)args[index])->get();
+			return (std::int32_t)args[index].doubleValue;
 		} else if (getArgType(index) == OFXOSC_TYPE_TRUE || getArgType(index) == OFXOSC_TYPE_FALSE) {
-			return (std::int32_t)((ofxOscArgBool *)args[index])->get();
+			return (std::int32_t)(args[index].type == OFXOSC_TYPE_TRUE);
 		} else {
 			ofLogError("ofxOscMessage") << "getArgAsInt32(): argument "
 										<< index << " is not a number";
 			return 0;
 		}
 	} else {
-		return ((ofxOscArgInt32 *)args[index])->get();
+		return args[index].int32Value;
 	}
 }
 
@@ -200,20 +170,20 @@ std::int32_t ofxOscMessage::getArgAsInt32(std::size_t index) const {
 std::int64_t ofxOscMessage::getArgAsInt64(std::size_t index) const {
 	if (getArgType(index) != OFXOSC_TYPE_INT64) {
 		if (getArgType(index) == OFXOSC_TYPE_INT32) {
-			return (std::int64_t)((ofxOscArgInt32 *)args[index])->get();
+			return (std::int64_t)args[index].int32Value;
 		} else if (getArgType(index) == OFXOSC_TYPE_FLOAT) {
-			return (std::int64_t)((ofxOscArgFloat *)args[index])->get();
+			return (std::int64_t)args[index].floatValue;
 		} else if (getArgType(index) == OFXOSC_TYPE_DOUBLE) {
-			return (std::int64_t)((ofxOscArgDouble *)args[index])->get();
+			return (std::int64_t)args[index].doubleValue;
 		} else if (getArgType(index) == OFXOSC_TYPE_TRUE || getArgType(index) == OFXOSC_TYPE_FALSE) {
-			return (std::int64_t)((ofxOscArgBool *)args[index])->get();
+			return (std::int64_t)(args[index].type == OFXOSC_TYPE_TRUE);
 		} else {
 			ofLogError("ofxOscMessage") << "getArgAsInt64(): argument "
 										<< index << " is not a number";
 			return 0;
 		}
 	} else {
-		return ((ofxOscArgInt64 *)args[index])->get();
+		return args[index].int64Value;
 	}
 }
 
@@ -221,28 +191,28 @@ std::int64_t ofxOscMessage::getArgAsInt64(std::size_t index) const {
 float ofxOscMessage::getArgAsFloat(std::size_t index) const {
 	if (getArgType(index) != OFXOSC_TYPE_FLOAT) {
 		if (getArgType(index) == OFXOSC_TYPE_INT32) {
-			return (float)((ofxOscArgInt32 *)args[index])->get();
+			return (float)args[index].int32Value;
 		} else if (getArgType(index) == OFXOSC_TYPE_INT64) {
 			// warn about possible lack of precision
 			ofLogWarning("ofxOscMessage")
 				<< "getArgAsFloat(): converting int64 to float for argument "
 				<< index;
-			return (float)((ofxOscArgInt64 *)args[index])->get();
+			return (float)args[index].int64Value;
 		} else if (getArgType(index) == OFXOSC_TYPE_DOUBLE) {
 			// warn about possible lack of precision
 			ofLogWarning("ofxOscMessage")
 				<< "getArgAsFloat(): converting double to float for argument "
 				<< index;
-			return (float)((ofxOscArgDouble *)args[index])->get();
+			return (float)args[index].doubleValue;
 		} else if (getArgType(index) == OFXOSC_TYPE_TRUE || getArgType(index) == OFXOSC_TYPE_FALSE) {
-			return (float)((ofxOscArgBool *)args[index])->get();
+			return (float)(args[index].type == OFXOSC_TYPE_TRUE);
 		} else {
 			ofLogError("ofxOscMessage") << "getArgAsFloat(): argument "
 										<< index << " is not a number";
 			return 0;
 		}
 	} else {
-		return ((ofxOscArgFloat *)args[index])->get();
+		return args[index].floatValue;
 	}
 }
 
@@ -250,20 +220,20 @@ float ofxOscMessage::getArgAsFloat(std::size_t index) const {
 double ofxOscMessage::getArgAsDouble(std::size_t index) const {
 	if (getArgType(index) != OFXOSC_TYPE_DOUBLE) {
 		if (getArgType(index) == OFXOSC_TYPE_INT32) {
-			return (double)((ofxOscArgInt32 *)args[index])->get();
+			return (double)args[index].int32Value;
 		} else if (getArgType(index) == OFXOSC_TYPE_INT64) {
-			return (double)((ofxOscArgInt64 *)args[index])->get();
+			return (double)args[index].int64Value;
 		} else if (getArgType(index) == OFXOSC_TYPE_FLOAT) {
-			return (double)((ofxOscArgFloat *)args[index])->get();
+			return (double)args[index].floatValue;
 		} else if (getArgType(index) == OFXOSC_TYPE_TRUE || getArgType(index) == OFXOSC_TYPE_FALSE) {
-			return (double)((ofxOscArgBool *)args[index])->get();
+			return (double)(args[index].type == OFXOSC_TYPE_TRUE);
 		} else {
 			ofLogError("ofxOscMessage") << "getArgAsDouble(): argument "
 										<< index << " is not a number";
 			return 0;
 		}
 	} else {
-		return ((ofxOscArgDouble *)args[index])->get();
+		return args[index].doubleValue;
 	}
 }
 
@@ -275,29 +245,29 @@ std::string ofxOscMessage::getArgAsString(std::size_t index) const {
 			ofLogWarning("ofxOscMessage")
 				<< "getArgAsString(): converting int32 to string for argument "
 				<< index;
-			return ofToString(((ofxOscArgInt32 *)args[index])->get());
+			return ofToString(args[index].int32Value);
 		} else if (getArgType(index) == OFXOSC_TYPE_INT64) {
 			ofLogWarning("ofxOscMessage")
 				<< "getArgAsString(): converting int64 to string for argument "
 				<< index;
-			return ofToString(((ofxOscArgInt64 *)args[index])->get());
+			return ofToString(args[index].int64Value);
 		} else if (getArgType(index) == OFXOSC_TYPE_FLOAT) {
 			ofLogWarning("ofxOscMessage")
 				<< "getArgAsString(): converting float to string for argument "
 				<< index;
-			return ofToString(((ofxOscArgFloat *)args[index])->get());
+			return ofToString(args[index].floatValue);
 		} else if (getArgType(index) == OFXOSC_TYPE_DOUBLE) {
 			ofLogWarning("ofxOscMessage")
 				<< "getArgAsString(): converting double to string for argument "
 				<< index;
-			return ofToString(((ofxOscArgDouble *)args[index])->get());
+			return ofToString(args[index].doubleValue);
 		} else if (getArgType(index) == OFXOSC_TYPE_SYMBOL) {
-			return ((ofxOscArgSymbol *)args[index])->get();
+			return getArgBytesAsString(index);
 		} else if (getArgType(index) == OFXOSC_TYPE_CHAR) {
 			ofLogWarning("ofxOscMessage")
 				<< "getArgAsString(): converting char to string for argument "
 				<< index;
-			return ofToString(((ofxOscArgChar *)args[index])->get());
+			return ofToString(args[index].charValue);
 		} else {
 			ofLogError("ofxOscMessage")
 				<< "getArgAsString(): argument " << index
@@ -305,7 +275,7 @@ std::string ofxOscMessage::getArgAsString(std::size_t index) const {
 			return "";
 		}
 	} else {
-		return ((ofxOscArgString *)args[index])->get();
+		return getArgBytesAsString(index);
 	}
 }
 
@@ -317,43 +287,43 @@ std::string ofxOscMessage::getArgAsSymbol(std::size_t index) const {
 			ofLogWarning("ofxOscMessage")
 				<< "getArgAsSymbol(): converting int32 to symbol (string) "
 				<< "for argument " << index;
-			return ofToString(((ofxOscArgInt32 *)args[index])->get());
+			return ofToString(args[index].int32Value);
 		} else if (getArgType(index) == OFXOSC_TYPE_INT64) {
 			ofLogWarning("ofxOscMessage")
 				<< "getArgAsSymbol(): converting int64 to symbol (string) "
 				<< "for argument " << index;
-			return ofToString(((ofxOscArgInt64 *)args[index])->get());
+			return ofToString(args[index].int64Value);
 		} else if (getArgType(index) == OFXOSC_TYPE_FLOAT) {
 			ofLogWarning("ofxOscMessage")
 				<< "getArgAsSymbol(): converting float to symbol (string) "
 				<< "for argument " << index;
-			return ofToString(((ofxOscArgFloat *)args[index])->get());
+			return ofToString(args[index].floatValue);
 		} else if (getArgType(index) == OFXOSC_TYPE_DOUBLE) {
 			ofLogWarning("ofxOscMessage")
 				<< "getArgAsSymbol(): converting double to symbol (string) "
 				<< "for argument " << index;
-			return ofToString(((ofxOscArgDouble *)args[index])->get());
+			return ofToString(args[index].doubleValue);
 		} else if (getArgType(index) == OFXOSC_TYPE_STRING) {
-			return ((ofxOscArgString *)args[index])->get();
+			return getArgBytesAsString(index);
 		} else if (getArgType(index) == OFXOSC_TYPE_CHAR) {
 			ofLogWarning("ofxOscMessage")
 				<< "getArgAsSymbol(): converting char to symbol (string) "
 				<< "for argument " << index;
-			return ofToString(((ofxOscArgChar *)args[index])->get());
+			return ofToString(args[index].charValue);
 		} else {
 			ofLogError("ofxOscMessage") << "getArgAsSymbol(): argument "
 										<< index << " is not a symbol (string) interpretable value";
 			return "";
 		}
 	} else {
-		return ((ofxOscArgSymbol *)args[index])->get();
+		return getArgBytesAsString(index);
 	}
 }
 
 //--------------------------------------------------------------
 char ofxOscMessage::getArgAsChar(std::size_t index) const {
 	if (getArgType(index) == OFXOSC_TYPE_CHAR) {
-		return ((ofxOscArgChar *)args[index])->get();
+		return args[index].charValue;
 	} else {
 		ofLogError("ofxOscMessage") << "getArgAsChar(): argument "
 									<< index << " is not a char";
@@ -364,7 +334,7 @@ char ofxOscMessage::getArgAsChar(std::size_t index) const {
 //--------------------------------------------------------------
 std::uint32_t ofxOscMessage::getArgAsMidiMessage(std::size_t index) const {
 	if (getArgType(index) == OFXOSC_TYPE_MIDI_MESSAGE) {
-		return ((ofxOscArgMidiMessage *)args[index])->get();
+		return args[index].uint32Value;
 	} else {
 		ofLogError("ofxOscMessage") << "getArgAsMidiMessage(): argument "
 									<< index << " is not a midi message";
@@ -377,18 +347,18 @@ bool ofxOscMessage::getArgAsBool(std::size_t index) const {
 	switch (getArgType(index)) {
 	case OFXOSC_TYPE_TRUE:
 	case OFXOSC_TYPE_FALSE:
-		return ((ofxOscArgBool *)args[index])->get();
+		return (args[index].type == OFXOSC_TYPE_TRUE);
 	case OFXOSC_TYPE_INT32:
-		return ((ofxOscArgInt32 *)args[index])->get() > 0;
+		return args[index].int32Value > 0;
 	case OFXOSC_TYPE_INT64:
-		return ((ofxOscArgInt64 *)args[index])->get() > 0;
+		return args[index].int64Value > 0;
 	case OFXOSC_TYPE_FLOAT:
-		return ((ofxOscArgFloat *)args[index])->get() > 0;
+		return args[index].floatValue > 0;
 	case OFXOSC_TYPE_DOUBLE:
-		return ((ofxOscArgDouble *)args[index])->get() > 0;
+		return args[index].doubleValue > 0;
 	case OFXOSC_TYPE_STRING:
 	case OFXOSC_TYPE_SYMBOL:
-		return ((ofxOscArgString *)args[index])->get() == "true";
+		return std::strcmp(getBytes(index), "true") == 0;
 	default:
 		ofLogError("ofxOscMessage") << "getArgAsBool(): argument "
 									<< index << " is not a boolean interpretable value";
@@ -403,7 +373,7 @@ bool ofxOscMessage::getArgAsNone(std::size_t index) const {
 									<< index << " is not a none/nil";
 		return false;
 	} else {
-		return ((ofxOscArgNone *)args[index])->get();
+		return true;
 	}
 }
 
@@ -414,7 +384,7 @@ bool ofxOscMessage::getArgAsTrigger(std::size_t index) const {
 									<< index << " is not a trigger";
 		return false;
 	} else {
-		return ((ofxOscArgTrigger *)args[index])->get();
+		return true;
 	}
 }
 
@@ -436,14 +406,14 @@ std::uint64_t ofxOscMessage::getArgAsTimetag(std::size_t index) const {
 			ofLogWarning("ofxOscMessage")
 				<< "getArgAsTimetag(): converting double to Timetag "
 				<< "for argument " << index;
-			return (std::uint64_t)((ofxOscArgDouble *)args[index])->get();
+			return (std::uint64_t)args[index].doubleValue;
 		} else {
 			ofLogError("ofxOscMessage") << "getArgAsTimetag(): argument "
 										<< index << " is not a valid number";
 			return 0;
 		}
 	} else {
-		return ((ofxOscArgTimetag *)args[index])->get();
+		return args[index].timetagValue;
 	}
 }
 
@@ -454,7 +424,7 @@ ofBuffer ofxOscMessage::getArgAsBlob(std::size_t index) const {
 									<< index << " is not a blob";
 		return ofBuffer();
 	} else {
-		return ((ofxOscArgBlob *)args[index])->get();
+		return ofBuffer(getBytes(index), args[index].bytes.size);
 	}
 }
 
@@ -465,113 +435,151 @@ std::uint32_t ofxOscMessage::getArgAsRgbaColor(std::size_t index) const {
 									<< index << " is not an rgba color";
 		return 0;
 	} else {
-		return ((ofxOscArgRgbaColor *)args[index])->get();
+		return args[index].uint32Value;
 	}
 }
 
 // set methods
 //--------------------------------------------------------------
 ofxOscMessage & ofxOscMessage::addIntArg(std::int32_t argument) {
-	args.push_back(new ofxOscArgInt32(argument));
+	addArg(OFXOSC_TYPE_INT32).int32Value = argument;
 	return *this;
 }
 
 //--------------------------------------------------------------
 ofxOscMessage & ofxOscMessage::addInt32Arg(std::int32_t argument) {
-	args.push_back(new ofxOscArgInt32(argument));
+	addArg(OFXOSC_TYPE_INT32).int32Value = argument;
 	return *this;
 }
 
 //--------------------------------------------------------------
 ofxOscMessage & ofxOscMessage::addInt64Arg(std::int64_t argument) {
-	args.push_back(new ofxOscArgInt64(argument));
+	addArg(OFXOSC_TYPE_INT64).int64Value = argument;
 	return *this;
 }
 
 //--------------------------------------------------------------
 ofxOscMessage & ofxOscMessage::addFloatArg(float argument) {
-	args.push_back(new ofxOscArgFloat(argument));
+	addArg(OFXOSC_TYPE_FLOAT).floatValue = argument;
 	return *this;
 }
 
 //--------------------------------------------------------------
 ofxOscMessage & ofxOscMessage::addDoubleArg(double argument) {
-	args.push_back(new ofxOscArgDouble(argument));
+	addArg(OFXOSC_TYPE_DOUBLE).doubleValue = argument;
 	return *this;
 }
 
 //--------------------------------------------------------------
 ofxOscMessage & ofxOscMessage::addStringArg(const std::string & argument) {
-	args.push_back(new ofxOscArgString(argument));
-	return *this;
+	return addBytesArg(OFXOSC_TYPE_STRING, argument.c_str(), argument.size());
+}
+
+//--------------------------------------------------------------
+ofxOscMessage & ofxOscMessage::addStringArg(const char * argument) {
+	return addBytesArg(OFXOSC_TYPE_STRING, argument, std::strlen(argument));
 }
 
 //--------------------------------------------------------------
 ofxOscMessage & ofxOscMessage::addSymbolArg(const std::string & argument) {
-	args.push_back(new ofxOscArgSymbol(argument));
-	return *this;
+	return addBytesArg(OFXOSC_TYPE_SYMBOL, argument.c_str(), argument.size());
+}
+
+//--------------------------------------------------------------
+ofxOscMessage & ofxOscMessage::addSymbolArg(const char * argument) {
+	return addBytesArg(OFXOSC_TYPE_SYMBOL, argument, std::strlen(argument));
 }
 
 //--------------------------------------------------------------
 ofxOscMessage & ofxOscMessage::addCharArg(char argument) {
-	args.push_back(new ofxOscArgChar(argument));
+	addArg(OFXOSC_TYPE_CHAR).charValue = argument;
 	return *this;
 }
 
 //--------------------------------------------------------------
 ofxOscMessage & ofxOscMessage::addMidiMessageArg(std::uint32_t argument) {
-	args.push_back(new ofxOscArgMidiMessage(argument));
+	addArg(OFXOSC_TYPE_MIDI_MESSAGE).uint32Value = argument;
 	return *this;
 }
 
 //--------------------------------------------------------------
 ofxOscMessage & ofxOscMessage::addBoolArg(bool argument) {
-	args.push_back(new ofxOscArgBool(argument));
+	addArg(argument ? OFXOSC_TYPE_TRUE : OFXOSC_TYPE_FALSE);
 	return *this;
 }
 
 //--------------------------------------------------------------
 ofxOscMessage & ofxOscMessage::addNoneArg() {
-	args.push_back(new ofxOscArgNone());
+	addArg(OFXOSC_TYPE_NONE);
 	return *this;
 }
 
 //--------------------------------------------------------------
 ofxOscMessage & ofxOscMessage::addTriggerArg() {
-	args.push_back(new ofxOscArgTrigger());
+	addArg(OFXOSC_TYPE_TRIGGER);
 	return *this;
 }
 
 //--------------------------------------------------------------
 ofxOscMessage & ofxOscMessage::addImpulseArg() {
-	args.push_back(new ofxOscArgTrigger());
-	return *this;
+	return addTriggerArg();
 }
 
 //--------------------------------------------------------------
 ofxOscMessage & ofxOscMessage::addInfinitumArg() {
-	args.push_back(new ofxOscArgTrigger());
-	return *this;
+	return addTriggerArg();
 }
 
 //--------------------------------------------------------------
 ofxOscMessage & ofxOscMessage::addTimetagArg(std::uint64_t argument) {
-	args.push_back(new ofxOscArgTimetag(argument));
+	addArg(OFXOSC_TYPE_TIMETAG).timetagValue = argument;
 	return *this;
 }
 
 //--------------------------------------------------------------
 ofxOscMessage & ofxOscMessage::addBlobArg(const ofBuffer & argument) {
-	args.push_back(new ofxOscArgBlob(argument));
-	return *this;
+	return addBytesArg(OFXOSC_TYPE_BLOB, argument.getData(), argument.size());
+}
+
+//--------------------------------------------------------------
+ofxOscMessage & ofxOscMessage::addBlobArg(const char * data, std::size_t size) {
+	return addBytesArg(OFXOSC_TYPE_BLOB, data, size);
 }
 
 //--------------------------------------------------------------
 ofxOscMessage & ofxOscMessage::addRgbaColorArg(std::uint32_t argument) {
-	args.push_back(new ofxOscArgRgbaColor(argument));
+	addArg(OFXOSC_TYPE_RGBA_COLOR).uint32Value = argument;
 	return *this;
 }
 
+// PRIVATE
+//--------------------------------------------------------------
+ofxOscMessage::Arg & ofxOscMessage::addArg(ofxOscArgType type) {
+	args.emplace_back();
+	args.back().type = type;
+	return args.back();
+}
+
+//--------------------------------------------------------------
+ofxOscMessage & ofxOscMessage::addBytesArg(ofxOscArgType type, const char * bytes, std::size_t size) {
+	auto & arg = addArg(type);
+	arg.bytes.offset = (std::uint32_t)data.size();
+	arg.bytes.size = (std::uint32_t)size;
+	data.append(bytes, size);
+	data.push_back('\0');
+	return *this;
+}
+
+//--------------------------------------------------------------
+const char * ofxOscMessage::getBytes(std::size_t index) const {
+	return data.data() + args[index].bytes.offset;
+}
+
+//--------------------------------------------------------------
+std::string ofxOscMessage::getArgBytesAsString(std::size_t index) const {
+	return std::string(getBytes(index), args[index].bytes.size);
+}
+
 // util
 //--------------------------------------------------------------
 void ofxOscMessage::setRemoteEndpoint(const std::string & host, int port) {
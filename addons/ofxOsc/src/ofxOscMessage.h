@@ -11,12 +11,17 @@ public:
 	ofxOscMessage();
 	~ofxOscMessage();
 	ofxOscMessage(const ofxOscMessage & other);
+	ofxOscMessage(ofxOscMessage && other) noexcept;
 	ofxOscMessage(const std::string & address);
 	ofxOscMessage & operator=(const ofxOscMessage & other);
+	ofxOscMessage & operator=(ofxOscMessage && other) noexcept;
 	/// for operator= and copy constructor
 	ofxOscMessage & copy(const ofxOscMessage & other);
 
 	/// clear this message
+	///
+	/// the memory used by the arguments is kept so a message that is
+	/// cleared and filled again every frame doesn't allocate
 	void clear();
 
 	/// set the message address, must start with a /
@@ -202,12 +207,14 @@ public:
 	/// add a string
 	/// \return a reference to this ofxOscMessage
 	ofxOscMessage & addStringArg(const std::string & argument);
+	ofxOscMessage & addStringArg(const char * argument);
 	ofxOscMessage & add(const std::string & argument) { return addStringArg(argument); }
 	ofxOscMessage & add(const char * argument) { return addStringArg(argument); }
 
 	/// add a symbol (string)
 	/// \return a reference to this ofxOscMessage
 	ofxOscMessage & addSymbolArg(const std::string & argument);
+	ofxOscMessage & addSymbolArg(const char * argument);
 
 	/// add a char
 	/// \return a reference to this ofxOscMessage
@@ -250,6 +257,7 @@ public:
 	/// add a binary blog
 	/// \return a reference to this ofxOscMessage
 	ofxOscMessage & addBlobArg(const ofBuffer & argument);
+	ofxOscMessage & addBlobArg(const char * data, std::size_t size);
 	ofxOscMessage & add(const ofBuffer & argument) { return addBlobArg(argument); }
 
 	/// add a 32-bit color
@@ -274,9 +282,36 @@ public:
 	friend std::ostream & operator<<(std::ostream & os, const ofxOscMessage & message);
 
 private:
+	friend class ofxOscSender;
+
+	/// an argument stored by value, the contents of strings and blobs
+	/// are stored one after the other in data
+	struct Arg {
+		ofxOscArgType type;
+		union {
+			std::int32_t int32Value;
+			std::int64_t int64Value;
+			float floatValue;
+			double doubleValue;
+			char charValue;
+			std::uint32_t uint32Value; ///< midi message & rgba color
+			std::uint64_t timetagValue;
+			struct {
+				std::uint32_t offset;
+				std::uint32_t size;
+			} bytes; ///< string, symbol & blob
+		};
+	};
+
+	Arg & addArg(ofxOscArgType type);
+	ofxOscMessage & addBytesArg(ofxOscArgType type, const char * bytes, std::size_t size);
+	const char * getBytes(std::size_t index) const;
+	std::string getArgBytesAsString(std::size_t index) const;
+
 	std::string address; ///< OSC address, must start with a /
-	std::vector<ofxOscArg *> args; ///< current arguments
+	std::vector<Arg> args; ///< current arguments
+	std::string data; ///< string & blob contents, strings are null terminated
 
 	std::string remoteHost; ///< host name/ip the message was sent from
-	int remotePort; ///< port the message was sent from
+	int remotePort = 0; ///< port the message was sent from
 };
@@ -1,5 +1,6 @@
 // copyright (c) openFrameworks team 2012-2023
 #include "ofxOscParameterSync.h"
+#include "ofUtils.h"
 
 //--------------------------------------------------------------
 ofxOscParameterSync::ofxOscParameterSync() {
@@ -26,10 +27,62 @@ void ofxOscParameterSync::update() {
 		receiver.getParameter(syncGroup);
 		updatingParameter = false;
 	}
+
+	if (batched && !changedParameters.empty()) {
+		auto now = ofGetElapsedTimeMicros();
+		if (now - lastSendTime >= sendPeriod) {
+			sendChanges();
+			lastSendTime = now;
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ofxOscParameterSync::setBatched(bool batched, float sendRate) {
+	if (!batched) {
+		sendChanges();
+	}
+	this->batched = batched;
+	sendPeriod = sendRate > 0 ? std::uint64_t(1000000 / sendRate) : 0;
+}
+
+//--------------------------------------------------------------
+bool ofxOscParameterSync::isBatched() const {
+	return batched;
 }
 
 //--------------------------------------------------------------
 void ofxOscParameterSync::parameterChanged(ofAbstractParameter & parameter) {
 	if (updatingParameter) return;
-	sender.sendParameter(parameter);
+	if (!batched) {
+		sender.sendParameter(parameter);
+		return;
+	}
+
+	// parameters are identified by their address, the reference shares the
+	// value with the parameter so only the last value is sent no matter how
+	// many times it changes until then
+	auto groupAddress = ofxOscSender::getParameterAddress(parameter);
+	if (changedAddresses.insert(groupAddress + parameter.getEscapedName()).second) {
+		changedParameters.push_back(parameter.newReference());
+		changedGroupAddresses.push_back(std::move(groupAddress));
+	}
+}
+
+//--------------------------------------------------------------
+void ofxOscParameterSync::sendChanges() {
+	if (changedParameters.empty()) {
+		return;
+	}
+
+	messages.resize(changedParameters.size());
+	for (std::size_t i = 0; i < changedParameters.size(); i++) {
+		messages[i].clear();
+		sender.appendParameter(messages[i], *changedParameters[i], changedGroupAddresses[i]);
+	}
+	sender.sendMessages(messages);
+
+	changedParameters.clear();
+	changedGroupAddresses.clear();
+	changedAddresses.clear();
 }
@@ -5,6 +5,8 @@
 #include "ofxOscReceiver.h"
 #include "ofxOscSender.h"
 
+#include <unordered_set>
+
 /// \class ofxOscParamaterSync
 /// \brief a high-level sync object for ofParamaters over OSC
 class ofxOscParameterSync {
@@ -16,15 +18,40 @@ public:
 	/// the remote and local ports must be different to avoid collisions
 	void setup(ofParameterGroup & group, int localPort, const std::string & remoteHost, int remotePort);
 
-	/// process any incoming messages
+	/// process any incoming messages and, when batched, send the changes
 	void update();
 
+	/// by default every change is sent right away in its own packet.
+	/// When batched the changes are collected and sent from update() in
+	/// bundles of up to 1472 bytes, a parameter that changes several times
+	/// between sends is only sent once with its last value.
+	///
+	/// the changes received in a bundle are always applied in the same update()
+	///
+	/// \param batched true to collect the changes and send them from update()
+	/// \param sendRate max times per second the changes are sent, 0 sends on every update()
+	void setBatched(bool batched, float sendRate = 0);
+
+	/// \return true if the changes are collected and sent from update()
+	bool isBatched() const;
+
 private:
 	/// parameter change callaback
 	void parameterChanged(ofAbstractParameter & parameter);
 
+	/// send the changes collected since the last send
+	void sendChanges();
+
 	ofxOscSender sender; ///< sync sender
 	ofxOscReceiver receiver; ///< sync receiver
 	ofParameterGroup syncGroup; ///< target parameter group
 	bool updatingParameter; ///< is a parameter being updated?
+
+	bool batched = false; ///< send the changes from update()?
+	std::uint64_t sendPeriod = 0; ///< minimum time between sends in microseconds
+	std::uint64_t lastSendTime = 0; ///< time of the last send in microseconds
+	std::vector<std::shared_ptr<ofAbstractParameter>> changedParameters; ///< changed since the last send, in order
+	std::vector<std::string> changedGroupAddresses; ///< address of the group of each changed parameter
+	std::unordered_set<std::string> changedAddresses; ///< full address of the parameters in changedParameters
+	std::vector<ofxOscMessage> messages; ///< reused between sends
 };
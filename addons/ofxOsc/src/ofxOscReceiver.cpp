@@ -122,7 +122,7 @@ bool ofxOscReceiver::isListening() const {
 
 //--------------------------------------------------------------
 bool ofxOscReceiver::hasWaitingMessages() const {
-	return !messagesChannel.empty();
+	return nextMessage < receivedMessages.size() || !messagesChannel.empty();
 }
 
 //--------------------------------------------------------------
@@ -132,18 +132,26 @@ bool ofxOscReceiver::getNextMessage(ofxOscMessage * message) {
 
 //--------------------------------------------------------------
 bool ofxOscReceiver::getNextMessage(ofxOscMessage & message) {
-	return messagesChannel.tryReceive(message);
+	if (nextMessage == receivedMessages.size()) {
+		receivedMessages.clear();
+		nextMessage = 0;
+		if (!messagesChannel.tryReceive(receivedMessages) || receivedMessages.empty()) {
+			return false;
+		}
+	}
+	message = std::move(receivedMessages[nextMessage++]);
+	return true;
 }
 
 std::optional<const ofxOscMessage> ofxOscReceiver::getMessage() {
-	if (messagesChannel.tryReceive(message_buffer)) return { message_buffer };
+	if (getNextMessage(message_buffer)) return { message_buffer };
 	return std::nullopt;
 }
 
 //--------------------------------------------------------------
 bool ofxOscReceiver::getParameter(ofAbstractParameter & parameter) {
 	ofxOscMessage msg;
-	while (messagesChannel.tryReceive(msg)) {
+	while (getNextMessage(msg)) {
 		ofAbstractParameter * p = &parameter;
 		std::vector<std::string> address = ofSplitString(msg.getAddress(), "/", true);
 		for (unsigned int i = 0; i < address.size(); i++) {
@@ -188,11 +196,29 @@ const ofxOscReceiverSettings & ofxOscReceiver::getSettings() const {
 	return settings;
 }
 
+//--------------------------------------------------------------
+void ofxOscReceiver::ProcessPacket(const char * data, int size, const osc::IpEndpointName & remoteEndpoint) {
+	packetMessages.clear();
+	try {
+		osc::OscPacketListener::ProcessPacket(data, size, remoteEndpoint);
+	} catch (osc::Exception & e) {
+		// drop the whole packet so bundles are never received partially
+		ofLogError("ofxOscReceiver") << "ProcessPacket(): malformed packet: " << e.what();
+		packetMessages.clear();
+	}
+
+	// send the packet messages to main thread, they are moved so the arguments are not copied
+	if (!packetMessages.empty()) {
+		messagesChannel.send(std::move(packetMessages));
+	}
+}
+
 // PROTECTED
 //--------------------------------------------------------------
 void ofxOscReceiver::ProcessMessage(const osc::ReceivedMessage & m, const osc::IpEndpointName & remoteEndpoint) {
 	// convert the message to an ofxOscMessage
-	ofxOscMessage msg;
+	packetMessages.emplace_back();
+	ofxOscMessage & msg = packetMessages.back();
 
 	// set the address
 	msg.setAddress(m.AddressPattern());
@@ -234,8 +260,7 @@ void ofxOscReceiver::ProcessMessage(const osc::ReceivedMessage & m, const osc::I
 			const char * dataPtr;
 			osc::osc_bundle_element_size_t len = 0;
 			arg->AsBlobUnchecked((const void *&)dataPtr, len);
-			ofBuffer buffer(dataPtr, len);
-			msg.addBlobArg(buffer);
+			msg.addBlobArg(dataPtr, len);
 		} else {
 			ofLogError("ofxOscReceiver") << "ProcessMessage(): argument in message "
 										 << m.AddressPattern() << " is an unknown type "
@@ -243,9 +268,6 @@ void ofxOscReceiver::ProcessMessage(const osc::ReceivedMessage & m, const osc::I
 			break;
 		}
 	}
-
-	// send msg to main thread
-	messagesChannel.send(std::move(msg));
 }
 
 // friend functions
@@ -84,7 +84,8 @@ public:
 	/// \return true if there are any messages waiting for collection
 	bool hasWaitingMessages() const;
 
-	/// remove a message from the queue and copy it's data into msg
+	/// remove a message from the queue and move it into msg, the arguments
+	/// are not copied
 	/// \return false if there are no waiting messages, otherwise return true
 	bool getNextMessage(ofxOscMessage & msg);
 	[[deprecated("Pass a reference instead of a pointer")]]
@@ -109,6 +110,10 @@ public:
 	/// \return current port value and "listening" if receiver is listening
 	friend std::ostream & operator<<(std::ostream & os, const ofxOscReceiver & receiver);
 
+	/// process a received packet, all the messages in it are queued at
+	/// once so the messages of a bundle are always retrieved together
+	virtual void ProcessPacket(const char * data, int size, const osc::IpEndpointName & remoteEndpoint);
+
 protected:
 	/// process an incoming osc message and add it to the queue
 	virtual void ProcessMessage(const osc::ReceivedMessage & m, const osc::IpEndpointName & remoteEndpoint);
@@ -119,7 +124,10 @@ private:
 	std::unique_ptr<osc::UdpListeningReceiveSocket, std::function<void(osc::UdpListeningReceiveSocket *)>> listenSocket;
 
 	std::thread listenThread; ///< listener thread
-	ofThreadChannel<ofxOscMessage> messagesChannel; ///< message passing thread channel
+	std::vector<ofxOscMessage> packetMessages; ///< messages of the packet being processed by the listener thread
+	ofThreadChannel<std::vector<ofxOscMessage>> messagesChannel; ///< message passing thread channel, one vector per packet
+	std::vector<ofxOscMessage> receivedMessages; ///< last packet received from the channel
+	std::size_t nextMessage = 0; ///< next message to return from receivedMessages
 
 	ofxOscReceiverSettings settings; ///< current settings
 };
@@ -3,6 +3,16 @@
 #include "ofUtils.h"
 #include "ofxOscSender.h"
 
+namespace {
+	// setting this much larger as it gets trimmed down to the size its using before being sent.
+	const std::size_t OUTPUT_BUFFER_SIZE = 327680;
+
+	// size of an OSC string or blob padded to 4 bytes
+	std::size_t roundUp4(std::size_t size) {
+		return (size + 3) & ~std::size_t(3);
+	}
+}
+
 //--------------------------------------------------------------
 ofxOscSender::~ofxOscSender() {
 	clear();
@@ -45,6 +55,11 @@ bool ofxOscSender::setup(const ofxOscSenderSettings & settings) {
 
 	this->settings = settings;
 
+	{
+		std::unique_lock<std::mutex> lock(sendMutex);
+		outputBuffer.resize(OUTPUT_BUFFER_SIZE);
+	}
+
 	// check for empty host
 	if (settings.host == "") {
 		ofLogError("ofxOscSender") << "couldn't create sender to empty host";
@@ -99,14 +114,16 @@ bool ofxOscSender::sendBundle(const ofxOscBundle & bundle) {
 		return false;
 	}
 
-	// setting this much larger as it gets trimmed down to the size its using before being sent.
-	// TODO: much better if we could make this dynamic? Maybe have ofxOscBundle return its size?
-	static const int OUTPUT_BUFFER_SIZE = 327680;
-	char buffer[OUTPUT_BUFFER_SIZE];
-	osc::OutboundPacketStream p(buffer, OUTPUT_BUFFER_SIZE);
+	std::unique_lock<std::mutex> lock(sendMutex);
+	osc::OutboundPacketStream p(outputBuffer.data(), outputBuffer.size());
 
 	// serialise the bundle and send
-	appendBundle(bundle, p);
+	try {
+		appendBundle(bundle, p);
+	} catch (osc::Exception & e) {
+		ofLogError("ofxOscSender") << "couldn't serialise bundle: " << e.what();
+		return false;
+	}
 	sendSocket->Send(p.Data(), p.Size());
 	return true;
 }
@@ -120,19 +137,61 @@ bool ofxOscSender::sendMessage(const ofxOscMessage & message, bool wrapInBundle)
 		return false;
 	}
 
-	// setting this much larger as it gets trimmed down to the size its using before being sent.
-	// TODO: much better if we could make this dynamic? Maybe have ofxOscMessage return its size?
-	static const int OUTPUT_BUFFER_SIZE = 327680;
-	char buffer[OUTPUT_BUFFER_SIZE];
-	osc::OutboundPacketStream p(buffer, OUTPUT_BUFFER_SIZE);
+	std::unique_lock<std::mutex> lock(sendMutex);
+	osc::OutboundPacketStream p(outputBuffer.data(), outputBuffer.size());
 
 	// serialise the message and send
-	if (wrapInBundle) {
-		p << osc::BeginBundleImmediate;
+	try {
+		if (wrapInBundle) {
+			p << osc::BeginBundleImmediate;
+		}
+		appendMessage(message, p);
+		if (wrapInBundle) {
+			p << osc::EndBundle;
+		}
+	} catch (osc::Exception & e) {
+		ofLogError("ofxOscSender") << "couldn't serialise message "
+								   << message.getAddress() << ": " << e.what();
+		return false;
 	}
-	appendMessage(message, p);
-	if (wrapInBundle) {
+	sendSocket->Send(p.Data(), p.Size());
+	return true;
+}
+
+//--------------------------------------------------------------
+bool ofxOscSender::sendMessages(const std::vector<ofxOscMessage> & messages) {
+	if (!isReady()) {
+		if (!settings.silent) {
+			ofLogError("ofxOscSender") << "trying to send with empty socket";
+		}
+		return false;
+	}
+	if (messages.empty()) {
+		return true;
+	}
+
+	std::unique_lock<std::mutex> lock(sendMutex);
+	osc::OutboundPacketStream p(outputBuffer.data(), outputBuffer.size());
+	const std::size_t emptyBundleSize = 16; // "#bundle" + timetag
+
+	try {
+		p << osc::BeginBundleImmediate;
+		for (auto & message : messages) {
+			// send the current bundle if this message doesn't fit,
+			// a message bigger than maxPacketSize is sent on its own
+			std::size_t elementSize = 4 + getMessageSize(message);
+			if (p.Size() > emptyBundleSize && p.Size() + elementSize > settings.maxPacketSize) {
+				p << osc::EndBundle;
+				sendSocket->Send(p.Data(), p.Size());
+				p.Clear();
+				p << osc::BeginBundleImmediate;
+			}
+			appendMessage(message, p);
+		}
 		p << osc::EndBundle;
+	} catch (osc::Exception & e) {
+		ofLogError("ofxOscSender") << "couldn't serialise messages: " << e.what();
+		return false;
 	}
 	sendSocket->Send(p.Data(), p.Size());
 	return true;
@@ -150,16 +209,8 @@ bool ofxOscSender::sendParameter(const ofAbstractParameter & parameter) {
 		appendParameter(bundle, parameter, address);
 		sendBundle(bundle);
 	} else {
-		std::string address = "";
-		const std::vector<std::string> hierarchy = parameter.getGroupHierarchyNames();
-		for (int i = 0; i < (int)hierarchy.size() - 1; i++) {
-			address += "/" + hierarchy[i];
-		}
-		if (address.length()) {
-			address += "/";
-		}
 		ofxOscMessage msg;
-		appendParameter(msg, parameter, address);
+		appendParameter(msg, parameter, getParameterAddress(parameter));
 		sendMessage(msg, false);
 	}
 	return true;
@@ -196,36 +247,40 @@ void ofxOscSender::appendBundle(const ofxOscBundle & bundle, osc::OutboundPacket
 
 //--------------------------------------------------------------
 void ofxOscSender::appendMessage(const ofxOscMessage & message, osc::OutboundPacketStream & p) {
-	p << osc::BeginMessage(message.getAddress().c_str());
-	for (size_t i = 0; i < message.getNumArgs(); ++i) {
-		switch (message.getArgType(i)) {
+	// read the arguments in place, without the conversions and copies of the getters
+	p << osc::BeginMessage(message.address.c_str());
+	for (size_t i = 0; i < message.args.size(); ++i) {
+		auto & arg = message.args[i];
+		switch (arg.type) {
 		case OFXOSC_TYPE_INT32:
-			p << message.getArgAsInt32(i);
+			p << (osc::int32)arg.int32Value;
 			break;
 		case OFXOSC_TYPE_INT64:
-			p << (osc::int64)message.getArgAsInt64(i);
+			p << (osc::int64)arg.int64Value;
 			break;
 		case OFXOSC_TYPE_FLOAT:
-			p << message.getArgAsFloat(i);
+			p << arg.floatValue;
 			break;
 		case OFXOSC_TYPE_DOUBLE:
-			p << message.getArgAsDouble(i);
+			p << arg.doubleValue;
 			break;
 		case OFXOSC_TYPE_STRING:
-			p << message.getArgAsString(i).c_str();
+			p << message.getBytes(i);
 			break;
 		case OFXOSC_TYPE_SYMBOL:
-			p << osc::Symbol(message.getArgAsString(i).c_str());
+			p << osc::Symbol(message.getBytes(i));
 			break;
 		case OFXOSC_TYPE_CHAR:
-			p << message.getArgAsChar(i);
+			p << arg.charValue;
 			break;
 		case OFXOSC_TYPE_MIDI_MESSAGE:
-			p << osc::MidiMessage(message.getArgAsMidiMessage(i));
+			p << osc::MidiMessage(arg.uint32Value);
 			break;
 		case OFXOSC_TYPE_TRUE:
+			p << true;
+			break;
 		case OFXOSC_TYPE_FALSE:
-			p << message.getArgAsBool(i);
+			p << false;
 			break;
 		case OFXOSC_TYPE_NONE:
 			p << osc::NilType();
@@ -234,25 +289,55 @@ void ofxOscSender::appendMessage(const ofxOscMessage & message, osc::OutboundPac
 			p << osc::InfinitumType();
 			break;
 		case OFXOSC_TYPE_TIMETAG:
-			p << osc::TimeTag(message.getArgAsTimetag(i));
+			p << osc::TimeTag(arg.timetagValue);
 			break;
 		case OFXOSC_TYPE_RGBA_COLOR:
-			p << osc::RgbaColor(message.getArgAsRgbaColor(i));
+			p << osc::RgbaColor(arg.uint32Value);
 			break;
-		case OFXOSC_TYPE_BLOB: {
-			ofBuffer buff = message.getArgAsBlob(i);
-			p << osc::Blob(buff.getData(), (unsigned long)buff.size());
+		case OFXOSC_TYPE_BLOB:
+			p << osc::Blob(message.getBytes(i), (osc::osc_bundle_element_size_t)arg.bytes.size);
 			break;
-		}
 		default:
 			ofLogError("ofxOscSender") << "appendMessage(): bad argument type "
-									   << message.getArgType(i) << " '" << (char)message.getArgType(i) << "'";
+									   << arg.type << " '" << (char)arg.type << "'";
 			break;
 		}
 	}
 	p << osc::EndMessage;
 }
 
+//--------------------------------------------------------------
+std::size_t ofxOscSender::getMessageSize(const ofxOscMessage & message) {
+	// address and type tags, both null terminated and the tags starting with ','
+	std::size_t size = roundUp4(message.address.size() + 1) + roundUp4(message.args.size() + 2);
+	for (auto & arg : message.args) {
+		switch (arg.type) {
+		case OFXOSC_TYPE_INT32:
+		case OFXOSC_TYPE_FLOAT:
+		case OFXOSC_TYPE_CHAR:
+		case OFXOSC_TYPE_MIDI_MESSAGE:
+		case OFXOSC_TYPE_RGBA_COLOR:
+			size += 4;
+			break;
+		case OFXOSC_TYPE_INT64:
+		case OFXOSC_TYPE_DOUBLE:
+		case OFXOSC_TYPE_TIMETAG:
+			size += 8;
+			break;
+		case OFXOSC_TYPE_STRING:
+		case OFXOSC_TYPE_SYMBOL:
+			size += roundUp4(arg.bytes.size + 1);
+			break;
+		case OFXOSC_TYPE_BLOB:
+			size += 4 + roundUp4(arg.bytes.size);
+			break;
+		default:
+			break;
+		}
+	}
+	return size;
+}
+
 //--------------------------------------------------------------
 void ofxOscSender::appendParameter(ofxOscBundle & _bundle, const ofAbstractParameter & parameter, const std::string & address) {
 	if (parameter.type() == typeid(ofParameterGroup).name()) {
@@ -293,6 +378,20 @@ void ofxOscSender::appendParameter(ofxOscMessage & msg, const ofAbstractParamete
 	}
 }
 
+//--------------------------------------------------------------
+std::string ofxOscSender::getParameterAddress(const ofAbstractParameter & parameter) {
+	// address of the groups containing the parameter, appendParameter adds its name
+	std::string address = "";
+	const std::vector<std::string> hierarchy = parameter.getGroupHierarchyNames();
+	for (int i = 0; i < (int)hierarchy.size() - 1; i++) {
+		address += "/" + hierarchy[i];
+	}
+	if (address.length()) {
+		address += "/";
+	}
+	return address;
+}
+
 // friend functions
 //--------------------------------------------------------------
 std::ostream & operator<<(std::ostream & os, const ofxOscSender & sender) {
@@ -9,6 +9,8 @@
 #include "ofParameter.h"
 #include "ofxOscBundle.h"
 
+#include <mutex>
+
 /// \struct ofxOscSenderSettings
 /// \brief OSC message sender settings
 struct ofxOscSenderSettings {
@@ -16,6 +18,7 @@ struct ofxOscSenderSettings {
 	int port = 0; ///< destination port
 	bool broadcast = true; ///< broadcast (aka multicast) ip range support?
 	bool silent = false; ///< does not complain if msgs not received
+	std::size_t maxPacketSize = 1472; ///< max size of the bundles sent by sendMessages, the default fits in an ethernet frame
 };
 
 /// \class ofxOscSender
@@ -57,6 +60,13 @@ public:
 	bool sendBundle(const ofxOscBundle & bundle);
 	bool send(const ofxOscBundle & bundle) { return sendBundle(bundle); };
 
+	/// send several messages packed in immediate bundles of up to
+	/// maxPacketSize bytes, which needs much less packets and system calls
+	/// than sending each message on its own
+	/// \return true on successfull send
+	bool sendMessages(const std::vector<ofxOscMessage> & messages);
+	bool send(const std::vector<ofxOscMessage> & messages) { return sendMessages(messages); };
+
 	/// create & send a message with data from an ofParameter
 	/// \return true on successfull send
 	bool sendParameter(const ofAbstractParameter & parameter);
@@ -84,12 +94,19 @@ public:
 	friend std::ostream & operator<<(std::ostream & os, const ofxOscSender & sender);
 
 private:
+	friend class ofxOscParameterSync;
+
 	// helper methods for constructing messages
 	void appendBundle(const ofxOscBundle & bundle, osc::OutboundPacketStream & p);
 	void appendMessage(const ofxOscMessage & message, osc::OutboundPacketStream & p);
 	void appendParameter(ofxOscBundle & bundle, const ofAbstractParameter & parameter, const std::string & address);
 	void appendParameter(ofxOscMessage & msg, const ofAbstractParameter & parameter, const std::string & address);
+	static std::string getParameterAddress(const ofAbstractParameter & parameter);
+	static std::size_t getMessageSize(const ofxOscMessage & message);
 
 	ofxOscSenderSettings settings; ///< current settings
 	std::unique_ptr<osc::UdpTransmitSocket> sendSocket; ///< sender socket
+
+	std::vector<char> outputBuffer; ///< packets are serialised here, allocated once in setup
+	std::mutex sendMutex; ///< guards outputBuffer so the sender can be used from several threads
 };
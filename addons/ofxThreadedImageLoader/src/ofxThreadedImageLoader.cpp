@@ -1,69 +1,324 @@
 #include "ofxThreadedImageLoader.h"
 #include "ofLog.h"
+#include "ofTaskPool.h"
+#include <algorithm>
+#include <iterator>
 #include <sstream>
 
 ofxThreadedImageLoader::ofxThreadedImageLoader(){
 	nextID = 0;
-    ofAddListener(ofEvents().update, this, &ofxThreadedImageLoader::update);
+	closed = false;
+	numWorkers = std::max(size_t(1), ofGetTaskPool().getNumThreads());
+	uploadTimeBudget = 4;
+	numDecoding = 0;
+	numDecoded = 0;
+	totalDecodeTime = 0;
+	ofAddListener(ofEvents().update, this, &ofxThreadedImageLoader::update);
 	ofAddListener(ofURLResponseEvent(),this,&ofxThreadedImageLoader::urlResponse);
-    
-    startThread();
-    lastUpdate = 0;
+
+	startThread();
 }
 
 ofxThreadedImageLoader::~ofxThreadedImageLoader(){
-	images_to_load_from_disk.close();
-	images_to_update.close();
+	{
+		std::unique_lock<std::mutex> lock(queueMutex);
+		closed = true;
+		images_to_load.clear();
+		queueCondition.notify_all();
+	}
 	waitForThread(true);
-    ofRemoveListener(ofEvents().update, this, &ofxThreadedImageLoader::update);
+
+	// the decoding tasks reference this loader, wait for them to finish
+	// before destroying anything they use
+	waitForDecodingTasks(true);
+	images_to_update.close();
+	ofRemoveListener(ofEvents().update, this, &ofxThreadedImageLoader::update);
 	ofRemoveListener(ofURLResponseEvent(),this,&ofxThreadedImageLoader::urlResponse);
 }
 
 // Load an image from disk.
 //--------------------------------------------------------------
-void ofxThreadedImageLoader::loadFromDisk(ofImage& image, std::string filename) {
-	nextID++;
+void ofxThreadedImageLoader::loadFromDisk(ofImage& image, std::string filename, int priority) {
 	ofImageLoaderEntry entry(image);
 	entry.filename = filename;
-	entry.image->setUseTexture(false);
 	entry.name = filename;
-    
-	images_to_load_from_disk.send(entry);
+	entry.priority = priority;
+	enqueue(std::move(entry));
 }
 
 
 // Load an url asynchronously from an url.
 //--------------------------------------------------------------
-void ofxThreadedImageLoader::loadFromURL(ofImage& image, std::string url) {
-	nextID++;
+void ofxThreadedImageLoader::loadFromURL(ofImage& image, std::string url, int priority) {
 	ofImageLoaderEntry entry(image);
 	entry.url = url;
-	entry.image->setUseTexture(false);	
-	entry.name = "image" + ofToString(nextID);
+	entry.priority = priority;
+	{
+		std::unique_lock<std::mutex> lock(queueMutex);
+		entry.id = ++nextID;
+	}
+	entry.name = "image" + ofToString(entry.id);
+	entry.requestId = ofLoadURLAsync(entry.url, entry.name);
 	images_async_loading[entry.name] = entry;
-	ofLoadURLAsync(entry.url, entry.name);
 }
 
 
-// Reads from the queue and loads new images.
+// Queues an entry to be decoded by the loader thread.
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::enqueue(ofImageLoaderEntry && entry){
+	std::unique_lock<std::mutex> lock(queueMutex);
+	if(closed){
+		return;
+	}
+	if(entry.id == 0){
+		entry.id = ++nextID;
+	}
+	images_to_load.emplace(entry.priority, std::move(entry));
+	queueCondition.notify_all();
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::setPriority(ofImage& image, int priority){
+	std::unique_lock<std::mutex> lock(queueMutex);
+	std::vector<ofImageLoaderEntry> changed;
+	for(auto it = images_to_load.begin(); it != images_to_load.end();){
+		if(it->second.image == &image){
+			it->second.priority = priority;
+			changed.push_back(std::move(it->second));
+			it = images_to_load.erase(it);
+		}else{
+			++it;
+		}
+	}
+	for(auto & entry: changed){
+		images_to_load.emplace(priority, std::move(entry));
+	}
+	for(auto & loading: images_async_loading){
+		if(loading.second.image == &image){
+			loading.second.priority = priority;
+		}
+	}
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::cancel(ofImage& image){
+	std::unique_lock<std::mutex> lock(queueMutex);
+	for(auto it = images_to_load.begin(); it != images_to_load.end();){
+		if(it->second.image == &image){
+			it = images_to_load.erase(it);
+			stats.canceled++;
+		}else{
+			++it;
+		}
+	}
+	for(auto & inProgress: images_in_progress){
+		if(inProgress.second == &image){
+			images_canceled.insert(inProgress.first);
+		}
+	}
+
+	// this happens in the update thread, same as urlResponse, so
+	// images_async_loading is only accessed from this thread
+	for(auto it = images_async_loading.begin(); it != images_async_loading.end();){
+		if(it->second.image == &image){
+			ofRemoveURLRequest(it->second.requestId);
+			it = images_async_loading.erase(it);
+			stats.canceled++;
+		}else{
+			++it;
+		}
+	}
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::cancelAll(){
+	std::unique_lock<std::mutex> lock(queueMutex);
+	stats.canceled += images_to_load.size() + images_async_loading.size();
+	images_to_load.clear();
+	for(auto & inProgress: images_in_progress){
+		images_canceled.insert(inProgress.first);
+	}
+	lock.unlock();
+	for(auto & loading: images_async_loading){
+		ofRemoveURLRequest(loading.second.requestId);
+	}
+	images_async_loading.clear();
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::setNumWorkers(size_t workers){
+	std::unique_lock<std::mutex> lock(queueMutex);
+	numWorkers = std::max(size_t(1), workers);
+	queueCondition.notify_all();
+}
+
+
+//--------------------------------------------------------------
+size_t ofxThreadedImageLoader::getNumWorkers() const{
+	std::unique_lock<std::mutex> lock(queueMutex);
+	return numWorkers;
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::setUploadTimeBudget(float milliseconds){
+	uploadTimeBudget = milliseconds;
+}
+
+
+//--------------------------------------------------------------
+float ofxThreadedImageLoader::getUploadTimeBudget() const{
+	return uploadTimeBudget;
+}
+
+
+//--------------------------------------------------------------
+ofxThreadedImageLoader::Stats ofxThreadedImageLoader::getStats() const{
+	std::unique_lock<std::mutex> lock(queueMutex);
+	Stats current = stats;
+	current.queued = images_to_load.size();
+	current.decoding = numDecoding;
+	current.waitingUpload = images_to_update.size();
+	return current;
+}
+
+
+// Takes the requests with the highest priority from the queue and
+// decodes them in the task pool, with at most numWorkers at a time.
 //--------------------------------------------------------------
 void ofxThreadedImageLoader::threadedFunction() {
 	setThreadName("ofxThreadedImageLoader " + ofToString(thread.get_id()));
-	ofImageLoaderEntry entry;
-	while( images_to_load_from_disk.receive(entry) ) {
-		if(entry.image->load(entry.filename) )  {
-			images_to_update.send(entry);
-		}else{
-			ofLogError("ofxThreadedImageLoader") << "couldn't load file: \"" << entry.filename << "\"";
+	while(isThreadRunning()) {
+		ofImageLoaderEntry entry;
+		{
+			std::unique_lock<std::mutex> lock(queueMutex);
+			queueCondition.wait(lock, [this]{
+				return closed || (!images_to_load.empty() && numDecoding < numWorkers);
+			});
+			if(closed){
+				break;
+			}
+			auto next = images_to_load.begin();
+			entry = std::move(next->second);
+			images_to_load.erase(next);
+			images_in_progress[entry.id] = entry.image;
+			numDecoding++;
 		}
+
+		auto id = entry.id;
+		auto decoding = std::make_shared<ofImageLoaderEntry>(std::move(entry));
+		auto task = ofGetTaskPool().submit([this, decoding, id]{
+			try{
+				decode(std::move(*decoding));
+			}catch(...){
+				finishDecoding(id, true);
+				throw;
+			}
+			finishDecoding(id, false);
+		});
+		std::unique_lock<std::mutex> lock(queueMutex);
+		decodingTasks.push_back(std::move(task));
 	}
 	ofLogVerbose("ofxThreadedImageLoader") << "finishing thread on closed queue";
 }
 
 
-// When we receive an url response this method is called; 
+// Runs in one of the task pool workers.
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::decode(ofImageLoaderEntry && entry){
+	auto start = std::chrono::steady_clock::now();
+	bool loaded;
+	if(entry.filename.empty()){
+		loaded = ofLoadImage(entry.pixels, entry.data);
+		entry.data.clear();
+	}else{
+		loaded = ofLoadImage(entry.pixels, entry.filename);
+	}
+	double decodeTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	bool canceled;
+	{
+		std::unique_lock<std::mutex> lock(queueMutex);
+		canceled = images_canceled.erase(entry.id) > 0;
+		if(canceled || !loaded){
+			images_in_progress.erase(entry.id);
+		}
+		if(canceled){
+			stats.canceled++;
+		}else if(loaded){
+			numDecoded++;
+			totalDecodeTime += decodeTime;
+			stats.maxDecodeTime = std::max(stats.maxDecodeTime, decodeTime);
+			stats.averageDecodeTime = totalDecodeTime / numDecoded;
+		}else{
+			stats.failed++;
+		}
+	}
+
+	if(canceled){
+		return;
+	}
+	if(loaded){
+		images_to_update.send(std::move(entry));
+	}else if(entry.filename.empty()){
+		ofLogError("ofxThreadedImageLoader") << "couldn't load image from url: \"" << entry.url << "\"";
+	}else{
+		ofLogError("ofxThreadedImageLoader") << "couldn't load file: \"" << entry.filename << "\"";
+	}
+}
+
+
+// Runs in the task pool worker once decode() is done with the loader,
+// lets the loader thread start the next decode.
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::finishDecoding(uint64_t id, bool failed){
+	std::unique_lock<std::mutex> lock(queueMutex);
+	if(failed){
+		images_in_progress.erase(id);
+		images_canceled.erase(id);
+		stats.failed++;
+	}
+	numDecoding--;
+	queueCondition.notify_all();
+}
+
+
+// Collects the decoding tasks that finished, or waits for all of them,
+// logging the exceptions they threw.
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::waitForDecodingTasks(bool all){
+	std::vector<std::future<void>> finished;
+	{
+		std::unique_lock<std::mutex> lock(queueMutex);
+		if(all){
+			finished.swap(decodingTasks);
+		}else{
+			auto ready = std::partition(decodingTasks.begin(), decodingTasks.end(), [](std::future<void> & task){
+				return task.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+			});
+			std::move(ready, decodingTasks.end(), std::back_inserter(finished));
+			decodingTasks.erase(ready, decodingTasks.end());
+		}
+	}
+	for(auto & task: finished){
+		try{
+			task.get();
+		}catch(std::exception & e){
+			ofLogError("ofxThreadedImageLoader") << "exception decoding image: " << e.what();
+		}catch(...){
+			ofLogError("ofxThreadedImageLoader") << "unknown exception decoding image";
+		}
+	}
+}
+
+
+// When we receive an url response this method is called;
 // The loaded image is removed from the async_queue and added to the
-// update queue. The update queue is used to update the texture.
+// decode queue.
 //--------------------------------------------------------------
 void ofxThreadedImageLoader::urlResponse(ofHttpResponse & response) {
 	// this happens in the update thread so no need to lock to access
@@ -71,8 +326,8 @@ void ofxThreadedImageLoader::urlResponse(ofHttpResponse & response) {
 	entry_iterator it = images_async_loading.find(response.request.name);
 	if(response.status == 200) {
 		if(it != images_async_loading.end()) {
-			it->second.image->load(response.data);
-			images_to_update.send(it->second);
+			it->second.data = response.data;
+			enqueue(std::move(it->second));
 		}
 	}else{
 		// log error.
@@ -87,14 +342,38 @@ void ofxThreadedImageLoader::urlResponse(ofHttpResponse & response) {
 }
 
 
-// Check the update queue and update the texture
+// Check the update queue and upload the textures until the time budget
+// for this frame runs out
 //--------------------------------------------------------------
 void ofxThreadedImageLoader::update(ofEventArgs & a){
-    // Load 1 image per update so we don't block the gl thread for too long
+	auto start = std::chrono::steady_clock::now();
+	auto elapsed = [start]{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	};
+
 	ofImageLoaderEntry entry;
-	if (images_to_update.tryReceive(entry)) {
+	size_t uploaded = 0;
+	while((uploaded == 0 || elapsed() < uploadTimeBudget) && images_to_update.tryReceive(entry)) {
+		{
+			std::unique_lock<std::mutex> lock(queueMutex);
+			images_in_progress.erase(entry.id);
+			if(images_canceled.erase(entry.id) > 0){
+				stats.canceled++;
+				continue;
+			}
+			stats.loaded++;
+		}
+		entry.image->getPixels().swap(entry.pixels);
 		entry.image->setUseTexture(true);
 		entry.image->update();
+		entry.pixels.clear();
+		uploaded++;
 	}
-}
 
+	if(uploaded > 0){
+		std::unique_lock<std::mutex> lock(queueMutex);
+		stats.lastUploadTime = elapsed();
+	}
+
+	waitForDecodingTasks(false);
+}
@@ -6,47 +6,136 @@
 #include "ofURLFileLoader.h"
 #include "ofTypes.h"
 #include "ofThreadChannel.h"
+#include <condition_variable>
+#include <future>
+#include <set>
 
+/// \brief Loads images in the background and uploads them to the GPU
+/// from the update event.
+///
+/// Images are decoded by several workers of the shared ofTaskPool, in
+/// order of priority, higher first. Requests can be canceled or
+/// reprioritized while they are still waiting, e.g. to load the images
+/// that are visible on screen first when scrolling a gallery.
+///
+/// Decoded images are uploaded in update() until a time budget runs out,
+/// so loading hundreds of images doesn't make any frame take too long.
 class ofxThreadedImageLoader : public ofThread {
 public:
-    ofxThreadedImageLoader();
-    ~ofxThreadedImageLoader();
+	ofxThreadedImageLoader();
+	~ofxThreadedImageLoader();
 
-	void loadFromDisk(ofImage& image, std::string file);
-	void loadFromURL(ofImage& image, std::string url);
+	/// \brief Load an image from disk.
+	///
+	/// \param priority Images with higher priority are decoded first.
+	void loadFromDisk(ofImage& image, std::string file, int priority = 0);
 
+	/// \brief Load an image from a URL.
+	///
+	/// The download is asynchronous, once it arrives the image is decoded
+	/// like the ones loaded from disk.
+	///
+	/// \param priority Images with higher priority are decoded first.
+	void loadFromURL(ofImage& image, std::string url, int priority = 0);
 
+	/// \brief Change the priority of every request for this image that
+	/// hasn't started decoding yet.
+	void setPriority(ofImage& image, int priority);
+
+	/// \brief Cancel every pending request for this image.
+	///
+	/// Images already being decoded are discarded once they finish.
+	void cancel(ofImage& image);
+
+	/// \brief Cancel every pending request.
+	void cancelAll();
+
+	/// \brief Maximum number of images decoded at the same time.
+	///
+	/// Defaults to the number of threads in ofGetTaskPool().
+	void setNumWorkers(size_t numWorkers);
+	size_t getNumWorkers() const;
+
+	/// \brief Maximum time in milliseconds spent uploading textures in
+	/// every update.
+	///
+	/// At least one image is uploaded per update even if it takes longer.
+	/// Defaults to 4ms.
+	void setUploadTimeBudget(float milliseconds);
+	float getUploadTimeBudget() const;
+
+	struct Stats{
+		/// \brief Requests waiting to be decoded.
+		size_t queued = 0;
+		/// \brief Images being decoded right now.
+		size_t decoding = 0;
+		/// \brief Decoded images waiting to be uploaded.
+		size_t waitingUpload = 0;
+		/// \brief Images loaded since the loader was created.
+		size_t loaded = 0;
+		/// \brief Images that couldn't be decoded.
+		size_t failed = 0;
+		/// \brief Requests canceled before they were uploaded.
+		size_t canceled = 0;
+		/// \brief Average and maximum time spent decoding an image, in ms.
+		double averageDecodeTime = 0;
+		double maxDecodeTime = 0;
+		/// \brief Time spent uploading textures in the last update, in ms.
+		double lastUploadTime = 0;
+	};
+
+	/// \brief Counters to monitor the loader's queues and performance.
+	Stats getStats() const;
 
 private:
 	void update(ofEventArgs & a);
-    virtual void threadedFunction();
+	virtual void threadedFunction();
 	void urlResponse(ofHttpResponse & response);
-    
-    // Entry to load.
-    struct ofImageLoaderEntry {
-    public:
-        ofImageLoaderEntry() {
-            image = NULL;
-        }
-        
-        ofImageLoaderEntry(ofImage & pImage) {
-            image = &pImage;
-        }
-        ofImage* image;
-        std::string filename;
-        std::string url;
-        std::string name;
-    };
-
-
-    typedef std::map<std::string, ofImageLoaderEntry>::iterator entry_iterator;
-
-	int                 nextID;
-    int                 lastUpdate;
+
+	// Entry to load.
+	struct ofImageLoaderEntry {
+	public:
+		ofImageLoaderEntry() {
+			image = NULL;
+		}
+
+		ofImageLoaderEntry(ofImage & pImage) {
+			image = &pImage;
+		}
+		ofImage* image;
+		std::string filename;
+		std::string url;
+		std::string name;
+		int priority = 0;
+		uint64_t id = 0;
+		int requestId = -1;
+		ofBuffer data;
+		ofPixels pixels;
+	};
+
+	void enqueue(ofImageLoaderEntry && entry);
+	void decode(ofImageLoaderEntry && entry);
+	void finishDecoding(uint64_t id, bool failed);
+	void waitForDecodingTasks(bool all);
+
+	typedef std::map<std::string, ofImageLoaderEntry>::iterator entry_iterator;
+
+	uint64_t            nextID;
 
 	std::map<std::string,ofImageLoaderEntry> images_async_loading; // keeps track of images which are loading async
-	ofThreadChannel<ofImageLoaderEntry> images_to_load_from_disk;
+	std::multimap<int,ofImageLoaderEntry,std::greater<int>> images_to_load; // waiting to be decoded, highest priority first
+	std::map<uint64_t,ofImage*> images_in_progress; // decoding or waiting upload
+	std::set<uint64_t> images_canceled; // in progress when they were canceled
 	ofThreadChannel<ofImageLoaderEntry> images_to_update;
-};
-
+	std::vector<std::future<void>> decodingTasks; // submitted to the task pool, waited on before destruction
 
+	mutable std::mutex queueMutex;
+	std::condition_variable queueCondition;
+	bool closed;
+	size_t numWorkers;
+	float uploadTimeBudget;
+	size_t numDecoding;
+	Stats stats;
+	size_t numDecoded;
+	double totalDecodeTime;
+};
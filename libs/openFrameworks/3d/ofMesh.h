@@ -234,7 +234,17 @@ public:
 	/// of the current mesh's lists.
 	void append(const ofMesh_ & mesh);
 
-	void mergeDuplicateVertices();
+	/// \brief Merge the vertices that are in the same position, or closer
+	/// than epsilon, into one and update the indices to point to it.
+	///
+	/// The colors, normals and texture coordinates of the first vertex of
+	/// each group are kept and vertices that aren't indexed are removed.
+	/// If the mesh has no indices they are generated first. Runs in linear
+	/// time using a spatial hash so it can be used on big meshes.
+	///
+	/// \param epsilon Maximum distance between two vertices to merge
+	/// them, 0 merges only the ones that are exactly equal.
+	void mergeDuplicateVertices(float epsilon = 0);
 
 	/// \returns a glm::vec3 defining the centroid of all the vetices in the mesh.
 	V getCentroid() const;
@@ -315,7 +325,17 @@ public:
 	virtual void disableNormals();
 	virtual bool usingNormals() const;
 
-	void smoothNormals( float angle );
+	/// \brief Calculate normals that are averaged across adjacent faces.
+	///
+	/// Faces whose normals differ by more than angle don't contribute to
+	/// each other, so hard edges are kept. Vertices closer than epsilon are
+	/// considered the same point. Only works with OF_PRIMITIVE_TRIANGLES,
+	/// the resulting mesh has one vertex per face corner.
+	///
+	/// \param angle Maximum angle in degrees between faces to smooth them.
+	/// \param epsilon Maximum distance between vertices to consider them
+	/// the same point.
+	void smoothNormals( float angle, float epsilon = 0.01f );
         
         /// \brief Duplicates vertices and updates normals to get a low-poly look.
         void flatNormals();
@@ -331,6 +351,8 @@ public:
 	/// As a default it only calculates the normal for the face as a whole but
 	/// by setting (perVertex = true) it will return the same normal value for
 	/// each of the three vertices making up a face.
+	/// Assumes the mesh is made of triangles, the normals are calculated in
+	/// parallel using ofGetTaskPool() and kept until the mesh changes.
 	/// \returns a vector containing the calculated normals of each face in the mesh.
 	std::vector<N> getFaceNormals( bool perVetex=false) const;
 
@@ -601,8 +623,9 @@ public:
 	/// \brief Loads a mesh from a file located at the provided path into the mesh.
 	/// This will replace any existing data within the mesh.
 	///
-	/// It expects that the file will be in the [PLY Format](http://en.wikipedia.org/wiki/PLY_(file_format)).
-	/// It will only load meshes saved in the PLY ASCII format; the binary format is not supported.
+	/// It expects that the file will be in the [PLY Format](http://en.wikipedia.org/wiki/PLY_(file_format)),
+	/// either ASCII or binary. Binary files are much faster to load. To load
+	/// meshes that don't fit in memory in chunks use ofPlyReader.
     void load(const of::filesystem::path& path);
 
 	///  \brief Saves the mesh at the passed path in the [PLY Format](http://en.wikipedia.org/wiki/PLY_(file_format)).
@@ -611,7 +634,8 @@ public:
 	///  By default, it will save using the ASCII format.
 	///  Passing ``true`` into the ``useBinary`` parameter will save it in the binary format.
 	///
-	///  If you're planning on reloading the mesh into ofMesh, ofMesh currently only supports loading the ASCII format.
+	///  The binary format is much faster to save and load and takes less space.
+	///  To save meshes that don't fit in memory in chunks use ofPlyWriter.
 	///
 	///  For more information, see the [PLY format specification](http://paulbourke.net/dataformats/ply/).
     void save(const of::filesystem::path& path, bool useBinary = false) const;
@@ -637,6 +661,12 @@ protected:
 
 private:
 
+	// maps every vertex to the first one closer than epsilon
+	std::vector<ofIndexType> findDuplicateVertices(float epsilon) const;
+
+	// empties the caches built from the triangles if the mesh changed since
+	void clearFacesIfDirty() const;
+
 	std::vector<V> vertices;
 	std::vector<C> colors;
 	std::vector<N> normals;
@@ -645,7 +675,10 @@ private:
 
 	// this variables are only caches and returned always as const
 	// mutable allows to change them from const methods
+	// faces and faceNormals are filled when first requested and emptied
+	// together when bFacesDirty, so every accessor shares the same pass
 	mutable std::vector<ofMeshFace_<V,N,C,T>> faces;
+	mutable std::vector<N> faceNormals;
 	mutable bool bFacesDirty;
 
 	bool bVertsChanged, bColorsChanged, bNormalsChanged, bTexCoordsChanged,
@@ -9,10 +9,14 @@
 #include "ofLog.h"
 #include "ofColor.h"
 #include "ofUtils.h" // ofTo
+#include "ofPly.h"
+#include "ofTaskPool.h"
 
 //#include <glm/gtx/vector_angle.hpp>
 
 #include <unordered_map>
+#include <limits>
+#include <cstring>
 
 //--------------------------------------------------------------
 template<class V, class N, class C, class T>
@@ -1091,362 +1095,64 @@ void ofMesh_<V,N,C,T>::append(const ofMesh_<V,N,C,T> & mesh){
 //--------------------------------------------------------------
 template<class V, class N, class C, class T>
 void ofMesh_<V,N,C,T>::load(const of::filesystem::path& path){
-	ofFile is = {path, ofFile::ReadOnly};
-	auto & data = *this;
-
-	std::string error;
-	ofBuffer buffer(is);
-	auto backup = data;
-
-	int orderVertices=-1;
-	int orderIndices=-1;
-
-	ofIndexType vertexCoordsFound=0;
-	ofIndexType colorCompsFound=0;
-	ofIndexType texCoordsFound=0;
-	ofIndexType normalsCoordsFound=0;
-
-	ofIndexType currentVertex = 0;
-	ofIndexType currentFace = 0;
-
-	bool colorTypeIsUChar = false; /// flag to distinguish between uchar (more common) and float (less common) color format in ply file
-	
-	enum State{
-		Header,
-		VertexDef,
-		FaceDef,
-		Vertices,
-		Normals,
-		Faces
-	};
-
-	
-	enum Attribute {
-		Position,
-		Color,
-		Normal,
-		TexCoord,
-	};
-	
-	std::vector<Attribute> meshDefinition;
-	
-	data.clear();
-	State state = Header;
-
-	int lineNum = 0;
-	ofBuffer::Lines lines = buffer.getLines();
-	ofBuffer::Line line = lines.begin();
-	lineNum++;
-	if(*line!="ply"){
-		error = "wrong format, expecting 'ply'";
-		goto clean;
-	}
-
-	line++;
-	lineNum++;
-	if(*line!="format ascii 1.0"){
-		error = "wrong format, expecting 'format ascii 1.0'";
-		goto clean;
-	}
-
-	for(;line != lines.end(); ++line){
-		lineNum++;
-		std::string lineStr = *line;
-		if(lineStr.find("comment")==0 || lineStr.empty()){
-			continue;
-		}
-
-		if((state==Header || state==FaceDef) && lineStr.find("element vertex")==0){
-			state = VertexDef;
-			orderVertices = std::max(orderIndices, 0)+1;
-			data.getVertices().resize(ofTo<size_t>(lineStr.substr(15)));
-			continue;
-		}
-
-		if((state==Header || state==VertexDef) && lineStr.find("element face")==0){
-			state = FaceDef;
-			orderIndices = std::max(orderVertices, 0)+1;
-			data.getIndices().resize(ofTo<size_t>(lineStr.substr(13))*3);
-			continue;
-		}
-
-		if(state==VertexDef && (lineStr.find("property float x")==0 || lineStr.find("property float y")==0 || lineStr.find("property float z")==0
-                || lineStr.find("property double x")==0 || lineStr.find("property double y")==0 || lineStr.find("property double z")==0)){
-			meshDefinition.push_back(Position);
-			vertexCoordsFound++;
-			continue;
-		}
-
-		if(state==VertexDef && (lineStr.find("property float r")==0 || lineStr.find("property float g")==0 || lineStr.find("property float b")==0 || lineStr.find("property float a")==0)){
-			colorCompsFound++;
-			meshDefinition.push_back(Color);
-			data.getColors().resize(data.getVertices().size());
-			continue;
-		}
-
-		if(state==VertexDef && (lineStr.find("property uchar red")==0 || lineStr.find("property uchar green")==0 || lineStr.find("property uchar blue")==0 || lineStr.find("property uchar alpha")==0)){
-			colorTypeIsUChar = true;
-			colorCompsFound++;
-			meshDefinition.push_back(Color);
-			data.getColors().resize(data.getVertices().size());
-			continue;
-		}
-
-		if(state==VertexDef && (lineStr.find("property float u")==0 || lineStr.find("property float v")==0|| lineStr.find("property float s")==0 || lineStr.find("property float t")==0)){
-			texCoordsFound++;
-			meshDefinition.push_back(TexCoord);
-			data.getTexCoords().resize(data.getVertices().size());
-			continue;
-		}
-
-		if(state==VertexDef && (lineStr.find("property float nx")==0 || lineStr.find("property float ny")==0 || lineStr.find("property float nz")==0)){
-			normalsCoordsFound++;
-			meshDefinition.push_back(Normal);
-			if (normalsCoordsFound==3) data.getNormals().resize(data.getVertices().size());
-			continue;
-		}
-
-		if(state==FaceDef && lineStr.find("property list")!=0 && lineStr!="end_header"){
-			error = "wrong face definition";
-			goto clean;
-		}
-
-		if(lineStr=="end_header"){
-			if(data.hasColors() && colorCompsFound!=3 && colorCompsFound!=4){
-				error =  "data has color coordiantes but not correct number of components. Found " + ofToString(colorCompsFound) + " expecting 3 or 4";
-				goto clean;
-			}
-			if(data.hasNormals() && normalsCoordsFound!=3){
-				error = "data has normal coordiantes but not correct number of components. Found " + ofToString(normalsCoordsFound) + " expecting 3";
-				goto clean;
-			}
-			if(!data.hasVertices()){
-				ofLogWarning("ofMesh") << "load(): mesh loaded from " << path << " has no vertices";
-			}
-			if(orderVertices==-1) orderVertices=9999;
-			if(orderIndices==-1) orderIndices=9999;
-
-			if(orderVertices < orderIndices){
-				state = Vertices;
-			}else {
-				state = Faces;
-			}
-			continue;
-		}
-
-		if(state==Vertices){
-			if(data.getNumVertices()<=currentVertex){
-				error = "found more vertices: " + ofToString(currentVertex+1) + " than specified in header: " + ofToString(data.getNumVertices());
-				goto clean;
-			}
-			std::stringstream sline(lineStr);
-			
-			// read in a line of vertex elements
-			// and split it into attributes,
-			// based attribute order specified in file header
-			ofIndexType vAttr = 0;
-			ofIndexType nAttr = 0;
-			ofIndexType tAttr = 0;
-			ofIndexType cAttr = 0;
-			for(auto s:meshDefinition){
-				switch (s) {
-					case Position:
-						sline >> *(&data.getVertices()[currentVertex].x + (vAttr++)%vertexCoordsFound);
-						break;
-					case Color:
-						if (colorTypeIsUChar){
-							int c = 0;
-							sline >> c;
-							*(&data.getColors()[currentVertex].r + (cAttr++)%colorCompsFound) = c/255.f;
-						} else {
-							sline >> *(&data.getColors()[currentVertex].r + (cAttr++)%colorCompsFound);
-						}
-						break;
-					case Normal:
-						sline >> *(&data.getNormals()[currentVertex].x + (nAttr++)%normalsCoordsFound);
-						break;
-					case TexCoord:
-						sline >> *(&data.getTexCoords()[currentVertex].x + (tAttr++)%texCoordsFound);
-						break;
-					default:
-						break;
-				}
-			}
-			if (vAttr != vertexCoordsFound || cAttr!= colorCompsFound || nAttr!=normalsCoordsFound || tAttr!=texCoordsFound){
-				error = "attribute data does not match definition in header";
-				goto clean;
-			}
-			
-			currentVertex++;
-			if(currentVertex==data.getNumVertices()){
-				if(orderVertices<orderIndices){
-					state = Faces;
-				}else{
-					state = Vertices;
-				}
-			}
-			continue;
-		}
-
-		if(state==Faces){
-			if(data.getNumIndices()/3<currentFace){
-				error = "found more faces than specified in header";
-				goto clean;
-			}
-			std::stringstream sline(lineStr);
-			int numV;
-			sline >> numV;
-			if(numV!=3){
-				error = "face not a triangle";
-				goto clean;
-			}
-			ofIndexType i;
-			sline >> i;
-			data.getIndices()[currentFace*3] = i;
-			sline >> i;
-			data.getIndices()[currentFace*3+1] = i;
-			sline >> i;
-			data.getIndices()[currentFace*3+2] = i;
-
-			currentFace++;
-			if(currentFace==data.getNumIndices()/3){
-				if(orderVertices<orderIndices){
-					state = Vertices;
-				}else{
-					state = Faces;
-				}
-			}
-			continue;
-		}
+	ofPlyReader reader;
+	ofMesh_<V,N,C,T> loaded;
+	if(!reader.open(path) || !reader.read(loaded)){
+		ofLogError("ofMesh") << "load(): couldn't load " << path << ": " << reader.getError();
+		return;
+	}
+	if(!loaded.hasVertices()){
+		ofLogWarning("ofMesh") << "load(): mesh loaded from " << path << " has no vertices";
 	}
 
-
-	return;
-	clean:
-	ofLogError("ofMesh") << "load(): " << lineNum << ":" << error;
-	ofLogError("ofMesh") << "load(): \"" << *line << "\"";
-	data = backup;
+	// swap instead of copying, meshes loaded from ply files can be huge
+	clear();
+	getVertices().swap(loaded.getVertices());
+	getNormals().swap(loaded.getNormals());
+	getColors().swap(loaded.getColors());
+	getTexCoords().swap(loaded.getTexCoords());
+	getIndices().swap(loaded.getIndices());
 }
 
 //--------------------------------------------------------------
 template<class V, class N, class C, class T>
 void ofMesh_<V,N,C,T>::save(const of::filesystem::path& path, bool useBinary) const{
-	ofFile os(path, ofFile::WriteOnly);
 	const auto & data = *this;
 
-	os << "ply" << std::endl;
-	if(useBinary) {
-		os << "format binary_little_endian 1.0" << std::endl;
-	} else {
-		os << "format ascii 1.0" << std::endl;
-	}
-
-	if(data.getNumVertices()){
-		os << "element vertex " << data.getNumVertices() << std::endl;
-		os << "property float x" << std::endl;
-		os << "property float y" << std::endl;
-		os << "property float z" << std::endl;
-		if(data.getNumColors()){
-			os << "property uchar red" << std::endl;
-			os << "property uchar green" << std::endl;
-			os << "property uchar blue" << std::endl;
-			os << "property uchar alpha" << std::endl;
-		}
-		if(data.getNumTexCoords()){
-			os << "property float u" << std::endl;
-			os << "property float v" << std::endl;
-		}
-		if(data.getNumNormals()){
-			os << "property float nx" << std::endl;
-			os << "property float ny" << std::endl;
-			os << "property float nz" << std::endl;
-		}
-	}
-
-	uint8_t faceSize = 3;
-	if(data.getNumIndices()){
-		os << "element face " << data.getNumIndices() / faceSize << std::endl;
-		os << "property list uchar int vertex_indices" << std::endl;
-	} else if(data.getMode() == OF_PRIMITIVE_TRIANGLES) {
-		os << "element face " << data.getNumVertices() / faceSize << std::endl;
-		os << "property list uchar int vertex_indices" << std::endl;
-	} else if(data.getMode() == OF_PRIMITIVE_TRIANGLE_STRIP && data.getNumVertices() >= 4) {
-		os << "element face " << data.getNumVertices() - 2 << std::endl;
-		os << "property list uchar int vertex_indices" << std::endl;
-	}
-
-	os << "end_header" << std::endl;
-
-	for(std::size_t i = 0; i < data.getNumVertices(); i++){
-		if(useBinary) {
-			os.write((char*) &data.getVertices()[i], sizeof(V));
-		} else {
-			os << data.getVertex(i).x << " " << data.getVertex(i).y << " " << data.getVertex(i).z;
-		}
-		if(data.getNumColors()){
-			// VCG lib / MeshLab don't support float colors, so we have to cast
-			ofColor cur = data.getColors()[i];
-			if(useBinary) {
-				os.write((char*) &cur, sizeof(ofColor));
-			} else {
-				os << " " << (int) cur.r << " " << (int) cur.g << " " << (int) cur.b << " " << (int) cur.a;
-			}
-		}
-		if(data.getNumTexCoords()){
-			if(useBinary) {
-				os.write((char*) &data.getTexCoords()[i], sizeof(T));
-			} else {
-				os << " " << data.getTexCoord(i).x << " " << data.getTexCoord(i).y;
+	// meshes without indices are saved as indexed triangles
+	std::vector<ofIndexType> generatedIndices;
+	auto addTriangle = [&generatedIndices](ofIndexType a, ofIndexType b, ofIndexType c){
+		generatedIndices.push_back(a);
+		generatedIndices.push_back(b);
+		generatedIndices.push_back(c);
+	};
+	ofIndexType numVertices = data.getNumVertices();
+	if(!data.getNumIndices()){
+		if(data.getMode() == OF_PRIMITIVE_TRIANGLES) {
+			for(ofIndexType i = 0; i + 2 < numVertices; i += 3) {
+				addTriangle(i, i + 1, i + 2);
 			}
-		}
-		if(data.getNumNormals()){
-			if(useBinary) {
-				os.write((char*) &data.getNormals()[i], sizeof(V));
-			} else {
-				os << " " << data.getNormal(i).x << " " << data.getNormal(i).y << " " << data.getNormal(i).z;
+		} else if(data.getMode() == OF_PRIMITIVE_TRIANGLE_STRIP) {
+			for(ofIndexType i = 0; i + 2 < numVertices; i++) {
+				if(i % 2 == 0){
+					addTriangle(i, i + 1, i + 2);
+				}else{
+					addTriangle(i + 1, i, i + 2);
+				}
 			}
 		}
-		if(!useBinary) {
-			os << std::endl;
-		}
+		//TODO: add index generation for other OF_PRIMITIVE cases
 	}
+	const auto & indices = data.getNumIndices() ? data.getIndices() : generatedIndices;
 
-	if(data.getNumIndices()) {
-		for(uint32_t i = 0; i < data.getNumIndices(); i += faceSize) {
-			if(useBinary) {
-				os.write((char*) &faceSize, sizeof(unsigned char));
-				os.write((char*)&data.getIndices()[i], faceSize);
-			} else {
-				os << (std::size_t) faceSize << " " << data.getIndex(i) << " " << data.getIndex(i+1) << " " << data.getIndex(i+2) << std::endl;
-			}
-		}
-	} else if(data.getMode() == OF_PRIMITIVE_TRIANGLES) {
-		for(uint32_t i = 0; i < data.getNumVertices(); i += faceSize) {
-			uint32_t indices[] = {i, i + 1, i + 2};
-			if(useBinary) {
-				os.write((char*) &faceSize, sizeof(unsigned char));
-				os.write((char*) indices, sizeof(indices));
-			} else {
-				os << (std::size_t) faceSize << " " << indices[0] << " " << indices[1] << " " << indices[2] << std::endl;
-			}
-		}
-	} else if(data.getMode() == OF_PRIMITIVE_TRIANGLE_STRIP && data.getNumVertices() >= 4) {
-		for(uint32_t i = 0; i < data.getNumVertices() - 2; i += 2) {
-			uint32_t indices1[] = {i, i + 1, i + 2};
-			uint32_t indices2[] = {i + 1, i + 3, i + 2};
-			if(useBinary) {
-				os.write((char*) &faceSize, sizeof(unsigned char));
-				os.write((char*) indices1, sizeof(indices1));
-				os.write((char*) &faceSize, sizeof(unsigned char));
-				os.write((char*) indices2, sizeof(indices2));
-			} else {
-				os << (std::size_t) faceSize << " " << indices1[0] << " " << indices1[1] << " " << indices1[2] << std::endl;
-				os << (std::size_t) faceSize << " " << indices2[0] << " " << indices2[1] << " " << indices2[2] << std::endl;
-			}
-		}
+	ofPlyWriter writer;
+	auto format = useBinary ? OF_PLY_BINARY_LITTLE_ENDIAN : OF_PLY_ASCII;
+	if(!writer.open(path, format, numVertices, indices.size() / 3, data.getNumColors() > 0, data.getNumTexCoords() > 0, data.getNumNormals() > 0)){
+		return;
 	}
-
-	//TODO: add index generation for other OF_PRIMITIVE cases
+	writer.writeVertices(data);
+	writer.writeFaces(indices.data(), indices.size() - indices.size() % 3);
+	writer.close();
 }
 
 
@@ -1537,97 +1243,156 @@ ofMesh_<V,N,C,T> ofMesh_<V,N,C,T>::getMeshForIndices( ofIndexType startIndex, of
 
 //--------------------------------------------------------------
 template<class V, class N, class C, class T>
-void ofMesh_<V,N,C,T>::mergeDuplicateVertices() {
+std::vector<ofIndexType> ofMesh_<V,N,C,T>::findDuplicateVertices(float epsilon) const{
+	// every vertex is mapped to the first vertex closer than epsilon. the
+	// vertices are hashed by the cell of a grid they fall in so only the
+	// vertices in the cells that can be closer than epsilon are compared,
+	// which makes this linear instead of quadratic on the number of vertices
+	std::vector<ofIndexType> duplicateOf(vertices.size());
+	std::vector<ofIndexType> next(vertices.size());
+	std::unordered_map<uint64_t, ofIndexType> cells;
+	cells.reserve(vertices.size());
+	const ofIndexType none = std::numeric_limits<ofIndexType>::max();
 
-	std::vector<V> verts = getVertices();
-	std::vector<ofIndexType> indices = getIndices();
+	auto hashCell = [](int64_t x, int64_t y, int64_t z){
+		return uint64_t(x) * 73856093ull ^ uint64_t(y) * 19349663ull ^ uint64_t(z) * 83492791ull;
+	};
 
-	//get indexes to share single point - TODO: try j < i
-	for(ofIndexType i = 0; i < indices.size(); i++) {
-		for(ofIndexType j = 0; j < indices.size(); j++ ) {
-			if(i==j) continue;
+	auto findIn = [&](uint64_t cell, const glm::vec3 & p) -> ofIndexType{
+		auto it = cells.find(cell);
+		if(it == cells.end()){
+			return none;
+		}
+		// different cells can end up in the same bucket, they are only
+		// compared once more
+		for(auto i = it->second; i != none; i = next[i]){
+			glm::vec3 q = toGlm(vertices[i]);
+			if(epsilon > 0 ? glm::distance(p, q) <= epsilon : p == q){
+				return i;
+			}
+		}
+		return none;
+	};
 
-			ofIndexType i1 = indices[i];
-			ofIndexType i2 = indices[j];
-			const V & v1 = verts[ i1 ];
-			const V & v2 = verts[ i2 ];
+	auto insert = [&](uint64_t cell, ofIndexType i){
+		auto it = cells.emplace(cell, none).first;
+		next[i] = it->second;
+		it->second = i;
+	};
 
-			if( v1 == v2 && i1 != i2) {
-				indices[j] = i1;
-				break;
+	if(epsilon > 0){
+		// with cells twice epsilon wide any vertex closer than epsilon is
+		// in the same cell or in one of its neighbours towards the point,
+		// so at most 8 cells need to be searched
+		float cellSize = epsilon * 2;
+		for(ofIndexType i = 0; i < vertices.size(); i++){
+			glm::vec3 p = toGlm(vertices[i]);
+			int64_t cell[3], neighbour[3];
+			for(int k = 0; k < 3; k++){
+				auto c = std::floor(p[k] / cellSize);
+				cell[k] = int64_t(c);
+				neighbour[k] = cell[k];
+				if(p[k] - epsilon < c * cellSize){
+					neighbour[k] = cell[k] - 1;
+				}else if(p[k] + epsilon >= (c + 1) * cellSize){
+					neighbour[k] = cell[k] + 1;
+				}
+			}
+			duplicateOf[i] = i;
+			for(int n = 0; n < 8; n++){
+				int64_t x = n & 1 ? neighbour[0] : cell[0];
+				int64_t y = n & 2 ? neighbour[1] : cell[1];
+				int64_t z = n & 4 ? neighbour[2] : cell[2];
+				if((n & 1 && x == cell[0]) || (n & 2 && y == cell[1]) || (n & 4 && z == cell[2])){
+					continue;
+				}
+				auto found = findIn(hashCell(x, y, z), p);
+				if(found != none){
+					duplicateOf[i] = found;
+					break;
+				}
+			}
+			if(duplicateOf[i] == i){
+				insert(hashCell(cell[0], cell[1], cell[2]), i);
+			}
+		}
+	}else{
+		// exact matches only, hash the bits of the coordinates
+		for(ofIndexType i = 0; i < vertices.size(); i++){
+			// adding 0 turns -0 into 0 so both hash the same
+			glm::vec3 p = toGlm(vertices[i]) + glm::vec3(0.f);
+			uint32_t bits[3];
+			memcpy(bits, &p[0], sizeof(bits));
+			auto cell = hashCell(bits[0], bits[1], bits[2]);
+			auto found = findIn(cell, p);
+			if(found != none){
+				duplicateOf[i] = found;
+			}else{
+				duplicateOf[i] = i;
+				insert(cell, i);
 			}
 		}
 	}
 
-	//indices array now has list of unique points we need
-	//but we need to delete the old points we're not using and that means the index values will change
-	//so we are going to create a new list of points and new indexes - we will use a map to map old index values to the new ones
-	std::vector <V> newPoints;
-	std::vector <ofIndexType> newIndexes;
-	std::unordered_map <ofIndexType, bool> ptCreated;
-	std::unordered_map <ofIndexType, ofIndexType> oldIndexNewIndex;
+	return duplicateOf;
+}
 
-	std::vector<ofFloatColor> newColors;
-	std::vector<ofFloatColor>& colors = getColors();
-	std::vector<T> newTCoords;
-	std::vector<T>& tcoords = getTexCoords();
-	std::vector<N> newNormals;
-	std::vector<N>& normals = getNormals();
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+void ofMesh_<V,N,C,T>::mergeDuplicateVertices(float epsilon) {
+	if(!hasVertices()){
+		return;
+	}
 
-	for(ofIndexType i = 0; i < indices.size(); i++){
-		ptCreated[i] = false;
+	if(!hasIndices()){
+		setupIndicesAuto();
 	}
 
-	for(ofIndexType i = 0; i < indices.size(); i++){
-		ofIndexType index = indices[i];
-		const auto & p = verts[ index ];
+	auto duplicateOf = findDuplicateVertices(epsilon);
 
-		if( ptCreated[index] == false ){
-			oldIndexNewIndex[index] = newPoints.size();
-			newPoints.push_back( p );
-			if(hasColors()) {
+	// the vertices that are still used are kept in the order they are first
+	// indexed, every index points to the new position of the vertex it
+	// was merged into
+	const ofIndexType none = std::numeric_limits<ofIndexType>::max();
+	std::vector<ofIndexType> newIndex(vertices.size(), none);
+	std::vector<V> newVertices;
+	std::vector<C> newColors;
+	std::vector<T> newTexCoords;
+	std::vector<N> newNormals;
+	bool bHasColors = colors.size() == vertices.size();
+	bool bHasTexCoords = texCoords.size() == vertices.size();
+	bool bHasNormals = normals.size() == vertices.size();
+
+	std::vector<ofIndexType> newIndices(indices.size());
+	for(std::size_t i = 0; i < indices.size(); i++){
+		auto index = duplicateOf[indices[i]];
+		if(newIndex[index] == none){
+			newIndex[index] = newVertices.size();
+			newVertices.push_back(vertices[index]);
+			if(bHasColors){
 				newColors.push_back(colors[index]);
 			}
-			if(hasTexCoords()) {
-				newTCoords.push_back(tcoords[index]);
+			if(bHasTexCoords){
+				newTexCoords.push_back(texCoords[index]);
 			}
-			if(hasNormals()) {
+			if(bHasNormals){
 				newNormals.push_back(normals[index]);
 			}
-
-			ptCreated[index] = true;
 		}
-
-		//ofLogNotice("ofMesh") << "[" << i << "]: old " << index << " --> " << oldIndexNewIndex[index];
-		newIndexes.push_back( oldIndexNewIndex[index] );
+		newIndices[i] = newIndex[index];
 	}
 
-	verts.clear();
-	verts = newPoints;
-
-	indices.clear();
-	indices = newIndexes;
-
-	clearIndices();
-	addIndices(indices);
-	clearVertices();
-	addVertices( verts );
-
-	if(hasColors()) {
-		clearColors();
-		addColors( newColors );
+	getIndices().swap(newIndices);
+	getVertices().swap(newVertices);
+	if(bHasColors){
+		getColors().swap(newColors);
 	}
-
-	if(hasTexCoords()) {
-		clearTexCoords();
-		addTexCoords( newTCoords );
+	if(bHasTexCoords){
+		getTexCoords().swap(newTexCoords);
 	}
-
-	if(hasNormals()) {
-		clearNormals();
-		addNormals( newNormals );
+	if(bHasNormals){
+		getNormals().swap(newNormals);
 	}
-
 }
 
 
@@ -1646,24 +1411,32 @@ ofMeshFace_<V,N,C,T> ofMesh_<V,N,C,T>::getFace(ofIndexType faceId) const{
 
 //--------------------------------------------------------------
 template<class V, class N, class C, class T>
-const std::vector<ofMeshFace_<V,N,C,T>> & ofMesh_<V,N,C,T>::getUniqueFaces() const{
+void ofMesh_<V,N,C,T>::clearFacesIfDirty() const{
 	if(bFacesDirty){
+		faces.clear();
+		faceNormals.clear();
+		bFacesDirty = false;
+	}
+}
+
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+const std::vector<ofMeshFace_<V,N,C,T>> & ofMesh_<V,N,C,T>::getUniqueFaces() const{
+	clearFacesIfDirty();
+	if(faces.empty() && indices.size() >= 3){
 		// if we are doing triangles, we have to use a vert and normal for each triangle
 		// that way we can calculate face normals and use getFaceNormal();
 		faces.resize( indices.size()/3 );
 
-		int index	   = 0;
-		int triindex	= 0;
-
-		bool bHasColors	 = hasColors();
-		bool bHasNormals	= hasNormals();
-		bool bHasTexcoords  = hasTexCoords();
-
 		if( getMode() == OF_PRIMITIVE_TRIANGLES) {
-			for(ofIndexType j = 0; j < indices.size(); j += 3) {
+			bool bHasColors	 = hasColors();
+			bool bHasNormals	= hasNormals();
+			bool bHasTexcoords  = hasTexCoords();
+
+			ofGetTaskPool().parallelFor(0, faces.size(), [&](std::size_t triindex){
 				ofMeshFace_<V,N,C,T> & tri = faces[triindex];
 				for(std::size_t k = 0; k < 3; k++) {
-					index = indices[j+k];
+					auto index = indices[triindex*3+k];
 					tri.setVertex( k, vertices[index] );
 					if(bHasNormals)
 						tri.setNormal(k, normals[index] );
@@ -1672,14 +1445,11 @@ const std::vector<ofMeshFace_<V,N,C,T>> & ofMesh_<V,N,C,T>::getUniqueFaces() con
 					if(bHasColors)
 						tri.setColor(k, colors[index] );
 				}
-				triindex++;
-			}
+			}, 1024);
 
 		} else {
 			ofLogWarning("ofMesh") << "getUniqueFaces(): only works with primitive mode OF_PRIMITIVE_TRIANGLES";
 		}
-
-		bFacesDirty = false;
 	}
 
 	return faces;
@@ -1691,34 +1461,35 @@ const std::vector<ofMeshFace_<V,N,C,T>> & ofMesh_<V,N,C,T>::getUniqueFaces() con
 template<class V, class N, class C, class T>
 std::vector<N> ofMesh_<V,N,C,T>::getFaceNormals( bool perVertex ) const{
 	// default for ofPrimitiveBase is vertex normals //
-	std::vector<N> faceNormals;
+	if(!hasVertices()){
+		return std::vector<N>();
+	}
 
-	if( hasVertices() ) {
-		if(vertices.size() > 3 && indices.size() > 3) {
-			if(perVertex){
-				faceNormals.resize(indices.size()*3);
-			}else{
-				faceNormals.resize(indices.size());
-			}
-			ofMeshFace_<V,N,C,T> face;
-			N n;
-			for(ofIndexType i = 0; i < indices.size(); i+=3) {
-				face.setVertex( 0, vertices[indices[i+0]] );
-				face.setVertex( 1, vertices[indices[i+1]] );
-				face.setVertex( 2, vertices[indices[i+2]] );
-
-				n = face.getFaceNormal();
-
-				faceNormals[i]=n;
-				if(perVertex) {
-					faceNormals[i+1]=n;
-					faceNormals[i+2]=n;
-				}
-			}
-		}
+	clearFacesIfDirty();
+	auto numFaces = (hasIndices() ? indices.size() : vertices.size()) / 3;
+	if(faceNormals.size() != numFaces){
+		auto index = [this](std::size_t i) -> std::size_t{
+			return indices.empty() ? i : indices[i];
+		};
+		faceNormals.resize(numFaces);
+		ofGetTaskPool().parallelFor(0, numFaces, [&](std::size_t face){
+			glm::vec3 v0 = toGlm(vertices[index(face * 3)]);
+			glm::vec3 v1 = toGlm(vertices[index(face * 3 + 1)]);
+			glm::vec3 v2 = toGlm(vertices[index(face * 3 + 2)]);
+			faceNormals[face] = glm::normalize(glm::cross(v1 - v0, v2 - v0));
+		}, 1024);
 	}
 
-	return faceNormals;
+	if(!perVertex){
+		return faceNormals;
+	}
+	std::vector<N> cornerNormals(numFaces * 3);
+	for(std::size_t face = 0; face < numFaces; face++){
+		cornerNormals[face * 3] = faceNormals[face];
+		cornerNormals[face * 3 + 1] = faceNormals[face];
+		cornerNormals[face * 3 + 2] = faceNormals[face];
+	}
+	return cornerNormals;
 }
 
 
@@ -1776,112 +1547,78 @@ void ofMesh_<V,N,C,T>::setFromTriangles( const std::vector<ofMeshFace_<V,N,C,T>>
 
 	bFacesDirty = false;
 	faces = tris;
+	faceNormals.clear();
 }
 
 
 //--------------------------------------------------------------
 template<class V, class N, class C, class T>
-void ofMesh_<V,N,C,T>::smoothNormals( float angle ) {
+void ofMesh_<V,N,C,T>::smoothNormals( float angle, float epsilon ) {
 
-	if( getMode() == OF_PRIMITIVE_TRIANGLES) {
-		std::vector<ofMeshFace_<V,N,C,T>> triangles = getUniqueFaces();
-		std::vector<V> verts;
-		verts.reserve( triangles.size() * 3 );
-		
-		for(ofIndexType i = 0; i < triangles.size(); i++) {
-			for(ofIndexType j = 0; j < 3; j++) {
-				verts.emplace_back( triangles[i].getVertex(j) );
-			}
-		}
+	if( getMode() != OF_PRIMITIVE_TRIANGLES || !hasVertices()) {
+		return;
+	}
 
-		std::unordered_map<int, int> removeIds;
-
-		float epsilon = .01f;
-		for(ofIndexType i = 0; i < verts.size()-1; i++) {
-			for(ofIndexType j = i+1; j < verts.size(); j++) {
-				if(i != j) {
-					const auto& v1 = toGlm(verts[i]);
-					const auto& v2 = toGlm(verts[j]);
-					if( glm::distance(v1, v2) <= epsilon ) {
-						// average the location //
-						verts[i] = (v1+v2)/2.f;
-						verts[j] = verts[i];
-						removeIds[j] = 1;
-					}
-				}
-			}
-		}
+	auto faceNormals = getFaceNormals();
+	auto numCorners = faceNormals.size() * 3;
+	auto index = [this](std::size_t i) -> ofIndexType{
+		return indices.empty() ? ofIndexType(i) : indices[i];
+	};
 
-		// string of vertex in 3d space to triangle index //
-		std::unordered_map<std::string, std::vector<int> > vertHash;
-
-		//ofLogNotice("ofMesh") << "smoothNormals(): num verts = " << verts.size() << " tris size = " << triangles.size();
-
-
-		for(ofIndexType i = 0; i < verts.size(); i++ ) {
-			std::string vstring {
-				"x"+ofToString(verts[i].x==-0?0:verts[i].x) +
-				"y"+ofToString(verts[i].y==-0?0:verts[i].y) +
-				"z"+ofToString(verts[i].z==-0?0:verts[i].z)
-			};
-			
-			if(vertHash.find(vstring) == vertHash.end()) {
-				for(ofIndexType j = 0; j < triangles.size(); j++) {
-					for(ofIndexType k = 0; k < 3; k++) {
-						if(verts[i].x == triangles[j].getVertex(k).x) {
-							if(verts[i].y == triangles[j].getVertex(k).y) {
-								if(verts[i].z == triangles[j].getVertex(k).z) {
-									vertHash[vstring].emplace_back( j );
-								}
-							}
-						}
-					}
-				}
+	// corners closer than epsilon are the same point, the faces around each
+	// point are stored contiguously in adjacentFaces, from
+	// firstFace[point] to firstFace[point+1]
+	auto pointOf = findDuplicateVertices(epsilon);
+	std::vector<std::size_t> firstFace(vertices.size() + 1, 0);
+	for(std::size_t i = 0; i < numCorners; i++){
+		firstFace[pointOf[index(i)] + 1]++;
+	}
+	for(std::size_t i = 1; i < firstFace.size(); i++){
+		firstFace[i] += firstFace[i - 1];
+	}
+	std::vector<std::size_t> adjacentFaces(numCorners);
+	{
+		auto end = firstFace;
+		for(std::size_t i = 0; i < numCorners; i++){
+			adjacentFaces[end[pointOf[index(i)]]++] = i / 3;
+		}
+	}
+
+	// every corner gets the average of the normals of the faces around it
+	// that are within angle of its own face, so hard edges stay hard. the
+	// result has one vertex per corner like setFromTriangles
+	float angleCos = std::cos(glm::radians(angle));
+	std::vector<V> newVertices(numCorners);
+	std::vector<N> newNormals(numCorners);
+	std::vector<C> newColors(colors.size() == vertices.size() ? numCorners : 0);
+	std::vector<T> newTexCoords(texCoords.size() == vertices.size() ? numCorners : 0);
+	ofGetTaskPool().parallelFor(0, numCorners, [&](std::size_t i){
+		auto vertex = index(i);
+		auto point = pointOf[vertex];
+		glm::vec3 faceNormal = toGlm(faceNormals[i / 3]);
+		glm::vec3 normal(0.f);
+		for(auto f = firstFace[point]; f < firstFace[point + 1]; f++){
+			glm::vec3 adjacentNormal = toGlm(faceNormals[adjacentFaces[f]]);
+			if(glm::dot(faceNormal, adjacentNormal) >= angleCos){
+				normal += adjacentNormal;
 			}
 		}
-
-//		for( std::unordered_map<std::string, std::vector<int> >::iterator it = vertHash.begin(); it != vertHash.end(); ++it) {
-//			//for( std::unordered_map<std::string, int >::iterator it = vertHash.begin(); it != vertHash.end(); ++it) {
-//			ofLogNotice("ofMesh") << "smoothNormals(): " << it->first << "  num = " << it->second.size();
-//		}
-
-		V vert;
-		N normal;
-		float angleCos = std::cos(glm::radians(angle));
-		float numNormals=0;
-
-		for(ofIndexType j = 0; j < triangles.size(); j++) {
-			for(ofIndexType k = 0; k < 3; k++) {
-				vert = triangles[j].getVertex(k);
-				std::string vstring {
-					"x"+ofToString(vert.x==-0?0:vert.x) +
-					"y"+ofToString(vert.y==-0?0:vert.y) +
-					"z"+ofToString(vert.z==-0?0:vert.z)
-				};
-				
-				numNormals=0;
-				normal = {0.f,0.f,0.f};
-				if(vertHash.find(vstring) != vertHash.end()) {
-					for(ofIndexType i = 0; i < vertHash[vstring].size(); i++) {
-						auto f1 = triangles[j].getFaceNormal();
-						auto f2 = triangles[vertHash[vstring][i]].getFaceNormal();
-						if(glm::dot(toGlm(f1), toGlm(f2)) >= angleCos ) {
-							normal += f2;
-							numNormals+=1.f;
-						}
-					}
-					//normal /= (float)vertHash[vstring].size();
-					normal /= numNormals;
-
-					triangles[j].setNormal(k, normal);
-				}
-			}
+		auto length = glm::length(normal);
+		newNormals[i] = length > 0 ? normal / length : faceNormal;
+		newVertices[i] = vertices[vertex];
+		if(!newColors.empty()){
+			newColors[i] = colors[vertex];
 		}
+		if(!newTexCoords.empty()){
+			newTexCoords[i] = texCoords[vertex];
+		}
+	}, 1024);
 
-		//ofLogNotice("ofMesh") << "smoothNormals(): setting from triangles ";
-		setFromTriangles( triangles );
-
-	}
+	getVertices().swap(newVertices);
+	getNormals().swap(newNormals);
+	getColors().swap(newColors);
+	getTexCoords().swap(newTexCoords);
+	setupIndicesAuto();
 }
 
 //--------------------------------------------------------------
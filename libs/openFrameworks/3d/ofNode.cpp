@@ -27,7 +27,7 @@ ofNode::ofNode()
 //----------------------------------------
 ofNode::~ofNode(){
 	if(parent){
-		parent->removeListener(*this);
+		parent->removeChild(*this);
 	}
 
 	// clearParent() will remove children of this element as a side-effect.
@@ -46,7 +46,7 @@ ofNode::ofNode(const ofNode & node)
 ,localTransformMatrix(node.localTransformMatrix)
 ,legacyCustomDrawOverrided(true){
 	if(parent){
-		parent->addListener(*this);
+		parent->addChild(*this);
 	}
 	position = node.position;
 	orientation = node.orientation;
@@ -67,8 +67,13 @@ ofNode::ofNode(ofNode && node)
 ,legacyCustomDrawOverrided(std::move(node.legacyCustomDrawOverrided))
 ,children(std::move(node.children)){
 	if(parent){
-		parent->addListener(*this);
+		parent->addChild(*this);
 	}
+	node.children.clear();
+	for(auto child: children){
+		child->parent = this;
+	}
+	invalidateGlobalTransform();
 }
 
 //----------------------------------------
@@ -85,8 +90,9 @@ ofNode & ofNode::operator=(const ofNode & node){
 	localTransformMatrix = node.localTransformMatrix;
 	legacyCustomDrawOverrided = true;
 	if(parent){
-		parent->addListener(*this);
+		parent->addChild(*this);
 	}
+	invalidateGlobalTransform();
 	return *this;
 }
 
@@ -102,35 +108,66 @@ ofNode & ofNode::operator=(ofNode && node){
 	legacyCustomDrawOverrided = std::move(node.legacyCustomDrawOverrided);
 	children = std::move(node.children);
 	if(parent){
-		parent->addListener(*this);
+		parent->addChild(*this);
+	}
+	node.children.clear();
+	for(auto child: children){
+		child->parent = this;
 	}
+	invalidateGlobalTransform();
 	return *this;
 }
 
 //----------------------------------------
-void ofNode::addListener(ofNode & node){
-	position.addListener(&node, &ofNode::onParentPositionChanged);
-	orientation.addListener(&node, &ofNode::onParentOrientationChanged);
-	scale.addListener(&node, &ofNode::onParentScaleChanged);
-	position.enableEvents();
-	orientation.enableEvents();
-	scale.enableEvents();
+void ofNode::addChild(ofNode & node){
 	children.insert(&node);
 }
 
 //----------------------------------------
-void ofNode::removeListener(ofNode & node){
-	position.removeListener(&node, &ofNode::onParentPositionChanged);
-	orientation.removeListener(&node, &ofNode::onParentOrientationChanged);
-	scale.removeListener(&node, &ofNode::onParentScaleChanged);
-	if(position.getNumListeners()==0){
-		position.disableEvents();
-		scale.disableEvents();
-		orientation.disableEvents();
-	}
+void ofNode::removeChild(ofNode & node){
 	children.erase(&node);
 }
 
+// children are notified directly instead of listening to the parent's
+// parameters, with big hierarchies the events were most of the cost of
+// moving a node
+//----------------------------------------
+void ofNode::notifyPositionChanged(){
+	onPositionChanged();
+	for(auto child: children){
+		child->onPositionChanged();
+	}
+}
+
+//----------------------------------------
+void ofNode::notifyOrientationChanged(){
+	onOrientationChanged();
+	for(auto child: children){
+		child->onOrientationChanged();
+	}
+}
+
+//----------------------------------------
+void ofNode::notifyScaleChanged(){
+	onScaleChanged();
+	for(auto child: children){
+		child->onScaleChanged();
+	}
+}
+
+// Marks the global matrix of this node and every node below it as dirty so
+// it's recalculated the next time it's needed. A dirty node always has
+// dirty children so the recursion stops at the first one.
+//----------------------------------------
+void ofNode::invalidateGlobalTransform(){
+	bGlobalTransformDirty = true;
+	for(auto child: children){
+		if(!child->bGlobalTransformDirty){
+			child->invalidateGlobalTransform();
+		}
+	}
+}
+
 //----------------------------------------
 void ofNode::setParent(ofNode& parent, bool bMaintainGlobalTransform) {
 	if (this->parent)
@@ -143,20 +180,21 @@ void ofNode::setParent(ofNode& parent, bool bMaintainGlobalTransform) {
 		auto postParentPosition = position - parent.getGlobalPosition();
 		auto postParentOrientation = orientation.get() * glm::inverse(parent.getGlobalOrientation());
 		auto postParentScale = scale / parent.getGlobalScale();
-		parent.addListener(*this);
+		parent.addChild(*this);
 		setOrientation(postParentOrientation);
 		setPosition(postParentPosition);
 		setScale(postParentScale);
 	} else {
-		parent.addListener(*this);
+		parent.addChild(*this);
 	}
 	this->parent = &parent;
+	invalidateGlobalTransform();
 }
 
 //----------------------------------------
 void ofNode::clearParent(bool bMaintainGlobalTransform) {
 	if(parent){
-		parent->removeListener(*this);
+		parent->removeChild(*this);
 	}
 	if(bMaintainGlobalTransform && parent) {
 		auto orientation = getGlobalOrientation();
@@ -169,7 +207,7 @@ void ofNode::clearParent(bool bMaintainGlobalTransform) {
 	}else{
 		this->parent = nullptr;
 	}
-
+	invalidateGlobalTransform();
 }
 
 //----------------------------------------
@@ -186,7 +224,7 @@ void ofNode::setPosition(float px, float py, float pz) {
 void ofNode::setPosition(const glm::vec3& p) {
 	position = p;
 	createMatrix();
-	onPositionChanged();
+	notifyPositionChanged();
 }
 
 //----------------------------------------
@@ -228,7 +266,7 @@ float ofNode::getZ() const {
 void ofNode::setOrientation(const glm::quat& q) {
 	orientation = q;
 	createMatrix();
-	onOrientationChanged();
+	notifyOrientationChanged();
 }
 
 //----------------------------------------
@@ -283,7 +321,7 @@ void ofNode::setScale(float sx, float sy, float sz) {
 void ofNode::setScale(const glm::vec3& s) {
 	this->scale = s;
 	createMatrix();
-	onScaleChanged();
+	notifyScaleChanged();
 }
 
 //----------------------------------------
@@ -297,9 +335,9 @@ void ofNode::setPositionOrientationScale( const glm::vec3& p, const glm::quat& q
 	this->orientation = q;
 	this->scale = s;
 	createMatrix();
-	onPositionChanged();
-	onOrientationChanged();
-	onScaleChanged();
+	notifyPositionChanged();
+	notifyOrientationChanged();
+	notifyScaleChanged();
 }
 
 //----------------------------------------
@@ -314,9 +352,9 @@ void ofNode::setPositionOrientationScale( const glm::vec3& p, const glm::vec3& e
 	this->orientation = q;
 	this->scale = s;
 	createMatrix();
-	onPositionChanged();
-	onOrientationChanged();
-	onScaleChanged();
+	notifyPositionChanged();
+	notifyOrientationChanged();
+	notifyScaleChanged();
 }
 
 //----------------------------------------
@@ -333,7 +371,7 @@ void ofNode::move(float x, float y, float z) {
 void ofNode::move(const glm::vec3& offset) {
 	position += offset;
 	createMatrix();
-	onPositionChanged();
+	notifyPositionChanged();
 }
 
 //----------------------------------------
@@ -400,7 +438,7 @@ void ofNode::rollRad(float radians) {
 void ofNode::rotate(const glm::quat& q) {
 	orientation = q * (const glm::quat&)orientation;
 	createMatrix();
-	onOrientationChanged();
+	notifyOrientationChanged();
 }
 
 //----------------------------------------
@@ -590,9 +628,29 @@ const glm::mat4& ofNode::getLocalTransformMatrix() const {
 }
 
 //----------------------------------------
-glm::mat4 ofNode::getGlobalTransformMatrix() const {
-	if(parent) return parent->getGlobalTransformMatrix() * getLocalTransformMatrix();
-	else return getLocalTransformMatrix();
+const glm::mat4& ofNode::getGlobalTransformMatrix() const {
+	if(bGlobalTransformDirty){
+		if(parent){
+			globalTransformMatrix = parent->getGlobalTransformMatrix() * getLocalTransformMatrix();
+		}else{
+			globalTransformMatrix = getLocalTransformMatrix();
+		}
+		bGlobalTransformDirty = false;
+	}
+	return globalTransformMatrix;
+}
+
+//----------------------------------------
+void ofNode::updateGlobalTransforms() const {
+	// walk the hierarchy iteratively, parents first, so every matrix is
+	// calculated once from its parent's already updated one
+	std::vector<const ofNode*> pending{this};
+	while(!pending.empty()){
+		auto node = pending.back();
+		pending.pop_back();
+		node->getGlobalTransformMatrix();
+		pending.insert(pending.end(), node->children.begin(), node->children.end());
+	}
 }
 
 //----------------------------------------
@@ -718,6 +776,9 @@ void ofNode::createMatrix() {
 	localTransformMatrix = glm::scale(localTransformMatrix, toGlm(scale));
 
 	updateAxis();
+	if(!bGlobalTransformDirty){
+		invalidateGlobalTransform();
+	}
 }
 
 
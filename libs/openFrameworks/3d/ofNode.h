@@ -158,14 +158,25 @@ public:
 	/// \sa https://open.gl/transformations
 	const glm::mat4& getLocalTransformMatrix() const;
 	
-	// TODO: optimize and cache these
-	// (parent would need to know about its children so it can inform them 
-	// to update their global matrices if it itself transforms)
-	
 	/// \brief Get node's global transformations (position, orientation, scale).
+	///
+	/// The global matrix is cached and only recalculated when this node or
+	/// any of its parents changed since the last call.
+	///
 	/// \returns A refrence to mat4 containing node's global transformations.
 	/// \sa https://open.gl/transformations
-	glm::mat4 getGlobalTransformMatrix() const;
+	const glm::mat4& getGlobalTransformMatrix() const;
+
+	/// \brief Update the cached global matrices of this node and all the
+	/// nodes below it in one pass.
+	///
+	/// Global matrices are otherwise calculated lazily the first time
+	/// they are needed. With big hierarchies, like animated skeletons, call
+	/// this on the root once after changing the local transforms and before
+	/// drawing. It also has to be called before reading the global transforms
+	/// from several threads at the same time since the lazy update isn't
+	/// thread safe.
+	void updateGlobalTransforms() const;
 	
 	/// \brief Get node's global position as a 3D vector.
 	/// \returns A 3D vector with the global coordinates.
@@ -530,9 +541,10 @@ protected:
 	ofNode * parent = nullptr;
 
 private:
-	void onParentPositionChanged(glm::vec3 & position) {onPositionChanged();}
-	void onParentOrientationChanged(glm::quat & orientation) {onOrientationChanged();}
-	void onParentScaleChanged(glm::vec3 & scale) {onScaleChanged();}
+	void notifyPositionChanged();
+	void notifyOrientationChanged();
+	void notifyScaleChanged();
+	void invalidateGlobalTransform();
 
 	ofParameter<glm::vec3> position;
 	ofParameter<glm::quat> orientation;
@@ -544,7 +556,9 @@ private:
 	bool legacyCustomDrawOverrided;
 	std::set<ofNode*> children;
 
-	void addListener(ofNode & node);
-	void removeListener(ofNode & node);
-//	glm::mat4 globalTransformMatrix;
+	mutable glm::mat4 globalTransformMatrix;
+	mutable bool bGlobalTransformDirty = true;
+
+	void addChild(ofNode & node);
+	void removeChild(ofNode & node);
 };
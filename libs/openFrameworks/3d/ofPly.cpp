@@ -0,0 +1,695 @@
+#include "ofPly.h"
+#include "ofUtils.h"
+#include <algorithm>
+#include <charconv>
+#include <clocale>
+
+namespace{
+	//--------------------------------------------------------------
+	bool isLittleEndian(){
+		uint16_t one = 1;
+		char first;
+		memcpy(&first, &one, 1);
+		return first == 1;
+	}
+
+	//--------------------------------------------------------------
+	bool isSpace(char c){
+		return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+	}
+}
+
+//--------------------------------------------------------------
+ofPlyReader::ofPlyReader()
+:end(nullptr)
+,format(OF_PLY_ASCII)
+,swapBytes(false)
+,vertexElement(-1)
+,faceElement(-1){
+}
+
+//--------------------------------------------------------------
+bool ofPlyReader::open(const of::filesystem::path & path){
+	close();
+	if(!ofFile::doesFileExist(path)){
+		return setError("file doesn't exist");
+	}
+	buffer = ofBufferFromFileMapped(path, ofBuffer::Sequential);
+	return parseHeader();
+}
+
+//--------------------------------------------------------------
+bool ofPlyReader::open(const ofBuffer & buffer){
+	close();
+	this->buffer = buffer;
+	return parseHeader();
+}
+
+//--------------------------------------------------------------
+void ofPlyReader::close(){
+	buffer.clear();
+	end = nullptr;
+	elements.clear();
+	vertexElement = -1;
+	faceElement = -1;
+	error.clear();
+}
+
+//--------------------------------------------------------------
+bool ofPlyReader::isOpen() const{
+	return end != nullptr;
+}
+
+//--------------------------------------------------------------
+ofPlyFormat ofPlyReader::getFormat() const{
+	return format;
+}
+
+//--------------------------------------------------------------
+size_t ofPlyReader::getNumVertices() const{
+	return vertexElement < 0 ? 0 : elements[vertexElement].count;
+}
+
+//--------------------------------------------------------------
+size_t ofPlyReader::getNumFaces() const{
+	return faceElement < 0 ? 0 : elements[faceElement].count;
+}
+
+//--------------------------------------------------------------
+bool ofPlyReader::hasNormals() const{
+	if(vertexElement < 0){
+		return false;
+	}
+	for(auto & property: elements[vertexElement].properties){
+		if(property.attribute == Normal){
+			return true;
+		}
+	}
+	return false;
+}
+
+//--------------------------------------------------------------
+bool ofPlyReader::hasColors() const{
+	if(vertexElement < 0){
+		return false;
+	}
+	for(auto & property: elements[vertexElement].properties){
+		if(property.attribute == Color){
+			return true;
+		}
+	}
+	return false;
+}
+
+//--------------------------------------------------------------
+bool ofPlyReader::hasTexCoords() const{
+	if(vertexElement < 0){
+		return false;
+	}
+	for(auto & property: elements[vertexElement].properties){
+		if(property.attribute == TexCoord){
+			return true;
+		}
+	}
+	return false;
+}
+
+//--------------------------------------------------------------
+const std::string & ofPlyReader::getError() const{
+	return error;
+}
+
+//--------------------------------------------------------------
+bool ofPlyReader::setError(const std::string & error){
+	this->error = error;
+	return false;
+}
+
+//--------------------------------------------------------------
+size_t ofPlyReader::sizeOf(Type type){
+	switch(type){
+		case Int8:
+		case UInt8:
+			return 1;
+		case Int16:
+		case UInt16:
+			return 2;
+		case Int32:
+		case UInt32:
+		case Float32:
+			return 4;
+		case Float64:
+			return 8;
+	}
+	return 0;
+}
+
+//--------------------------------------------------------------
+bool ofPlyReader::parseType(const std::string & name, Type & type){
+	if(name == "char" || name == "int8"){
+		type = Int8;
+	}else if(name == "uchar" || name == "uint8"){
+		type = UInt8;
+	}else if(name == "short" || name == "int16"){
+		type = Int16;
+	}else if(name == "ushort" || name == "uint16"){
+		type = UInt16;
+	}else if(name == "int" || name == "int32"){
+		type = Int32;
+	}else if(name == "uint" || name == "uint32"){
+		type = UInt32;
+	}else if(name == "float" || name == "float32"){
+		type = Float32;
+	}else if(name == "double" || name == "float64"){
+		type = Float64;
+	}else{
+		return false;
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+bool ofPlyReader::parseHeader(){
+	const char * p = buffer.getData();
+	const char * bufferEnd = p + buffer.size();
+	std::string line;
+	auto nextLine = [&]{
+		if(p >= bufferEnd){
+			return false;
+		}
+		auto eol = static_cast<const char*>(memchr(p, '\n', bufferEnd - p));
+		auto lineEnd = eol ? eol : bufferEnd;
+		line.assign(p, lineEnd);
+		if(!line.empty() && line.back() == '\r'){
+			line.pop_back();
+		}
+		p = eol ? eol + 1 : bufferEnd;
+		return true;
+	};
+
+	if(!nextLine() || line != "ply"){
+		return setError("wrong format, expecting 'ply'");
+	}
+
+	bool formatFound = false;
+	while(true){
+		if(!nextLine()){
+			return setError("unexpected end of file in the header");
+		}
+		auto words = ofSplitString(line, " ", true, true);
+		if(words.empty() || words[0] == "comment" || words[0] == "obj_info"){
+			continue;
+		}
+
+		if(words[0] == "format" && words.size() == 3){
+			if(words[1] == "ascii"){
+				format = OF_PLY_ASCII;
+			}else if(words[1] == "binary_little_endian"){
+				format = OF_PLY_BINARY_LITTLE_ENDIAN;
+			}else if(words[1] == "binary_big_endian"){
+				format = OF_PLY_BINARY_BIG_ENDIAN;
+			}else{
+				return setError("unknown format '" + words[1] + "'");
+			}
+			formatFound = true;
+		}else if(words[0] == "element" && words.size() == 3){
+			Element element;
+			element.name = words[1];
+			element.count = std::strtoull(words[2].c_str(), nullptr, 10);
+			elements.push_back(element);
+		}else if(words[0] == "property" && !elements.empty()){
+			Property property;
+			bool validType;
+			if(words.size() == 5 && words[1] == "list"){
+				property.isList = true;
+				property.name = words[4];
+				validType = parseType(words[2], property.countType) && parseType(words[3], property.type);
+			}else if(words.size() == 3){
+				property.name = words[2];
+				validType = parseType(words[1], property.type);
+			}else{
+				return setError("wrong property definition '" + line + "'");
+			}
+			if(!validType){
+				return setError("unknown type in '" + line + "'");
+			}
+			elements.back().properties.push_back(property);
+		}else if(words[0] == "end_header"){
+			break;
+		}else{
+			return setError("unexpected line in header '" + line + "'");
+		}
+	}
+
+	if(!formatFound){
+		return setError("missing format in header");
+	}
+	swapBytes = format != OF_PLY_ASCII && (format == OF_PLY_BINARY_LITTLE_ENDIAN) != isLittleEndian();
+
+	// vertex properties used by the mesh and the attribute and component
+	// they are stored in
+	static const std::vector<std::pair<std::string, std::pair<Attribute, size_t>>> attributes = {
+		{"x", {Position, 0}}, {"y", {Position, 1}}, {"z", {Position, 2}},
+		{"nx", {Normal, 0}}, {"ny", {Normal, 1}}, {"nz", {Normal, 2}},
+		{"red", {Color, 0}}, {"green", {Color, 1}}, {"blue", {Color, 2}}, {"alpha", {Color, 3}},
+		{"r", {Color, 0}}, {"g", {Color, 1}}, {"b", {Color, 2}}, {"a", {Color, 3}},
+		{"u", {TexCoord, 0}}, {"v", {TexCoord, 1}},
+		{"s", {TexCoord, 0}}, {"t", {TexCoord, 1}},
+		{"texture_u", {TexCoord, 0}}, {"texture_v", {TexCoord, 1}},
+	};
+
+	for(size_t i = 0; i < elements.size(); i++){
+		auto & element = elements[i];
+		if(element.name == "vertex" && vertexElement < 0){
+			vertexElement = i;
+			for(auto & property: element.properties){
+				for(auto & attribute: attributes){
+					if(!property.isList && property.name == attribute.first){
+						property.attribute = attribute.second.first;
+						property.component = attribute.second.second;
+					}
+				}
+			}
+		}else if(element.name == "face" && faceElement < 0){
+			faceElement = i;
+			for(auto & property: element.properties){
+				if(property.isList && (property.name == "vertex_indices" || property.name == "vertex_index")){
+					property.attribute = Indices;
+				}
+			}
+		}
+
+		if(format != OF_PLY_ASCII){
+			for(auto & property: element.properties){
+				if(property.isList){
+					element.stride = 0;
+					break;
+				}
+				element.stride += sizeOf(property.type);
+			}
+		}
+	}
+
+	if(faceElement >= 0 && elements[faceElement].count > 0){
+		bool hasIndices = false;
+		for(auto & property: elements[faceElement].properties){
+			hasIndices |= property.attribute == Indices;
+		}
+		if(!hasIndices){
+			return setError("wrong face definition, expecting a vertex_indices list");
+		}
+	}
+
+	if(!elements.empty()){
+		elements[0].begin = p;
+	}
+	end = bufferEnd;
+	return true;
+}
+
+//--------------------------------------------------------------
+bool ofPlyReader::parseAscii(const char *& p, double & value){
+	while(p < end && isSpace(*p)){
+		p++;
+	}
+	if(p >= end){
+		return false;
+	}
+	const char * tokenBegin = p;
+	while(p < end && !isSpace(*p)){
+		p++;
+	}
+#if defined(__cpp_lib_to_chars)
+	auto result = std::from_chars(tokenBegin, p, value);
+	if(result.ec != std::errc() || result.ptr != p){
+		return setError("invalid number '" + std::string(tokenBegin, p) + "'");
+	}
+#else
+	char token[64];
+	size_t length = std::min(size_t(p - tokenBegin), sizeof(token) - 1);
+	memcpy(token, tokenBegin, length);
+	token[length] = 0;
+	// strtod expects the decimal point of the C locale the app set
+	std::replace(token, token + length, '.', *localeconv()->decimal_point);
+	char * tokenEnd;
+	value = std::strtod(token, &tokenEnd);
+	if(tokenEnd != token + length){
+		return setError("invalid number '" + std::string(tokenBegin, p) + "'");
+	}
+#endif
+	return true;
+}
+
+//--------------------------------------------------------------
+bool ofPlyReader::skipList(const Property & property, const char *& p){
+	if(format == OF_PLY_ASCII){
+		double count;
+		if(!parseAscii(p, count)){
+			return setError("unexpected end of file reading " + property.name);
+		}
+		if(!(count >= 0)){
+			return setError("invalid list size reading " + property.name);
+		}
+		double value;
+		for(size_t i = 0; i < size_t(count); i++){
+			if(!parseAscii(p, value)){
+				return setError("unexpected end of file reading " + property.name);
+			}
+		}
+	}else{
+		if(p + sizeOf(property.countType) > end){
+			return setError("unexpected end of file reading " + property.name);
+		}
+		double size = readBinary(p, property.countType);
+		if(!(size >= 0)){
+			return setError("invalid list size reading " + property.name);
+		}
+		size_t count = size_t(size);
+		if(count > size_t(end - p) / sizeOf(property.type)){
+			return setError("unexpected end of file reading " + property.name);
+		}
+		p += count * sizeOf(property.type);
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+bool ofPlyReader::skipProperty(const Property & property, const char *& p){
+	if(property.isList){
+		return skipList(property, p);
+	}else if(format == OF_PLY_ASCII){
+		double value;
+		if(!parseAscii(p, value)){
+			return setError("unexpected end of file reading " + property.name);
+		}
+	}else{
+		if(p + sizeOf(property.type) > end){
+			return setError("unexpected end of file reading " + property.name);
+		}
+		p += sizeOf(property.type);
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+bool ofPlyReader::skipRecord(const Element & element, const char *& p){
+	for(auto & property: element.properties){
+		if(!skipProperty(property, p)){
+			return false;
+		}
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+bool ofPlyReader::locate(size_t elementIndex){
+	auto & element = elements[elementIndex];
+	if(element.begin){
+		return true;
+	}
+	if(elementIndex == 0 || !locate(elementIndex - 1)){
+		return false;
+	}
+
+	// elements are stored one after another, skip the previous one to find
+	// where this one starts. For binary files without lists this is just a
+	// multiplication
+	auto & previous = elements[elementIndex - 1];
+	const char * p = previous.begin;
+	if(previous.stride){
+		if(size_t(end - p) < previous.count * previous.stride){
+			return setError("unexpected end of file reading " + previous.name);
+		}
+		p += previous.count * previous.stride;
+	}else{
+		for(size_t i = 0; i < previous.count; i++){
+			if(!skipRecord(previous, p)){
+				return false;
+			}
+		}
+	}
+	element.begin = p;
+	return true;
+}
+
+//--------------------------------------------------------------
+size_t ofPlyReader::prepareRead(int elementIndex, size_t maxRecords){
+	if(elementIndex < 0 || !error.empty() || !locate(elementIndex)){
+		return 0;
+	}
+	auto & element = elements[elementIndex];
+	if(!element.cursor){
+		element.cursor = element.begin;
+	}
+	size_t count = std::min(maxRecords, element.count - element.numRead);
+	if(element.stride && size_t(end - element.cursor) < count * element.stride){
+		setError("unexpected end of file reading " + element.name);
+		return 0;
+	}
+	return count;
+}
+
+//--------------------------------------------------------------
+size_t ofPlyReader::readFaces(std::vector<ofIndexType> & indices, size_t maxFaces){
+	indices.clear();
+	size_t count = prepareRead(faceElement, maxFaces);
+	if(count == 0){
+		return 0;
+	}
+
+	auto & element = elements[faceElement];
+	indices.reserve(count * 3);
+	const char * p = element.cursor;
+	auto readIndex = [&](Type type, double & value){
+		if(format == OF_PLY_ASCII){
+			if(!parseAscii(p, value)){
+				return setError("expected " + ofToString(element.count) + " faces but found " + ofToString(element.numRead));
+			}
+		}else{
+			if(p + sizeOf(type) > end){
+				return setError("unexpected end of file reading faces");
+			}
+			value = readBinary(p, type);
+		}
+		// also rejects NaN, converting it or a negative value to an
+		// unsigned type is undefined
+		if(!(value >= 0)){
+			return setError("invalid vertex index or list size reading faces");
+		}
+		return true;
+	};
+
+	for(size_t i = 0; i < count; i++){
+		for(auto & property: element.properties){
+			if(property.attribute != Indices){
+				if(!skipProperty(property, p)){
+					element.cursor = p;
+					element.numRead += i;
+					return i;
+				}
+				continue;
+			}
+
+			// split polygons in a triangle fan
+			double numVertices, first, previous, current;
+			bool valid = readIndex(property.countType, numVertices);
+			for(size_t j = 0; valid && j < size_t(numVertices); j++){
+				valid = readIndex(property.type, current);
+				if(j == 0){
+					first = current;
+				}else if(j >= 2){
+					indices.push_back(ofIndexType(first));
+					indices.push_back(ofIndexType(previous));
+					indices.push_back(ofIndexType(current));
+				}
+				previous = current;
+			}
+			if(!valid){
+				element.cursor = p;
+				element.numRead += i;
+				return i;
+			}
+		}
+	}
+
+	element.cursor = p;
+	element.numRead += count;
+	return count;
+}
+
+//--------------------------------------------------------------
+ofPlyWriter::ofPlyWriter()
+:format(OF_PLY_ASCII)
+,swapBytes(false)
+,colors(false)
+,texCoords(false)
+,normals(false)
+,numVertices(0)
+,numFaces(0)
+,verticesWritten(0)
+,facesWritten(0)
+,failed(false){
+}
+
+//--------------------------------------------------------------
+ofPlyWriter::~ofPlyWriter(){
+	if(isOpen()){
+		close();
+	}
+}
+
+//--------------------------------------------------------------
+bool ofPlyWriter::open(const of::filesystem::path & path, ofPlyFormat format, size_t numVertices, size_t numFaces, bool colors, bool texCoords, bool normals){
+	if(isOpen()){
+		close();
+	}
+	if(!file.open(path, ofFile::WriteOnly, true)){
+		ofLogError("ofPlyWriter") << "open(): couldn't open " << path;
+		return false;
+	}
+	this->format = format;
+	this->swapBytes = format != OF_PLY_ASCII && (format == OF_PLY_BINARY_LITTLE_ENDIAN) != isLittleEndian();
+	this->numVertices = numVertices;
+	this->numFaces = numFaces;
+	this->colors = colors;
+	this->texCoords = texCoords;
+	this->normals = normals;
+	verticesWritten = 0;
+	facesWritten = 0;
+	failed = false;
+
+	std::string header = "ply\n";
+	switch(format){
+		case OF_PLY_ASCII: header += "format ascii 1.0\n"; break;
+		case OF_PLY_BINARY_LITTLE_ENDIAN: header += "format binary_little_endian 1.0\n"; break;
+		case OF_PLY_BINARY_BIG_ENDIAN: header += "format binary_big_endian 1.0\n"; break;
+	}
+	if(numVertices){
+		header += "element vertex " + ofToString(numVertices) + "\n";
+		header += "property float x\n";
+		header += "property float y\n";
+		header += "property float z\n";
+		if(colors){
+			header += "property uchar red\n";
+			header += "property uchar green\n";
+			header += "property uchar blue\n";
+			header += "property uchar alpha\n";
+		}
+		if(texCoords){
+			header += "property float u\n";
+			header += "property float v\n";
+		}
+		if(normals){
+			header += "property float nx\n";
+			header += "property float ny\n";
+			header += "property float nz\n";
+		}
+	}
+	if(numFaces){
+		header += "element face " + ofToString(numFaces) + "\n";
+		header += "property list uchar int vertex_indices\n";
+	}
+	header += "end_header\n";
+	chunk.assign(header.begin(), header.end());
+	return flush();
+}
+
+//--------------------------------------------------------------
+bool ofPlyWriter::isOpen() const{
+	return file.is_open();
+}
+
+//--------------------------------------------------------------
+bool ofPlyWriter::writeFaces(const std::vector<ofIndexType> & indices){
+	return writeFaces(indices.data(), indices.size());
+}
+
+//--------------------------------------------------------------
+bool ofPlyWriter::writeFaces(const ofIndexType * indices, size_t numIndices){
+	if(!isOpen()){
+		return false;
+	}
+	if(numIndices % 3 != 0){
+		ofLogError("ofPlyWriter") << "writeFaces(): number of indices is not a multiple of 3";
+		failed = true;
+		return false;
+	}
+	for(size_t i = 0; i < numIndices; i += 3){
+		addUChar(3);
+		addInt(indices[i]);
+		addInt(indices[i + 1]);
+		addInt(indices[i + 2]);
+		endRecord();
+		if(!flush()){
+			return false;
+		}
+	}
+	facesWritten += numIndices / 3;
+	return true;
+}
+
+//--------------------------------------------------------------
+bool ofPlyWriter::close(){
+	if(!isOpen()){
+		return false;
+	}
+	flush(true);
+	file.close();
+	if(verticesWritten != numVertices || facesWritten != numFaces){
+		ofLogError("ofPlyWriter") << "close(): wrote " << verticesWritten << " vertices and " << facesWritten
+			<< " faces but the header declares " << numVertices << " and " << numFaces;
+		failed = true;
+	}
+	return !failed;
+}
+
+//--------------------------------------------------------------
+void ofPlyWriter::addText(float value){
+	if(!chunk.empty() && chunk.back() != '\n'){
+		chunk.push_back(' ');
+	}
+	char text[32];
+#if defined(__cpp_lib_to_chars)
+	// the shortest text that reads back as the same float, always with a '.'
+	auto result = std::to_chars(text, text + sizeof(text), value);
+	chunk.insert(chunk.end(), text, result.ptr);
+#else
+	int length = snprintf(text, sizeof(text), "%.9g", value);
+	// snprintf uses the decimal point of the C locale the app set
+	std::replace(text, text + length, *localeconv()->decimal_point, '.');
+	chunk.insert(chunk.end(), text, text + length);
+#endif
+}
+
+//--------------------------------------------------------------
+void ofPlyWriter::addText(int value){
+	if(!chunk.empty() && chunk.back() != '\n'){
+		chunk.push_back(' ');
+	}
+	char text[16];
+	int length = snprintf(text, sizeof(text), "%d", value);
+	chunk.insert(chunk.end(), text, text + length);
+}
+
+//--------------------------------------------------------------
+void ofPlyWriter::endRecord(){
+	if(format == OF_PLY_ASCII){
+		chunk.push_back('\n');
+	}
+}
+
+//--------------------------------------------------------------
+bool ofPlyWriter::flush(bool force){
+	// writing in big blocks is much faster than one value at a time
+	if(chunk.size() < 1024 * 1024 && !force){
+		return true;
+	}
+	file.write(chunk.data(), chunk.size());
+	chunk.clear();
+	if(!file.good()){
+		ofLogError("ofPlyWriter") << "couldn't write to " << file.path();
+		failed = true;
+		return false;
+	}
+	return true;
+}
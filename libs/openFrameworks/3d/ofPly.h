@@ -0,0 +1,492 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofColor.h"
+#include "ofFileUtils.h"
+#include "ofLog.h"
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+template<class V, class N, class C, class T>
+class ofMesh_;
+
+enum ofPlyFormat{
+	OF_PLY_ASCII,
+	OF_PLY_BINARY_LITTLE_ENDIAN,
+	OF_PLY_BINARY_BIG_ENDIAN,
+};
+
+/// \brief Reads meshes in the [PLY format](http://paulbourke.net/dataformats/ply/).
+///
+/// Supports ascii and binary files in both byte orders. The file is mapped
+/// into memory and binary data is copied straight into the mesh, without
+/// parsing text. Vertices and faces can be read in chunks, which allows to
+/// process meshes that don't fit in memory:
+///
+/// ~~~~{.cpp}
+/// ofPlyReader reader;
+/// if(reader.open("scan.ply")){
+/// 	ofMesh chunk;
+/// 	while(reader.readVertices(chunk, 1000000)){
+/// 		// process chunk.getVertices()...
+/// 	}
+/// }
+/// ~~~~
+///
+/// Vertex positions are read from the x, y and z properties, normals from
+/// nx, ny and nz, colors from red, green, blue and alpha (or r, g, b, a)
+/// and texture coordinates from u and v (or s and t). Faces are read from
+/// the vertex_indices list of the face element, polygons with more than 3
+/// vertices are split into triangles. Any other elements and properties are
+/// skipped.
+///
+/// Usually it's easier to call ofMesh::load, which uses this class to load
+/// the whole file.
+class ofPlyReader{
+public:
+	ofPlyReader();
+
+	/// \brief Map a file and parse its header.
+	///
+	/// \returns false if the file couldn't be opened or the header is not
+	/// valid, getError() tells why.
+	bool open(const of::filesystem::path & path);
+
+	/// \brief Parse the header of a file already loaded in a buffer.
+	///
+	/// The reader keeps a copy of the buffer, which doesn't copy any data
+	/// if the buffer is mapped.
+	bool open(const ofBuffer & buffer);
+
+	void close();
+	bool isOpen() const;
+
+	ofPlyFormat getFormat() const;
+
+	/// \brief Number of vertices and faces declared in the header.
+	size_t getNumVertices() const;
+	size_t getNumFaces() const;
+
+	bool hasNormals() const;
+	bool hasColors() const;
+	bool hasTexCoords() const;
+
+	/// \brief Read the next vertices in the file into mesh.
+	///
+	/// The vertices, normals, colors and texture coordinates of the mesh
+	/// are replaced with the ones read, its indices are left untouched.
+	///
+	/// \returns the number of vertices read, 0 once every vertex has been
+	/// read or if there was an error.
+	template<class V, class N, class C, class T>
+	size_t readVertices(ofMesh_<V,N,C,T> & mesh, size_t maxVertices = std::numeric_limits<size_t>::max());
+
+	/// \brief Read the next faces in the file as triangle indices.
+	///
+	/// The contents of indices are replaced, each face adds 3 indices per
+	/// triangle. Indices refer to the position of the vertices in the file,
+	/// not in the last chunk read.
+	///
+	/// \returns the number of faces read, 0 once every face has been read
+	/// or if there was an error.
+	size_t readFaces(std::vector<ofIndexType> & indices, size_t maxFaces = std::numeric_limits<size_t>::max());
+
+	/// \brief Read every remaining vertex and face into mesh.
+	template<class V, class N, class C, class T>
+	bool read(ofMesh_<V,N,C,T> & mesh);
+
+	/// \brief Description of the last error, empty if there was none.
+	const std::string & getError() const;
+
+private:
+	enum Type{
+		Int8,
+		UInt8,
+		Int16,
+		UInt16,
+		Int32,
+		UInt32,
+		Float32,
+		Float64,
+	};
+
+	enum Attribute{
+		None,
+		Position,
+		Normal,
+		Color,
+		TexCoord,
+		Indices,
+	};
+
+	struct Property{
+		std::string name;
+		Type type;
+		bool isList = false;
+		Type countType = UInt8;
+		Attribute attribute = None;
+		size_t component = 0;
+	};
+
+	struct Element{
+		std::string name;
+		size_t count = 0;
+		std::vector<Property> properties;
+		/// Size of each record in binary files, 0 if it has lists.
+		size_t stride = 0;
+		const char * begin = nullptr;
+		const char * cursor = nullptr;
+		size_t numRead = 0;
+	};
+
+	bool parseHeader();
+	bool locate(size_t elementIndex);
+	bool skipRecord(const Element & element, const char *& p);
+	bool skipList(const Property & property, const char *& p);
+	bool skipProperty(const Property & property, const char *& p);
+	size_t prepareRead(int elementIndex, size_t maxRecords);
+	bool parseAscii(const char *& p, double & value);
+	bool setError(const std::string & error);
+
+	static size_t sizeOf(Type type);
+	static bool parseType(const std::string & name, Type & type);
+
+	double readBinary(const char *& p, Type type) const{
+		switch(type){
+			case Int8: return readBinary<int8_t>(p);
+			case UInt8: return readBinary<uint8_t>(p);
+			case Int16: return readBinary<int16_t>(p);
+			case UInt16: return readBinary<uint16_t>(p);
+			case Int32: return readBinary<int32_t>(p);
+			case UInt32: return readBinary<uint32_t>(p);
+			case Float32: return readBinary<float>(p);
+			case Float64: return readBinary<double>(p);
+		}
+		return 0;
+	}
+
+	template<typename S>
+	S readBinary(const char *& p) const{
+		char bytes[sizeof(S)];
+		if(swapBytes){
+			for(size_t i = 0; i < sizeof(S); i++){
+				bytes[i] = p[sizeof(S) - 1 - i];
+			}
+		}else{
+			memcpy(bytes, p, sizeof(S));
+		}
+		p += sizeof(S);
+		S value;
+		memcpy(&value, bytes, sizeof(S));
+		return value;
+	}
+
+	template<class Vec>
+	static void setComponent(Vec & v, size_t component, double value){
+		typedef typename std::remove_reference<decltype(v.x)>::type Component;
+		(&v.x)[component] = Component(value);
+	}
+
+	template<class Color>
+	static void setColorComponent(Color & c, size_t component, double value){
+		typedef typename std::remove_reference<decltype(c.r)>::type Component;
+		(&c.r)[component] = Component(value);
+	}
+
+	template<class Vec>
+	static constexpr size_t numComponents(){
+		return sizeof(Vec) / sizeof(std::declval<Vec&>().x);
+	}
+
+	ofBuffer buffer;
+	const char * end;
+	ofPlyFormat format;
+	bool swapBytes;
+	std::vector<Element> elements;
+	int vertexElement;
+	int faceElement;
+	std::string error;
+};
+
+/// \brief Writes meshes in the [PLY format](http://paulbourke.net/dataformats/ply/).
+///
+/// The number of vertices and faces and which attributes they have has to
+/// be known when opening the file, then vertices and faces can be written
+/// in chunks so a mesh doesn't need to be in memory all at once.
+///
+/// ~~~~{.cpp}
+/// ofPlyWriter writer;
+/// writer.open("scan.ply", OF_PLY_BINARY_LITTLE_ENDIAN, numVertices, 0, true, false, false);
+/// for(auto & chunk: chunks){
+/// 	writer.writeVertices(chunk);
+/// }
+/// writer.close();
+/// ~~~~
+class ofPlyWriter{
+public:
+	ofPlyWriter();
+	~ofPlyWriter();
+
+	ofPlyWriter(const ofPlyWriter &) = delete;
+	ofPlyWriter & operator=(const ofPlyWriter &) = delete;
+
+	/// \brief Create the file and write its header.
+	///
+	/// Colors are written as 8 bit per component RGBA, which is what most
+	/// other software expects.
+	bool open(const of::filesystem::path & path, ofPlyFormat format, size_t numVertices, size_t numFaces, bool colors, bool texCoords, bool normals);
+
+	/// \brief Write every vertex of mesh with the attributes declared in
+	/// open(), the mesh needs to have all of them.
+	template<class V, class N, class C, class T>
+	bool writeVertices(const ofMesh_<V,N,C,T> & mesh);
+
+	/// \brief Write triangles, 3 indices per face.
+	bool writeFaces(const ofIndexType * indices, size_t numIndices);
+	bool writeFaces(const std::vector<ofIndexType> & indices);
+
+	/// \brief Flush the remaining data and close the file.
+	///
+	/// \returns false if the number of vertices or faces written doesn't
+	/// match the ones declared in open() or there was any error writing.
+	bool close();
+
+	bool isOpen() const;
+
+private:
+	void addFloat(float value){
+		if(format == OF_PLY_ASCII){
+			addText(value);
+		}else{
+			addBinary(value);
+		}
+	}
+
+	void addUChar(unsigned char value){
+		if(format == OF_PLY_ASCII){
+			addText(int(value));
+		}else{
+			chunk.push_back(char(value));
+		}
+	}
+
+	void addInt(int32_t value){
+		if(format == OF_PLY_ASCII){
+			addText(value);
+		}else{
+			addBinary(value);
+		}
+	}
+
+	template<typename S>
+	void addBinary(S value){
+		char bytes[sizeof(S)];
+		memcpy(bytes, &value, sizeof(S));
+		if(swapBytes){
+			for(size_t i = 0; i < sizeof(S) / 2; i++){
+				std::swap(bytes[i], bytes[sizeof(S) - 1 - i]);
+			}
+		}
+		chunk.insert(chunk.end(), bytes, bytes + sizeof(S));
+	}
+
+	void addText(float value);
+	void addText(int value);
+	void endRecord();
+	bool flush(bool force = false);
+
+	ofFile file;
+	ofPlyFormat format;
+	bool swapBytes;
+	bool colors;
+	bool texCoords;
+	bool normals;
+	size_t numVertices;
+	size_t numFaces;
+	size_t verticesWritten;
+	size_t facesWritten;
+	std::vector<char> chunk;
+	bool failed;
+};
+
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+size_t ofPlyReader::readVertices(ofMesh_<V,N,C,T> & mesh, size_t maxVertices){
+	size_t count = prepareRead(vertexElement, maxVertices);
+
+	auto & vertices = mesh.getVertices();
+	auto & normals = mesh.getNormals();
+	auto & colors = mesh.getColors();
+	auto & texCoords = mesh.getTexCoords();
+	vertices.assign(count, V());
+	normals.clear();
+	colors.clear();
+	texCoords.clear();
+	if(count == 0){
+		return 0;
+	}
+	auto & element = elements[vertexElement];
+	if(hasNormals()){
+		normals.assign(count, N());
+	}
+	if(hasColors()){
+		colors.assign(count, C());
+	}
+	if(hasTexCoords()){
+		texCoords.assign(count, T());
+	}
+
+	// skip the components the mesh types don't have, like z in 2d meshes
+	std::vector<Attribute> targets;
+	for(auto & property: element.properties){
+		Attribute target = property.attribute;
+		if((target == Position && property.component >= numComponents<V>())
+		   || (target == Normal && property.component >= numComponents<N>())
+		   || (target == TexCoord && property.component >= numComponents<T>())){
+			target = None;
+		}
+		targets.push_back(target);
+	}
+
+	const char * p = element.cursor;
+	typedef typename std::remove_reference<decltype(vertices[0].x)>::type VertexComponent;
+	bool positionsOnly = element.properties.size() == 3
+		&& targets[0] == Position && targets[1] == Position && targets[2] == Position
+		&& element.properties[0].component == 0 && element.properties[1].component == 1 && element.properties[2].component == 2;
+	bool allFloat = true;
+	for(auto & property: element.properties){
+		allFloat &= !property.isList && property.type == Float32;
+	}
+
+	if(format != OF_PLY_ASCII && !swapBytes && allFloat && positionsOnly
+	   && std::is_same<VertexComponent, float>::value && sizeof(V) == 3 * sizeof(float)){
+		// the most common layout for point clouds, the whole block can be
+		// copied straight into the vertices
+		memcpy(vertices.data(), p, count * element.stride);
+		p += count * element.stride;
+	}else{
+		auto colorScale = C::limit();
+		for(size_t i = 0; i < count; i++){
+			for(size_t j = 0; j < element.properties.size(); j++){
+				auto & property = element.properties[j];
+				if(property.isList){
+					if(!skipList(property, p)){
+						vertices.resize(i);
+						return i;
+					}
+					continue;
+				}
+
+				double value;
+				if(format == OF_PLY_ASCII){
+					if(!parseAscii(p, value)){
+						setError("expected " + std::to_string(element.count) + " vertices but found " + std::to_string(element.numRead + i));
+						vertices.resize(i);
+						return i;
+					}
+				}else{
+					if(element.stride == 0 && p + sizeOf(property.type) > end){
+						setError("unexpected end of file reading vertices");
+						vertices.resize(i);
+						return i;
+					}
+					value = readBinary(p, property.type);
+				}
+
+				switch(targets[j]){
+					case Position:
+						setComponent(vertices[i], property.component, value);
+						break;
+					case Normal:
+						setComponent(normals[i], property.component, value);
+						break;
+					case Color:
+						if(property.type == UInt8){
+							value /= 255.0;
+						}
+						setColorComponent(colors[i], property.component, value * colorScale);
+						break;
+					case TexCoord:
+						setComponent(texCoords[i], property.component, value);
+						break;
+					default:
+						break;
+				}
+			}
+		}
+	}
+
+	element.cursor = p;
+	element.numRead += count;
+	return count;
+}
+
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+bool ofPlyReader::read(ofMesh_<V,N,C,T> & mesh){
+	if(!isOpen()){
+		return false;
+	}
+	if(vertexElement >= 0){
+		size_t toRead = elements[vertexElement].count - elements[vertexElement].numRead;
+		if(readVertices(mesh, toRead) != toRead){
+			return false;
+		}
+	}
+	mesh.getIndices().clear();
+	if(faceElement >= 0){
+		size_t toRead = elements[faceElement].count - elements[faceElement].numRead;
+		if(readFaces(mesh.getIndices(), toRead) != toRead){
+			return false;
+		}
+	}
+	return error.empty();
+}
+
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+bool ofPlyWriter::writeVertices(const ofMesh_<V,N,C,T> & mesh){
+	if(!isOpen()){
+		return false;
+	}
+	auto & vertices = mesh.getVertices();
+	auto & meshNormals = mesh.getNormals();
+	auto & meshColors = mesh.getColors();
+	auto & meshTexCoords = mesh.getTexCoords();
+	if((colors && meshColors.size() < vertices.size())
+	   || (texCoords && meshTexCoords.size() < vertices.size())
+	   || (normals && meshNormals.size() < vertices.size())){
+		ofLogError("ofPlyWriter") << "writeVertices(): the mesh doesn't have every attribute declared in the header";
+		failed = true;
+		return false;
+	}
+	for(size_t i = 0; i < vertices.size(); i++){
+		addFloat(vertices[i].x);
+		addFloat(vertices[i].y);
+		addFloat(vertices[i].z);
+		if(colors){
+			// VCG lib / MeshLab don't support float colors, so we have to cast
+			ofColor color = meshColors[i];
+			addUChar(color.r);
+			addUChar(color.g);
+			addUChar(color.b);
+			addUChar(color.a);
+		}
+		if(texCoords){
+			addFloat(meshTexCoords[i].x);
+			addFloat(meshTexCoords[i].y);
+		}
+		if(normals){
+			addFloat(meshNormals[i].x);
+			addFloat(meshNormals[i].y);
+			addFloat(meshNormals[i].z);
+		}
+		endRecord();
+		if(!flush()){
+			return false;
+		}
+	}
+	verticesWritten += vertices.size();
+	return true;
+}
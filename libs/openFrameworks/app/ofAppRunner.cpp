@@ -273,6 +273,12 @@ void ofExitCallback(){
 	// try to close font libraries
 	ofTrueTypeShutdown();
 
+	//------------------------
+	// write the messages still queued in the logger
+	if(auto channel = ofGetLoggerChannel()){
+		channel->flush();
+	}
+
 	// static deinitialization happens after this finishes
 	// every object should have ended by now and won't receive any
 	// events
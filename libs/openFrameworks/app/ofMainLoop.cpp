@@ -261,6 +261,22 @@ void ofMainLoop::setEscapeQuitsLoop(bool quits){
 	escapeQuits = quits;
 }
 
+void ofMainLoop::post(std::function<void()> && function){
+	std::unique_lock<std::mutex> lock(postedMutex);
+	posted.push_back(std::move(function));
+}
+
+void ofMainLoop::runPostedFunctions(ofEventArgs &){
+	{
+		std::unique_lock<std::mutex> lock(postedMutex);
+		std::swap(posted, running);
+	}
+	for(auto & function: running){
+		function();
+	}
+	running.clear();
+}
+
 void ofMainLoop::keyPressed(ofKeyEventArgs & key){
 	if (key.key == OF_KEY_ESC && escapeQuits == true){				// "escape"
 		shouldClose(0);
@@ -2,6 +2,7 @@
 
 #include "ofEvents.h"
 #include <unordered_map>
+#include <mutex>
 
 class ofBaseApp;
 class ofAppBaseWindow;
@@ -29,6 +30,7 @@ public:
 		windowsApps[window] = std::shared_ptr<ofBaseApp>();
 		currentWindow = window;
 		ofAddListener(window->events().keyPressed,this,&ofMainLoop::keyPressed);
+		ofAddListener(window->events().update,this,&ofMainLoop::runPostedFunctions,OF_EVENT_ORDER_BEFORE_APP);
 	}
 
 	void run(const std::shared_ptr<ofAppBaseWindow> & window, std::shared_ptr<ofBaseApp> && app);
@@ -44,6 +46,13 @@ public:
 	std::shared_ptr<ofBaseApp> getCurrentApp();
 	void setEscapeQuitsLoop(bool quits);
 
+	/// \brief Call a function in the main thread before the next update.
+	///
+	/// Can be called from any thread, it's how ofTaskPool delivers results
+	/// that need to be used from the main thread, like pixels that have
+	/// to be uploaded to a texture.
+	void post(std::function<void()> && function);
+
 	ofEvent<void> exitEvent;
 	ofEvent<void> loopEvent;
 	
@@ -53,6 +62,7 @@ private:
 	std::thread::id thread_id { std::this_thread::get_id() };
 
 	void keyPressed(ofKeyEventArgs & key);
+	void runPostedFunctions(ofEventArgs &);
 	std::unordered_map<std::shared_ptr<ofAppBaseWindow>, std::shared_ptr<ofBaseApp> > windowsApps;
 	bool bShouldClose;
 	std::weak_ptr<ofAppBaseWindow> currentWindow;
@@ -61,4 +71,7 @@ private:
 	std::function<void()> windowLoop;
 	std::function<void()> windowPollEvents;
 	bool escapeQuits;
+	std::mutex postedMutex;
+	std::vector<std::function<void()>> posted;
+	std::vector<std::function<void()>> running;
 };
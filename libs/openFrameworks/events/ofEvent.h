@@ -153,7 +153,7 @@ namespace priv{
 
 		BaseEvent(const BaseEvent & mom){
 			std::unique_lock<Mutex> lck(const_cast<BaseEvent&>(mom).self->mtx);
-			self->functions = mom.self->functions;
+			self->setFunctions(mom.self->getFunctions());
 		}
 
 		BaseEvent & operator=(const BaseEvent & mom){
@@ -162,14 +162,15 @@ namespace priv{
 			}
 			std::unique_lock<Mutex> lck(const_cast<BaseEvent&>(mom).self->mtx);
 			std::unique_lock<Mutex> lck2(self->mtx);
-			self->functions = mom.self->functions;
+			self->setFunctions(mom.self->getFunctions());
 			self->enabled = mom.self->enabled;
 			return *this;
 		}
 
 		BaseEvent(BaseEvent && mom){
 			std::unique_lock<Mutex> lck(const_cast<BaseEvent&>(mom).self->mtx);
-			self->functions = std::move(mom.self->functions);
+			self->setFunctions(mom.self->getFunctions());
+			mom.self->setFunctions(std::make_shared<Functions>());
 			self->enabled = std::move(mom.self->enabled);
 		}
 
@@ -179,7 +180,7 @@ namespace priv{
 			}
 			std::unique_lock<Mutex> lck(const_cast<BaseEvent&>(mom).self->mtx);
 			std::unique_lock<Mutex> lck2(self->mtx);
-			self->functions = mom.self->functions;
+			self->setFunctions(mom.self->getFunctions());
 			self->enabled = mom.self->enabled;
 			return *this;
 		}
@@ -197,14 +198,27 @@ namespace priv{
 		}
 
 		std::size_t size() const {
-			return self->functions.size();
+			return self->numFunctions.load(std::memory_order_relaxed);
 		}
 
 	protected:
+		typedef std::vector<std::shared_ptr<Function>> Functions;
 
 		struct Data{
 			Mutex mtx;
-			std::vector<std::shared_ptr<Function>> functions;
+			// the list of listeners is never modified, adding or removing
+			// a listener publishes a modified copy with an atomic store, so
+			// notify only loads the current list without locking and keeps
+			// it alive while it iterates it. modifications are serialized
+			// by mtx. std::atomic<std::shared_ptr> replaces the free atomic
+			// functions for shared_ptr, deprecated in c++20
+#if defined(__cpp_lib_atomic_shared_ptr)
+			std::atomic<std::shared_ptr<const Functions>> functions { std::make_shared<Functions>() };
+#else
+			std::shared_ptr<const Functions> functions = std::make_shared<Functions>();
+#endif
+			// lets notify skip loading the list when there are no listeners
+			std::atomic<std::size_t> numFunctions { 0 };
 			std::atomic<bool> notified_ { false };
 			bool enabled = true;
 			
@@ -220,18 +234,62 @@ namespace priv{
 				notified_.store(state, std::memory_order_relaxed);
 			}
 
+			bool empty() const{
+				return numFunctions.load(std::memory_order_acquire) == 0;
+			}
+
+			std::shared_ptr<const Functions> getFunctions() const{
+#if defined(__cpp_lib_atomic_shared_ptr)
+				return functions.load();
+#else
+				return std::atomic_load(&functions);
+#endif
+			}
+
+			// only called with mtx locked
+			void setFunctions(std::shared_ptr<const Functions> newFunctions){
+				auto size = newFunctions->size();
+#if defined(__cpp_lib_atomic_shared_ptr)
+				functions.store(std::move(newFunctions));
+#else
+				std::atomic_store(&functions, std::move(newFunctions));
+#endif
+				numFunctions.store(size, std::memory_order_release);
+			}
+
 			void remove(const BaseFunctionId & id){
 				std::unique_lock<Mutex> lck(mtx);
-				auto it = functions.begin();
-				for(; it!=functions.end(); ++it){
+				auto current = getFunctions();
+				auto it = current->begin();
+				for(; it!=current->end(); ++it){
 					auto f = *it;
 					if(*f->id == id){
 						f->disable();
-						functions.erase(it);
+						auto copy = std::make_shared<Functions>();
+						copy->reserve(current->size() - 1);
+						copy->insert(copy->end(), current->begin(), it);
+						copy->insert(copy->end(), it + 1, current->end());
+						setFunctions(std::move(copy));
 						break;
 					}
 				}
 			}
+
+			template<typename TFunction>
+			void insert(TFunction && f){
+				std::unique_lock<Mutex> lck(mtx);
+				auto current = getFunctions();
+				auto it = current->begin();
+				for(; it!=current->end(); ++it){
+					if((*it)->priority>f->priority) break;
+				}
+				auto copy = std::make_shared<Functions>();
+				copy->reserve(current->size() + 1);
+				copy->insert(copy->end(), current->begin(), it);
+				copy->push_back(f);
+				copy->insert(copy->end(), it, current->end());
+				setFunctions(std::move(copy));
+			}
 		};
 		std::shared_ptr<Data> self{new Data};
 
@@ -263,22 +321,12 @@ namespace priv{
 
 		template<typename TFunction>
 		void addNoToken(TFunction && f){
-			std::unique_lock<Mutex> lck(self->mtx);
-			auto it = self->functions.begin();
-			for(; it!=self->functions.end(); ++it){
-				if((*it)->priority>f->priority) break;
-			}
-			self->functions.emplace(it, f);
+			self->insert(f);
 		}
 
 		template<typename TFunction>
 		std::unique_ptr<EventToken> addFunction(TFunction && f){
-			std::unique_lock<Mutex> lck(self->mtx);
-			auto it = self->functions.begin();
-			for(; it!=self->functions.end(); ++it){
-				if((*it)->priority>f->priority) break;
-			}
-			self->functions.emplace(it, f);
+			self->insert(f);
 			return make_token(*f);
 		}
 	};
@@ -585,14 +633,13 @@ public:
 	inline bool notify(const void* sender, T & param) {
 		if (ofEvent<T,Mutex>::self->enabled) {
 			ofEvent<T,Mutex>::self->setNotified(true);
-			if (!ofEvent<T,Mutex>::self->functions.empty()) {
-				std::unique_lock<Mutex> lck(ofEvent<T,Mutex>::self->mtx);
-				auto functions_copy = ofEvent<T,Mutex>::self->functions;
-				lck.unlock();
-				for (auto & f: functions_copy) {
-					if (f->notify(sender,param)) {
-						return true;
-					}
+			if(ofEvent<T,Mutex>::self->empty()){
+				return false;
+			}
+			auto functions = ofEvent<T,Mutex>::self->getFunctions();
+			for (auto & f: *functions) {
+				if (f->notify(sender,param)) {
+					return true;
 				}
 			}
 		}
@@ -742,14 +789,13 @@ public:
 	bool notify(const void* sender){
 		if(ofEvent<void,Mutex>::self->enabled) {
 			ofEvent<void,Mutex>::self->setNotified(true);
-			if (!ofEvent<void,Mutex>::self->functions.empty()) {
-				std::unique_lock<Mutex> lck(ofEvent<void,Mutex>::self->mtx);
-				auto functions_copy = ofEvent<void,Mutex>::self->functions;
-				lck.unlock();
-				for (auto & f: functions_copy) {
-					if (f->notify(sender)) {
-						return true;
-					}
+			if(ofEvent<void,Mutex>::self->empty()){
+				return false;
+			}
+			auto functions = ofEvent<void,Mutex>::self->getFunctions();
+			for (auto & f: *functions) {
+				if (f->notify(sender)) {
+					return true;
 				}
 			}
 		}
@@ -762,14 +808,16 @@ public:
 };
 
 // -------------------------------------
-/// Non thread safe event that avoids locks and copies of the listeners
-/// making it faster than a plain ofEvent
+/// Non thread safe event that avoids locks making it faster than a plain
+/// ofEvent
 template<typename T>
 class ofFastEvent: public ofEvent<T,of::priv::NoopMutex>{
 public:
 	inline bool notify(const void* sender, T & param){
-		if(this->isEnabled()){
-			for(auto & f: ofFastEvent<T>::self->functions){
+		if(this->isEnabled() && !ofFastEvent<T>::self->empty()){
+			// keeps the list alive in case a listener removes itself
+			auto functions = ofFastEvent<T>::self->getFunctions();
+			for(auto & f: *functions){
 				if(f->notify(sender, param)){
 					return true;
 				}
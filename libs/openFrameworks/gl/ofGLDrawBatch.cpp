@@ -0,0 +1,172 @@
+#include "ofGLDrawBatch.h"
+
+//----------------------------------------------------------
+ofGLDrawBatch::ofGLDrawBatch()
+:lineWidth(1)
+,maxVertices(65536)
+,flushing(false){
+	mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+}
+
+//----------------------------------------------------------
+void ofGLDrawBatch::setFlushFunction(std::function<void(const ofMesh & mesh)> flushFunction){
+	this->flushFunction = flushFunction;
+}
+
+//----------------------------------------------------------
+void ofGLDrawBatch::prepare(ofPrimitiveMode mode, std::size_t numVertices, float lineWidth){
+	if(!isEmpty()){
+		bool differentLines = mode == OF_PRIMITIVE_LINES && lineWidth != this->lineWidth;
+		if(mode != mesh.getMode() || differentLines || mesh.getNumVertices() + numVertices > maxVertices){
+			flush();
+		}
+	}
+	mesh.setMode(mode);
+	this->lineWidth = lineWidth;
+	currentFrame.batchedPrimitives++;
+}
+
+//----------------------------------------------------------
+void ofGLDrawBatch::addVertex(const glm::vec3 & vertex, const glm::mat4 & modelView, const ofFloatColor & color){
+	mesh.getVertices().emplace_back(modelView * glm::vec4(vertex, 1.f));
+	mesh.getColors().push_back(color);
+}
+
+//----------------------------------------------------------
+void ofGLDrawBatch::addTriangles(const glm::vec3 * vertices, std::size_t numVertices, ofPrimitiveMode mode, const glm::mat4 & modelView, const ofFloatColor & color){
+	if(numVertices < 3){
+		return;
+	}
+	prepare(OF_PRIMITIVE_TRIANGLES, numVertices, lineWidth);
+
+	ofIndexType first = mesh.getNumVertices();
+	for(std::size_t i = 0; i < numVertices; i++){
+		addVertex(vertices[i], modelView, color);
+	}
+
+	auto & indices = mesh.getIndices();
+	switch(mode){
+	case OF_PRIMITIVE_TRIANGLE_FAN:
+		for(ofIndexType i = 1; i + 1 < numVertices; i++){
+			indices.push_back(first);
+			indices.push_back(first + i);
+			indices.push_back(first + i + 1);
+		}
+		break;
+	case OF_PRIMITIVE_TRIANGLE_STRIP:
+		// keep the winding of every other triangle
+		for(ofIndexType i = 0; i + 2 < numVertices; i++){
+			indices.push_back(first + i + (i % 2));
+			indices.push_back(first + i + 1 - (i % 2));
+			indices.push_back(first + i + 2);
+		}
+		break;
+	default:
+		for(ofIndexType i = 0; i + 2 < numVertices; i += 3){
+			indices.push_back(first + i);
+			indices.push_back(first + i + 1);
+			indices.push_back(first + i + 2);
+		}
+		break;
+	}
+}
+
+//----------------------------------------------------------
+void ofGLDrawBatch::addLines(const glm::vec3 * vertices, std::size_t numVertices, ofPrimitiveMode mode, const glm::mat4 & modelView, const ofFloatColor & color, float lineWidth){
+	if(numVertices < 2){
+		return;
+	}
+	switch(mode){
+	case OF_PRIMITIVE_LINE_STRIP:
+		prepare(OF_PRIMITIVE_LINES, (numVertices - 1) * 2, lineWidth);
+		for(std::size_t i = 0; i + 1 < numVertices; i++){
+			addVertex(vertices[i], modelView, color);
+			addVertex(vertices[i + 1], modelView, color);
+		}
+		break;
+	case OF_PRIMITIVE_LINE_LOOP:
+		prepare(OF_PRIMITIVE_LINES, numVertices * 2, lineWidth);
+		for(std::size_t i = 0; i < numVertices; i++){
+			addVertex(vertices[i], modelView, color);
+			addVertex(vertices[(i + 1) % numVertices], modelView, color);
+		}
+		break;
+	default:
+		prepare(OF_PRIMITIVE_LINES, numVertices / 2 * 2, lineWidth);
+		for(std::size_t i = 0; i + 1 < numVertices; i += 2){
+			addVertex(vertices[i], modelView, color);
+			addVertex(vertices[i + 1], modelView, color);
+		}
+		break;
+	}
+}
+
+//----------------------------------------------------------
+void ofGLDrawBatch::flush(){
+	// the flush function draws through the renderer, which flushes again
+	if(flushing || isEmpty()){
+		return;
+	}
+	flushing = true;
+	currentFrame.flushes++;
+	currentFrame.batchedVertices += mesh.getNumVertices();
+	if(flushFunction){
+		flushFunction(mesh);
+	}
+	mesh.clear();
+	flushing = false;
+}
+
+//----------------------------------------------------------
+void ofGLDrawBatch::clear(){
+	mesh.clear();
+}
+
+//----------------------------------------------------------
+bool ofGLDrawBatch::isEmpty() const{
+	return mesh.getNumVertices() == 0;
+}
+
+//----------------------------------------------------------
+bool ofGLDrawBatch::isFlushing() const{
+	return flushing;
+}
+
+//----------------------------------------------------------
+std::size_t ofGLDrawBatch::getNumVertices() const{
+	return mesh.getNumVertices();
+}
+
+//----------------------------------------------------------
+void ofGLDrawBatch::setMaxVertices(std::size_t maxVertices){
+	this->maxVertices = maxVertices;
+	if(mesh.getNumVertices() > maxVertices){
+		flush();
+	}
+}
+
+//----------------------------------------------------------
+std::size_t ofGLDrawBatch::getMaxVertices() const{
+	return maxVertices;
+}
+
+//----------------------------------------------------------
+void ofGLDrawBatch::countDrawCall(){
+	currentFrame.drawCalls++;
+}
+
+//----------------------------------------------------------
+void ofGLDrawBatch::newFrame(){
+	lastFrame = currentFrame;
+	currentFrame = ofGLDrawStats();
+}
+
+//----------------------------------------------------------
+const ofGLDrawStats & ofGLDrawBatch::getLastFrameStats() const{
+	return lastFrame;
+}
+
+//----------------------------------------------------------
+const ofGLDrawStats & ofGLDrawBatch::getCurrentFrameStats() const{
+	return currentFrame;
+}
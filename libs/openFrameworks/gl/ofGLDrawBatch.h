@@ -0,0 +1,87 @@
+#pragma once
+
+#include "ofMesh.h"
+#include <functional>
+
+/// \brief Draw call counters of a frame.
+struct ofGLDrawStats{
+	std::size_t drawCalls = 0; ///< draw calls sent to GL, a flushed batch is one
+	std::size_t flushes = 0; ///< batches drawn
+	std::size_t batchedPrimitives = 0; ///< shapes recorded in a batch instead of drawn one by one
+	std::size_t batchedVertices = 0; ///< vertices drawn by the flushed batches
+};
+
+/// \brief Records 2D shapes in one mesh so they can be drawn with a single
+/// upload and draw call.
+///
+/// The vertices are transformed by the model view matrix of each shape and
+/// carry its color, so changing the matrix or the color between shapes
+/// doesn't split the batch. Filled shapes and lines can't be mixed, adding
+/// a different kind of shape, or lines with a different width, flushes
+/// what was recorded before so the drawing order is kept. Any other change
+/// of state has to flush the batch before it's applied, the renderer does
+/// that.
+///
+/// The batch doesn't use GL, flushing calls the flush function with the
+/// recorded mesh in eye space and the renderer draws it.
+class ofGLDrawBatch{
+public:
+	ofGLDrawBatch();
+
+	/// \brief Sets the function that draws the recorded mesh when flushing.
+	void setFlushFunction(std::function<void(const ofMesh & mesh)> flushFunction);
+
+	/// \brief Records a filled shape.
+	///
+	/// \param mode OF_PRIMITIVE_TRIANGLES, OF_PRIMITIVE_TRIANGLE_STRIP or
+	/// OF_PRIMITIVE_TRIANGLE_FAN
+	void addTriangles(const glm::vec3 * vertices, std::size_t numVertices, ofPrimitiveMode mode, const glm::mat4 & modelView, const ofFloatColor & color);
+
+	/// \brief Records lines, strips and loops are split in separate
+	/// segments.
+	///
+	/// \param mode OF_PRIMITIVE_LINES, OF_PRIMITIVE_LINE_STRIP or
+	/// OF_PRIMITIVE_LINE_LOOP
+	void addLines(const glm::vec3 * vertices, std::size_t numVertices, ofPrimitiveMode mode, const glm::mat4 & modelView, const ofFloatColor & color, float lineWidth);
+
+	/// \brief Draws the recorded shapes through the flush function and
+	/// empties the batch.
+	void flush();
+
+	/// \brief Discards the recorded shapes without drawing them.
+	void clear();
+
+	bool isEmpty() const;
+	bool isFlushing() const;
+	std::size_t getNumVertices() const;
+
+	/// \brief Vertices recorded before the batch flushes itself, 65536 by
+	/// default so the indices fit in 16 bits on OpenGL ES.
+	void setMaxVertices(std::size_t maxVertices);
+	std::size_t getMaxVertices() const;
+
+	/// \brief Counts a draw call of the renderer, batched or not.
+	void countDrawCall();
+
+	/// \brief Starts counting a new frame, the counters so far become the
+	/// last frame ones.
+	void newFrame();
+
+	/// \returns the counters of the last complete frame
+	const ofGLDrawStats & getLastFrameStats() const;
+
+	/// \returns the counters of the frame being drawn
+	const ofGLDrawStats & getCurrentFrameStats() const;
+
+private:
+	void prepare(ofPrimitiveMode mode, std::size_t numVertices, float lineWidth);
+	void addVertex(const glm::vec3 & vertex, const glm::mat4 & modelView, const ofFloatColor & color);
+
+	std::function<void(const ofMesh & mesh)> flushFunction;
+	ofMesh mesh;
+	float lineWidth;
+	std::size_t maxVertices;
+	bool flushing;
+	ofGLDrawStats currentFrame;
+	ofGLDrawStats lastFrame;
+};
@@ -80,6 +80,11 @@ ofGLProgrammableRenderer::ofGLProgrammableRenderer(const ofAppBaseWindow * _wind
 	path.setMode(ofPath::POLYLINES);
 	path.setUseShapeColor(false);
 	currentEyePos = { 0.f, 0.f, 0.f };
+
+	batchingEnabled = false;
+	batch.setFlushFunction([this](const ofMesh & mesh){
+		drawBatch(mesh);
+	});
 }
 
 //----------------------------------------------------------
@@ -105,6 +110,8 @@ void ofGLProgrammableRenderer::startRender() {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::finishRender() {
+	flushBatch();
+	batch.newFrame();
 	if (!uniqueShader) {
 		glUseProgram(0);
 		if (!usingCustomShader) currentShader = nullptr;
@@ -119,6 +126,10 @@ void ofGLProgrammableRenderer::finishRender() {
 void ofGLProgrammableRenderer::draw(const ofMesh & vertexData, ofPolyRenderMode renderType, bool useColors, bool useTextures, bool useNormals) const {
 	if (vertexData.getVertices().empty()) return;
 
+	// the batch is drawn through meshVbo, flush it before it's replaced by
+	// this mesh. Does nothing when this is the batch being flushed
+	flushBatch();
+
 		// tig: note that for GL3+ we use glPolygonMode to draw wireframes or filled meshes, and not the primitive mode.
 		// the reason is not purely aesthetic, but more conformant with the behaviour of ofGLRenderer. Whereas
 		// gles2.0 doesn't allow for a polygonmode.
@@ -179,6 +190,7 @@ void ofGLProgrammableRenderer::draw(const ofMesh & vertexData, ofPolyRenderMode
 	} else {
 		glDrawArrays(drawMode, 0, vertexData.getNumVertices());
 	}
+	batch.countDrawCall();
 #else
 	
 	ofVbo* vboToRender = nullptr;
@@ -303,6 +315,8 @@ void ofGLProgrammableRenderer::draw(const ofVboMesh & mesh, ofPolyRenderMode ren
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::drawInstanced(const ofVboMesh & mesh, ofPolyRenderMode renderType, int primCount) const {
 	if (mesh.getNumVertices() == 0) return;
+	// before the polygon mode changes, the batch is always filled
+	flushBatch();
 	GLuint mode = ofGetGLPrimitiveMode(mesh.getMode());
 	// nh: if the render type is different than the primitive mode
 	// ie. mesh mode is triangles but we called mesh.drawVertices() which uses GL_POINT for the render type
@@ -401,6 +415,7 @@ void ofGLProgrammableRenderer::draw(const ofPolyline & poly) const {
 
 #if defined(TARGET_OPENGLES) && !defined(TARGET_EMSCRIPTEN)
 
+	flushBatch();
 	glEnableVertexAttribArray(ofShader::POSITION_ATTRIBUTE);
 	glVertexAttribPointer(ofShader::POSITION_ATTRIBUTE, 3, GL_FLOAT, GL_FALSE, sizeof(typename ofPolyline::VertexType), &poly[0]);
 
@@ -410,9 +425,20 @@ void ofGLProgrammableRenderer::draw(const ofPolyline & poly) const {
 	const_cast<ofGLProgrammableRenderer *>(this)->setAttributes(true, false, false, false, drawMode);
 
 	glDrawArrays(drawMode, 0, poly.size());
+	batch.countDrawCall();
 
 #else
 	
+	auto numBatchVertices = poly.size();
+	// closed polylines can repeat the first vertex at the end
+	if (poly.isClosed() && numBatchVertices > 1 && poly.getVertices().front() == poly.getVertices().back()) {
+		numBatchVertices--;
+	}
+	if (addToBatch(poly.getVertices().data(), numBatchVertices, poly.isClosed() ? OF_PRIMITIVE_LINE_LOOP : OF_PRIMITIVE_LINE_STRIP)) {
+		return;
+	}
+	flushBatch();
+
 //	polylineMesh.clear();
 //	polylineMesh.addVertices(poly.getVertices());
 	
@@ -489,6 +515,7 @@ void ofGLProgrammableRenderer::draw(const ofPath & shape) const {
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::draw(const ofImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const {
 	if (image.isUsingTexture()) {
+		flushBatch();
 		const_cast<ofGLProgrammableRenderer *>(this)->setAttributes(true, false, true, false, GL_TRIANGLES);
 		const ofTexture & tex = image.getTexture();
 		if (tex.isAllocated()) {
@@ -504,6 +531,7 @@ void ofGLProgrammableRenderer::draw(const ofImage & image, float x, float y, flo
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::draw(const ofFloatImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const {
 	if (image.isUsingTexture()) {
+		flushBatch();
 		const_cast<ofGLProgrammableRenderer *>(this)->setAttributes(true, false, true, false, GL_TRIANGLES);
 		const ofTexture & tex = image.getTexture();
 		if (tex.isAllocated()) {
@@ -519,6 +547,7 @@ void ofGLProgrammableRenderer::draw(const ofFloatImage & image, float x, float y
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::draw(const ofShortImage & image, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const {
 	if (image.isUsingTexture()) {
+		flushBatch();
 		const_cast<ofGLProgrammableRenderer *>(this)->setAttributes(true, false, true, false, GL_TRIANGLES);
 		const ofTexture & tex = image.getTexture();
 		if (tex.isAllocated()) {
@@ -533,6 +562,7 @@ void ofGLProgrammableRenderer::draw(const ofShortImage & image, float x, float y
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::draw(const ofTexture & tex, float x, float y, float z, float w, float h, float sx, float sy, float sw, float sh) const {
+	flushBatch();
 	const_cast<ofGLProgrammableRenderer *>(this)->setAttributes(true, false, true, false, GL_TRIANGLES);
 	if (tex.isAllocated()) {
 		const_cast<ofGLProgrammableRenderer *>(this)->bind(tex, 0);
@@ -556,9 +586,11 @@ void ofGLProgrammableRenderer::draw(const ofBaseVideoDraws & video, float x, flo
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::draw(const ofVbo & vbo, GLuint drawMode, int first, int total) const {
 	if (vbo.getUsingVerts()) {	
+		flushBatch();
 		vbo.bind();
 		const_cast<ofGLProgrammableRenderer *>(this)->setAttributes(vbo.getUsingVerts(), vbo.getUsingColors(), vbo.getUsingTexCoords(), vbo.getUsingNormals(), drawMode);
 		glDrawArrays(drawMode, first, total);
+		batch.countDrawCall();
 		vbo.unbind();
 	}
 }
@@ -566,6 +598,7 @@ void ofGLProgrammableRenderer::draw(const ofVbo & vbo, GLuint drawMode, int firs
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::drawElements(const ofVbo & vbo, GLuint drawMode, int amt, int offsetelements) const {
 	if (vbo.getUsingVerts()) {
+		flushBatch();
 		vbo.bind();
 		const_cast<ofGLProgrammableRenderer *>(this)->setAttributes(vbo.getUsingVerts(), vbo.getUsingColors(), vbo.getUsingTexCoords(), vbo.getUsingNormals(), drawMode);
 #ifdef TARGET_OPENGLES
@@ -573,6 +606,7 @@ void ofGLProgrammableRenderer::drawElements(const ofVbo & vbo, GLuint drawMode,
 #else
 		glDrawElements(drawMode, amt, GL_UNSIGNED_INT, (void *)(sizeof(ofIndexType) * offsetelements));
 #endif
+		batch.countDrawCall();
 		vbo.unbind();
 	}
 }
@@ -580,6 +614,7 @@ void ofGLProgrammableRenderer::drawElements(const ofVbo & vbo, GLuint drawMode,
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::drawInstanced(const ofVbo & vbo, GLuint drawMode, int first, int total, int primCount) const {
 	if (vbo.getUsingVerts()) {
+		flushBatch();
 		vbo.bind();
 		const_cast<ofGLProgrammableRenderer *>(this)->setAttributes(vbo.getUsingVerts(), vbo.getUsingColors(), vbo.getUsingTexCoords(), vbo.getUsingNormals(), drawMode);
 #ifdef TARGET_OPENGLES
@@ -590,6 +625,7 @@ void ofGLProgrammableRenderer::drawInstanced(const ofVbo & vbo, GLuint drawMode,
 		// glDrawArraysInstanced(drawMode, first, total, primCount);
 #else
 		glDrawArraysInstanced(drawMode, first, total, primCount);
+		batch.countDrawCall();
 #endif
 		vbo.unbind();
 	}
@@ -598,6 +634,7 @@ void ofGLProgrammableRenderer::drawInstanced(const ofVbo & vbo, GLuint drawMode,
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::drawElementsInstanced(const ofVbo & vbo, GLuint drawMode, int amt, int primCount) const {
 	if (vbo.getUsingVerts()) {
+		flushBatch();
 		vbo.bind();
 		const_cast<ofGLProgrammableRenderer *>(this)->setAttributes(vbo.getUsingVerts(), vbo.getUsingColors(), vbo.getUsingTexCoords(), vbo.getUsingNormals(), drawMode);
 #if defined(TARGET_OPENGLES) && !defined(TARGET_EMSCRIPTEN) // TODO: Check against OPENGL_ES Version
@@ -612,6 +649,7 @@ void ofGLProgrammableRenderer::drawElementsInstanced(const ofVbo & vbo, GLuint d
 		#else
 		glDrawElementsInstanced(drawMode, amt, GL_UNSIGNED_INT, nullptr, primCount);
 		#endif
+		batch.countDrawCall();
 #endif
 		vbo.unbind();
 	}
@@ -624,6 +662,7 @@ ofPath & ofGLProgrammableRenderer::getPath() {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::bind(const ofBaseVideoDraws & video) {
+	flushBatch();
 	if (!video.isInitialized() || !video.isUsingTexture() || video.getTexturePlanes().empty()) {
 		return;
 	}
@@ -644,6 +683,7 @@ void ofGLProgrammableRenderer::bind(const ofBaseVideoDraws & video) {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::unbind(const ofBaseVideoDraws & video) {
+	flushBatch();
 	if (!video.isInitialized() || !video.isUsingTexture() || video.getTexturePlanes().empty()) {
 		return;
 	}
@@ -657,11 +697,13 @@ void ofGLProgrammableRenderer::unbind(const ofBaseVideoDraws & video) {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::pushView() {
+	flushBatch();
 	matrixStack.pushView();
 }
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::popView() {
+	flushBatch();
 	matrixStack.popView();
 	uploadMatrices();
 	viewport(matrixStack.getCurrentViewport());
@@ -674,6 +716,7 @@ void ofGLProgrammableRenderer::viewport(ofRectangle viewport_) {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::viewport(float x, float y, float width, float height, bool vflip) {
+	flushBatch();
 	matrixStack.viewport(x, y, width, height, vflip);
 	ofRectangle nativeViewport = matrixStack.getNativeViewport();
 	glViewport(nativeViewport.x, nativeViewport.y, nativeViewport.width, nativeViewport.height);
@@ -716,6 +759,7 @@ ofHandednessType ofGLProgrammableRenderer::getCoordHandedness() const {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::setOrientation(ofOrientation orientation, bool vFlip) {
+	flushBatch();
 	matrixStack.setOrientation(orientation, vFlip);
 	uploadMatrices();
 }
@@ -830,6 +874,7 @@ void ofGLProgrammableRenderer::pushMatrix() {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::popMatrix() {
+	flushBatchBeforeProjectionChange();
 	matrixStack.popMatrix();
 	uploadCurrentMatrix();
 }
@@ -841,18 +886,21 @@ void ofGLProgrammableRenderer::translate(const glm::vec3 & p) {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::translate(float x, float y, float z) {
+	flushBatchBeforeProjectionChange();
 	matrixStack.translate(x, y, z);
 	uploadCurrentMatrix();
 }
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::scale(float xAmnt, float yAmnt, float zAmnt) {
+	flushBatchBeforeProjectionChange();
 	matrixStack.scale(xAmnt, yAmnt, zAmnt);
 	uploadCurrentMatrix();
 }
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::rotateRad(float radians, float vecX, float vecY, float vecZ) {
+	flushBatchBeforeProjectionChange();
 	matrixStack.rotateRad(radians, vecX, vecY, vecZ);
 	uploadCurrentMatrix();
 }
@@ -885,12 +933,14 @@ void ofGLProgrammableRenderer::matrixMode(ofMatrixMode mode) {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::loadIdentityMatrix(void) {
+	flushBatchBeforeProjectionChange();
 	matrixStack.loadIdentityMatrix();
 	uploadCurrentMatrix();
 }
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::loadMatrix(const glm::mat4 & m) {
+	flushBatchBeforeProjectionChange();
 	matrixStack.loadMatrix(m);
 	uploadCurrentMatrix();
 }
@@ -902,6 +952,7 @@ void ofGLProgrammableRenderer::loadMatrix(const float * m) {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::multMatrix(const glm::mat4 & m) {
+	flushBatchBeforeProjectionChange();
 	matrixStack.multMatrix(m);
 	uploadCurrentMatrix();
 }
@@ -1036,11 +1087,13 @@ void ofGLProgrammableRenderer::setBitmapTextMode(ofDrawBitmapMode mode) {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::clear() {
+	flushBatch();
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::clear(float r, float g, float b, float a) {
+	flushBatch();
 	glClearColor(r, g, b, a);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
@@ -1052,6 +1105,7 @@ void ofGLProgrammableRenderer::clear(float brightness, float a) {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::clearAlpha() {
+	flushBatch();
 	glColorMask(0, 0, 0, 1);
 	glClearColor(0, 0, 0, 1);
 	glClear(GL_COLOR_BUFFER_BIT);
@@ -1081,6 +1135,7 @@ void ofGLProgrammableRenderer::setBackgroundColor(const ofFloatColor & c) {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::background(const ofFloatColor & c) {
+	flushBatch();
 	setBackgroundColor(c);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
@@ -1151,6 +1206,9 @@ void ofGLProgrammableRenderer::setLineWidth(float lineWidth) {
 	// INVALID_VALUE error".
 	// use geometry shaders to draw lines of varying thickness...
 
+	if (lineWidth != currentStyle.lineWidth) {
+		flushBatch();
+	}
 	currentStyle.lineWidth = lineWidth;
 	if (!currentStyle.bFill) {
 		path.setStrokeWidth(lineWidth);
@@ -1166,6 +1224,7 @@ void ofGLProgrammableRenderer::setPointSize(float pointSize) {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::setDepthTest(bool depthTest) {
+	flushBatch();
 	if (depthTest) {
 		glEnable(GL_DEPTH_TEST);
 	} else {
@@ -1190,6 +1249,9 @@ void ofGLProgrammableRenderer::endSmoothing() {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::setBlendMode(ofBlendMode blendMode) {
+	if (blendMode != currentStyle.blendingMode) {
+		flushBatch();
+	}
 	switch (blendMode) {
 	case OF_BLENDMODE_DISABLED:
 		glDisable(GL_BLEND);
@@ -1276,6 +1338,7 @@ void ofGLProgrammableRenderer::disablePointSprites() {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::enableAntiAliasing() {
+	flushBatch();
 #if !defined(TARGET_PROGRAMMABLE_GL) || !defined(TARGET_OPENGLES)
 	glEnable(GL_MULTISAMPLE);
 #endif
@@ -1283,6 +1346,7 @@ void ofGLProgrammableRenderer::enableAntiAliasing() {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::disableAntiAliasing() {
+	flushBatch();
 #if !defined(TARGET_PROGRAMMABLE_GL) || !defined(TARGET_OPENGLES)
 	glDisable(GL_MULTISAMPLE);
 #endif
@@ -1290,20 +1354,24 @@ void ofGLProgrammableRenderer::disableAntiAliasing() {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::enableLineSizeAttenuation() {
+	flushBatch();
 	mBLineSizeAttenutation = true;
 }
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::disableLineSizeAttenuation() {
+	flushBatch();
 	mBLineSizeAttenutation = false;
 }
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::enableLinesShaders() {
+	flushBatch();
 	mBEnableLinesShaders = true;
 }
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::disableLinesShaders() {
+	flushBatch();
 	mBEnableLinesShaders = false;
 }
 
@@ -1563,6 +1631,7 @@ void ofGLProgrammableRenderer::disableAlphaMask() {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::bind(const ofShader & shader) {
+	flushBatch();
 	if (currentShader && *currentShader == shader) {
 		return;
 	}
@@ -1591,6 +1660,7 @@ void ofGLProgrammableRenderer::bind(const ofShader & shader) {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::unbind(const ofShader & shader) {
+	flushBatch();
 	glUseProgram(0);
 	usingCustomShader = false;
 	bCustomShadowShader = false;
@@ -1599,6 +1669,7 @@ void ofGLProgrammableRenderer::unbind(const ofShader & shader) {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::begin(const ofFbo & fbo, ofFboMode mode) {
+	flushBatch();
 	pushView();
 	pushStyle();
 	if (mode & OF_FBOMODE_MATRIXFLIP) {
@@ -1617,6 +1688,7 @@ void ofGLProgrammableRenderer::begin(const ofFbo & fbo, ofFboMode mode) {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::end(const ofFbo & fbo) {
+	flushBatch();
 	unbind(fbo);
 	matrixStack.setRenderSurface(*window);
 	uploadMatrices();
@@ -1626,6 +1698,7 @@ void ofGLProgrammableRenderer::end(const ofFbo & fbo) {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::bind(const ofFbo & fbo) {
+	flushBatch();
 	if (currentFramebufferId == fbo.getId()) {
 		ofLogWarning() << "Framebuffer with id: " << fbo.getId() << " cannot be bound onto itself. \n"
 					   << "Most probably you forgot to end() the current framebuffer before calling begin() again or you forgot to allocate() before calling begin().";
@@ -1644,6 +1717,7 @@ void ofGLProgrammableRenderer::bind(const ofFbo & fbo) {
 #ifndef TARGET_OPENGLES
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::bindForBlitting(const ofFbo & fboSrc, ofFbo & fboDst, int attachmentPoint) {
+	flushBatch();
 	if (currentFramebufferId == fboSrc.getId()) {
 		ofLogWarning() << "Framebuffer with id: " << fboSrc.getId() << " cannot be bound onto itself. \n"
 					   << "Most probably you forgot to end() the current framebuffer before calling getTexture().";
@@ -1665,6 +1739,7 @@ void ofGLProgrammableRenderer::bindForBlitting(const ofFbo & fboSrc, ofFbo & fbo
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::unbind(const ofFbo & fbo) {
+	flushBatch();
 	if (framebufferIdStack.empty()) {
 		ofLogError() << "unbalanced fbo bind/unbind binding default framebuffer";
 		currentFramebufferId = defaultFramebufferId;
@@ -1678,6 +1753,7 @@ void ofGLProgrammableRenderer::unbind(const ofFbo & fbo) {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::bind(const ofBaseMaterial & material) {
+	flushBatch();
 	if (bIsShadowDepthPass && !material.hasDepthShader()) {
 		//		currentMaterial = nullptr;
 		// we are the shadow depth pass right now, we don't need
@@ -1695,6 +1771,7 @@ void ofGLProgrammableRenderer::bind(const ofBaseMaterial & material) {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::bind(const ofShadow & shadow) {
+	flushBatch();
 	currentShadow = &shadow;
 	bIsShadowDepthPass = true;
 	beginDefaultShader();
@@ -1702,12 +1779,14 @@ void ofGLProgrammableRenderer::bind(const ofShadow & shadow) {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::bind(const ofShadow & shadow, GLenum aCubeFace) {
+	flushBatch();
 	shadowCubeFace = aCubeFace;
 	bind(shadow);
 }
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::unbind(const ofBaseMaterial &) {
+	flushBatch();
 	if (currentMaterial) {
 		currentMaterial->unbind(*this);
 	}
@@ -1722,6 +1801,7 @@ void ofGLProgrammableRenderer::unbind(const ofBaseMaterial &) {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::unbind(const ofShadow & shadow) {
+	flushBatch();
 	currentShadow = nullptr;
 	bIsShadowDepthPass = false;
 	bCustomShadowShader = false;
@@ -1730,6 +1810,7 @@ void ofGLProgrammableRenderer::unbind(const ofShadow & shadow) {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::unbind(const ofShadow & shadow, GLenum aCubeFace) {
+	flushBatch();
 	unbind(shadow);
 }
 
@@ -1756,6 +1837,7 @@ bool ofGLProgrammableRenderer::getLightingEnabled() {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::bind(const ofTexture & texture, int location) {
+	flushBatch();
 	//we could check if it has been allocated - but we don't do that in draw()
 	if (texture.getAlphaMask()) {
 		setAlphaMaskTex(*texture.getAlphaMask());
@@ -1787,6 +1869,7 @@ void ofGLProgrammableRenderer::bind(const ofTexture & texture, int location) {
 
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::unbind(const ofTexture & texture, int location) {
+	flushBatch();
 	disableTextureTarget(texture.texData.textureTarget, location);
 	if (texture.getAlphaMask()) {
 		disableAlphaMask();
@@ -1965,6 +2048,9 @@ void ofGLProgrammableRenderer::drawLine(float x1, float y1, float z1, float x2,
 	ofGLProgrammableRenderer * mutThis = const_cast<ofGLProgrammableRenderer *>(this);
 	lineMesh.getVertices()[0] = { x1, y1, z1 };
 	lineMesh.getVertices()[1] = { x2, y2, z2 };
+	if (addToBatch(lineMesh.getVertices(), OF_PRIMITIVE_LINES)) {
+		return;
+	}
 
 	// use smoothness, if requested:
 	if (currentStyle.smoothing) mutThis->startSmoothing();
@@ -1989,6 +2075,9 @@ void ofGLProgrammableRenderer::drawRectangle(float x, float y, float z, float w,
 		rectMesh.getVertices()[2] = { x + w / 2.0f, y + h / 2.0f, z };
 		rectMesh.getVertices()[3] = { x - w / 2.0f, y + h / 2.0f, z };
 	}
+	if (addToBatch(rectMesh.getVertices(), currentStyle.bFill ? OF_PRIMITIVE_TRIANGLE_FAN : OF_PRIMITIVE_LINE_LOOP)) {
+		return;
+	}
 
 	// use smoothness, if requested:
 	if (currentStyle.smoothing && !currentStyle.bFill) mutThis->startSmoothing();
@@ -2006,6 +2095,9 @@ void ofGLProgrammableRenderer::drawTriangle(float x1, float y1, float z1, float
 	triangleMesh.getVertices()[0] = { x1, y1, z1 };
 	triangleMesh.getVertices()[1] = { x2, y2, z2 };
 	triangleMesh.getVertices()[2] = { x3, y3, z3 };
+	if (addToBatch(triangleMesh.getVertices(), currentStyle.bFill ? OF_PRIMITIVE_TRIANGLES : OF_PRIMITIVE_LINE_LOOP)) {
+		return;
+	}
 
 	// use smoothness, if requested:
 	if (currentStyle.smoothing && !currentStyle.bFill) mutThis->startSmoothing();
@@ -2030,15 +2122,19 @@ void ofGLProgrammableRenderer::drawCircle(float x, float y, float z, float radiu
 		for (int i = 0; i < (int)circleCache.size(); i++) {
 			circleOutlineMesh.getVertices()[i] = { radius * circleCache[i].x + x, radius * circleCache[i].y + y, z };
 		}
-		circleOutlineMesh.setMode(OF_PRIMITIVE_LINE_LOOP);
-		draw(circleOutlineMesh, OF_MESH_FILL, false, false, false);
+		if (!addToBatch(circleOutlineMesh.getVertices(), OF_PRIMITIVE_LINE_LOOP)) {
+			circleOutlineMesh.setMode(OF_PRIMITIVE_LINE_LOOP);
+			draw(circleOutlineMesh, OF_MESH_FILL, false, false, false);
+		}
 	} else {
 		const auto & circleCache = circlePolyline.getVertices();
 		for (int i = 0; i < (int)circleCache.size(); i++) {
 			circleMesh.getVertices()[i] = { radius * circleCache[i].x + x, radius * circleCache[i].y + y, z };
 		}
-		circleMesh.setMode(currentStyle.bFill ? OF_PRIMITIVE_TRIANGLE_FAN : OF_PRIMITIVE_LINE_STRIP);
-		draw(circleMesh, OF_MESH_FILL, false, false, false);
+		if (!addToBatch(circleMesh.getVertices(), OF_PRIMITIVE_TRIANGLE_FAN)) {
+			circleMesh.setMode(currentStyle.bFill ? OF_PRIMITIVE_TRIANGLE_FAN : OF_PRIMITIVE_LINE_STRIP);
+			draw(circleMesh, OF_MESH_FILL, false, false, false);
+		}
 	}
 	
 //	circleMesh.setMode(currentStyle.bFill ? OF_PRIMITIVE_TRIANGLE_FAN : OF_PRIMITIVE_LINE_STRIP);
@@ -2068,15 +2164,19 @@ void ofGLProgrammableRenderer::drawEllipse(float x, float y, float z, float widt
 		for (int i = 0; i < (int)circleCache.size(); i++) {
 			circleOutlineMesh.getVertices()[i] = { radiusX * circleCache[i].x + x, radiusY * circleCache[i].y + y, z };
 		}
-		circleOutlineMesh.setMode(OF_PRIMITIVE_LINE_LOOP);
-		draw(circleOutlineMesh, OF_MESH_FILL, false, false, false);
+		if (!addToBatch(circleOutlineMesh.getVertices(), OF_PRIMITIVE_LINE_LOOP)) {
+			circleOutlineMesh.setMode(OF_PRIMITIVE_LINE_LOOP);
+			draw(circleOutlineMesh, OF_MESH_FILL, false, false, false);
+		}
 	} else {
 		const auto & circleCache = circlePolyline.getVertices();
 		for (int i = 0; i < (int)circleCache.size(); i++) {
 			circleMesh.getVertices()[i] = { radiusX * circleCache[i].x + x, radiusY * circleCache[i].y + y, z };
 		}
-		circleMesh.setMode(currentStyle.bFill ? OF_PRIMITIVE_TRIANGLE_FAN : OF_PRIMITIVE_LINE_STRIP);
-		draw(circleMesh, OF_MESH_FILL, false, false, false);
+		if (!addToBatch(circleMesh.getVertices(), OF_PRIMITIVE_TRIANGLE_FAN)) {
+			circleMesh.setMode(currentStyle.bFill ? OF_PRIMITIVE_TRIANGLE_FAN : OF_PRIMITIVE_LINE_STRIP);
+			draw(circleMesh, OF_MESH_FILL, false, false, false);
+		}
 	}
 
 //	circleMesh.setMode(currentStyle.bFill ? OF_PRIMITIVE_TRIANGLE_FAN : OF_PRIMITIVE_LINE_STRIP);
@@ -2086,6 +2186,95 @@ void ofGLProgrammableRenderer::drawEllipse(float x, float y, float z, float widt
 	if (currentStyle.smoothing && !currentStyle.bFill) mutThis->endSmoothing();
 }
 
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::setBatchingEnabled(bool enabled) {
+	if (!enabled) {
+		flushBatch();
+	}
+	batchingEnabled = enabled;
+}
+
+//----------------------------------------------------------
+bool ofGLProgrammableRenderer::isBatchingEnabled() const {
+	return batchingEnabled;
+}
+
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::flushBatch() const {
+	batch.flush();
+}
+
+//----------------------------------------------------------
+const ofGLDrawStats & ofGLProgrammableRenderer::getLastFrameStats() const {
+	return batch.getLastFrameStats();
+}
+
+//----------------------------------------------------------
+const ofGLDrawStats & ofGLProgrammableRenderer::getCurrentFrameStats() const {
+	return batch.getCurrentFrameStats();
+}
+
+//----------------------------------------------------------
+bool ofGLProgrammableRenderer::addToBatch(const std::vector<glm::vec3> & vertices, ofPrimitiveMode mode) const {
+	return addToBatch(vertices.data(), vertices.size(), mode);
+}
+
+//----------------------------------------------------------
+bool ofGLProgrammableRenderer::addToBatch(const glm::vec3 * vertices, std::size_t numVertices, ofPrimitiveMode mode) const {
+	// only shapes drawn with the default shaders and no textures
+	if (!batchingEnabled || usingCustomShader || uniqueShader || currentMaterial || currentShadow
+		|| currentTextureTarget != OF_NO_TEXTURE || alphaMaskTextureTarget != OF_NO_TEXTURE || bitmapStringEnabled) {
+		return false;
+	}
+
+	switch (mode) {
+	case OF_PRIMITIVE_TRIANGLES:
+	case OF_PRIMITIVE_TRIANGLE_FAN:
+	case OF_PRIMITIVE_TRIANGLE_STRIP:
+		batch.addTriangles(vertices, numVertices, mode, matrixStack.getModelViewMatrix(), currentStyle.color);
+		return true;
+	case OF_PRIMITIVE_LINE_STRIP:
+	case OF_PRIMITIVE_LINE_LOOP:
+		// the lines shader joins the segments of strips and loops, as
+		// separate lines they would look different
+		if (areLinesShadersEnabled()) {
+			return false;
+		}
+		batch.addLines(vertices, numVertices, mode, matrixStack.getModelViewMatrix(), currentStyle.color, currentStyle.lineWidth);
+		return true;
+	case OF_PRIMITIVE_LINES:
+		batch.addLines(vertices, numVertices, mode, matrixStack.getModelViewMatrix(), currentStyle.color, currentStyle.lineWidth);
+		return true;
+	default:
+		return false;
+	}
+}
+
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::drawBatch(const ofMesh & mesh) const {
+	ofGLProgrammableRenderer * mutThis = const_cast<ofGLProgrammableRenderer *>(this);
+
+	// the vertices are already transformed by the model view matrix
+	auto matrixMode = matrixStack.getCurrentMatrixMode();
+	mutThis->matrixStack.matrixMode(OF_MATRIX_MODELVIEW);
+	mutThis->matrixStack.pushMatrix();
+	mutThis->matrixStack.loadIdentityMatrix();
+	mutThis->uploadMatrices();
+
+	draw(mesh, OF_MESH_FILL, true, false, false);
+
+	mutThis->matrixStack.popMatrix();
+	mutThis->matrixStack.matrixMode(matrixMode);
+	mutThis->uploadMatrices();
+}
+
+//----------------------------------------------------------
+void ofGLProgrammableRenderer::flushBatchBeforeProjectionChange() {
+	if (matrixStack.getCurrentMatrixMode() == OF_MATRIX_PROJECTION) {
+		flushBatch();
+	}
+}
+
 //----------------------------------------------------------
 void ofGLProgrammableRenderer::drawString(string textString, float x, float y, float z) const {
 	ofGLProgrammableRenderer * mutThis = const_cast<ofGLProgrammableRenderer *>(this);
@@ -2240,8 +2429,10 @@ void ofGLProgrammableRenderer::drawString(const ofTrueTypeFont & font, string te
 
 	mutThis->setBlendMode(OF_BLENDMODE_ALPHA);
 
+	// the mesh first, it can add glyphs to the font texture
+	auto & mesh = font.getStringMesh(text, x, y, isVFlipped());
 	mutThis->bind(font.getFontTexture(), 0);
-	draw(font.getStringMesh(text, x, y, isVFlipped()), OF_MESH_FILL);
+	draw(mesh, OF_MESH_FILL);
 	mutThis->unbind(font.getFontTexture(), 0);
 
 	mutThis->setBlendMode(blendMode);
@@ -3533,6 +3724,7 @@ void ofGLProgrammableRenderer::saveFullViewport(ofPixels & pixels) {
 }
 
 void ofGLProgrammableRenderer::saveScreen(int x, int y, int w, int h, ofPixels & pixels) {
+	flushBatch();
 	int sh = getViewportHeight();
 
 #ifndef TARGET_OPENGLES
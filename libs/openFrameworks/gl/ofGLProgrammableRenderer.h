@@ -8,6 +8,7 @@
 #include "ofPolyline.h"
 #include "ofBitmapFont.h"
 #include "ofPath.h"
+#include "ofGLDrawBatch.h"
 
 class ofShapeTessellation;
 class ofFbo;
@@ -179,6 +180,30 @@ public:
 	void drawString(std::string text, float x, float y, float z) const;
 	void drawString(const ofTrueTypeFont & font, std::string text, float x, float y) const;
 
+	/// \brief Records the lines, rectangles, triangles, circles and
+	/// ellipses drawn from now on in a batch instead of drawing them one by
+	/// one.
+	///
+	/// The batch is drawn with a single draw call when anything other
+	/// than the color or the model view matrix changes, or when something
+	/// that isn't batched is drawn. Only shapes drawn with the default
+	/// shaders and no texture are batched. Outlines and polylines are
+	/// recorded as separate lines so they are only batched when the lines
+	/// shaders are disabled, the lines shaders join their segments.
+	///
+	/// Call flushBatch() before using GL directly. Disabled by default.
+	void setBatchingEnabled(bool enabled);
+	bool isBatchingEnabled() const;
+
+	/// \brief Draws the shapes recorded in the batch so far.
+	void flushBatch() const;
+
+	/// \returns the draw calls and batch flushes of the last frame
+	const ofGLDrawStats & getLastFrameStats() const;
+
+	/// \returns the draw calls and batch flushes so far in this frame
+	const ofGLDrawStats & getCurrentFrameStats() const;
+
 
 	void enableTextureTarget(const ofTexture & tex, int textureLocation);
 	void disableTextureTarget(int textureTarget, int textureLocation);
@@ -263,6 +288,8 @@ private:
 	mutable ofMesh lineMesh;
 	mutable ofVbo meshVbo;
 	mutable ofMesh polylineMesh;
+	mutable ofGLDrawBatch batch;
+	bool batchingEnabled;
 
 	// when adding more draw modes, POINTS, LINES, etc.
 	// store in a structure so we don't have to create a lot of variables
@@ -304,6 +331,11 @@ private:
 
 	void uploadCurrentMatrix();
 
+	bool addToBatch(const std::vector<glm::vec3> & vertices, ofPrimitiveMode mode) const;
+	bool addToBatch(const glm::vec3 * vertices, std::size_t numVertices, ofPrimitiveMode mode) const;
+	void drawBatch(const ofMesh & mesh) const;
+	void flushBatchBeforeProjectionChange();
+
 
 	void startSmoothing();
 	void endSmoothing();
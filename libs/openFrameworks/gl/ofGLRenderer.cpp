@@ -1719,8 +1719,10 @@ void ofGLRenderer::drawString(const ofTrueTypeFont & font, std::string text, flo
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
+	// the mesh first, it can add glyphs to the font texture
+	auto & mesh = font.getStringMesh(text, x, y, isVFlipped());
 	mutThis->bind(font.getFontTexture(), 0);
-	draw(font.getStringMesh(text, x, y, isVFlipped()), OF_MESH_FILL);
+	draw(mesh, OF_MESH_FILL);
 	mutThis->unbind(font.getFontTexture(), 0);
 
 	if (!blendEnabled) {
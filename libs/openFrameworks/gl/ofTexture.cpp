@@ -616,6 +616,74 @@ void ofTexture::loadData(const ofFloatPixels & pix){
 	}
 }
 
+//----------------------------------------------------------
+static int getGLType(const ofConstPixelsView & view){
+#ifndef TARGET_OPENGLES
+	if(view.getPixelFormat() == OF_PIXELS_RGB565){
+		return GL_UNSIGNED_SHORT_5_6_5;
+	}
+#endif
+	return GL_UNSIGNED_BYTE;
+}
+
+static int getGLType(const ofConstShortPixelsView &){
+	return GL_UNSIGNED_SHORT;
+}
+
+static int getGLType(const ofConstFloatPixelsView &){
+	return GL_FLOAT;
+}
+
+//----------------------------------------------------------
+template<typename PixelType>
+static void loadPixelsView(ofTexture & tex, const ofPixelsView_<const PixelType> & view){
+	if(!view.isAllocated()) return;
+
+	bool canUploadDirectly = view.getPixelStep() == view.getNumChannels();
+#ifdef TARGET_OPENGLES
+	// no GL_UNPACK_ROW_LENGTH on ES 2
+	canUploadDirectly = canUploadDirectly && view.isContinuous();
+#endif
+	if(!canUploadDirectly){
+		ofPixels_<PixelType> pixels;
+		view.copyTo(pixels);
+		tex.loadData(pixels);
+		return;
+	}
+
+	int glFormat = ofGetGLFormatFromPixelFormat(view.getPixelFormat());
+	int glType = getGLType(view);
+	if(!tex.isAllocated()){
+		tex.allocate(view.getWidth(), view.getHeight(), ofGetGLInternalFormatFromPixelFormat(view.getPixelFormat()), ofGetUsingArbTex(), glFormat, glType);
+		if((view.getPixelFormat()==OF_PIXELS_GRAY || view.getPixelFormat()==OF_PIXELS_GRAY_ALPHA) && ofIsGLProgrammableRenderer()){
+			tex.setRGToRGBASwizzles(true);
+		}
+	}
+	ofSetPixelStoreiAlignment(GL_UNPACK_ALIGNMENT, view.getBytesStride());
+#ifndef TARGET_OPENGLES
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, view.getStride() / view.getPixelStep());
+#endif
+	tex.loadData(view.getData(), view.getWidth(), view.getHeight(), glFormat, glType);
+#ifndef TARGET_OPENGLES
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+}
+
+//----------------------------------------------------------
+void ofTexture::loadData(const ofConstPixelsView & pix){
+	loadPixelsView(*this, pix);
+}
+
+//----------------------------------------------------------
+void ofTexture::loadData(const ofConstShortPixelsView & pix){
+	loadPixelsView(*this, pix);
+}
+
+//----------------------------------------------------------
+void ofTexture::loadData(const ofConstFloatPixelsView & pix){
+	loadPixelsView(*this, pix);
+}
+
 //----------------------------------------------------------
 void ofTexture::loadData(const ofPixels & pix, int glFormat){
 	if(!isAllocated()){
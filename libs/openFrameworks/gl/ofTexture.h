@@ -21,6 +21,12 @@ typedef ofPixels_<unsigned char> ofPixels;
 typedef ofPixels_<unsigned short> ofShortPixels;
 typedef ofPixels_<float> ofFloatPixels;
 
+template<typename T>
+class ofPixelsView_;
+typedef ofPixelsView_<const unsigned char> ofConstPixelsView;
+typedef ofPixelsView_<const unsigned short> ofConstShortPixelsView;
+typedef ofPixelsView_<const float> ofConstFloatPixelsView;
+
 class ofTexture;
 class ofBufferObject;
 
@@ -531,6 +537,25 @@ class ofTexture : public ofBaseDraws {
 	/// \param pix Reference to ofFloatPixels instance.
 	void loadData(const ofFloatPixels & pix);
 
+	/// \brief Load pixels from a view, like a region of interest of a bigger
+	/// image, without copying them first.
+	///
+	/// Views of a single channel and, on OpenGL ES, views with padding
+	/// between rows can't be uploaded directly and are copied first.
+	///
+	/// \param pix Reference to an ofPixelsView.
+	void loadData(const ofConstPixelsView & pix);
+
+	/// \brief Load pixels from an ofShortPixelsView.
+	///
+	/// \sa loadData(const ofConstPixelsView & pix)
+	void loadData(const ofConstShortPixelsView & pix);
+
+	/// \brief Load pixels from an ofFloatPixelsView.
+	///
+	/// \sa loadData(const ofConstPixelsView & pix)
+	void loadData(const ofConstFloatPixelsView & pix);
+
 	/// \brief Load pixels from an ofPixels instance and specify the format.
 	///
 	/// glFormat can be different to the internal format of the texture on each
@@ -4,6 +4,8 @@
 #include "ofFileUtils.h"
 
 #include <FreeImage.h>
+#include <atomic>
+#include <mutex>
 
 #include "ofURLFileLoader.h"
 #include <uriparser/Uri.h>
@@ -18,14 +20,21 @@
 void ofInitFreeImage(bool deinit=false){
 	// need a new bool to avoid c++ "deinitialization order fiasco":
 	// http://www.parashift.com/c++-faq-lite/ctors.html#faq-10.15
-	static bool	* bFreeImageInited = new bool(false);
+	static std::atomic<bool> * bFreeImageInited = new std::atomic<bool>(false);
+	// images can be loaded from several threads, the first one initializes
+	// FreeImage while the others wait for it
+	static std::mutex * initMutex = new std::mutex;
+	if(!deinit && bFreeImageInited->load(std::memory_order_acquire)){
+		return;
+	}
+	std::unique_lock<std::mutex> lock(*initMutex);
 	if(!*bFreeImageInited && !deinit){
 		FreeImage_Initialise();
-		*bFreeImageInited = true;
+		bFreeImageInited->store(true, std::memory_order_release);
 	}
 	if(*bFreeImageInited && deinit){
 		FreeImage_DeInitialise();
-		*bFreeImageInited = false;
+		bFreeImageInited->store(false, std::memory_order_release);
 	}
 }
 
@@ -1133,6 +1142,13 @@ void ofImage_<PixelType>::setFromPixels(const ofPixels_<PixelType> & pixels){
 	setFromPixels(pixels.getData(),pixels.getWidth(),pixels.getHeight(),pixels.getImageType());
 }
 
+//------------------------------------
+template<typename PixelType>
+void ofImage_<PixelType>::setFromPixels(const ofPixelsView_<const PixelType> & view){
+	pixels.setFromPixels(view);
+	update();
+}
+
 //------------------------------------
 template<typename PixelType>
 ofImage_<PixelType> & ofImage_<PixelType>::operator=(ofPixels_<PixelType> & pixels){
@@ -490,6 +490,13 @@ public:
     /// to be unsigned chars.
     void setFromPixels(const ofPixels_<PixelType> & pixels);
 
+    /// \brief Set the pixels of the image from a view, like a region of
+    /// interest or a single channel of other pixels.
+    ///
+    /// The image only reallocates if the size or format of the view is
+    /// different from the current one.
+    void setFromPixels(const ofPixelsView_<const PixelType> & pixels);
+
     /// \brief Grabs pixels from the opengl window specified by the region
     /// (x, y, w, h) and turns them into an image.
     ///
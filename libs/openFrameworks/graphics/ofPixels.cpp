@@ -1,6 +1,8 @@
 #include "ofGraphicsConstants.h"
 #include "ofPixels.h"
 #include "ofColor.h"
+#include "ofTaskPool.h"
+#include <glm/gtc/constants.hpp>
 
 static ofImageType getImageTypeFromChannels(size_t channels){
 	switch(channels){
@@ -398,7 +400,7 @@ void ofPixels_<PixelType>::setFromExternalPixels(PixelType * newPixels, size_t w
 	width = w;
 	height = h;
 
-	pixelsSize = w * h * getNumChannels();
+	pixelsSize = std::max(w * h * getNumChannels(), (bytesFromPixelFormat(w, h, _pixelFormat) + sizeof(PixelType) - 1) / sizeof(PixelType));
 
 	pixels = newPixels;
 	pixelsOwner = false;
@@ -532,7 +534,9 @@ void ofPixels_<PixelType>::allocate(size_t w, size_t h, ofPixelFormat format){
 	width 		= w;
 	height 		= h;
 
-	pixelsSize = w * h * getNumChannels();
+	// the 4:2:0 YUV formats have half a byte of chroma per pixel on top of
+	// their single luma channel
+	pixelsSize = std::max(w * h * getNumChannels(), (bytesFromPixelFormat(w, h, format) + sizeof(PixelType) - 1) / sizeof(PixelType));
 
 	// we have some incongruence here, if we use PixelType
 	// we are not able to use RGB565 format
@@ -551,32 +555,19 @@ template<typename PixelType>
 void ofPixels_<PixelType>::swapRgb(){
 	switch(pixelFormat){
 	case OF_PIXELS_RGB:
-	case OF_PIXELS_BGR:
-	case OF_PIXELS_RGBA:
-	case OF_PIXELS_BGRA:{
-		for(auto pixel: getPixelsIter()){
-			std::swap(pixel[0],pixel[2]);
-		}
-	}
-	break;
-	default:
-		ofLogWarning("ofPixels") << "rgb swap not supported for this pixel format";
-		break;
-	}
-	switch(pixelFormat){
-	case OF_PIXELS_RGB:
-		pixelFormat = OF_PIXELS_BGR;
+		setPixelFormat(OF_PIXELS_BGR);
 		break;
 	case OF_PIXELS_BGR:
-		pixelFormat = OF_PIXELS_RGB;
+		setPixelFormat(OF_PIXELS_RGB);
 		break;
 	case OF_PIXELS_RGBA:
-		pixelFormat = OF_PIXELS_BGRA;
+		setPixelFormat(OF_PIXELS_BGRA);
 		break;
 	case OF_PIXELS_BGRA:
-		pixelFormat = OF_PIXELS_RGBA;
+		setPixelFormat(OF_PIXELS_RGBA);
 		break;
 	default:
+		ofLogWarning("ofPixels") << "rgb swap not supported for this pixel format";
 		break;
 	}
 }
@@ -957,30 +948,7 @@ ofImageType ofPixels_<PixelType>::getImageType() const{
 template<typename PixelType>
 void ofPixels_<PixelType>::setImageType(ofImageType imageType){
 	if(!isAllocated() || imageType==getImageType()) return;
-	ofPixels_<PixelType> dst;
-	dst.allocate(width,height,imageType);
-	PixelType * dstPtr = &dst[0];
-	PixelType * srcPtr = &pixels[0];
-	size_t dstNumChannels = dst.getNumChannels();
-	size_t srcNumChannels = getNumChannels();
-	size_t diffNumChannels = 0;
-	if(dstNumChannels<srcNumChannels){
-		diffNumChannels = srcNumChannels-dstNumChannels;
-	}
-	for(size_t i=0;i<width*height;i++){
-		const PixelType & gray = *srcPtr;
-		for(size_t j=0;j<dstNumChannels;j++){
-			if(j<srcNumChannels){
-				*dstPtr++ =  *srcPtr++;
-			}else if(j<3){
-				*dstPtr++ = gray;
-			}else{
-				*dstPtr++ = ofColor_<PixelType>::limit();
-			}
-		}
-		srcPtr+=diffNumChannels;
-	}
-	swap(dst);
+	setPixelFormat(ofPixelFormatFromImageType(imageType));
 }
 
 template<typename PixelType>
@@ -1334,6 +1302,206 @@ float ofPixels_<PixelType>::bicubicInterpolate (const float *patch, float x,floa
 	return std::min(static_cast<size_t>(255), std::max(static_cast<size_t>(out), static_cast<size_t>(0)));
 }
 
+//----------------------------------------------------------------------
+// Separable resampling used by the bilinear, area and lanczos modes.
+//
+// Every destination pixel along one axis is a weighted sum of a fixed
+// number of consecutive source pixels, so the weights are computed once
+// per axis. Rows are first filtered horizontally into a float buffer and
+// then combined vertically, both loops running over contiguous memory so
+// the compiler can vectorize them.
+struct ofResampleAxis{
+	size_t taps = 0;
+	std::vector<size_t> first;
+	std::vector<float> weights;
+};
+
+static float lanczos3(float x){
+	x = std::abs(x);
+	if(x < std::numeric_limits<float>::epsilon()) return 1.f;
+	if(x >= 3.f) return 0.f;
+	float pix = glm::pi<float>() * x;
+	return 3.f * std::sin(pix) * std::sin(pix / 3.f) / (pix * pix);
+}
+
+static ofResampleAxis computeResampleAxis(size_t srcLen, size_t dstLen, ofInterpolationMethod interpMethod){
+	ofResampleAxis axis;
+	float scale = float(srcLen) / float(dstLen);
+
+	if(interpMethod == OF_INTERPOLATE_AREA){
+		// weight of each source pixel is how much of it the
+		// destination pixel footprint covers
+		axis.taps = std::min(srcLen, size_t(std::ceil(scale)) + 1);
+	}else{
+		float support = interpMethod == OF_INTERPOLATE_LANCZOS ? 3.f * std::max(1.f, scale) : 1.f;
+		axis.taps = std::min(srcLen, size_t(std::ceil(support * 2.f)) + 1);
+	}
+
+	axis.first.resize(dstLen);
+	axis.weights.assign(dstLen * axis.taps, 0.f);
+	for(size_t i = 0; i < dstLen; i++){
+		float * weights = axis.weights.data() + i * axis.taps;
+		float total = 0;
+		if(interpMethod == OF_INTERPOLATE_AREA){
+			float start = i * scale;
+			float end = start + scale;
+			size_t first = std::min(size_t(start), srcLen - axis.taps);
+			axis.first[i] = first;
+			for(size_t t = 0; t < axis.taps; t++){
+				float pixStart = float(first + t);
+				float covered = std::min(end, pixStart + 1.f) - std::max(start, pixStart);
+				weights[t] = std::max(covered, 0.f);
+				total += weights[t];
+			}
+		}else{
+			float center = (i + 0.5f) * scale - 0.5f;
+			float filterScale = interpMethod == OF_INTERPOLATE_LANCZOS ? std::max(1.f, scale) : 1.f;
+			float support = interpMethod == OF_INTERPOLATE_LANCZOS ? 3.f * filterScale : 1.f;
+			long firstLong = long(std::ceil(center - support));
+			size_t first = size_t(glm::clamp(firstLong, 0l, long(srcLen - axis.taps)));
+			axis.first[i] = first;
+			for(long j = firstLong; j <= long(std::floor(center + support)); j++){
+				float x = (j - center) / filterScale;
+				float w = interpMethod == OF_INTERPOLATE_LANCZOS ? lanczos3(x) : std::max(0.f, 1.f - std::abs(x));
+				// samples outside the image repeat the edge
+				size_t src = size_t(glm::clamp(j, 0l, long(srcLen - 1)));
+				weights[src - first] += w;
+				total += w;
+			}
+		}
+		if(total != 0){
+			for(size_t t = 0; t < axis.taps; t++){
+				weights[t] /= total;
+			}
+		}
+	}
+	return axis;
+}
+
+template<typename PixelType>
+static inline PixelType resampledValue(float value){
+	if(std::is_floating_point<PixelType>::value){
+		return PixelType(value);
+	}
+	double v = std::round(double(value));
+	if(v <= double(std::numeric_limits<PixelType>::lowest())) return std::numeric_limits<PixelType>::lowest();
+	if(v >= double(std::numeric_limits<PixelType>::max())) return std::numeric_limits<PixelType>::max();
+	return PixelType(v);
+}
+
+// Channels is 0 for channel counts without a specialized loop or for
+// sources with padding between pixels, in which case the runtime number
+// of channels and pixel step are used instead.
+template<typename PixelType, size_t Channels>
+static void resampleRows(const ofPixelsView_<const PixelType> & src, PixelType * dst, size_t dstWidth, const ofResampleAxis & xAxis, const ofResampleAxis & yAxis, size_t dstRowStart, size_t dstRowEnd){
+	const size_t channels = Channels ? Channels : src.getNumChannels();
+	const size_t pixelStep = Channels ? Channels : src.getPixelStep();
+	const size_t rowLen = dstWidth * channels;
+	const size_t srcRowStart = yAxis.first[dstRowStart];
+	const size_t srcRowEnd = yAxis.first[dstRowEnd - 1] + yAxis.taps;
+
+	std::vector<float> horizontal((srcRowEnd - srcRowStart) * rowLen);
+	for(size_t srcY = srcRowStart; srcY < srcRowEnd; srcY++){
+		const PixelType * srcRow = src.getLine(srcY);
+		float * out = horizontal.data() + (srcY - srcRowStart) * rowLen;
+		for(size_t x = 0; x < dstWidth; x++){
+			const PixelType * srcPix = srcRow + xAxis.first[x] * pixelStep;
+			const float * weights = xAxis.weights.data() + x * xAxis.taps;
+			float * outPix = out + x * channels;
+			for(size_t c = 0; c < channels; c++){
+				outPix[c] = 0;
+			}
+			for(size_t t = 0; t < xAxis.taps; t++){
+				const float w = weights[t];
+				for(size_t c = 0; c < channels; c++){
+					outPix[c] += w * float(srcPix[t * pixelStep + c]);
+				}
+			}
+		}
+	}
+
+	std::vector<float> accum(rowLen);
+	for(size_t dstY = dstRowStart; dstY < dstRowEnd; dstY++){
+		const float * weights = yAxis.weights.data() + dstY * yAxis.taps;
+		const float * in = horizontal.data() + (yAxis.first[dstY] - srcRowStart) * rowLen;
+		std::fill(accum.begin(), accum.end(), 0.f);
+		for(size_t t = 0; t < yAxis.taps; t++){
+			const float w = weights[t];
+			const float * inRow = in + t * rowLen;
+			for(size_t i = 0; i < rowLen; i++){
+				accum[i] += w * inRow[i];
+			}
+		}
+		PixelType * dstRow = dst + dstY * rowLen;
+		for(size_t i = 0; i < rowLen; i++){
+			dstRow[i] = resampledValue<PixelType>(accum[i]);
+		}
+	}
+}
+
+template<typename PixelType>
+static bool resampleSeparable(const ofPixelsView_<const PixelType> & src, ofPixels_<PixelType> & dst, ofInterpolationMethod interpMethod){
+	switch(src.getPixelFormat()){
+	case OF_PIXELS_RGB565:
+	case OF_PIXELS_NV12:
+	case OF_PIXELS_NV21:
+	case OF_PIXELS_YV12:
+	case OF_PIXELS_I420:
+	case OF_PIXELS_YUY2:
+	case OF_PIXELS_UYVY:
+	case OF_PIXELS_UNKNOWN:
+	case OF_PIXELS_NATIVE:
+		ofLogError("ofPixels") << "resizeTo(): can't filter pixel format " << ofToString(src.getPixelFormat()) << ", not resizing";
+		return false;
+	default:
+		break;
+	}
+
+	const size_t dstWidth = dst.getWidth();
+	const size_t numChannels = src.getNumChannels();
+	const ofResampleAxis xAxis = computeResampleAxis(src.getWidth(), dstWidth, interpMethod);
+	const ofResampleAxis yAxis = computeResampleAxis(src.getHeight(), dst.getHeight(), interpMethod);
+	PixelType * dstPixels = dst.getData();
+
+	std::function<void(size_t, size_t)> processRows;
+	switch(src.getPixelStep() == numChannels ? numChannels : 0){
+	case 1:
+		processRows = [&](size_t start, size_t end){
+			resampleRows<PixelType, 1>(src, dstPixels, dstWidth, xAxis, yAxis, start, end);
+		};
+		break;
+	case 2:
+		processRows = [&](size_t start, size_t end){
+			resampleRows<PixelType, 2>(src, dstPixels, dstWidth, xAxis, yAxis, start, end);
+		};
+		break;
+	case 3:
+		processRows = [&](size_t start, size_t end){
+			resampleRows<PixelType, 3>(src, dstPixels, dstWidth, xAxis, yAxis, start, end);
+		};
+		break;
+	case 4:
+		processRows = [&](size_t start, size_t end){
+			resampleRows<PixelType, 4>(src, dstPixels, dstWidth, xAxis, yAxis, start, end);
+		};
+		break;
+	default:
+		processRows = [&](size_t start, size_t end){
+			resampleRows<PixelType, 0>(src, dstPixels, dstWidth, xAxis, yAxis, start, end);
+		};
+		break;
+	}
+
+	// each output row costs a vertical pass plus its share of the
+	// horizontal one, roughly proportional to the number of taps
+	size_t workPerRow = dstWidth * numChannels * (xAxis.taps + yAxis.taps);
+	// bands of at least ~64K samples, smaller ones aren't worth the
+	// overhead of running in another thread
+	size_t rowsPerBand = std::max(size_t(1), (size_t(1) << 16) / std::max(size_t(1), workPerRow));
+	ofGetTaskPool().parallelForRanges(0, dst.getHeight(), processRows, rowsPerBand);
+	return true;
+}
+
 //----------------------------------------------------------------------
 template<typename PixelType>
 bool ofPixels_<PixelType>::resizeTo(ofPixels_<PixelType>& dst, ofInterpolationMethod interpMethod) const{
@@ -1378,9 +1546,9 @@ bool ofPixels_<PixelType>::resizeTo(ofPixels_<PixelType>& dst, ofInterpolationMe
 
 			//----------------------------------------
 		case OF_INTERPOLATE_BILINEAR:
-			// not implemented yet
-			ofLogError("ofPixels") << "resizeTo(): bilinear resize not implemented, not resizing";
-			break;
+		case OF_INTERPOLATE_AREA:
+		case OF_INTERPOLATE_LANCZOS:
+			return resampleSeparable(getView(), dst, interpMethod);
 
 			//----------------------------------------
 		case OF_INTERPOLATE_BICUBIC:
@@ -1518,6 +1686,147 @@ bool ofPixels_<PixelType>::blendInto(ofPixels_<PixelType> &dst, size_t xTo, size
 }
 
 
+//----------------------------------------------------------------------
+template<typename PixelType>
+void ofPixels_<PixelType>::setFromPixels(const ofPixelsView_<const PixelType> & view){
+	view.copyTo(*this);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType> ofPixels_<PixelType>::getPlaneView(size_t planeIdx){
+	auto plane = getPlane(planeIdx);
+	return ofPixelsView_<PixelType>(plane.getData(), plane.getWidth(), plane.getHeight(), plane.getPixelFormat());
+}
+
+//----------------------------------------------------------------------
+// views only describe one plane of interleaved values, so planar
+// formats are seen through their first plane
+static ofPixelFormat viewPixelFormat(ofPixelFormat pixelFormat){
+	switch(pixelFormat){
+	case OF_PIXELS_NV12:
+	case OF_PIXELS_NV21:
+	case OF_PIXELS_YV12:
+	case OF_PIXELS_I420:
+		return OF_PIXELS_Y;
+	default:
+		return pixelFormat;
+	}
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType>::ofPixelsView_(){}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType>::ofPixelsView_(PixelType * data, size_t width, size_t height, ofPixelFormat pixelFormat)
+:data(data)
+,width(width)
+,height(height)
+,pixelFormat(viewPixelFormat(pixelFormat)){
+	numChannels = channelsFromPixelFormat(this->pixelFormat);
+	pixelStep = numChannels;
+	stride = width * numChannels;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType>::ofPixelsView_(PixelType * data, size_t width, size_t height, ofPixelFormat pixelFormat, size_t stride, size_t pixelStep)
+:data(data)
+,width(width)
+,height(height)
+,stride(stride)
+,pixelStep(pixelStep)
+,pixelFormat(viewPixelFormat(pixelFormat)){
+	numChannels = channelsFromPixelFormat(this->pixelFormat);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType>::ofPixelsView_(ofPixels_<value_type> & pixels)
+:ofPixelsView_(pixels.getData(), pixels.getWidth(), pixels.getHeight(), pixels.getPixelFormat()){}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType> ofPixelsView_<PixelType>::getROI(size_t x, size_t y, size_t _width, size_t _height) const{
+	x = std::min(x, width);
+	y = std::min(y, height);
+	_width = std::min(_width, width - x);
+	_height = std::min(_height, height - y);
+	return ofPixelsView_<PixelType>(getPixel(x, y), _width, _height, pixelFormat, stride, pixelStep);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType> ofPixelsView_<PixelType>::getChannel(size_t channel) const{
+	if(numChannels == 0) return ofPixelsView_<PixelType>();
+	channel = glm::clamp(channel, size_t(0), numChannels-1);
+	return ofPixelsView_<PixelType>(data + channel, width, height, OF_PIXELS_GRAY, stride, pixelStep);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+bool ofPixelsView_<PixelType>::copyTo(ofPixels_<value_type> & dst) const{
+	if(!isAllocated()) return false;
+	if(dst.getWidth() != width || dst.getHeight() != height || dst.getPixelFormat() != pixelFormat){
+		dst.allocate(width, height, pixelFormat);
+	}
+	return pasteInto(dst, 0, 0);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+bool ofPixelsView_<PixelType>::pasteInto(ofPixels_<value_type> & dst, size_t x, size_t y) const{
+	if(!isAllocated() || !dst.isAllocated() || dst.getNumChannels() != numChannels || x + width > dst.getWidth() || y + height > dst.getHeight()) return false;
+
+	const size_t dstStride = dst.getWidth() * numChannels;
+	value_type * dstLine = dst.getData() + y * dstStride + x * numChannels;
+	if(isContinuous() && dst.getWidth() == width){
+		memcpy(dstLine, data, width * height * numChannels * sizeof(value_type));
+		return true;
+	}
+
+	for(size_t line = 0; line < height; line++, dstLine += dstStride){
+		const PixelType * src = getLine(line);
+		if(pixelStep == numChannels){
+			memcpy(dstLine, src, width * numChannels * sizeof(value_type));
+		}else{
+			value_type * dstPixel = dstLine;
+			for(size_t i = 0; i < width; i++, src += pixelStep){
+				for(size_t c = 0; c < numChannels; c++){
+					*dstPixel++ = src[c];
+				}
+			}
+		}
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+bool ofPixelsView_<PixelType>::resizeTo(ofPixels_<value_type> & dst, ofInterpolationMethod interpMethod) const{
+	if(!isAllocated() || !dst.isAllocated() || dst.getNumChannels() != numChannels) return false;
+
+	switch(interpMethod){
+	case OF_INTERPOLATE_BILINEAR:
+	case OF_INTERPOLATE_AREA:
+	case OF_INTERPOLATE_LANCZOS:
+		return resampleSeparable(ofPixelsView_<const value_type>(*this), dst, interpMethod);
+	default:{
+		ofPixels_<value_type> src;
+		if(isContinuous()){
+			// resizeTo() doesn't write to the source so wrapping the
+			// data without copying it is safe even for const views
+			src.setFromExternalPixels(const_cast<value_type*>(data), width, height, pixelFormat);
+		}else{
+			copyTo(src);
+		}
+		return src.resizeTo(dst, interpMethod);
+	}
+	}
+}
+
 template class ofPixels_<char>;
 template class ofPixels_<unsigned char>;
 template class ofPixels_<short>;
@@ -1528,3 +1837,24 @@ template class ofPixels_<long>;
 template class ofPixels_<unsigned long>;
 template class ofPixels_<float>;
 template class ofPixels_<double>;
+
+template class ofPixelsView_<char>;
+template class ofPixelsView_<unsigned char>;
+template class ofPixelsView_<short>;
+template class ofPixelsView_<unsigned short>;
+template class ofPixelsView_<int>;
+template class ofPixelsView_<unsigned int>;
+template class ofPixelsView_<long>;
+template class ofPixelsView_<unsigned long>;
+template class ofPixelsView_<float>;
+template class ofPixelsView_<double>;
+template class ofPixelsView_<const char>;
+template class ofPixelsView_<const unsigned char>;
+template class ofPixelsView_<const short>;
+template class ofPixelsView_<const unsigned short>;
+template class ofPixelsView_<const int>;
+template class ofPixelsView_<const unsigned int>;
+template class ofPixelsView_<const long>;
+template class ofPixelsView_<const unsigned long>;
+template class ofPixelsView_<const float>;
+template class ofPixelsView_<const double>;
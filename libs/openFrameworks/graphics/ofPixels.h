@@ -56,7 +56,15 @@ typedef ofColor_<unsigned short> ofShortColor;
 enum ofInterpolationMethod {
 	OF_INTERPOLATE_NEAREST_NEIGHBOR =1,
 	OF_INTERPOLATE_BILINEAR			=2,
-	OF_INTERPOLATE_BICUBIC			=3
+	OF_INTERPOLATE_BICUBIC			=3,
+	/// \brief Averages every source pixel covered by a destination pixel.
+	///
+	/// This is the best choice for downscaling, e.g. generating thumbnails.
+	OF_INTERPOLATE_AREA				=4,
+	/// \brief Windowed sinc filter with 3 lobes.
+	///
+	/// Sharper than bilinear, at the cost of some ringing around hard edges.
+	OF_INTERPOLATE_LANCZOS			=5
 };
 
 
@@ -156,6 +164,20 @@ enum ofPixelFormat: short{
 #define OF_PIXELS_R OF_PIXELS_GRAY
 #define OF_PIXELS_RG OF_PIXELS_GRAY_ALPHA
 
+/// \brief Color matrix used when converting between YUV and RGB formats.
+///
+/// Also selects the luma weights used when converting color to gray.
+///
+/// \sa ofPixels_::convertTo
+enum ofYUVMatrix{
+	/// \brief ITU-R BT.601, limited range. Standard definition video.
+	OF_YUV_MATRIX_BT601,
+	/// \brief ITU-R BT.709, limited range. High definition video.
+	OF_YUV_MATRIX_BT709,
+	/// \brief ITU-R BT.601, full range as used by JPEG.
+	OF_YUV_MATRIX_JPEG
+};
+
 template<typename T>
 std::string ofToString(const T & v);
 template<>
@@ -163,6 +185,9 @@ std::string ofToString(const ofPixelFormat & pixelType);
 
 enum ofImageType: short;
 
+template<typename PixelType>
+class ofPixelsView_;
+
 /// \brief A class representing a collection of pixels.
 template <typename PixelType>
 class ofPixels_ {
@@ -245,6 +270,12 @@ public:
 	/// \brief used to copy i420 pixels from gstreamer when (width % 4) != 0
 	void setFromAlignedPixels(const PixelType * newPixels, size_t width, size_t height, ofPixelFormat pixelFormat, std::vector<size_t> strides);
 
+	/// \brief Copy the pixels described by a view, for example a region of
+	/// interest or a single channel of another image.
+	///
+	/// Only reallocates if the size or format of the view is different.
+	void setFromPixels(const ofPixelsView_<const PixelType> & view);
+
 	void swap(ofPixels_<PixelType> & pix);
 
 	/// \}
@@ -261,7 +292,8 @@ public:
 	/// at the `x` and `y` and width the new width and height.
 	///
 	/// As a word of caution this reallocates memory and can be a bit
-	/// expensive if done a lot.
+	/// expensive if done a lot. If the cropped pixels are only read,
+	/// getView().getROI() gives access to them without copying.
 	void cropTo(ofPixels_<PixelType> &toPix, size_t x, size_t y, size_t width, size_t height) const;
 
 	// crop to a new width and height, this reallocates memory.
@@ -281,6 +313,12 @@ public:
 	///     OF_INTERPOLATE_NEAREST_NEIGHBOR
 	///     OF_INTERPOLATE_BILINEAR
 	///     OF_INTERPOLATE_BICUBIC
+	///     OF_INTERPOLATE_AREA
+	///     OF_INTERPOLATE_LANCZOS
+	///
+	/// Bilinear, area and lanczos are separable filters that process big
+	/// images in bands of rows on several threads. They only work with
+	/// interleaved formats, not with planar or packed YUV ones.
 	bool resize(size_t dstWidth, size_t dstHeight, ofInterpolationMethod interpMethod=OF_INTERPOLATE_NEAREST_NEIGHBOR);
 
 	/// \brief Resize the ofPixels instance to the size of the ofPixels object passed in dst.
@@ -290,6 +328,8 @@ public:
 	///     OF_INTERPOLATE_NEAREST_NEIGHBOR
 	///     OF_INTERPOLATE_BILINEAR
 	///     OF_INTERPOLATE_BICUBIC
+	///     OF_INTERPOLATE_AREA
+	///     OF_INTERPOLATE_LANCZOS
 	bool resizeTo(ofPixels_<PixelType> & dst, ofInterpolationMethod interpMethod=OF_INTERPOLATE_NEAREST_NEIGHBOR) const;
 
 	/// \brief Paste the ofPixels object into another ofPixels object at the
@@ -304,6 +344,31 @@ public:
 	/// image, leaving the G and A channels as is.
 	void swapRgb();
 
+	/// \brief Convert the pixels to a different pixel format.
+	///
+	/// Converts between any of the interleaved formats (GRAY, GRAY_ALPHA,
+	/// RGB, BGR, RGBA and BGRA) for every pixel type. 8 bit pixels can also
+	/// be converted from and to RGB565, and from and to NV12, NV21, I420,
+	/// YV12, YUY2 and UYVY as long as the width and height are even.
+	///
+	/// Color is converted to gray using the luma weights of the passed
+	/// matrix, alpha is set to opaque when the source has none. dst is
+	/// reallocated if its size or format don't match.
+	///
+	/// \param dst Destination pixels, can be this same object.
+	/// \param dstFormat Pixel format to convert to.
+	/// \param matrix Color matrix used for YUV and gray conversions.
+	/// \returns true if the conversion is supported and succeeded.
+	bool convertTo(ofPixels_<PixelType> & dst, ofPixelFormat dstFormat, ofYUVMatrix matrix = OF_YUV_MATRIX_BT601) const;
+
+	/// \brief Convert the pixels to a different pixel format in place.
+	///
+	/// Conversions between interleaved formats with the same number of
+	/// channels don't allocate any memory.
+	///
+	/// \sa convertTo
+	bool setPixelFormat(ofPixelFormat dstFormat, ofYUVMatrix matrix = OF_YUV_MATRIX_BT601);
+
 	/// \}
 	/// \name Pixels Access
 	/// \{
@@ -398,12 +463,32 @@ public:
 
 	ofPixels_<PixelType> getPlane(size_t plane);
 
+	/// \brief Get a view of the whole pixels without copying them.
+	///
+	/// For planar formats like NV12 or I420 the view covers the first
+	/// plane, use getPlaneView() to access the rest.
+	ofPixelsView_<PixelType> getView();
+	ofPixelsView_<const PixelType> getView() const;
+
+	/// \brief Get a view of one of the planes of a planar format without
+	/// copying it.
+	///
+	/// ~~~~{.cpp}
+	///     // luma and interleaved chroma of an NV12 frame
+	///     ofPixelsView y = nv12.getPlaneView(0);
+	///     ofPixelsView uv = nv12.getPlaneView(1);
+	/// ~~~~
+	ofPixelsView_<PixelType> getPlaneView(size_t plane);
+
 	/// \brief Get all values of one channel
 	///
 	/// For instance, the Red pixel values, from the
 	/// ofPixels object, this gives you a grayscale representation of the
 	/// specific channel
 	///
+	/// This allocates new pixels, getView().getChannel() gives access to
+	/// the same values without copying them.
+	///
 	/// ~~~~{.cpp}
 	///     // Get red pixels
 	/// 	ofPixels rpix = pix.getChannel(0);
@@ -437,6 +522,9 @@ public:
 
 	/// \brief Changes the image type for the ofPixels object
 	///
+	/// Converts with setPixelFormat to GRAY, RGB or RGBA, so color becomes
+	/// gray using the BT.601 luma weights.
+	///
 	/// \param imageType Can be one of the following: OF_IMAGE_GRAYSCALE, OF_IMAGE_COLOR, OF_IMAGE_COLOR_ALPHA
 	void setImageType(ofImageType imageType);
 
@@ -700,6 +788,121 @@ typedef ofPixels& ofPixelsRef;
 typedef ofFloatPixels& ofFloatPixelsRef;
 typedef ofShortPixels& ofShortPixelsRef;
 
+
+/// \brief A non-owning view into pixels stored somewhere else.
+///
+/// A view describes a rectangle of pixels with an arbitrary distance
+/// between rows (stride) and between consecutive pixels (pixel step), so a
+/// region of interest, a single channel of an interleaved image or a plane
+/// of a YUV frame can be passed around without copying:
+///
+/// ~~~~{.cpp}
+/// ofPixels frame;
+/// // ...
+/// ofPixelsView roi = frame.getView().getROI(100, 100, 320, 240);
+/// ofPixelsView green = roi.getChannel(1);
+/// texture.loadData(roi);
+/// ~~~~
+///
+/// A view never allocates or frees memory, the pixels it points to have to
+/// outlive it. Use the const variants (ofConstPixelsView...) for read
+/// only access, any view converts implicitly to its const variant and
+/// ofPixels converts implicitly to both.
+///
+/// Views only describe interleaved pixels, planar formats need to be
+/// accessed plane by plane through ofPixels_::getPlaneView().
+template<typename PixelType>
+class ofPixelsView_{
+public:
+	typedef typename std::remove_const<PixelType>::type value_type;
+
+	ofPixelsView_();
+
+	/// \brief View over tightly packed pixels.
+	ofPixelsView_(PixelType * data, size_t width, size_t height, ofPixelFormat pixelFormat);
+
+	/// \brief View over pixels with padding between rows or pixels.
+	/// \param stride Number of values (not bytes) from one row to the next.
+	/// \param pixelStep Number of values from one pixel to the next.
+	ofPixelsView_(PixelType * data, size_t width, size_t height, ofPixelFormat pixelFormat, size_t stride, size_t pixelStep);
+
+	ofPixelsView_(ofPixels_<value_type> & pixels);
+
+	template<typename T = PixelType, typename std::enable_if<std::is_const<T>::value, int>::type = 0>
+	ofPixelsView_(const ofPixels_<value_type> & pixels)
+	:ofPixelsView_(pixels.getData(), pixels.getWidth(), pixels.getHeight(), pixels.getPixelFormat()){}
+
+	template<typename T = PixelType, typename std::enable_if<std::is_const<T>::value, int>::type = 0>
+	ofPixelsView_(const ofPixelsView_<value_type> & view)
+	:data(view.getData())
+	,width(view.getWidth())
+	,height(view.getHeight())
+	,stride(view.getStride())
+	,pixelStep(view.getPixelStep())
+	,numChannels(view.getNumChannels())
+	,pixelFormat(view.getPixelFormat()){}
+
+	bool isAllocated() const;
+
+	PixelType * getData() const;
+	PixelType * getLine(size_t y) const;
+	PixelType * getPixel(size_t x, size_t y) const;
+
+	size_t getWidth() const;
+	size_t getHeight() const;
+	size_t getNumChannels() const;
+	ofPixelFormat getPixelFormat() const;
+
+	/// \brief Number of values from the beginning of one row to the next.
+	size_t getStride() const;
+	size_t getBytesStride() const;
+
+	/// \brief Number of values from the beginning of one pixel to the next.
+	///
+	/// This is bigger than getNumChannels() for views of single channels.
+	size_t getPixelStep() const;
+
+	/// \brief Whether the pixels are laid out as in an ofPixels, so they can
+	/// be copied with a single memcpy.
+	bool isContinuous() const;
+
+	/// \brief View of a rectangle inside this view, clamped to its bounds.
+	ofPixelsView_<PixelType> getROI(size_t x, size_t y, size_t width, size_t height) const;
+
+	/// \brief View of a single channel as a grayscale image.
+	ofPixelsView_<PixelType> getChannel(size_t channel) const;
+
+	/// \brief Copy the viewed pixels into dst, allocating it only if its size
+	/// or format are different.
+	bool copyTo(ofPixels_<value_type> & dst) const;
+
+	/// \brief Copy the viewed pixels into dst at x, y, dst has to be big enough.
+	bool pasteInto(ofPixels_<value_type> & dst, size_t x, size_t y) const;
+
+	/// \brief Resize the viewed pixels into dst without copying them first.
+	///
+	/// dst has to be allocated with the size to resize to and the same
+	/// number of channels. Nearest neighbor and bicubic need tightly packed
+	/// pixels and copy the view first when it's not.
+	bool resizeTo(ofPixels_<value_type> & dst, ofInterpolationMethod interpMethod=OF_INTERPOLATE_BILINEAR) const;
+
+private:
+	PixelType * data = nullptr;
+	size_t width = 0;
+	size_t height = 0;
+	size_t stride = 0;
+	size_t pixelStep = 0;
+	size_t numChannels = 0;
+	ofPixelFormat pixelFormat = OF_PIXELS_UNKNOWN;
+};
+
+typedef ofPixelsView_<unsigned char> ofPixelsView;
+typedef ofPixelsView_<float> ofFloatPixelsView;
+typedef ofPixelsView_<unsigned short> ofShortPixelsView;
+typedef ofPixelsView_<const unsigned char> ofConstPixelsView;
+typedef ofPixelsView_<const float> ofConstFloatPixelsView;
+typedef ofPixelsView_<const unsigned short> ofConstShortPixelsView;
+
 // sorry for these ones, being templated functions inside a template i needed to do it in the .h
 // they allow to do things like:
 //
@@ -731,7 +934,11 @@ template<typename PixelType>
 template<typename SrcType>
 void ofPixels_<PixelType>::copyFrom(const ofPixels_<SrcType> & mom){
 	if(mom.isAllocated()){
-		allocate(mom.getWidth(),mom.getHeight(),mom.getNumChannels());
+		// keeps the channel order, only the type of the values changes
+		allocate(mom.getWidth(),mom.getHeight(),mom.getPixelFormat());
+		// formats with subsampled chroma take a different number of values
+		// for each type
+		const size_t numValues = std::min(size(), mom.size());
 
 		const float srcMax = ( (sizeof(SrcType) == sizeof(float) ) ? 1.f : std::numeric_limits<SrcType>::max() );
 		const float dstMax = ( (sizeof(PixelType) == sizeof(float) ) ? 1.f : std::numeric_limits<PixelType>::max() );
@@ -739,12 +946,12 @@ void ofPixels_<PixelType>::copyFrom(const ofPixels_<SrcType> & mom){
 
 		if(sizeof(SrcType) == sizeof(float)) {
 			// coming from float we need a special case to clamp the values
-			for(size_t i = 0; i < mom.size(); i++){
+			for(size_t i = 0; i < numValues; i++){
 				pixels[i] = ofClamp(mom[i], 0, 1) * factor;
 			}
 		} else{
 			// everything else is a straight scaling
-			for(size_t i = 0; i < mom.size(); i++){
+			for(size_t i = 0; i < numValues; i++){
 				pixels[i] = mom[i] * factor;
 			}
 		}
@@ -1521,6 +1728,90 @@ inline typename ofPixels_<PixelType>::ConstPixels ofPixels_<PixelType>::getConst
 	return ConstPixels(begin(),end(),getNumChannels(),pixelFormat);
 }
 
+//----------------------------------------------------------------------
+template<typename PixelType>
+inline ofPixelsView_<PixelType> ofPixels_<PixelType>::getView(){
+	return ofPixelsView_<PixelType>(*this);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+inline ofPixelsView_<const PixelType> ofPixels_<PixelType>::getView() const{
+	return ofPixelsView_<const PixelType>(*this);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+inline bool ofPixelsView_<PixelType>::isAllocated() const{
+	return data != nullptr;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+inline PixelType * ofPixelsView_<PixelType>::getData() const{
+	return data;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+inline PixelType * ofPixelsView_<PixelType>::getLine(size_t y) const{
+	return data + y * stride;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+inline PixelType * ofPixelsView_<PixelType>::getPixel(size_t x, size_t y) const{
+	return data + y * stride + x * pixelStep;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+inline size_t ofPixelsView_<PixelType>::getWidth() const{
+	return width;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+inline size_t ofPixelsView_<PixelType>::getHeight() const{
+	return height;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+inline size_t ofPixelsView_<PixelType>::getNumChannels() const{
+	return numChannels;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+inline ofPixelFormat ofPixelsView_<PixelType>::getPixelFormat() const{
+	return pixelFormat;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+inline size_t ofPixelsView_<PixelType>::getStride() const{
+	return stride;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+inline size_t ofPixelsView_<PixelType>::getBytesStride() const{
+	return stride * sizeof(PixelType);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+inline size_t ofPixelsView_<PixelType>::getPixelStep() const{
+	return pixelStep;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+inline bool ofPixelsView_<PixelType>::isContinuous() const{
+	return pixelStep == numChannels && stride == width * numChannels;
+}
+
 namespace std{
 template<typename PixelType>
 void swap(ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst){
@@ -0,0 +1,575 @@
+#include "ofPixels.h"
+
+// Conversions between pixel formats used by ofPixels_::convertTo.
+//
+// Every supported pair of formats has its own row converter, with the
+// layout of both formats known at compile time, so the inner loops are
+// straight line code the compiler can vectorize. The converters are
+// looked up in a table indexed by source and destination format.
+
+namespace{
+
+//----------------------------------------------------------------------
+// packed formats: one or more interleaved channels per pixel
+
+struct ofPackedLayout{
+	size_t channels;
+	size_t r, g, b;
+	int alpha; // -1 if there's no alpha channel
+	bool gray;
+};
+
+constexpr ofPackedLayout packedLayout(int pixelFormat){
+	return pixelFormat == OF_PIXELS_GRAY ? ofPackedLayout{1, 0, 0, 0, -1, true} :
+		pixelFormat == OF_PIXELS_GRAY_ALPHA ? ofPackedLayout{2, 0, 0, 0, 1, true} :
+		pixelFormat == OF_PIXELS_RGB ? ofPackedLayout{3, 0, 1, 2, -1, false} :
+		pixelFormat == OF_PIXELS_BGR ? ofPackedLayout{3, 2, 1, 0, -1, false} :
+		pixelFormat == OF_PIXELS_RGBA ? ofPackedLayout{4, 0, 1, 2, 3, false} :
+		ofPackedLayout{4, 2, 1, 0, 3, false}; // OF_PIXELS_BGRA
+}
+
+bool isPacked(ofPixelFormat pixelFormat){
+	switch(pixelFormat){
+	case OF_PIXELS_GRAY:
+	case OF_PIXELS_GRAY_ALPHA:
+	case OF_PIXELS_RGB:
+	case OF_PIXELS_BGR:
+	case OF_PIXELS_RGBA:
+	case OF_PIXELS_BGRA:
+		return true;
+	default:
+		return false;
+	}
+}
+
+//----------------------------------------------------------------------
+// YUV formats: chroma subsampled 2x horizontally and, for the 4:2:0
+// ones, also vertically
+
+struct ofYUVLayout{
+	size_t yOffset, yStep, yStride;
+	size_t uOffset, vOffset, uvStep, uvStride;
+	size_t chromaRowShift;
+};
+
+bool getYUVLayout(ofPixelFormat pixelFormat, size_t width, size_t height, ofYUVLayout & layout){
+	size_t lumaSize = width * height;
+	size_t chromaPlaneSize = (width / 2) * (height / 2);
+	switch(pixelFormat){
+	case OF_PIXELS_NV12:
+		layout = {0, 1, width, lumaSize, lumaSize + 1, 2, width, 1};
+		return true;
+	case OF_PIXELS_NV21:
+		layout = {0, 1, width, lumaSize + 1, lumaSize, 2, width, 1};
+		return true;
+	case OF_PIXELS_I420:
+		layout = {0, 1, width, lumaSize, lumaSize + chromaPlaneSize, 1, width / 2, 1};
+		return true;
+	case OF_PIXELS_YV12:
+		layout = {0, 1, width, lumaSize + chromaPlaneSize, lumaSize, 1, width / 2, 1};
+		return true;
+	case OF_PIXELS_YUY2:
+		layout = {0, 2, width * 2, 1, 3, 4, width * 2, 0};
+		return true;
+	case OF_PIXELS_UYVY:
+		layout = {1, 2, width * 2, 0, 2, 4, width * 2, 0};
+		return true;
+	default:
+		return false;
+	}
+}
+
+//----------------------------------------------------------------------
+// 16.16 fixed point version of the YUV matrices for 8 bit data
+
+struct ofYUVCoefficients{
+	// luma weights, also used to convert RGB to gray
+	float kr, kg, kb;
+	bool fullRange;
+};
+
+ofYUVCoefficients getYUVCoefficients(ofYUVMatrix matrix){
+	switch(matrix){
+	case OF_YUV_MATRIX_BT709:
+		return {0.2126f, 0.7152f, 0.0722f, false};
+	case OF_YUV_MATRIX_JPEG:
+		return {0.299f, 0.587f, 0.114f, true};
+	case OF_YUV_MATRIX_BT601:
+	default:
+		return {0.299f, 0.587f, 0.114f, false};
+	}
+}
+
+struct ofYUVFixedMatrix{
+	// YUV -> RGB
+	int yOffset, yScale;
+	int rv, gu, gv, bu;
+	// RGB -> YUV
+	int yr, yg, yb, yAdd;
+	int ur, ug, ub;
+	int vr, vg, vb;
+	// RGB -> gray
+	int grayR, grayG, grayB;
+};
+
+int toFixed(double v){
+	return int(std::round(v * 65536.0));
+}
+
+ofYUVFixedMatrix getFixedMatrix(ofYUVMatrix matrix){
+	auto k = getYUVCoefficients(matrix);
+	double kr = k.kr, kg = k.kg, kb = k.kb;
+	double yRange = k.fullRange ? 255. : 219.;
+	double cRange = k.fullRange ? 255. : 224.;
+	double yToRGB = 255. / yRange;
+	double cToRGB = 255. / cRange;
+
+	ofYUVFixedMatrix m;
+	m.yOffset = k.fullRange ? 0 : 16;
+	m.yScale = toFixed(yToRGB);
+	m.rv = toFixed(2. * (1. - kr) * cToRGB);
+	m.gu = toFixed(-2. * (1. - kb) * kb / kg * cToRGB);
+	m.gv = toFixed(-2. * (1. - kr) * kr / kg * cToRGB);
+	m.bu = toFixed(2. * (1. - kb) * cToRGB);
+
+	m.yr = toFixed(kr / yToRGB);
+	m.yg = toFixed(kg / yToRGB);
+	m.yb = toFixed(kb / yToRGB);
+	m.yAdd = m.yOffset;
+	m.ur = toFixed(-kr / (2. * (1. - kb)) / cToRGB);
+	m.ug = toFixed(-kg / (2. * (1. - kb)) / cToRGB);
+	m.ub = toFixed(0.5 / cToRGB);
+	m.vr = toFixed(0.5 / cToRGB);
+	m.vg = toFixed(-kg / (2. * (1. - kr)) / cToRGB);
+	m.vb = toFixed(-kb / (2. * (1. - kr)) / cToRGB);
+
+	m.grayR = toFixed(kr);
+	m.grayG = toFixed(kg);
+	m.grayB = 65536 - m.grayR - m.grayG;
+	return m;
+}
+
+template<typename PixelType>
+constexpr PixelType opaque(){
+	return std::is_floating_point<PixelType>::value ? PixelType(1) : std::numeric_limits<PixelType>::max();
+}
+
+inline unsigned char clampByte(int v){
+	return (unsigned char)(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+//----------------------------------------------------------------------
+// luma of an RGB value for each pixel type
+
+template<typename PixelType>
+inline PixelType toGray(PixelType r, PixelType g, PixelType b, const ofYUVFixedMatrix & m, const ofYUVCoefficients & k){
+	float gray = k.kr * r + k.kg * g + k.kb * b;
+	if(std::is_integral<PixelType>::value){
+		return PixelType(gray + 0.5f);
+	}
+	return PixelType(gray);
+}
+
+template<>
+inline unsigned char toGray(unsigned char r, unsigned char g, unsigned char b, const ofYUVFixedMatrix & m, const ofYUVCoefficients &){
+	return (unsigned char)((m.grayR * r + m.grayG * g + m.grayB * b + 32768) >> 16);
+}
+
+template<>
+inline unsigned short toGray(unsigned short r, unsigned short g, unsigned short b, const ofYUVFixedMatrix & m, const ofYUVCoefficients &){
+	return (unsigned short)((uint64_t(m.grayR) * r + uint64_t(m.grayG) * g + uint64_t(m.grayB) * b + 32768) >> 16);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+using ofPackedRowConverter = void(*)(const PixelType * src, PixelType * dst, size_t width, const ofYUVFixedMatrix & m, const ofYUVCoefficients & k);
+
+// all the values of a pixel are read before writing the result so
+// converting in place between formats with the same number of
+// channels is safe
+template<typename PixelType, int Src, int Dst>
+void convertPackedRow(const PixelType * src, PixelType * dst, size_t width, const ofYUVFixedMatrix & m, const ofYUVCoefficients & k){
+	constexpr ofPackedLayout s = packedLayout(Src);
+	constexpr ofPackedLayout d = packedLayout(Dst);
+	for(size_t i = 0; i < width; i++, src += s.channels, dst += d.channels){
+		const PixelType r = src[s.r];
+		const PixelType g = src[s.g];
+		const PixelType b = src[s.b];
+		const PixelType a = s.alpha >= 0 ? src[s.alpha] : opaque<PixelType>();
+		if constexpr(d.gray){
+			dst[0] = s.gray ? r : toGray(r, g, b, m, k);
+		}else{
+			dst[d.r] = r;
+			dst[d.g] = g;
+			dst[d.b] = b;
+		}
+		if constexpr(d.alpha >= 0){
+			dst[d.alpha] = a;
+		}
+	}
+}
+
+#define OF_PACKED_ROW_CONVERTERS(Src) { \
+	convertPackedRow<PixelType, Src, OF_PIXELS_GRAY>, \
+	convertPackedRow<PixelType, Src, OF_PIXELS_GRAY_ALPHA>, \
+	convertPackedRow<PixelType, Src, OF_PIXELS_RGB>, \
+	convertPackedRow<PixelType, Src, OF_PIXELS_BGR>, \
+	convertPackedRow<PixelType, Src, OF_PIXELS_RGBA>, \
+	convertPackedRow<PixelType, Src, OF_PIXELS_BGRA>}
+
+template<typename PixelType>
+ofPackedRowConverter<PixelType> getPackedRowConverter(ofPixelFormat src, ofPixelFormat dst){
+	// the packed formats are the first 6 in ofPixelFormat
+	static const ofPackedRowConverter<PixelType> converters[6][6] = {
+		OF_PACKED_ROW_CONVERTERS(OF_PIXELS_GRAY),
+		OF_PACKED_ROW_CONVERTERS(OF_PIXELS_GRAY_ALPHA),
+		OF_PACKED_ROW_CONVERTERS(OF_PIXELS_RGB),
+		OF_PACKED_ROW_CONVERTERS(OF_PIXELS_BGR),
+		OF_PACKED_ROW_CONVERTERS(OF_PIXELS_RGBA),
+		OF_PACKED_ROW_CONVERTERS(OF_PIXELS_BGRA),
+	};
+	return converters[src][dst];
+}
+
+#undef OF_PACKED_ROW_CONVERTERS
+
+//----------------------------------------------------------------------
+// RGB565: one native endian 16 bit word per pixel, as uploaded with
+// GL_UNSIGNED_SHORT_5_6_5, with 5 bits for red, 6 for green and 5 for blue
+
+using ofRGB565RowConverter = void(*)(const unsigned char * src, unsigned char * dst, size_t width, const ofYUVFixedMatrix & m, const ofYUVCoefficients & k);
+
+template<int Dst>
+void decodeRGB565Row(const unsigned char * src, unsigned char * dst, size_t width, const ofYUVFixedMatrix & m, const ofYUVCoefficients & k){
+	constexpr ofPackedLayout d = packedLayout(Dst);
+	for(size_t i = 0; i < width; i++, src += 2, dst += d.channels){
+		uint16_t v;
+		memcpy(&v, src, sizeof(v));
+		// repeating the high bits in the low ones maps the maximum to 255
+		const unsigned char r = (unsigned char)(((v >> 8) & 0xf8) | (v >> 13));
+		const unsigned char g = (unsigned char)(((v >> 3) & 0xfc) | ((v >> 9) & 0x03));
+		const unsigned char b = (unsigned char)(((v << 3) & 0xf8) | ((v >> 2) & 0x07));
+		if constexpr(d.gray){
+			dst[0] = toGray(r, g, b, m, k);
+		}else{
+			dst[d.r] = r;
+			dst[d.g] = g;
+			dst[d.b] = b;
+		}
+		if constexpr(d.alpha >= 0){
+			dst[d.alpha] = 255;
+		}
+	}
+}
+
+template<int Src>
+void encodeRGB565Row(const unsigned char * src, unsigned char * dst, size_t width, const ofYUVFixedMatrix &, const ofYUVCoefficients &){
+	constexpr ofPackedLayout s = packedLayout(Src);
+	for(size_t i = 0; i < width; i++, src += s.channels, dst += 2){
+		const unsigned r = (src[s.r] * 31u + 127u) / 255u;
+		const unsigned g = (src[s.g] * 63u + 127u) / 255u;
+		const unsigned b = (src[s.b] * 31u + 127u) / 255u;
+		const uint16_t v = uint16_t((r << 11) | (g << 5) | b);
+		memcpy(dst, &v, sizeof(v));
+	}
+}
+
+ofRGB565RowConverter getRGB565RowDecoder(ofPixelFormat dst){
+	static const ofRGB565RowConverter decoders[6] = {
+		decodeRGB565Row<OF_PIXELS_GRAY>,
+		decodeRGB565Row<OF_PIXELS_GRAY_ALPHA>,
+		decodeRGB565Row<OF_PIXELS_RGB>,
+		decodeRGB565Row<OF_PIXELS_BGR>,
+		decodeRGB565Row<OF_PIXELS_RGBA>,
+		decodeRGB565Row<OF_PIXELS_BGRA>,
+	};
+	return decoders[dst];
+}
+
+ofRGB565RowConverter getRGB565RowEncoder(ofPixelFormat src){
+	static const ofRGB565RowConverter encoders[6] = {
+		encodeRGB565Row<OF_PIXELS_GRAY>,
+		encodeRGB565Row<OF_PIXELS_GRAY_ALPHA>,
+		encodeRGB565Row<OF_PIXELS_RGB>,
+		encodeRGB565Row<OF_PIXELS_BGR>,
+		encodeRGB565Row<OF_PIXELS_RGBA>,
+		encodeRGB565Row<OF_PIXELS_BGRA>,
+	};
+	return encoders[src];
+}
+
+//----------------------------------------------------------------------
+struct ofYUVRow{
+	const unsigned char * y;
+	const unsigned char * u;
+	const unsigned char * v;
+	size_t yStep;
+	size_t uvStep;
+};
+
+using ofYUVRowDecoder = void(*)(const ofYUVRow & row, unsigned char * dst, size_t width, const ofYUVFixedMatrix & m);
+
+template<int Dst>
+void decodeYUVRow(const ofYUVRow & row, unsigned char * dst, size_t width, const ofYUVFixedMatrix & m){
+	constexpr ofPackedLayout d = packedLayout(Dst);
+	const unsigned char * y = row.y;
+	const unsigned char * u = row.u;
+	const unsigned char * v = row.v;
+	// every pair of pixels shares the same chroma
+	for(size_t x = 0; x < width; x += 2, u += row.uvStep, v += row.uvStep){
+		const int cu = int(*u) - 128;
+		const int cv = int(*v) - 128;
+		const int r = m.rv * cv + 32768;
+		const int g = m.gu * cu + m.gv * cv + 32768;
+		const int b = m.bu * cu + 32768;
+		for(size_t i = 0; i < 2; i++, y += row.yStep, dst += d.channels){
+			const int luma = (int(*y) - m.yOffset) * m.yScale;
+			if constexpr(d.gray){
+				dst[0] = clampByte((luma + 32768) >> 16);
+			}else{
+				dst[d.r] = clampByte((luma + r) >> 16);
+				dst[d.g] = clampByte((luma + g) >> 16);
+				dst[d.b] = clampByte((luma + b) >> 16);
+			}
+			if constexpr(d.alpha >= 0){
+				dst[d.alpha] = 255;
+			}
+		}
+	}
+}
+
+ofYUVRowDecoder getYUVRowDecoder(ofPixelFormat dst){
+	static const ofYUVRowDecoder decoders[6] = {
+		decodeYUVRow<OF_PIXELS_GRAY>,
+		decodeYUVRow<OF_PIXELS_GRAY_ALPHA>,
+		decodeYUVRow<OF_PIXELS_RGB>,
+		decodeYUVRow<OF_PIXELS_BGR>,
+		decodeYUVRow<OF_PIXELS_RGBA>,
+		decodeYUVRow<OF_PIXELS_BGRA>,
+	};
+	return decoders[dst];
+}
+
+//----------------------------------------------------------------------
+struct ofYUVOutRow{
+	unsigned char * y;
+	unsigned char * u;
+	unsigned char * v;
+	size_t yStep;
+	size_t uvStep;
+};
+
+using ofYUVRowEncoder = void(*)(const unsigned char * src0, const unsigned char * src1, const ofYUVOutRow & row0, unsigned char * y1, size_t width, const ofYUVFixedMatrix & m);
+
+// encodes one row of 4:2:2 or two rows of 4:2:0 data: the chroma is
+// computed from the average of the 2 or 4 pixels that share it. For 4:2:2
+// src1 == src0 and y1 is null.
+template<int Src>
+void encodeYUVRows(const unsigned char * src0, const unsigned char * src1, const ofYUVOutRow & row0, unsigned char * y1, size_t width, const ofYUVFixedMatrix & m){
+	constexpr ofPackedLayout s = packedLayout(Src);
+	unsigned char * y0 = row0.y;
+	unsigned char * u = row0.u;
+	unsigned char * v = row0.v;
+	for(size_t x = 0; x < width; x += 2, u += row0.uvStep, v += row0.uvStep){
+		int r = 0, g = 0, b = 0;
+		for(size_t i = 0; i < 2; i++, src0 += s.channels, src1 += s.channels){
+			const int r0 = src0[s.r], g0 = src0[s.g], b0 = src0[s.b];
+			*y0 = clampByte(((m.yr * r0 + m.yg * g0 + m.yb * b0 + 32768) >> 16) + m.yAdd);
+			y0 += row0.yStep;
+			const int r1 = src1[s.r], g1 = src1[s.g], b1 = src1[s.b];
+			if(y1){
+				*y1 = clampByte(((m.yr * r1 + m.yg * g1 + m.yb * b1 + 32768) >> 16) + m.yAdd);
+				y1 += row0.yStep;
+			}
+			r += r0 + r1;
+			g += g0 + g1;
+			b += b0 + b1;
+		}
+		// sums of 4 values, average them in the final shift
+		*u = clampByte((m.ur * r + m.ug * g + m.ub * b + (128 << 18) + (1 << 17)) >> 18);
+		*v = clampByte((m.vr * r + m.vg * g + m.vb * b + (128 << 18) + (1 << 17)) >> 18);
+	}
+}
+
+ofYUVRowEncoder getYUVRowEncoder(ofPixelFormat src){
+	static const ofYUVRowEncoder encoders[6] = {
+		encodeYUVRows<OF_PIXELS_GRAY>,
+		encodeYUVRows<OF_PIXELS_GRAY_ALPHA>,
+		encodeYUVRows<OF_PIXELS_RGB>,
+		encodeYUVRows<OF_PIXELS_BGR>,
+		encodeYUVRows<OF_PIXELS_RGBA>,
+		encodeYUVRows<OF_PIXELS_BGRA>,
+	};
+	return encoders[src];
+}
+
+//----------------------------------------------------------------------
+void decodeYUV(const unsigned char * src, ofPixelFormat srcFormat, unsigned char * dst, ofPixelFormat dstFormat, size_t width, size_t height, ofYUVMatrix matrix){
+	ofYUVLayout layout;
+	getYUVLayout(srcFormat, width, height, layout);
+	auto decoder = getYUVRowDecoder(dstFormat);
+	auto m = getFixedMatrix(matrix);
+	size_t dstStride = width * packedLayout(dstFormat).channels;
+	for(size_t y = 0; y < height; y++){
+		size_t chromaRow = (y >> layout.chromaRowShift) * layout.uvStride;
+		ofYUVRow row{
+			src + layout.yOffset + y * layout.yStride,
+			src + layout.uOffset + chromaRow,
+			src + layout.vOffset + chromaRow,
+			layout.yStep,
+			layout.uvStep
+		};
+		decoder(row, dst + y * dstStride, width, m);
+	}
+}
+
+void encodeYUV(const unsigned char * src, ofPixelFormat srcFormat, unsigned char * dst, ofPixelFormat dstFormat, size_t width, size_t height, ofYUVMatrix matrix){
+	ofYUVLayout layout;
+	getYUVLayout(dstFormat, width, height, layout);
+	auto encoder = getYUVRowEncoder(srcFormat);
+	auto m = getFixedMatrix(matrix);
+	size_t srcStride = width * packedLayout(srcFormat).channels;
+	size_t rowsPerChroma = size_t(1) << layout.chromaRowShift;
+	for(size_t y = 0; y < height; y += rowsPerChroma){
+		size_t chromaRow = (y >> layout.chromaRowShift) * layout.uvStride;
+		ofYUVOutRow row{
+			dst + layout.yOffset + y * layout.yStride,
+			dst + layout.uOffset + chromaRow,
+			dst + layout.vOffset + chromaRow,
+			layout.yStep,
+			layout.uvStep
+		};
+		const unsigned char * src0 = src + y * srcStride;
+		if(rowsPerChroma == 2){
+			encoder(src0, src0 + srcStride, row, row.y + layout.yStride, width, m);
+		}else{
+			encoder(src0, src0, row, nullptr, width, m);
+		}
+	}
+}
+
+//----------------------------------------------------------------------
+// 8 bit formats that aren't packed, from and to the packed ones
+
+void unpack(const unsigned char * src, ofPixelFormat srcFormat, unsigned char * dst, ofPixelFormat dstFormat, size_t width, size_t height, ofYUVMatrix matrix){
+	if(srcFormat == OF_PIXELS_RGB565){
+		getRGB565RowDecoder(dstFormat)(src, dst, width * height, getFixedMatrix(matrix), getYUVCoefficients(matrix));
+	}else{
+		decodeYUV(src, srcFormat, dst, dstFormat, width, height, matrix);
+	}
+}
+
+void pack(const unsigned char * src, ofPixelFormat srcFormat, unsigned char * dst, ofPixelFormat dstFormat, size_t width, size_t height, ofYUVMatrix matrix){
+	if(dstFormat == OF_PIXELS_RGB565){
+		getRGB565RowEncoder(srcFormat)(src, dst, width * height, getFixedMatrix(matrix), getYUVCoefficients(matrix));
+	}else{
+		encodeYUV(src, srcFormat, dst, dstFormat, width, height, matrix);
+	}
+}
+
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+bool ofPixels_<PixelType>::convertTo(ofPixels_<PixelType> & dst, ofPixelFormat dstFormat, ofYUVMatrix matrix) const{
+	if(!isAllocated()) return false;
+
+	if(&dst == this){
+		return dst.setPixelFormat(dstFormat, matrix);
+	}
+
+	const bool srcPacked = isPacked(pixelFormat);
+	const bool dstPacked = isPacked(dstFormat);
+	ofYUVLayout layout;
+	const bool srcYUV = getYUVLayout(pixelFormat, width, height, layout);
+	const bool dstYUV = getYUVLayout(dstFormat, width, height, layout);
+	const bool srcRGB565 = pixelFormat == OF_PIXELS_RGB565;
+	const bool dstRGB565 = dstFormat == OF_PIXELS_RGB565;
+	if(!(srcPacked || srcYUV || srcRGB565) || !(dstPacked || dstYUV || dstRGB565)){
+		ofLogError("ofPixels") << "convertTo(): conversion from " << ofToString(pixelFormat) << " to " << ofToString(dstFormat) << " not supported";
+		return false;
+	}
+	if((!srcPacked || !dstPacked) && !std::is_same<PixelType, unsigned char>::value){
+		ofLogError("ofPixels") << "convertTo(): YUV and RGB565 formats are only supported for 8 bit pixels";
+		return false;
+	}
+	if((srcYUV || dstYUV) && (width % 2 != 0 || height % 2 != 0)){
+		ofLogError("ofPixels") << "convertTo(): YUV formats need even width and height";
+		return false;
+	}
+
+	if(dst.getWidth() != width || dst.getHeight() != height || dst.getPixelFormat() != dstFormat){
+		dst.allocate(width, height, dstFormat);
+	}
+
+	if(pixelFormat == dstFormat){
+		memcpy(dst.getData(), pixels, getTotalBytes());
+		return true;
+	}
+
+	if(srcPacked && dstPacked){
+		auto converter = getPackedRowConverter<PixelType>(pixelFormat, dstFormat);
+		auto m = getFixedMatrix(matrix);
+		auto k = getYUVCoefficients(matrix);
+		converter(pixels, dst.getData(), width * height, m, k);
+		return true;
+	}
+
+	if constexpr(std::is_same<PixelType, unsigned char>::value){
+		if(dstPacked){
+			unpack(pixels, pixelFormat, dst.getData(), dstFormat, width, height, matrix);
+		}else if(srcPacked){
+			pack(pixels, pixelFormat, dst.getData(), dstFormat, width, height, matrix);
+		}else{
+			// between two formats that aren't packed go through RGB
+			ofPixels_<PixelType> rgb;
+			rgb.allocate(width, height, OF_PIXELS_RGB);
+			unpack(pixels, pixelFormat, rgb.getData(), OF_PIXELS_RGB, width, height, matrix);
+			pack(rgb.getData(), OF_PIXELS_RGB, dst.getData(), dstFormat, width, height, matrix);
+		}
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+bool ofPixels_<PixelType>::setPixelFormat(ofPixelFormat dstFormat, ofYUVMatrix matrix){
+	if(!isAllocated()) return false;
+	if(dstFormat == pixelFormat) return true;
+
+	if(isPacked(pixelFormat) && isPacked(dstFormat) && getNumChannels() == packedLayout(dstFormat).channels){
+		auto converter = getPackedRowConverter<PixelType>(pixelFormat, dstFormat);
+		auto m = getFixedMatrix(matrix);
+		auto k = getYUVCoefficients(matrix);
+		converter(pixels, pixels, width * height, m, k);
+		pixelFormat = dstFormat;
+		return true;
+	}
+
+	ofPixels_<PixelType> dst;
+	if(!convertTo(dst, dstFormat, matrix)) return false;
+	swap(dst);
+	return true;
+}
+
+template bool ofPixels_<char>::convertTo(ofPixels_<char> &, ofPixelFormat, ofYUVMatrix) const;
+template bool ofPixels_<unsigned char>::convertTo(ofPixels_<unsigned char> &, ofPixelFormat, ofYUVMatrix) const;
+template bool ofPixels_<short>::convertTo(ofPixels_<short> &, ofPixelFormat, ofYUVMatrix) const;
+template bool ofPixels_<unsigned short>::convertTo(ofPixels_<unsigned short> &, ofPixelFormat, ofYUVMatrix) const;
+template bool ofPixels_<int>::convertTo(ofPixels_<int> &, ofPixelFormat, ofYUVMatrix) const;
+template bool ofPixels_<unsigned int>::convertTo(ofPixels_<unsigned int> &, ofPixelFormat, ofYUVMatrix) const;
+template bool ofPixels_<long>::convertTo(ofPixels_<long> &, ofPixelFormat, ofYUVMatrix) const;
+template bool ofPixels_<unsigned long>::convertTo(ofPixels_<unsigned long> &, ofPixelFormat, ofYUVMatrix) const;
+template bool ofPixels_<float>::convertTo(ofPixels_<float> &, ofPixelFormat, ofYUVMatrix) const;
+template bool ofPixels_<double>::convertTo(ofPixels_<double> &, ofPixelFormat, ofYUVMatrix) const;
+
+template bool ofPixels_<char>::setPixelFormat(ofPixelFormat, ofYUVMatrix);
+template bool ofPixels_<unsigned char>::setPixelFormat(ofPixelFormat, ofYUVMatrix);
+template bool ofPixels_<short>::setPixelFormat(ofPixelFormat, ofYUVMatrix);
+template bool ofPixels_<unsigned short>::setPixelFormat(ofPixelFormat, ofYUVMatrix);
+template bool ofPixels_<int>::setPixelFormat(ofPixelFormat, ofYUVMatrix);
+template bool ofPixels_<unsigned int>::setPixelFormat(ofPixelFormat, ofYUVMatrix);
+template bool ofPixels_<long>::setPixelFormat(ofPixelFormat, ofYUVMatrix);
+template bool ofPixels_<unsigned long>::setPixelFormat(ofPixelFormat, ofYUVMatrix);
+template bool ofPixels_<float>::setPixelFormat(ofPixelFormat, ofYUVMatrix);
+template bool ofPixels_<double>::setPixelFormat(ofPixelFormat, ofYUVMatrix);
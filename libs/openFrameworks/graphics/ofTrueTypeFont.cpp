@@ -2,6 +2,7 @@
 #include "ofGraphics.h"
 #include "ofPixels.h"
 #include "ofPath.h"
+#include "ofFileUtils.h"
 
 #include <ft2build.h>
 #include <algorithm>
@@ -412,6 +413,7 @@ static bool loadFontFace(const string & _fontname, FT_Face & face,
 		ofLogError("ofTrueTypeFont") << "loadFontFace(): couldn't create new face for " << fontname << ": FT_Error " << err << " " << errorString;
 		return false;
 	}
+	_filename = filename;
 
 	return true;
 }
@@ -462,6 +464,14 @@ ofTrueTypeFont::ofTrueTypeFont()
 	ascenderHeight = 0;
 	descenderHeight = 0;
 	lineHeight = 0;
+	atlasDirtyBegin = 0;
+	atlasDirtyEnd = 0;
+	atlasResized = false;
+	glyphCacheDirty = false;
+	layoutCacheSize = 256;
+	layoutVersion = 0;
+	nextLayoutId = 0;
+	stringQuadsLayout = 0;
 }
 
 //------------------------------------------------------------------
@@ -501,6 +511,20 @@ ofTrueTypeFont::ofTrueTypeFont(const ofTrueTypeFont& mom)
 	glyphIndexMap = mom.glyphIndexMap;
 	texAtlas = mom.texAtlas;
 	face = mom.face;
+
+	atlasPixels = mom.atlasPixels;
+	atlasShelves = mom.atlasShelves;
+	atlasDirtyBegin = mom.atlasDirtyBegin;
+	atlasDirtyEnd = mom.atlasDirtyEnd;
+	// glyphs added to the copy can't go to the texture shared with mom
+	atlasResized = mom.atlasResized || atlasPixels.isAllocated();
+	glyphCacheDirty = mom.glyphCacheDirty;
+
+	// the cache index points to mom's strings, start with an empty one
+	layoutVersion = mom.layoutVersion;
+	nextLayoutId = 0;
+	clearLayoutCache();
+	layoutCacheSize = mom.layoutCacheSize;
 }
 
 //------------------------------------------------------------------
@@ -534,6 +558,19 @@ ofTrueTypeFont & ofTrueTypeFont::operator=(const ofTrueTypeFont& mom){
 	texAtlas = mom.texAtlas;
 	face = mom.face;
 
+	atlasPixels = mom.atlasPixels;
+	atlasShelves = mom.atlasShelves;
+	atlasDirtyBegin = mom.atlasDirtyBegin;
+	atlasDirtyEnd = mom.atlasDirtyEnd;
+	// glyphs added to the copy can't go to the texture shared with mom
+	atlasResized = mom.atlasResized || atlasPixels.isAllocated();
+	glyphCacheDirty = mom.glyphCacheDirty;
+
+	// the cache index points to mom's strings, start with an empty one
+	layoutVersion = mom.layoutVersion;
+	clearLayoutCache();
+	layoutCacheSize = mom.layoutCacheSize;
+
 	return *this;
 }
 
@@ -566,6 +603,19 @@ ofTrueTypeFont::ofTrueTypeFont(ofTrueTypeFont&& mom)
 	glyphIndexMap = std::move(mom.glyphIndexMap);
 	texAtlas = mom.texAtlas;
 	face = mom.face;
+
+	atlasPixels = std::move(mom.atlasPixels);
+	atlasShelves = std::move(mom.atlasShelves);
+	atlasDirtyBegin = mom.atlasDirtyBegin;
+	atlasDirtyEnd = mom.atlasDirtyEnd;
+	atlasResized = mom.atlasResized;
+	glyphCacheDirty = mom.glyphCacheDirty;
+	mom.glyphCacheDirty = false;
+
+	layoutVersion = mom.layoutVersion;
+	nextLayoutId = 0;
+	clearLayoutCache();
+	layoutCacheSize = mom.layoutCacheSize;
 }
 
 //------------------------------------------------------------------
@@ -597,6 +647,18 @@ ofTrueTypeFont & ofTrueTypeFont::operator=(ofTrueTypeFont&& mom){
 	glyphIndexMap = std::move(mom.glyphIndexMap);
 	texAtlas = mom.texAtlas;
 	face = mom.face;
+
+	atlasPixels = std::move(mom.atlasPixels);
+	atlasShelves = std::move(mom.atlasShelves);
+	atlasDirtyBegin = mom.atlasDirtyBegin;
+	atlasDirtyEnd = mom.atlasDirtyEnd;
+	atlasResized = mom.atlasResized;
+	glyphCacheDirty = mom.glyphCacheDirty;
+	mom.glyphCacheDirty = false;
+
+	layoutVersion = mom.layoutVersion;
+	clearLayoutCache();
+	layoutCacheSize = mom.layoutCacheSize;
 	return *this;
 }
 
@@ -608,7 +670,13 @@ void ofTrueTypeFont::unloadTextures(){
 
 //-----------------------------------------------------------
 void ofTrueTypeFont::reloadTextures(){
-	if(bLoadedOk) load(settings);
+	if(!bLoadedOk) return;
+	if(atlasPixels.isAllocated()){
+		atlasResized = true;
+		updateAtlasTexture();
+	}else{
+		load(settings);
+	}
 }
 
 //-----------------------------------------------------------
@@ -618,7 +686,7 @@ bool ofTrueTypeFont::loadFont(const of::filesystem::path & filename, int fontSiz
 
 //-----------------------------------------------------------
 ofTrueTypeFont::glyph ofTrueTypeFont::loadGlyph(uint32_t utf8) const{
-	glyph aGlyph;
+	glyph aGlyph{};
 	auto err = FT_Load_Glyph( face.get(), FT_Get_Char_Index( face.get(), utf8 ), settings.antialiased ?  FT_LOAD_FORCE_AUTOHINT : FT_LOAD_DEFAULT );
 	if(err){
 		ofLogError("ofTrueTypeFont") << "loadFont(): FT_Load_Glyph failed for utf8 code " << utf8 << ": FT_Error " << err;
@@ -710,6 +778,7 @@ bool ofTrueTypeFont::load(const ofTrueTypeFontSettings & _settings){
 	#endif
 
 	initLibraries();
+	clearLayoutCache();
 	settings = _settings;
 	if( settings.dpi == 0 ){
 		settings.dpi = ttfGlobalDpi;
@@ -746,6 +815,51 @@ bool ofTrueTypeFont::load(const ofTrueTypeFontSettings & _settings){
 			[](uint32_t acc, ofUnicode::range range){
 				return acc + range.getNumGlyphs();
 			});
+	cps.clear();
+	glyphIndexMap.clear();
+	atlasPixels.clear();
+	atlasShelves.clear();
+	atlasDirtyBegin = atlasDirtyEnd = 0;
+	atlasResized = false;
+	glyphCacheDirty = false;
+	charOutlines.clear();
+	charOutlinesNonVFlipped.clear();
+	charOutlinesContour.clear();
+	charOutlinesNonVFlippedContour.clear();
+
+	if(settings.loadGlyphsOnDemand){
+		// glyphProps are returned by reference, reserving all the possible
+		// glyphs keeps them valid when new ones are loaded
+		cps.reserve(nGlyphs);
+		if(settings.contours){
+			charOutlines.reserve(nGlyphs);
+			charOutlinesNonVFlipped.reserve(nGlyphs);
+			charOutlinesContour.reserve(nGlyphs);
+			charOutlinesNonVFlippedContour.reserve(nGlyphs);
+		}
+		if(!loadGlyphCache()){
+			atlasPixels.allocate(256,256,OF_PIXELS_GRAY_ALPHA);
+			atlasPixels.set(0,255);
+			atlasPixels.set(1,0);
+			atlasResized = true;
+		}
+		if(!settings.contours){
+			charOutlines.resize(1);
+		}
+		bLoadedOk = true;
+		// the advance of the space is used for every character
+		if(isValidGlyph(' ')){
+			indexForGlyph(' ');
+		}
+		return true;
+	}
+
+	if(loadGlyphCache()){
+		charOutlines.resize(1);
+		bLoadedOk = true;
+		return true;
+	}
+
 	cps.resize(nGlyphs);
 	if(settings.contours){
 		charOutlines.resize(nGlyphs);
@@ -776,27 +890,7 @@ bool ofTrueTypeFont::load(const ofTrueTypeFontSettings & _settings){
 					ofUTF8Append(str,g);
 					ofLogNotice("ofTrueTypeFont") <<  "character " << str;
 				}
-
-				//int character = i + NUM_CHARACTER_TO_START;
-				charOutlines[i] = makeContoursForCharacter( face.get() );
-				charOutlinesContour[i] = charOutlines[i];
-				charOutlinesContour[i].setFilled(false);
-				charOutlinesContour[i].setStrokeWidth(1);
-
-				charOutlinesNonVFlipped[i] = charOutlines[i];
-				charOutlinesNonVFlipped[i].translate({0,cps[i].height,0.f});
-				charOutlinesNonVFlipped[i].scale(1,-1);
-				charOutlinesNonVFlippedContour[i] = charOutlines[i];
-				charOutlinesNonVFlippedContour[i].setFilled(false);
-				charOutlinesNonVFlippedContour[i].setStrokeWidth(1);
-
-
-				if(settings.simplifyAmt>0){
-					charOutlines[i].simplify(settings.simplifyAmt);
-					charOutlinesNonVFlipped[i].simplify(settings.simplifyAmt);
-					charOutlinesContour[i].simplify(settings.simplifyAmt);
-					charOutlinesNonVFlippedContour[i].simplify(settings.simplifyAmt);
-				}
+				makeOutlines(i);
 			}
 		}
 	}
@@ -867,22 +961,19 @@ bool ofTrueTypeFont::load(const ofTrueTypeFontSettings & _settings){
 		x+= glyph.tW + border*2.0;
 	}
 
-	int maxSize;
+	int maxSize = 0;
 	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
-	if(w > maxSize || h > maxSize){
+	if(maxSize > 0 && (w > maxSize || h > maxSize)){
 		ofLogError("ofTruetypeFont") << "Trying to allocate texture of " << w << "x" << h << " which is bigger than supported in current platform: " << maxSize;
 		return false;
 	}else{
-		texAtlas.allocate(atlasPixelsLuminanceAlpha,false);
-		texAtlas.setRGToRGBASwizzles(true);
-
-		if(settings.antialiased && settings.fontSize>20){
-			texAtlas.setTextureMinMagFilter(GL_LINEAR,GL_LINEAR);
-		}else{
-			texAtlas.setTextureMinMagFilter(GL_NEAREST,GL_NEAREST);
-		}
-		texAtlas.loadData(atlasPixelsLuminanceAlpha);
+		// uploaded the first time the texture is used
+		atlasPixels = std::move(atlasPixelsLuminanceAlpha);
+		atlasResized = true;
 		bLoadedOk = true;
+		if(!settings.cacheDirectory.empty()){
+			saveGlyphCache();
+		}
 		return true;
 	}
 }
@@ -910,6 +1001,7 @@ int ofTrueTypeFont::getSize() const{
 //-----------------------------------------------------------
 void ofTrueTypeFont::setLineHeight(float _newLineHeight) {
 	lineHeight = _newLineHeight;
+	clearLayoutCache();
 }
 
 //-----------------------------------------------------------
@@ -935,6 +1027,7 @@ const ofRectangle & ofTrueTypeFont::getGlyphBBox() const {
 //-----------------------------------------------------------
 void ofTrueTypeFont::setLetterSpacing(float _newletterSpacing) {
 	letterSpacing = _newletterSpacing;
+	clearLayoutCache();
 }
 
 //-----------------------------------------------------------
@@ -945,6 +1038,7 @@ float ofTrueTypeFont::getLetterSpacing() const{
 //-----------------------------------------------------------
 void ofTrueTypeFont::setSpaceSize(float _newspaceSize) {
 	spaceSize = _newspaceSize;
+	clearLayoutCache();
 }
 
 //-----------------------------------------------------------
@@ -979,6 +1073,11 @@ ofPath ofTrueTypeFont::getCharacterAsPoints(uint32_t character, bool vflip, bool
 
 //-----------------------------------------------------------
 void ofTrueTypeFont::drawChar(uint32_t c, float x, float y, bool vFlipped) const{
+	drawChar(stringQuads, c, x, y, vFlipped);
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::drawChar(ofMesh & mesh, uint32_t c, float x, float y, bool vFlipped) const{
 
 	if (!isValidGlyph(c)){
 		//ofLogError("ofTrueTypeFont") << "drawChar(): char " << c + NUM_CHARACTER_TO_START << " not allocated: line " << __LINE__ << " in " << __FILE__;
@@ -1000,24 +1099,24 @@ void ofTrueTypeFont::drawChar(uint32_t c, float x, float y, bool vFlipped) const
 	ymin += y;
 	ymax += y;
 
-	ofIndexType firstIndex = stringQuads.getVertices().size();
+	ofIndexType firstIndex = mesh.getVertices().size();
 
-	stringQuads.addVertex(glm::vec3(xmin,ymin,0.f));
-	stringQuads.addVertex(glm::vec3(xmax,ymin,0.f));
-	stringQuads.addVertex(glm::vec3(xmax,ymax,0.f));
-	stringQuads.addVertex(glm::vec3(xmin,ymax,0.f));
+	mesh.addVertex(glm::vec3(xmin,ymin,0.f));
+	mesh.addVertex(glm::vec3(xmax,ymin,0.f));
+	mesh.addVertex(glm::vec3(xmax,ymax,0.f));
+	mesh.addVertex(glm::vec3(xmin,ymax,0.f));
 
-	stringQuads.addTexCoord(glm::vec2(props.t1,props.v1));
-	stringQuads.addTexCoord(glm::vec2(props.t2,props.v1));
-	stringQuads.addTexCoord(glm::vec2(props.t2,props.v2));
-	stringQuads.addTexCoord(glm::vec2(props.t1,props.v2));
+	mesh.addTexCoord(glm::vec2(props.t1,props.v1));
+	mesh.addTexCoord(glm::vec2(props.t2,props.v1));
+	mesh.addTexCoord(glm::vec2(props.t2,props.v2));
+	mesh.addTexCoord(glm::vec2(props.t1,props.v2));
 
-	stringQuads.addIndex(firstIndex);
-	stringQuads.addIndex(firstIndex+1);
-	stringQuads.addIndex(firstIndex+2);
-	stringQuads.addIndex(firstIndex+2);
-	stringQuads.addIndex(firstIndex+3);
-	stringQuads.addIndex(firstIndex);
+	mesh.addIndex(firstIndex);
+	mesh.addIndex(firstIndex+1);
+	mesh.addIndex(firstIndex+2);
+	mesh.addIndex(firstIndex+2);
+	mesh.addIndex(firstIndex+3);
+	mesh.addIndex(firstIndex);
 	
 	
 }
@@ -1095,6 +1194,7 @@ void ofTrueTypeFont::iterateString(const string & str, float x, float y, bool vF
 //-----------------------------------------------------------
 void ofTrueTypeFont::setDirection(ofTrueTypeFontDirection direction){
 	settings.direction = direction;
+	clearLayoutCache();
 }
 
 //-----------------------------------------------------------
@@ -1122,7 +1222,367 @@ bool ofTrueTypeFont::isValidGlyph(uint32_t glyph) const{
 }
 
 size_t ofTrueTypeFont::indexForGlyph(uint32_t glyph) const{
-	return glyphIndexMap.find(glyph)->second;
+	auto it = glyphIndexMap.find(glyph);
+	if(it == glyphIndexMap.end() && settings.loadGlyphsOnDemand){
+		return loadGlyphOnDemand(glyph);
+	}
+	return it->second;
+}
+
+//-----------------------------------------------------------
+size_t ofTrueTypeFont::loadGlyphOnDemand(uint32_t glyph) const{
+	auto g = loadGlyph(glyph);
+	auto index = cps.size();
+	g.props.characterIndex = index;
+
+	int border = 1;
+	int w = g.props.tW + border*2;
+	int h = g.props.tH + border*2;
+	int x, y;
+	if(packGlyph(w, h, x, y)){
+		if(g.pixels.isAllocated()){
+			g.pixels.pasteInto(atlasPixels, x+border, y+border);
+		}
+		float atlasW = atlasPixels.getWidth();
+		float atlasH = atlasPixels.getHeight();
+		g.props.t1 = float(x + border)/atlasW;
+		g.props.v1 = float(y + border)/atlasH;
+		g.props.t2 = float(g.props.tW + x + border)/atlasW;
+		g.props.v2 = float(g.props.tH + y + border)/atlasH;
+		if(atlasDirtyBegin >= atlasDirtyEnd){
+			atlasDirtyBegin = y;
+			atlasDirtyEnd = y + h;
+		}else{
+			atlasDirtyBegin = std::min(atlasDirtyBegin, y);
+			atlasDirtyEnd = std::max(atlasDirtyEnd, y + h);
+		}
+	}else{
+		ofLogError("ofTrueTypeFont") << "loadGlyphOnDemand(): no space left in the atlas for glyph " << glyph;
+		g.props.t1 = g.props.t2 = g.props.v1 = g.props.v2 = 0;
+	}
+
+	cps.push_back(g.props);
+	glyphIndexMap[glyph] = index;
+	if(settings.contours){
+		makeOutlines(index);
+	}
+	glyphCacheDirty = !settings.cacheDirectory.empty() && !settings.contours;
+	return index;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::makeOutlines(size_t i) const{
+	if(charOutlines.size() <= i){
+		charOutlines.resize(i + 1);
+		charOutlinesNonVFlipped.resize(i + 1);
+		charOutlinesContour.resize(i + 1);
+		charOutlinesNonVFlippedContour.resize(i + 1);
+	}
+
+	//int character = i + NUM_CHARACTER_TO_START;
+	charOutlines[i] = makeContoursForCharacter( face.get() );
+	charOutlinesContour[i] = charOutlines[i];
+	charOutlinesContour[i].setFilled(false);
+	charOutlinesContour[i].setStrokeWidth(1);
+
+	charOutlinesNonVFlipped[i] = charOutlines[i];
+	charOutlinesNonVFlipped[i].translate({0,cps[i].height,0.f});
+	charOutlinesNonVFlipped[i].scale(1,-1);
+	charOutlinesNonVFlippedContour[i] = charOutlines[i];
+	charOutlinesNonVFlippedContour[i].setFilled(false);
+	charOutlinesNonVFlippedContour[i].setStrokeWidth(1);
+
+
+	if(settings.simplifyAmt>0){
+		charOutlines[i].simplify(settings.simplifyAmt);
+		charOutlinesNonVFlipped[i].simplify(settings.simplifyAmt);
+		charOutlinesContour[i].simplify(settings.simplifyAmt);
+		charOutlinesNonVFlippedContour[i].simplify(settings.simplifyAmt);
+	}
+}
+
+//-----------------------------------------------------------
+bool ofTrueTypeFont::packGlyph(int w, int h, int & x, int & y) const{
+	while(true){
+		int atlasW = atlasPixels.getWidth();
+		int atlasH = atlasPixels.getHeight();
+
+		// the lowest shelf where the glyph fits, without wasting tall
+		// shelves on small glyphs
+		atlasShelf * best = nullptr;
+		for(auto & shelf: atlasShelves){
+			if(shelf.height >= h && shelf.height <= h + h/2 + 2 && shelf.x + w <= atlasW){
+				if(!best || shelf.height < best->height){
+					best = &shelf;
+				}
+			}
+		}
+		if(best){
+			x = best->x;
+			y = best->y;
+			best->x += w;
+			return true;
+		}
+
+		int top = atlasShelves.empty() ? 0 : atlasShelves.back().y + atlasShelves.back().height;
+		int shelfHeight = std::min(h + h/8, atlasH - top);
+		if(w <= atlasW && shelfHeight >= h){
+			atlasShelves.push_back({top, shelfHeight, w});
+			x = 0;
+			y = top;
+			return true;
+		}
+
+		if(!growAtlas()){
+			return false;
+		}
+	}
+}
+
+//-----------------------------------------------------------
+bool ofTrueTypeFont::growAtlas() const{
+	int w = atlasPixels.getWidth();
+	int h = atlasPixels.getHeight();
+	int newW = h < w ? w : w*2;
+	int newH = h < w ? h*2 : h;
+
+	int maxSize = 0;
+	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+	if(maxSize > 0 && (newW > maxSize || newH > maxSize)){
+		ofLogError("ofTrueTypeFont") << "growAtlas(): trying to allocate texture of " << newW << "x" << newH << " which is bigger than supported in current platform: " << maxSize;
+		return false;
+	}
+
+	ofPixels pixels;
+	pixels.allocate(newW,newH,OF_PIXELS_GRAY_ALPHA);
+	pixels.set(0,255);
+	pixels.set(1,0);
+	atlasPixels.pasteInto(pixels,0,0);
+	atlasPixels = std::move(pixels);
+
+	// the glyphs stay in the same pixels, the sizes are powers of 2 so
+	// scaling the texture coordinates is exact
+	float scaleX = float(w)/float(newW);
+	float scaleY = float(h)/float(newH);
+	for(auto & props: cps){
+		props.t1 *= scaleX;
+		props.t2 *= scaleX;
+		props.v1 *= scaleY;
+		props.v2 *= scaleY;
+	}
+	atlasResized = true;
+	layoutVersion++;
+	return true;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::updateAtlasTexture() const{
+	if(atlasResized || !texAtlas.isAllocated()){
+		if(!atlasPixels.isAllocated()){
+			return;
+		}
+		texAtlas.allocate(atlasPixels,false);
+		texAtlas.setRGToRGBASwizzles(true);
+
+		if(settings.antialiased && settings.fontSize>20){
+			texAtlas.setTextureMinMagFilter(GL_LINEAR,GL_LINEAR);
+		}else{
+			texAtlas.setTextureMinMagFilter(GL_NEAREST,GL_NEAREST);
+		}
+		texAtlas.loadData(atlasPixels);
+		// all the glyphs are already in the atlas
+		if(!settings.loadGlyphsOnDemand){
+			atlasPixels.clear();
+		}
+	}else if(atlasDirtyBegin < atlasDirtyEnd){
+		// upload only the rows with new glyphs
+		auto & texData = texAtlas.getTextureData();
+		auto width = atlasPixels.getWidth();
+		ofSetPixelStoreiAlignment(GL_UNPACK_ALIGNMENT, width, 1, 2);
+		glBindTexture(texData.textureTarget, texData.textureID);
+		glTexSubImage2D(texData.textureTarget, 0, 0, atlasDirtyBegin, width, atlasDirtyEnd - atlasDirtyBegin,
+						ofGetGLFormat(atlasPixels), GL_UNSIGNED_BYTE,
+						atlasPixels.getData() + atlasDirtyBegin * atlasPixels.getBytesStride());
+		glBindTexture(texData.textureTarget, 0);
+	}
+	atlasResized = false;
+	atlasDirtyBegin = atlasDirtyEnd = 0;
+}
+
+//-----------------------------------------------------------
+static const char glyphCacheMagic[8] = {'O','F','G','L','Y','P','H','S'};
+static const uint32_t glyphCacheVersion = 1;
+
+template<typename T>
+static void writeCacheValue(std::ostream & stream, const T & value){
+	stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+static bool readCacheValue(std::istream & stream, T & value){
+	return bool(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+//-----------------------------------------------------------
+std::string ofTrueTypeFont::getGlyphCacheKey() const{
+	// the cache is only valid for the same font file, the rasterization
+	// settings and the same binary layout of the glyph properties
+	std::stringstream key;
+	key << ofPathToString(settings.fontName);
+	try{
+		key << "|" << of::filesystem::file_size(settings.fontName)
+			<< "|" << of::filesystem::last_write_time(settings.fontName).time_since_epoch().count();
+	}catch(std::exception &){
+	}
+	key << "|" << settings.index
+		<< "|" << settings.fontSize
+		<< "|" << settings.dpi
+		<< "|" << settings.antialiased
+		<< "|" << settings.loadGlyphsOnDemand
+		<< "|" << sizeof(glyphProps)
+		<< "|";
+	for(auto & range: settings.ranges){
+		key << range.begin << "-" << range.end << ",";
+	}
+	return key.str();
+}
+
+//-----------------------------------------------------------
+of::filesystem::path ofTrueTypeFont::getGlyphCachePath() const{
+	std::stringstream name;
+	name << ofPathToString(settings.fontName.stem()) << "-" << settings.fontSize << "-"
+		<< std::hex << std::hash<std::string>()(getGlyphCacheKey()) << ".ofglyphs";
+	return ofToDataPathFS(settings.cacheDirectory, true) / name.str();
+}
+
+//-----------------------------------------------------------
+bool ofTrueTypeFont::saveGlyphCache() const{
+	if(!bLoadedOk || settings.cacheDirectory.empty() || settings.contours){
+		return false;
+	}
+	if(!atlasPixels.isAllocated()){
+		ofLogError("ofTrueTypeFont") << "saveGlyphCache(): the glyphs are only kept after the texture is created for fonts with loadGlyphsOnDemand";
+		return false;
+	}
+
+	auto path = getGlyphCachePath();
+	auto tmpPath = path;
+	tmpPath += ".tmp";
+	ofDirectory::createDirectory(path.parent_path(), false, true);
+	{
+		ofFile file(tmpPath, ofFile::WriteOnly, true);
+		auto key = getGlyphCacheKey();
+		file.write(glyphCacheMagic, sizeof(glyphCacheMagic));
+		writeCacheValue(file, glyphCacheVersion);
+		writeCacheValue(file, uint32_t(key.size()));
+		file.write(key.data(), key.size());
+
+		writeCacheValue(file, uint32_t(atlasPixels.getWidth()));
+		writeCacheValue(file, uint32_t(atlasPixels.getHeight()));
+		writeCacheValue(file, uint32_t(atlasShelves.size()));
+		for(auto & shelf: atlasShelves){
+			writeCacheValue(file, shelf);
+		}
+		writeCacheValue(file, uint32_t(cps.size()));
+		for(auto & props: cps){
+			writeCacheValue(file, props);
+		}
+		file.write(reinterpret_cast<const char*>(atlasPixels.getData()), atlasPixels.getTotalBytes());
+		if(!file){
+			ofLogError("ofTrueTypeFont") << "saveGlyphCache(): couldn't write " << tmpPath;
+			return false;
+		}
+	}
+
+	// replacing the file at once avoids other apps loading it half written
+	try{
+		of::filesystem::rename(tmpPath, path);
+	}catch(std::exception & e){
+		ofLogError("ofTrueTypeFont") << "saveGlyphCache(): couldn't save " << path << ": " << e.what();
+		return false;
+	}
+	glyphCacheDirty = false;
+	return true;
+}
+
+//-----------------------------------------------------------
+bool ofTrueTypeFont::loadGlyphCache(){
+	if(settings.cacheDirectory.empty() || settings.contours){
+		return false;
+	}
+
+	auto path = getGlyphCachePath();
+	if(!of::filesystem::exists(path)){
+		return false;
+	}
+	ofFile file(path, ofFile::ReadOnly, true);
+	// sizes read from the file are checked against its size before
+	// allocating anything, so a corrupted file can't allocate gigabytes
+	uint64_t fileSize = file.getSize();
+
+	char magic[sizeof(glyphCacheMagic)];
+	uint32_t version = 0;
+	uint32_t keySize = 0;
+	file.read(magic, sizeof(magic));
+	readCacheValue(file, version);
+	readCacheValue(file, keySize);
+	if(!file || !std::equal(magic, magic + sizeof(magic), glyphCacheMagic) || version != glyphCacheVersion){
+		ofLogWarning("ofTrueTypeFont") << "loadGlyphCache(): ignoring " << path << ", it was saved by a different version";
+		return false;
+	}
+	std::string key(keySize <= fileSize ? keySize : 0, ' ');
+	file.read(&key[0], key.size());
+	if(!file || key != getGlyphCacheKey()){
+		ofLogWarning("ofTrueTypeFont") << "loadGlyphCache(): ignoring " << path << ", the font or settings changed";
+		return false;
+	}
+
+	uint32_t w = 0, h = 0, numShelves = 0, numGlyphs = 0;
+	readCacheValue(file, w);
+	readCacheValue(file, h);
+	readCacheValue(file, numShelves);
+	// the pixels are stored at the end of the file, 2 bytes each, and every
+	// shelf is at least a pixel high
+	bool valid = bool(file) && uint64_t(w) * h * 2 <= fileSize && numShelves <= h;
+	std::vector<atlasShelf> shelves(valid ? numShelves : 0);
+	for(auto & shelf: shelves){
+		readCacheValue(file, shelf);
+		valid &= shelf.y >= 0 && shelf.height >= 0 && shelf.x >= 0
+			&& uint64_t(shelf.y) + shelf.height <= h && uint32_t(shelf.x) <= w;
+	}
+	readCacheValue(file, numGlyphs);
+	auto maxGlyphs = std::accumulate(settings.ranges.begin(), settings.ranges.end(), 0u,
+			[](uint32_t acc, ofUnicode::range range){
+				return acc + range.getNumGlyphs();
+			});
+	valid &= bool(file) && numGlyphs <= maxGlyphs;
+	std::vector<glyphProps> props(valid ? numGlyphs : 0);
+	for(auto & p: props){
+		readCacheValue(file, p);
+	}
+	ofPixels pixels;
+	if(valid && file && w > 0 && h > 0){
+		pixels.allocate(w,h,OF_PIXELS_GRAY_ALPHA);
+		file.read(reinterpret_cast<char*>(pixels.getData()), pixels.getTotalBytes());
+	}
+	if(!valid || !file || !pixels.isAllocated()){
+		ofLogWarning("ofTrueTypeFont") << "loadGlyphCache(): ignoring " << path << ", the file is corrupted";
+		return false;
+	}
+
+	if(settings.loadGlyphsOnDemand){
+		cps.insert(cps.end(), props.begin(), props.end());
+	}else{
+		cps = std::move(props);
+	}
+	for(size_t i = 0; i < cps.size(); i++){
+		glyphIndexMap[cps[i].glyph] = i;
+	}
+	atlasShelves = std::move(shelves);
+	atlasPixels = std::move(pixels);
+	atlasResized = true;
+	ofLogVerbose("ofTrueTypeFont") << "loadGlyphCache(): loaded " << cps.size() << " glyphs from " << path;
+	return true;
 }
 
 const ofTrueTypeFont::glyphProps & ofTrueTypeFont::getGlyphProperties(uint32_t glyph) const{
@@ -1232,20 +1692,136 @@ float ofTrueTypeFont::stringHeight(const string& c) const{
 
 //-----------------------------------------------------------
 void ofTrueTypeFont::createStringMesh(const string& str, float x, float y, bool vflip) const{
+	createStringMesh(stringQuads, str, x, y, vflip);
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::createStringMesh(ofMesh & mesh, const string& str, float x, float y, bool vflip) const{
+	auto numVertices = mesh.getNumVertices();
+	auto numIndices = mesh.getNumIndices();
+	auto version = layoutVersion;
 	iterateString(str,x,y,vflip,[&](uint32_t c, glm::vec2 pos){
-		drawChar(c, pos.x, pos.y, vflip);
+		drawChar(mesh, c, pos.x, pos.y, vflip);
 	});
+
+	// a glyph loaded on demand grew the atlas, the texture coordinates of
+	// the glyphs before it changed
+	if(version != layoutVersion){
+		mesh.getVertices().resize(numVertices);
+		mesh.getTexCoords().resize(numVertices);
+		mesh.getIndices().resize(numIndices);
+		iterateString(str,x,y,vflip,[&](uint32_t c, glm::vec2 pos){
+			drawChar(mesh, c, pos.x, pos.y, vflip);
+		});
+	}
+}
+
+//-----------------------------------------------------------
+const ofTrueTypeFont::cachedLayout * ofTrueTypeFont::getCachedLayout(const string& str, bool vFlipped) const{
+	auto & index = layoutCacheIndex[vFlipped];
+	auto it = index.find(str);
+	if(it != index.end()){
+		layoutCache.splice(layoutCache.begin(), layoutCache, it->second);
+		auto & layout = layoutCache.front();
+		if(layout.version != layoutVersion){
+			layout.mesh.clear();
+			createStringMesh(layout.mesh, str, 0, 0, vFlipped);
+			layout.version = layoutVersion;
+			layout.id = ++nextLayoutId;
+		}
+		return &layout;
+	}
+
+	// strings that are only drawn once aren't worth caching
+	auto hash = std::hash<string>()(str) + vFlipped;
+	if(layoutCacheCandidates.insert(hash).second){
+		if(layoutCacheCandidates.size() > layoutCacheSize){
+			layoutCacheCandidates.clear();
+			layoutCacheCandidates.insert(hash);
+		}
+		return nullptr;
+	}
+	layoutCacheCandidates.erase(hash);
+
+	if(layoutCache.size() >= layoutCacheSize){
+		auto & last = layoutCache.back();
+		layoutCacheIndex[last.vFlipped].erase(last.text);
+		layoutCache.pop_back();
+	}
+	layoutCache.push_front({str, vFlipped, 0, 0, ofMesh()});
+	auto & layout = layoutCache.front();
+	layout.mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+	createStringMesh(layout.mesh, str, 0, 0, vFlipped);
+	layout.version = layoutVersion;
+	layout.id = ++nextLayoutId;
+	index[layout.text] = layoutCache.begin();
+	return &layout;
 }
 
 //-----------------------------------------------------------
 const ofMesh & ofTrueTypeFont::getStringMesh(const string& c, float x, float y, bool vFlipped) const{
-	stringQuads.clear();
-	createStringMesh(c,x,y,vFlipped);
+	auto layout = layoutCacheSize > 0 ? getCachedLayout(c, vFlipped) : nullptr;
+	if(!layout){
+		stringQuads.clear();
+		stringQuadsLayout = 0;
+		createStringMesh(c,x,y,vFlipped);
+		return stringQuads;
+	}
+	if(x == 0 && y == 0){
+		return layout->mesh;
+	}
+
+	// offset the cached mesh instead of iterating the glyphs again, the
+	// texture coordinates and indices are still there if the same string
+	// was drawn last
+	if(stringQuadsLayout != layout->id){
+		stringQuads.getTexCoords() = layout->mesh.getTexCoords();
+		stringQuads.getIndices() = layout->mesh.getIndices();
+		stringQuadsLayout = layout->id;
+	}
+	glm::vec3 offset(x, y, 0.f);
+	auto & vertices = stringQuads.getVertices();
+	vertices.resize(layout->mesh.getNumVertices());
+	auto src = layout->mesh.getVerticesPointer();
+	for(auto & v: vertices){
+		v = *src++ + offset;
+	}
 	return stringQuads;
 }
 
+//-----------------------------------------------------------
+void ofTrueTypeFont::setLayoutCacheSize(size_t size){
+	layoutCacheSize = size;
+	while(layoutCache.size() > layoutCacheSize){
+		auto & last = layoutCache.back();
+		layoutCacheIndex[last.vFlipped].erase(last.text);
+		layoutCache.pop_back();
+	}
+}
+
+//-----------------------------------------------------------
+size_t ofTrueTypeFont::getLayoutCacheSize() const{
+	return layoutCacheSize;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::clearLayoutCache(){
+	layoutCacheIndex[0].clear();
+	layoutCacheIndex[1].clear();
+	layoutCache.clear();
+	layoutCacheCandidates.clear();
+	stringQuadsLayout = 0;
+	layoutVersion++;
+}
+
+//-----------------------------------------------------------
+uint64_t ofTrueTypeFont::getLayoutVersion() const{
+	return layoutVersion;
+}
+
 //-----------------------------------------------------------
 const ofTexture & ofTrueTypeFont::getFontTexture() const{
+	updateAtlasTexture();
 	return texAtlas;
 }
 
@@ -1382,3 +1958,85 @@ void ofTrueTypeFont::drawStringAsShapes(const string& str, float x, float y) con
 std::size_t ofTrueTypeFont::getNumCharacters() const{
 	return cps.size();
 }
+
+//-----------------------------------------------------------
+ofTextLayout::ofTextLayout(const ofTrueTypeFont & font, const string & text, bool vflip){
+	setup(font, text, vflip);
+}
+
+//-----------------------------------------------------------
+void ofTextLayout::setup(const ofTrueTypeFont & font, const string & text, bool vflip){
+	this->font = &font;
+	this->text = text;
+	this->vflip = vflip;
+	version = 0;
+	update();
+}
+
+//-----------------------------------------------------------
+void ofTextLayout::setText(const string & text){
+	if(text == this->text){
+		return;
+	}
+	this->text = text;
+	version = 0;
+	update();
+}
+
+//-----------------------------------------------------------
+const string & ofTextLayout::getText() const{
+	return text;
+}
+
+//-----------------------------------------------------------
+bool ofTextLayout::isSetup() const{
+	return font != nullptr;
+}
+
+//-----------------------------------------------------------
+void ofTextLayout::update() const{
+	if(!font || !font->isLoaded()){
+		return;
+	}
+	// the font version starts at 1 once it's loaded
+	if(version == font->layoutVersion){
+		return;
+	}
+	mesh.clear();
+	mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+	font->createStringMesh(mesh, text, 0, 0, vflip);
+	boundingBox = font->getStringBoundingBox(text, 0, 0, vflip);
+	version = font->layoutVersion;
+}
+
+//-----------------------------------------------------------
+const ofMesh & ofTextLayout::getMesh() const{
+	update();
+	return mesh;
+}
+
+//-----------------------------------------------------------
+const ofRectangle & ofTextLayout::getBoundingBox() const{
+	update();
+	return boundingBox;
+}
+
+//-----------------------------------------------------------
+void ofTextLayout::draw(float x, float y) const{
+	if(!font || !font->isLoaded()){
+		ofLogError("ofTextLayout") << "draw(): layout not setup or font not loaded";
+		return;
+	}
+	update();
+
+	auto blendMode = ofGetStyle().blendingMode;
+	ofEnableAlphaBlending();
+	ofPushMatrix();
+	ofTranslate(x, y);
+	auto & tex = font->getFontTexture();
+	tex.bind();
+	mesh.draw();
+	tex.unbind();
+	ofPopMatrix();
+	ofEnableBlendMode(blendMode);
+}
@@ -5,7 +5,10 @@
 #include "ofPixels.h" // Glyph ofPixels pixels
 #include "ofRectangle.h"
 #include "ofTexture.h"
+#include <list>
+#include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 
 class ofPath;
 
@@ -148,6 +151,16 @@ struct ofTrueTypeFontSettings {
 	ofTrueTypeFontDirection direction = OF_TTF_LEFT_TO_RIGHT;
 	std::vector<ofUnicode::range> ranges;
 
+	/// rasterize each glyph the first time it's drawn or measured instead of
+	/// every glyph in ranges when loading. The atlas texture grows as needed,
+	/// which makes loading big alphabets like CJK almost instant
+	bool loadGlyphsOnDemand = false;
+
+	/// folder to cache the rasterized glyphs in, so loading the same font
+	/// with the same settings again doesn't need to rasterize them.
+	/// Empty disables the cache. Not used for fonts with contours
+	of::filesystem::path cacheDirectory;
+
 	ofTrueTypeFontSettings(const of::filesystem::path & name, int size)
 		: fontName(name)
 		, fontSize(size) { }
@@ -368,6 +381,43 @@ public:
 	bool isValidGlyph(uint32_t) const;
 	/// \}
 
+	/// \brief Saves the rasterized glyphs to the settings cacheDirectory.
+	///
+	/// Fonts loading all the glyphs save the cache when loaded. Fonts loading
+	/// glyphs on demand never save it by themselves, call this once the app
+	/// drew its text, in exit() for example, to keep the glyphs rasterized
+	/// until then.
+	///
+	/// \returns true if the cache was saved.
+	bool saveGlyphCache() const;
+
+	/// \brief Sets how many string meshes are cached.
+	///
+	/// getStringMesh and drawString keep the mesh of the most recently used
+	/// strings so drawing the same text again only has to offset the vertices
+	/// instead of iterating the glyphs and kerning again. Strings are cached
+	/// the second time they are drawn so text that changes every frame, like
+	/// counters, is generated directly. Changing the spacing, line height or
+	/// direction clears the cache. 0 disables it.
+	///
+	/// The mesh returned by getStringMesh is only valid until the next call
+	/// to getStringMesh, drawString or any function changing the cache, copy
+	/// it to keep it.
+	///
+	/// \param size Maximum number of strings to keep, 256 by default.
+	void setLayoutCacheSize(std::size_t size);
+	std::size_t getLayoutCacheSize() const;
+	void clearLayoutCache();
+
+	/// \brief Changes every time the meshes returned until now become invalid.
+	///
+	/// Loading a glyph on demand can grow the atlas, which moves the texture
+	/// coordinates of every glyph, and changing the spacing, line height or
+	/// direction moves the vertices. Meshes copied from getStringMesh, or
+	/// strings accumulated in a single mesh, have to be generated again when
+	/// this changes.
+	uint64_t getLayoutVersion() const;
+
 	void setDirection(ofTrueTypeFontDirection direction);
 
 	float getCharWidth(uint32_t c) const {
@@ -390,10 +440,10 @@ protected:
 
 	bool bLoadedOk;
 
-	std::vector<ofPath> charOutlines;
-	std::vector<ofPath> charOutlinesNonVFlipped;
-	std::vector<ofPath> charOutlinesContour;
-	std::vector<ofPath> charOutlinesNonVFlippedContour;
+	mutable std::vector<ofPath> charOutlines;
+	mutable std::vector<ofPath> charOutlinesNonVFlipped;
+	mutable std::vector<ofPath> charOutlinesContour;
+	mutable std::vector<ofPath> charOutlinesNonVFlippedContour;
 
 	float lineHeight;
 	float ascenderHeight;
@@ -420,23 +470,70 @@ protected:
 		ofPixels pixels;
 	};
 
-	std::vector<glyphProps> cps; // properties for each character
+	mutable std::vector<glyphProps> cps; // properties for each character
 
 	ofTrueTypeFontSettings settings;
-	std::unordered_map<uint32_t, size_t> glyphIndexMap;
+	mutable std::unordered_map<uint32_t, size_t> glyphIndexMap;
 
 	double getKerning(uint32_t leftC, uint32_t rightC) const;
 	void drawChar(uint32_t c, float x, float y, bool vFlipped) const;
+	void drawChar(ofMesh & mesh, uint32_t c, float x, float y, bool vFlipped) const;
 	void drawCharAsShape(uint32_t c, float x, float y, bool vFlipped, bool filled) const;
 	void createStringMesh(const std::string & s, float x, float y, bool vFlipped) const;
+	void createStringMesh(ofMesh & mesh, const std::string & s, float x, float y, bool vFlipped) const;
+	struct cachedLayout;
+	const cachedLayout * getCachedLayout(const std::string & s, bool vFlipped) const;
 	glyph loadGlyph(uint32_t utf8) const;
 	const glyphProps & getGlyphProperties(uint32_t glyph) const;
 	void iterateString(const std::string & str, float x, float y, bool vFlipped, std::function<void(uint32_t, glm::vec2)> f) const;
 	size_t indexForGlyph(uint32_t glyph) const;
+	size_t loadGlyphOnDemand(uint32_t glyph) const;
+	void makeOutlines(size_t index) const;
+	bool packGlyph(int w, int h, int & x, int & y) const;
+	bool growAtlas() const;
+	void updateAtlasTexture() const;
+	of::filesystem::path getGlyphCachePath() const;
+	std::string getGlyphCacheKey() const;
+	bool loadGlyphCache();
+
+	/// a row of the atlas, glyphs are added from left to right
+	struct atlasShelf {
+		int y;
+		int height;
+		int x;
+	};
 
-	ofTexture texAtlas;
+	mutable ofTexture texAtlas;
+	mutable ofPixels atlasPixels; // only kept when loading glyphs on demand
+	mutable std::vector<atlasShelf> atlasShelves;
+	mutable int atlasDirtyBegin, atlasDirtyEnd; // rows changed since the last upload
+	mutable bool atlasResized;
+	mutable bool glyphCacheDirty;
 	mutable ofMesh stringQuads;
 
+	/// a string mesh generated at 0,0
+	struct cachedLayout {
+		std::string text;
+		bool vFlipped;
+		uint64_t version;
+		uint64_t id; // changes every time the mesh is generated
+		ofMesh mesh;
+	};
+
+	// most recently used first, indexed by text for each vflip
+	mutable std::list<cachedLayout> layoutCache;
+	mutable std::unordered_map<std::string_view, std::list<cachedLayout>::iterator> layoutCacheIndex[2];
+	std::size_t layoutCacheSize;
+
+	// hashes of the strings drawn once, they are cached the second time so
+	// text that changes every frame doesn't evict the rest of the cache
+	mutable std::unordered_set<std::size_t> layoutCacheCandidates;
+	mutable uint64_t nextLayoutId;
+	mutable uint64_t stringQuadsLayout; // layout whose texcoords and indices are in stringQuads
+
+	// changes every time the meshes generated until now become invalid
+	mutable uint64_t layoutVersion;
+
 	/// \endcond
 
 private:
@@ -452,4 +549,47 @@ private:
 	static void finishLibraries();
 
 	friend void ofExitCallback();
+	friend class ofTextLayout;
+};
+
+/// \brief The mesh and bounding box of a string, generated once and drawn
+/// as many times as needed.
+///
+/// Useful for static text drawn every frame, drawing only binds the font
+/// texture and draws the mesh. The layout is generated again if the font
+/// spacing, line height or direction change. The font has to outlive the
+/// layout.
+///
+/// ~~~~{.cpp}
+///     ofTextLayout label(font, "fps");
+///     // in draw
+///     label.draw(20, 20);
+/// ~~~~
+class ofTextLayout {
+public:
+	ofTextLayout() = default;
+	ofTextLayout(const ofTrueTypeFont & font, const std::string & text, bool vflip = true);
+
+	void setup(const ofTrueTypeFont & font, const std::string & text, bool vflip = true);
+	void setText(const std::string & text);
+	const std::string & getText() const;
+	bool isSetup() const;
+
+	/// \returns the mesh of the text positioned at 0,0
+	const ofMesh & getMesh() const;
+
+	/// \returns the bounding box of the text positioned at 0,0
+	const ofRectangle & getBoundingBox() const;
+
+	void draw(float x, float y) const;
+
+private:
+	void update() const;
+
+	const ofTrueTypeFont * font = nullptr;
+	std::string text;
+	bool vflip = true;
+	mutable uint64_t version = 0;
+	mutable ofMesh mesh;
+	mutable ofRectangle boundingBox;
 };
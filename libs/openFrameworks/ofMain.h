@@ -13,6 +13,8 @@
 
 #include "ofThread.h"
 #include "ofThreadChannel.h"
+#include "ofLockFreeThreadChannel.h"
+#include "ofTaskPool.h"
 
 #include "ofFpsCounter.h"
 #include "ofJson.h"
@@ -91,6 +93,9 @@
     #include "ofSoundStream.h"
     #include "ofSoundPlayer.h"
     #include "ofSoundBuffer.h"
+    #include "ofSoundBufferPool.h"
+    #include "ofSoundResampler.h"
+    #include "ofSoundRingBuffer.h"
 #endif
 
 //--------------------------
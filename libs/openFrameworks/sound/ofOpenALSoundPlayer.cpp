@@ -9,6 +9,7 @@
 #include <glm/ext/scalar_common.hpp>
 
 #include "ofLog.h"
+#include "ofSoundUtils.h"
 #include "ofEvents.h"
 #include "ofUtils.h"
 
@@ -469,9 +470,7 @@ bool ofOpenALSoundPlayer::stream(const fs::path & fileName, std::vector<short> &
 
 	for(int i=0;i<channels;i++){
 		fftBuffers[i].resize(numFrames);
-		for(int j=0;j<numFrames;j++){
-			fftBuffers[i][j] = fftAuxBuffer[j*channels+i];
-		}
+		ofSoundCopyChannel(fftAuxBuffer.data(), channels, i, fftBuffers[i].data(), 1, 0, numFrames);
 	}
 	return true;
 }
@@ -492,9 +491,7 @@ bool ofOpenALSoundPlayer::readFile(const fs::path & fileName, std::vector<short>
 
 	for(int i=0;i<channels;i++){
 		fftBuffers[i].resize(numFrames);
-		for(int j=0;j<numFrames;j++){
-			fftBuffers[i][j] = fftAuxBuffer[j*channels+i];
-		}
+		ofSoundCopyChannel(fftAuxBuffer.data(), channels, i, fftBuffers[i].data(), 1, 0, numFrames);
 	}
 	return true;
 }
@@ -580,9 +577,7 @@ bool ofOpenALSoundPlayer::load(const fs::path& _fileName, bool is_stream){
 			for(int s=0; s<2;s++){
 				for(int i=0;i<channels;i++){
 					multibuffer[i].resize(buffer.size()/channels);
-					for(int j=0;j<numFrames;j++){
-						multibuffer[i][j] = buffer[j*channels+i];
-					}
+					ofSoundCopyChannel(buffer.data(), channels, i, multibuffer[i].data(), 1, 0, numFrames);
 					alGetError(); // Clear error.
 					alBufferData(buffers[s*2+i],format,&multibuffer[i][0],buffer.size()/channels*2,samplerate);
 					err = alGetError();
@@ -597,9 +592,7 @@ bool ofOpenALSoundPlayer::load(const fs::path& _fileName, bool is_stream){
 		}else{
 			for(int i=0;i<channels;i++){
 				multibuffer[i].resize(buffer.size()/channels);
-				for(int j=0;j<numFrames;j++){
-					multibuffer[i][j] = buffer[j*channels+i];
-				}
+				ofSoundCopyChannel(buffer.data(), channels, i, multibuffer[i].data(), 1, 0, numFrames);
 				alGetError(); // Clear error.
 				alBufferData(buffers[i],format,&multibuffer[i][0],buffer.size()/channels*2,samplerate);
 				err = alGetError();
@@ -671,9 +664,7 @@ void ofOpenALSoundPlayer::threadedFunction(){
 				if(channels>1){
 					for(int j=0;j<channels;j++){
 						multibuffer[j].resize(buffer.size()/channels);
-						for(int k=0;k<numFrames;k++){
-							multibuffer[j][k] = buffer[k*channels+j];
-						}
+						ofSoundCopyChannel(buffer.data(), channels, j, multibuffer[j].data(), 1, 0, numFrames);
 						ALuint albuffer;
 						alSourceUnqueueBuffers(sources[i*channels+j], 1, &albuffer);
 						alBufferData(albuffer,AL_FORMAT_MONO16,&multibuffer[j][0],buffer.size()*2/channels,samplerate);
@@ -1042,12 +1033,11 @@ float * ofOpenALSoundPlayer::getCurrentBufferSum(int size){
 		for(int i=0;i<channels;i++){
 			float gain;
 			alGetSourcef(sources[k*channels+i],AL_GAIN,&gain);
-			for(int j=0;j<size;j++){
-				if(pos+j<(int)fftBuffers[i].size())
-					windowedSignal[j]+=fftBuffers[i][pos+j]*gain;
-				else
-					windowedSignal[j]=0;
+			int available = glm::clamp(int(fftBuffers[i].size()) - pos, 0, size);
+			if(available > 0){
+				ofSoundMix(&windowedSignal[0], &fftBuffers[i][pos], available, gain);
 			}
+			std::fill(windowedSignal.begin() + available, windowedSignal.end(), 0.f);
 		}
 	}
 	return &windowedSignal[0];
@@ -1087,9 +1077,7 @@ float * ofOpenALSoundPlayer::getSystemSpectrum(int bands){
 	for(it=players().begin();it!=players().end();it++){
 		if(!(*it)->isPlaying()) continue;
 		float * buffer = (*it)->getCurrentBufferSum(signalSize);
-		for(int i=0;i<signalSize;i++){
-			systemWindowedSignal[i]+=buffer[i];
-		}
+		ofSoundMix(&systemWindowedSignal[0], buffer, signalSize);
 	}
 
 	float normalizer = 2. / windowSum;
@@ -1103,8 +1091,7 @@ float * ofOpenALSoundPlayer::getSystemSpectrum(int bands){
 
 // ----------------------------------------------------------------------------
 void ofOpenALSoundPlayer::runWindow(std::vector<float> & signal){
-	for(int i = 0; i < (int)signal.size(); i++)
-		signal[i] *= window[i];
+	ofSoundMultiply(signal.data(), window.data(), signal.size());
 }
 
 
@@ -3,6 +3,7 @@
 #include "ofUtils.h"
 #include "ofAppRunner.h"
 #include "ofLog.h"
+#include "ofSoundBufferPool.h"
 #include <RtAudio.h>
 
 using std::vector;
@@ -280,6 +281,7 @@ ofSoundDevice ofRtAudioSoundStream::getOutDevice() const{
 //------------------------------------------------------------------------------
 int ofRtAudioSoundStream::rtAudioCallback(void *outputBuffer, void *inputBuffer, unsigned int nFramesPerBuffer, double streamTime, RtAudioStreamStatus status, void *data) {
 	ofRtAudioSoundStream * rtStreamPtr = (ofRtAudioSoundStream *)data;
+	ofAudioCallbackScope audioCallbackScope;
 
 	if (status) {
 		ofLogWarning("ofRtAudioSoundStream") << "stream over/underflow detected";
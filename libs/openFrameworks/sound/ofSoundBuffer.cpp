@@ -7,6 +7,7 @@
 
 #include "ofSoundBuffer.h"
 #include "ofSoundUtils.h"
+#include "ofSoundResampler.h"
 #include "ofLog.h"
 #include "ofMath.h"
 #if !defined(GLM_FORCE_CTOR_INIT)
@@ -47,9 +48,7 @@ void ofSoundBuffer::copyFrom(const short * shortBuffer, std::size_t numFrames, s
 	this->channels = numChannels;
 	setSampleRate(_sampleRate);
 	buffer.resize(numFrames * numChannels);
-	for(std::size_t i = 0; i < size(); i++){
-		buffer[i] = shortBuffer[i]/float(std::numeric_limits<short>::max());
-	}
+	ofSoundShortToFloat(shortBuffer, buffer.data(), size());
 	checkSizeAndChannelsConsistency("copyFrom");
 }
 
@@ -70,15 +69,11 @@ void ofSoundBuffer::copyFrom(const vector<float> & floatBuffer, std::size_t numC
 
 void ofSoundBuffer::toShortPCM(vector<short> & dst) const{
 	dst.resize(size());
-	for(std::size_t i = 0; i < size(); i++){
-		dst[i] = buffer[i]*float(std::numeric_limits<short>::max());
-	}
+	ofSoundFloatToShort(buffer.data(), dst.data(), size());
 }
 
 void ofSoundBuffer::toShortPCM(short * dst) const{
-	for(std::size_t i = 0; i < size(); i++){
-		dst[i] = buffer[i]*float(std::numeric_limits<short>::max());
-	}
+	ofSoundFloatToShort(buffer.data(), dst, size());
 }
 
 vector<float> & ofSoundBuffer::getBuffer(){
@@ -120,6 +115,10 @@ void ofSoundBuffer::resize(std::size_t samples, float val){
 	checkSizeAndChannelsConsistency("resize(samples,val)");
 }
 
+void ofSoundBuffer::reserve(std::size_t samples){
+	buffer.reserve(samples);
+}
+
 void ofSoundBuffer::clear(){
 	buffer.clear();
 }
@@ -129,19 +128,24 @@ void ofSoundBuffer::set(float value){
 	checkSizeAndChannelsConsistency("set");
 }
 
-bool ofSoundBuffer::checkSizeAndChannelsConsistency(const std::string& _function ) {
-	std::string function = _function;
-
-	if ( function.size()!= 0 ){
-		function += ": ";
-	}
+// called from resize and copyFrom in audio callbacks, takes a c string so
+// it doesn't allocate unless there's something to warn about
+bool ofSoundBuffer::checkSizeAndChannelsConsistency(const char * _function ) {
 	if ( (size()%channels) != 0 ){
+		std::string function = _function;
+		if ( function.size()!= 0 ){
+			function += ": ";
+		}
 		ofLogWarning("ofSoundBuffer") << function << "channel count " << channels << " is not consistent with sample count " << size() << " (non-zero remainder)";
 		return false;
 	}
 	return true;
 }
 
+bool ofSoundBuffer::checkSizeAndChannelsConsistency(const std::string & function) {
+	return checkSizeAndChannelsConsistency(function.c_str());
+}
+
 float & ofSoundBuffer::operator[](std::size_t pos){
 	return buffer[pos];
 }
@@ -173,9 +177,7 @@ ofSoundBuffer ofSoundBuffer::operator*(float value){
 }
 
 ofSoundBuffer & ofSoundBuffer::operator*=(float value){
-	for(std::size_t i=0;i<buffer.size();i++){
-		buffer[i] *= value;
-	}
+	ofSoundApplyGain(buffer.data(), buffer.size(), value);
 	return *this;
 }
 
@@ -184,11 +186,7 @@ void ofSoundBuffer::stereoPan(float left, float right){
 		ofLogWarning("ofSoundBuffer") << "stereoPan called on a buffer with " << channels << " channels, only works with 2 channels";
 		return;
 	}
-	float * bufferPtr = &buffer[0];
-	for(std::size_t i=0;i<getNumFrames();i++){
-		*bufferPtr++ *= left;
-		*bufferPtr++ *= right;
-	}
+	ofSoundStereoGain(buffer.data(), getNumFrames(), left, right);
 }
 
 void ofSoundBuffer::copyTo(ofSoundBuffer & soundBuffer, std::size_t nFrames, std::size_t outChannels,std::size_t fromFrame,bool loop) const{
@@ -267,6 +265,14 @@ void ofSoundBuffer::copyTo(float * outBuffer, std::size_t nFrames, std::size_t o
 }
 
 void ofSoundBuffer::addTo(float * outBuffer, std::size_t nFrames, std::size_t outChannels, std::size_t fromFrame, bool loop) const{
+	mixTo(outBuffer, nFrames, outChannels, 1, fromFrame, loop);
+}
+
+void ofSoundBuffer::mixTo(ofSoundBuffer & outBuffer, float gain, std::size_t fromFrame, bool loop) const{
+	mixTo(&outBuffer[0], outBuffer.getNumFrames(), outBuffer.getNumChannels(), gain, fromFrame, loop);
+}
+
+void ofSoundBuffer::mixTo(float * outBuffer, std::size_t nFrames, std::size_t outChannels, float gain, std::size_t fromFrame, bool loop) const{
 	// figure out how many frames we can copy before we need to stop or loop
 	std::size_t nFramesToCopy = nFrames;
 	if ((fromFrame + nFrames) >= this->getNumFrames()){
@@ -276,16 +282,14 @@ void ofSoundBuffer::addTo(float * outBuffer, std::size_t nFrames, std::size_t ou
 	const float * buffPtr = &buffer[fromFrame * channels];
 	// if channels count matches it is easy
 	if(channels == outChannels){
-		for(std::size_t i = 0; i < (nFramesToCopy * outChannels); i++){
-			outBuffer[i] += buffPtr[i];
-		}
+		ofSoundMix(outBuffer, buffPtr, nFramesToCopy * outChannels, gain);
 		outBuffer += nFramesToCopy * outChannels;
 	} else if(channels > outChannels){
 		// otherwise, if we have more channels than the output is requesting,
 		// we copy the first outChannels channels
 		for(std::size_t i = 0; i < nFramesToCopy; i++){
 			for(std::size_t j = 0; j < outChannels; j++){
-				*outBuffer++ += *buffPtr++;
+				*outBuffer++ += *buffPtr++ * gain;
 			}
 			// and skip the rest
 			buffPtr += channels - outChannels;
@@ -296,7 +300,7 @@ void ofSoundBuffer::addTo(float * outBuffer, std::size_t nFrames, std::size_t ou
 		// 1 2 1 2 1
 		for(std::size_t i = 0; i < nFramesToCopy; i++){
 			for(std::size_t j = 0; j < outChannels; j++){
-				*outBuffer++ += buffPtr[(j%channels)];
+				*outBuffer++ += buffPtr[(j%channels)] * gain;
 			}
 			buffPtr += channels;
 		}
@@ -306,7 +310,7 @@ void ofSoundBuffer::addTo(float * outBuffer, std::size_t nFrames, std::size_t ou
 	int framesRemaining = nFrames - (int)nFramesToCopy;
 	if (framesRemaining > 0 && loop){
 		// loop
-		addTo(outBuffer, framesRemaining, outChannels, 0, loop);
+		mixTo(outBuffer, framesRemaining, outChannels, gain, 0, loop);
 	}
 }
 
@@ -484,6 +488,16 @@ void ofSoundBuffer::hermiteResampleTo(ofSoundBuffer &outBuffer, std::size_t from
 	}
 }
 
+void ofSoundBuffer::sincResampleTo(ofSoundBuffer &outBuffer, std::size_t fromFrame, std::size_t numFrames, float speed, bool loop) const {
+	// the table is only built the first time in each thread and when the
+	// speed changes the cutoff, which allocates and computes it in the
+	// calling thread, see the resampleTo documentation
+	static thread_local ofSoundResampler resampler;
+	resampler.setSpeed(speed);
+	resampler.setPosition(fromFrame);
+	resampler.read(*this, outBuffer, numFrames, loop);
+}
+
 void ofSoundBuffer::resampleTo(ofSoundBuffer & buffer, std::size_t fromFrame, std::size_t numFrames, float speed, bool loop, InterpolationAlgorithm algorithm) const {
 	switch(algorithm){
 		case Linear:
@@ -492,6 +506,9 @@ void ofSoundBuffer::resampleTo(ofSoundBuffer & buffer, std::size_t fromFrame, st
 		case Hermite:
 			hermiteResampleTo(buffer, fromFrame, numFrames, speed, loop);
 			break;
+		case Sinc:
+			sincResampleTo(buffer, fromFrame, numFrames, speed, loop);
+			break;
 	}
 }
 
@@ -501,6 +518,13 @@ void ofSoundBuffer::resample(float speed, InterpolationAlgorithm algorithm){
 	*this = resampled;
 }
 
+void ofSoundBuffer::resample(float speed, ofSoundBuffer & scratch, InterpolationAlgorithm algorithm){
+	resampleTo(scratch, 0, ceilf(getNumFrames() / speed), speed, false, algorithm);
+	// copied instead of swapped so each buffer keeps its own storage, scratch
+	// might belong to a pool and this buffer not
+	buffer.assign(scratch.buffer.begin(), scratch.buffer.end());
+}
+
 void ofSoundBuffer::getChannel(ofSoundBuffer & targetBuffer, std::size_t sourceChannel) const {
 	if(channels == 0) {
 		ofLogWarning("ofSoundBuffer") << "getChannel requested on empty buffer";
@@ -517,34 +541,19 @@ void ofSoundBuffer::getChannel(ofSoundBuffer & targetBuffer, std::size_t sourceC
 	}else{
 		// fetch samples from only one channel
 		targetBuffer.resize(getNumFrames());
-		const float * bufferPtr = &this->buffer[sourceChannel];
-		for(std::size_t i = 0; i < targetBuffer.getNumFrames(); i++){
-			targetBuffer[i] = *bufferPtr;
-			bufferPtr += channels;
-		}
+		ofSoundCopyChannel(buffer.data(), channels, sourceChannel, targetBuffer.getBuffer().data(), 1, 0, getNumFrames());
 	}
 }
 
 void ofSoundBuffer::setChannel(const ofSoundBuffer & inBuffer, std::size_t targetChannel){
 	// resize ourself to match inBuffer
 	resize(inBuffer.getNumFrames() * channels);
-	// copy from inBuffer to targetChannel
-	float * bufferPtr = &this->buffer[targetChannel];
-	const float * inBufferPtr = &(inBuffer[0]);
-	for(std::size_t i = 0; i < getNumFrames(); i++){
-		*bufferPtr = *inBufferPtr;
-		bufferPtr += channels;
-		// inBuffer.getNumChannels() is probably 1 but let's be safe
-		inBufferPtr += inBuffer.getNumChannels(); 
-	}
+	// copy from the first channel of inBuffer to targetChannel
+	ofSoundCopyChannel(inBuffer.getBuffer().data(), inBuffer.getNumChannels(), 0, buffer.data(), channels, targetChannel, getNumFrames());
 }
 
 float ofSoundBuffer::getRMSAmplitude() const {
-	double acc = 0;
-	for(size_t i = 0; i < buffer.size(); i++){
-		acc += buffer[i] * buffer[i];
-	}
-	return std::sqrt(acc / (double)buffer.size());
+	return ofSoundRMS(buffer.data(), buffer.size());
 }
 
 float ofSoundBuffer::getRMSAmplitudeChannel(std::size_t channel) const {
@@ -552,22 +561,13 @@ float ofSoundBuffer::getRMSAmplitudeChannel(std::size_t channel) const {
 		return 0;
 	}
 
-	double acc = 0;
-	for(size_t i = 0; i < getNumFrames(); i++) {
-		float sample = getSample(i, channel);
-		acc += sample * sample;
-	}
-	return std::sqrt(acc / (double)getNumFrames());
+	return ofSoundRMS(buffer.data(), getNumFrames(), channels, channel);
 }
 
 void ofSoundBuffer::normalize(float level){
-	float maxAmplitude = 0;
-	for(std::size_t i = 0; i < size(); i++) {
-		maxAmplitude = std::max(maxAmplitude, std::abs(buffer[i]));
-	}
-	float normalizationFactor = level/maxAmplitude;
-	for(std::size_t i = 0; i < size(); i++) {
-		buffer[i] *= normalizationFactor;
+	float maxAmplitude = ofSoundPeak(buffer.data(), size());
+	if(maxAmplitude > 0){
+		ofSoundApplyGain(buffer.data(), size(), level / maxAmplitude);
 	}
 }
 
@@ -89,7 +89,8 @@ public:
 
 	enum InterpolationAlgorithm{
 		Linear,
-		Hermite
+		Hermite,
+		Sinc ///< windowed sinc, see ofSoundResampler. slower but doesn't alias when speeding up
 	};
 	static InterpolationAlgorithm defaultAlgorithm;  //defaults to Linear for mobile, Hermite for desktop
 
@@ -100,6 +101,10 @@ public:
 	void setSampleRate(unsigned int rate);
 	/// resample by changing the playback speed, keeping the same sampleRate
 	void resample(float speed, InterpolationAlgorithm algorithm=defaultAlgorithm);
+	/// as resample but resamples into scratch and copies the result back, so it
+	/// doesn't allocate if both buffers have enough capacity, eg. buffers from an
+	/// ofSoundBufferPool. each buffer keeps its own storage.
+	void resample(float speed, ofSoundBuffer & scratch, InterpolationAlgorithm algorithm=defaultAlgorithm);
 	/// the number of channels per frame
 	std::size_t getNumChannels() const { return channels; }
 	/// set the number of channels. does not change the underlying data, ie causes getNumFrames() to return a different result.
@@ -133,6 +138,7 @@ public:
 	const float & getSample(std::size_t frameIndex, std::size_t channel) const;
 
 	/// return a new buffer containing the contents of this buffer multiplied by value.
+	/// allocates, use operator*= or mixTo in audio callbacks.
 	ofSoundBuffer operator*(float value);
 	/// multiply everything in this buffer by value, in-place.
 	ofSoundBuffer & operator*=(float value);
@@ -165,6 +171,11 @@ public:
 	/// as addTo above but reads outNumFrames and outNumChannels from outBuffer
 	void addTo(ofSoundBuffer & outBuffer, std::size_t fromFrame = 0, bool loop = false) const;
 
+	/// as addTo but multiplies the source samples by gain before adding them.
+	/// never resizes outBuffer so it's safe to use in audio callbacks.
+	void mixTo(ofSoundBuffer & outBuffer, float gain, std::size_t fromFrame = 0, bool loop = false) const;
+
+	/// append the samples of other to this buffer. allocates unless enough capacity was reserved.
 	void append(ofSoundBuffer & other);
 
 	/// copy sample data to out, where out is already allocated to match outNumFrames and outNumChannels (ie outNumFrames*outNumChannels samples).
@@ -174,12 +185,19 @@ public:
 	void copyTo(float * outBuffer, std::size_t outNumFrames, std::size_t outNumChannels, std::size_t fromFrame, bool loop = false) const;
 	/// as copyTo but mixes source audio with audio in `out` by adding samples together (+), instead of overwriting
 	void addTo(float * outBuffer, std::size_t outNumFrames, std::size_t outNumChannels, std::size_t fromFrame, bool loop = false) const;
+	/// as addTo but multiplies the source samples by gain before adding them.
+	void mixTo(float * outBuffer, std::size_t outNumFrames, std::size_t outNumChannels, float gain, std::size_t fromFrame = 0, bool loop = false) const;
 
 	/// resample our data to outBuffer at the given target speed, starting at fromFrame and copying numFrames of data. resize outBuffer to fit.
 	/// speed is relative to current speed (ie 1.0f == no change). lower speeds will give a larger outBuffer, higher speeds a smaller outBuffer.
+	/// doesn't allocate if outBuffer already has enough capacity, except with Sinc: its filter table
+	/// is allocated and computed the first time it's used in each thread and computed again when the
+	/// speed changes the filter cutoff. in an audio callback use an ofSoundResampler set up in the app
+	/// thread instead, at a constant speed once it's set up it doesn't allocate or rebuild the table.
 	void resampleTo(ofSoundBuffer & outBuffer, std::size_t fromFrame, std::size_t numFrames, float speed, bool loop = false, InterpolationAlgorithm algorithm = defaultAlgorithm) const;
 	
-	/// copy the requested channel of our data to outBuffer. resize outBuffer to fit.
+	/// copy the requested channel of our data to outBuffer. resize outBuffer to fit,
+	/// which doesn't allocate if it already has enough capacity.
 	void getChannel(ofSoundBuffer & outBuffer, std::size_t sourceChannel) const;
 	/// copy data from inBuffer to the given channel. resize ourselves to match inBuffer's getNumFrames().
 	void setChannel(const ofSoundBuffer & inBuffer, std::size_t channel);
@@ -189,6 +207,9 @@ public:
 	
 	void linearResampleTo(ofSoundBuffer & buffer, std::size_t fromFrame, std::size_t numFrames, float speed, bool loop) const;
 	void hermiteResampleTo(ofSoundBuffer & buffer, std::size_t fromFrame, std::size_t numFrames, float speed, bool loop) const;
+	/// uses an ofSoundResampler per thread with the default number of taps. to resample
+	/// a stream across audio callbacks keep an ofSoundResampler instead, which remembers the position.
+	void sincResampleTo(ofSoundBuffer & buffer, std::size_t fromFrame, std::size_t numFrames, float speed, bool loop) const;
 	
 	/// fills the buffer with random noise between -amplitude and amplitude. useful for debugging.
 	void fillWithNoise(float amplitude = 1.0f);
@@ -206,6 +227,10 @@ public:
 	std::size_t size() const { return buffer.size(); }
 	/// resize this buffer to exactly this many samples. it's up to you make sure samples matches the channel count.
 	void resize(std::size_t numSamples, float val = float());
+	/// allocate space for this many samples without changing the size, resizing up to it won't allocate.
+	void reserve(std::size_t numSamples);
+	/// the number of samples this buffer can hold without allocating.
+	std::size_t capacity() const { return buffer.capacity(); }
 	/// remove all samples, preserving channel count and sample rate.
 	void clear();
 	/// swap the contents of this buffer with otherBuffer
@@ -220,7 +245,8 @@ public:
 protected:
 
 	// checks that size() and number of channels are consistent, logs a warning if not. returns consistency check result.
-	bool checkSizeAndChannelsConsistency(const std::string& function="" );
+	bool checkSizeAndChannelsConsistency(const char * function="" );
+	bool checkSizeAndChannelsConsistency(const std::string & function);
 
 	std::vector<float> buffer;
 	std::size_t channels;
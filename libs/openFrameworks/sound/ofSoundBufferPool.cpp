@@ -0,0 +1,186 @@
+#include "ofSoundBufferPool.h"
+#include <atomic>
+#include <cassert>
+
+//------------------------------------------------------------------------------
+ofPooledSoundBuffer::ofPooledSoundBuffer()
+:pool(nullptr)
+,index(0){
+
+}
+
+//------------------------------------------------------------------------------
+ofPooledSoundBuffer::ofPooledSoundBuffer(ofSoundBufferPool * pool, std::size_t index)
+:pool(pool)
+,index(index){
+
+}
+
+//------------------------------------------------------------------------------
+ofPooledSoundBuffer::~ofPooledSoundBuffer(){
+	release();
+}
+
+//------------------------------------------------------------------------------
+ofPooledSoundBuffer::ofPooledSoundBuffer(ofPooledSoundBuffer && other)
+:pool(other.pool)
+,index(other.index){
+	other.pool = nullptr;
+}
+
+//------------------------------------------------------------------------------
+ofPooledSoundBuffer & ofPooledSoundBuffer::operator=(ofPooledSoundBuffer && other){
+	if(&other != this){
+		release();
+		pool = other.pool;
+		index = other.index;
+		other.pool = nullptr;
+	}
+	return *this;
+}
+
+//------------------------------------------------------------------------------
+void ofPooledSoundBuffer::release(){
+	if(pool){
+		pool->release(index);
+		pool = nullptr;
+	}
+}
+
+//------------------------------------------------------------------------------
+bool ofPooledSoundBuffer::isValid() const{
+	return pool != nullptr;
+}
+
+//------------------------------------------------------------------------------
+ofPooledSoundBuffer::operator bool() const{
+	return isValid();
+}
+
+//------------------------------------------------------------------------------
+ofSoundBuffer & ofPooledSoundBuffer::operator*() const{
+	return pool->buffers[index];
+}
+
+//------------------------------------------------------------------------------
+ofSoundBuffer * ofPooledSoundBuffer::operator->() const{
+	return &pool->buffers[index];
+}
+
+//------------------------------------------------------------------------------
+ofSoundBufferPool::ofSoundBufferPool()
+:numFrames(0)
+,numChannels(1)
+,sampleRate(44100){
+
+}
+
+//------------------------------------------------------------------------------
+ofSoundBufferPool::ofSoundBufferPool(std::size_t numBuffers, std::size_t numFrames, std::size_t numChannels, unsigned int sampleRate){
+	setup(numBuffers, numFrames, numChannels, sampleRate);
+}
+
+//------------------------------------------------------------------------------
+void ofSoundBufferPool::setup(std::size_t numBuffers, std::size_t numFrames, std::size_t numChannels, unsigned int sampleRate){
+	this->numFrames = numFrames;
+	this->numChannels = numChannels;
+	this->sampleRate = sampleRate;
+	buffers.clear();
+	buffers.resize(numBuffers);
+	available.clear();
+	available.reserve(numBuffers);
+	for(std::size_t i = 0; i < numBuffers; i++){
+		buffers[i].reserve(numFrames * numChannels);
+		buffers[i].setSampleRate(sampleRate);
+		// released in reverse so the first buffer is acquired first
+		available.push_back(numBuffers - 1 - i);
+	}
+}
+
+//------------------------------------------------------------------------------
+ofPooledSoundBuffer ofSoundBufferPool::acquire(){
+	return acquire(numFrames, numChannels);
+}
+
+//------------------------------------------------------------------------------
+ofPooledSoundBuffer ofSoundBufferPool::acquire(std::size_t numFrames, std::size_t numChannels){
+	if(available.empty() || numChannels == 0 || numFrames * numChannels > getCapacity()){
+		return ofPooledSoundBuffer();
+	}
+	std::size_t index = available.back();
+	available.pop_back();
+	auto & buffer = buffers[index];
+	// cleared first so changing the channels doesn't warn about the old size
+	buffer.clear();
+	buffer.setNumChannels(numChannels);
+	buffer.setSampleRate(sampleRate);
+	buffer.setTickCount(0);
+	buffer.resize(numFrames * numChannels);
+	return ofPooledSoundBuffer(this, index);
+}
+
+//------------------------------------------------------------------------------
+void ofSoundBufferPool::release(std::size_t index){
+	// never grows, available is reserved for all the buffers
+	available.push_back(index);
+}
+
+//------------------------------------------------------------------------------
+std::size_t ofSoundBufferPool::getNumBuffers() const{
+	return buffers.size();
+}
+
+//------------------------------------------------------------------------------
+std::size_t ofSoundBufferPool::getNumAvailable() const{
+	return available.size();
+}
+
+//------------------------------------------------------------------------------
+std::size_t ofSoundBufferPool::getCapacity() const{
+	return numFrames * numChannels;
+}
+
+namespace{
+	// plain types so using them from operator new doesn't allocate
+	thread_local int audioCallbackDepth = 0;
+	std::atomic<uint64_t> audioCallbackAllocations{0};
+	std::atomic<bool> assertOnAllocation{false};
+}
+
+//------------------------------------------------------------------------------
+ofAudioCallbackScope::ofAudioCallbackScope(){
+	audioCallbackDepth++;
+}
+
+//------------------------------------------------------------------------------
+ofAudioCallbackScope::~ofAudioCallbackScope(){
+	audioCallbackDepth--;
+}
+
+//------------------------------------------------------------------------------
+bool ofIsInAudioCallback(){
+	return audioCallbackDepth > 0;
+}
+
+//------------------------------------------------------------------------------
+uint64_t ofGetAudioCallbackAllocations(){
+	return audioCallbackAllocations.load();
+}
+
+//------------------------------------------------------------------------------
+void ofResetAudioCallbackAllocations(){
+	audioCallbackAllocations = 0;
+}
+
+//------------------------------------------------------------------------------
+void ofSetAudioCallbackAllocationsAssert(bool enabled){
+	assertOnAllocation = enabled;
+}
+
+//------------------------------------------------------------------------------
+void ofSoundCountAllocation(){
+	if(audioCallbackDepth > 0){
+		audioCallbackAllocations++;
+		assert(!assertOnAllocation && "allocation in an audio callback");
+	}
+}
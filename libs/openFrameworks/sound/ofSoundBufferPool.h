@@ -0,0 +1,231 @@
+#pragma once
+
+#include "ofSoundBuffer.h"
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+class ofSoundBufferPool;
+
+/// \brief A buffer borrowed from an ofSoundBufferPool, it goes back to the
+/// pool when it's destroyed or released.
+///
+/// Handles can be moved but not copied, an empty handle is returned when
+/// the pool has no buffers left.
+class ofPooledSoundBuffer{
+public:
+	ofPooledSoundBuffer();
+	~ofPooledSoundBuffer();
+	ofPooledSoundBuffer(ofPooledSoundBuffer && other);
+	ofPooledSoundBuffer & operator=(ofPooledSoundBuffer && other);
+	ofPooledSoundBuffer(const ofPooledSoundBuffer &) = delete;
+	ofPooledSoundBuffer & operator=(const ofPooledSoundBuffer &) = delete;
+
+	/// \brief Returns the buffer to the pool, the handle is empty after
+	/// calling it.
+	void release();
+
+	bool isValid() const;
+	explicit operator bool() const;
+
+	ofSoundBuffer & operator*() const;
+	ofSoundBuffer * operator->() const;
+
+private:
+	friend class ofSoundBufferPool;
+	ofPooledSoundBuffer(ofSoundBufferPool * pool, std::size_t index);
+
+	ofSoundBufferPool * pool;
+	std::size_t index;
+};
+
+/// \brief Preallocated sound buffers to use as temporary buffers in audio
+/// callbacks without allocating.
+///
+/// All the buffers are allocated in setup with the capacity for the given
+/// number of frames and channels. Acquiring a buffer resizes it within that
+/// capacity, so as long as the operations done with it stay within it,
+/// eg. resampleTo, getChannel, copyTo or mixTo, nothing is allocated in the
+/// audio thread.
+///
+/// The pool isn't thread safe, use it from the audio thread only, and it
+/// has to outlive the buffers acquired from it.
+///
+/// ~~~~{.cpp}
+/// void setup(){
+///     pool.setup(4, 4096, 2, 44100);
+/// }
+///
+/// void audioOut(ofSoundBuffer & out){
+///     auto resampled = pool.acquire();
+///     if(!resampled) return; // all the buffers are in use
+///     sample.resampleTo(*resampled, position, out.getNumFrames(), speed);
+///     resampled->mixTo(out, volume);
+/// }
+/// ~~~~
+class ofSoundBufferPool{
+public:
+	ofSoundBufferPool();
+	ofSoundBufferPool(std::size_t numBuffers, std::size_t numFrames, std::size_t numChannels, unsigned int sampleRate = 44100);
+
+	ofSoundBufferPool(const ofSoundBufferPool &) = delete;
+	ofSoundBufferPool & operator=(const ofSoundBufferPool &) = delete;
+
+	/// \brief Allocates numBuffers buffers with capacity for numFrames of
+	/// numChannels samples. Shouldn't be called while buffers are acquired.
+	void setup(std::size_t numBuffers, std::size_t numFrames, std::size_t numChannels, unsigned int sampleRate = 44100);
+
+	/// \brief Acquires a buffer with the number of frames and channels of
+	/// the pool.
+	ofPooledSoundBuffer acquire();
+
+	/// \brief Acquires a buffer resized to numFrames x numChannels.
+	///
+	/// \returns an empty handle if there are no buffers left or the size
+	/// is bigger than the capacity of the buffers, since that would allocate
+	ofPooledSoundBuffer acquire(std::size_t numFrames, std::size_t numChannels);
+
+	std::size_t getNumBuffers() const;
+	std::size_t getNumAvailable() const;
+
+	/// \returns the number of samples each buffer can hold without
+	/// allocating
+	std::size_t getCapacity() const;
+
+private:
+	friend class ofPooledSoundBuffer;
+	void release(std::size_t index);
+
+	std::vector<ofSoundBuffer> buffers;
+	std::vector<std::size_t> available;
+	std::size_t numFrames;
+	std::size_t numChannels;
+	unsigned int sampleRate;
+};
+
+/// \brief Marks the current thread as running an audio callback while it's
+/// in scope.
+///
+/// The sound streams create one around the calls to audioIn and audioOut,
+/// allocations made while it's alive are counted when the allocation check
+/// is enabled with OF_SOUND_CHECK_ALLOCATIONS().
+class ofAudioCallbackScope{
+public:
+	ofAudioCallbackScope();
+	~ofAudioCallbackScope();
+	ofAudioCallbackScope(const ofAudioCallbackScope &) = delete;
+	ofAudioCallbackScope & operator=(const ofAudioCallbackScope &) = delete;
+};
+
+/// \returns true if called from an audio callback
+bool ofIsInAudioCallback();
+
+/// \returns the number of allocations made in audio callbacks since the
+/// last reset, always 0 if OF_SOUND_CHECK_ALLOCATIONS() isn't used
+uint64_t ofGetAudioCallbackAllocations();
+
+void ofResetAudioCallbackAllocations();
+
+/// \brief Asserts on any allocation made in an audio callback instead of
+/// only counting it, in debug builds.
+void ofSetAudioCallbackAllocationsAssert(bool assertOnAllocation);
+
+/// \brief Called by the allocation check for every allocation.
+void ofSoundCountAllocation();
+
+/*! \cond PRIVATE */
+// allocation functions for the over-aligned operator new and delete of the
+// allocation check, memory from _aligned_malloc can't be freed with free
+inline void * ofSoundAlignedAlloc(std::size_t size, std::size_t alignment){
+#ifdef _WIN32
+	return _aligned_malloc(size ? size : 1, alignment);
+#else
+	void * ptr = nullptr;
+	if(posix_memalign(&ptr, alignment < sizeof(void*) ? sizeof(void*) : alignment, size ? size : 1) != 0){
+		return nullptr;
+	}
+	return ptr;
+#endif
+}
+
+inline void ofSoundAlignedFree(void * ptr){
+#ifdef _WIN32
+	_aligned_free(ptr);
+#else
+	std::free(ptr);
+#endif
+}
+/*! \endcond */
+
+/// \brief Enables the allocation check in debug builds.
+///
+/// Replaces the global operator new and delete, including the over-aligned
+/// ones, to count the allocations made in audio callbacks, use it once at global scope in one of the
+/// application's source files, eg. main.cpp:
+///
+/// ~~~~{.cpp}
+/// #ifndef NDEBUG
+/// OF_SOUND_CHECK_ALLOCATIONS()
+/// #endif
+/// ~~~~
+#define OF_SOUND_CHECK_ALLOCATIONS() \
+	void * operator new(std::size_t size){ \
+		ofSoundCountAllocation(); \
+		if(void * ptr = std::malloc(size ? size : 1)){ \
+			return ptr; \
+		} \
+		throw std::bad_alloc(); \
+	} \
+	void * operator new[](std::size_t size){ \
+		return operator new(size); \
+	} \
+	void * operator new(std::size_t size, const std::nothrow_t &) noexcept{ \
+		ofSoundCountAllocation(); \
+		return std::malloc(size ? size : 1); \
+	} \
+	void * operator new[](std::size_t size, const std::nothrow_t & tag) noexcept{ \
+		return operator new(size, tag); \
+	} \
+	void operator delete(void * ptr) noexcept{ \
+		std::free(ptr); \
+	} \
+	void operator delete[](void * ptr) noexcept{ \
+		std::free(ptr); \
+	} \
+	void operator delete(void * ptr, std::size_t) noexcept{ \
+		std::free(ptr); \
+	} \
+	void operator delete[](void * ptr, std::size_t) noexcept{ \
+		std::free(ptr); \
+	} \
+	void * operator new(std::size_t size, std::align_val_t alignment){ \
+		ofSoundCountAllocation(); \
+		if(void * ptr = ofSoundAlignedAlloc(size, std::size_t(alignment))){ \
+			return ptr; \
+		} \
+		throw std::bad_alloc(); \
+	} \
+	void * operator new[](std::size_t size, std::align_val_t alignment){ \
+		return operator new(size, alignment); \
+	} \
+	void * operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept{ \
+		ofSoundCountAllocation(); \
+		return ofSoundAlignedAlloc(size, std::size_t(alignment)); \
+	} \
+	void * operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t & tag) noexcept{ \
+		return operator new(size, alignment, tag); \
+	} \
+	void operator delete(void * ptr, std::align_val_t) noexcept{ \
+		ofSoundAlignedFree(ptr); \
+	} \
+	void operator delete[](void * ptr, std::align_val_t) noexcept{ \
+		ofSoundAlignedFree(ptr); \
+	} \
+	void operator delete(void * ptr, std::size_t, std::align_val_t) noexcept{ \
+		ofSoundAlignedFree(ptr); \
+	} \
+	void operator delete[](void * ptr, std::size_t, std::align_val_t) noexcept{ \
+		ofSoundAlignedFree(ptr); \
+	}
@@ -0,0 +1,314 @@
+#include "ofSoundResampler.h"
+#include "ofLog.h"
+#if !defined(GLM_FORCE_CTOR_INIT)
+	#define GLM_FORCE_CTOR_INIT
+#endif
+#if !defined(GLM_ENABLE_EXPERIMENTAL)
+	#define GLM_ENABLE_EXPERIMENTAL
+#endif
+#include <glm/gtc/constants.hpp>
+#include <cmath>
+#include <cstring>
+
+namespace{
+	// the filter loops accumulate in blocks of 8 taps into separate sums so
+	// the compiler can vectorize them without reordering a single float sum.
+	// the channel count is a template parameter for the usual mono and stereo
+	// cases so the inner loops have constant bounds
+	constexpr std::size_t tapsBlock = 8;
+
+	// channels the window is reserved for in setup so read() doesn't allocate
+	constexpr std::size_t reservedChannels = 8;
+
+	template<std::size_t Channels>
+	void filter(const float * coefficients, std::size_t numTaps, const float * frames, float * out){
+		float acc[tapsBlock * Channels] = {};
+		for(std::size_t i = 0; i < numTaps; i += tapsBlock){
+			const float * c = coefficients + i;
+			const float * f = frames + i * Channels;
+			for(std::size_t j = 0; j < tapsBlock; j++){
+				for(std::size_t ch = 0; ch < Channels; ch++){
+					acc[j * Channels + ch] += c[j] * f[j * Channels + ch];
+				}
+			}
+		}
+		for(std::size_t ch = 0; ch < Channels; ch++){
+			float sum = 0;
+			for(std::size_t j = 0; j < tapsBlock; j++){
+				sum += acc[j * Channels + ch];
+			}
+			out[ch] = sum;
+		}
+	}
+
+	void filter(const float * coefficients, std::size_t numTaps, const float * frames, std::size_t numChannels, float * out){
+		for(std::size_t ch = 0; ch < numChannels; ch++){
+			float acc[tapsBlock] = {};
+			for(std::size_t i = 0; i < numTaps; i += tapsBlock){
+				for(std::size_t j = 0; j < tapsBlock; j++){
+					acc[j] += coefficients[i + j] * frames[(i + j) * numChannels + ch];
+				}
+			}
+			float sum = 0;
+			for(std::size_t j = 0; j < tapsBlock; j++){
+				sum += acc[j];
+			}
+			out[ch] = sum;
+		}
+	}
+
+	double sinc(double x){
+		if(x == 0){
+			return 1;
+		}
+		x *= glm::pi<double>();
+		return std::sin(x) / x;
+	}
+
+	// the cutoff is rounded down to steps of 1/128 of the nyquist frequency so
+	// modulating the speed doesn't rebuild the table on every call
+	float cutoffForSpeed(double speed){
+		if(speed <= 1){
+			return 1;
+		}
+		return std::max(1.f, std::floor(float(128 / speed))) / 128.f;
+	}
+
+	double blackman(double x, double width){
+		double t = glm::two_pi<double>() * x / width;
+		return 0.42 + 0.5 * std::cos(t) + 0.08 * std::cos(2 * t);
+	}
+}
+
+//------------------------------------------------------------------------------
+ofSoundResampler::ofSoundResampler()
+:pendingChannels(0)
+,pendingPosition(0)
+,numTaps(0)
+,numPhases(0)
+,tableCutoff(1)
+,speed(1)
+,position(0){
+
+}
+
+//------------------------------------------------------------------------------
+void ofSoundResampler::setup(std::size_t taps, std::size_t phases){
+	numTaps = std::max(tapsBlock, (taps + tapsBlock - 1) / tapsBlock * tapsBlock);
+	numPhases = std::max<std::size_t>(1, phases);
+	table.resize((numPhases + 1) * numTaps);
+	coefficients.resize(numTaps);
+	window.reserve(numTaps * reservedChannels);
+	updateTable(cutoffForSpeed(speed));
+	pending.clear();
+	pendingChannels = 0;
+}
+
+//------------------------------------------------------------------------------
+void ofSoundResampler::prepare(){
+	if(table.empty()){
+		setup();
+	}
+	float cutoff = cutoffForSpeed(speed);
+	if(cutoff != tableCutoff){
+		updateTable(cutoff);
+	}
+}
+
+//------------------------------------------------------------------------------
+void ofSoundResampler::updateTable(float cutoff){
+	// phase p is the filter for an output frame p/numPhases frames after the
+	// input frame numTaps/2 - 1 of the window. the last phase is the first one
+	// shifted by a frame so coefficients can be interpolated up to it
+	double center = numTaps / 2 - 1;
+	for(std::size_t p = 0; p <= numPhases; p++){
+		float * row = &table[p * numTaps];
+		double offset = center + double(p) / numPhases;
+		double sum = 0;
+		for(std::size_t k = 0; k < numTaps; k++){
+			double x = double(k) - offset;
+			double value = cutoff * sinc(cutoff * x) * blackman(x, numTaps);
+			row[k] = value;
+			sum += value;
+		}
+		// normalize so constant signals keep their level
+		for(std::size_t k = 0; k < numTaps; k++){
+			row[k] /= sum;
+		}
+	}
+	tableCutoff = cutoff;
+}
+
+//------------------------------------------------------------------------------
+void ofSoundResampler::setSpeed(double s){
+	if(s <= 0){
+		ofLogWarning("ofSoundResampler") << "setSpeed(): speed must be positive, got " << s;
+		return;
+	}
+	speed = s;
+}
+
+//------------------------------------------------------------------------------
+double ofSoundResampler::getSpeed() const{
+	return speed;
+}
+
+//------------------------------------------------------------------------------
+void ofSoundResampler::setPosition(double frame){
+	position = frame;
+}
+
+//------------------------------------------------------------------------------
+double ofSoundResampler::getPosition() const{
+	return position;
+}
+
+//------------------------------------------------------------------------------
+std::size_t ofSoundResampler::getNumTaps() const{
+	return numTaps;
+}
+
+//------------------------------------------------------------------------------
+std::size_t ofSoundResampler::getNumPhases() const{
+	return numPhases;
+}
+
+//------------------------------------------------------------------------------
+void ofSoundResampler::reset(){
+	position = 0;
+	pending.clear();
+	pendingChannels = 0;
+	pendingPosition = 0;
+}
+
+//------------------------------------------------------------------------------
+void ofSoundResampler::interpolateCoefficients(double pos){
+	double phase = (pos - std::floor(pos)) * numPhases;
+	std::size_t p = std::min(std::size_t(phase), numPhases - 1);
+	float t = phase - p;
+	const float * a = &table[p * numTaps];
+	const float * b = a + numTaps;
+	for(std::size_t k = 0; k < numTaps; k++){
+		coefficients[k] = a[k] + (b[k] - a[k]) * t;
+	}
+}
+
+//------------------------------------------------------------------------------
+void ofSoundResampler::filterFrame(const float * frames, std::size_t numChannels, float * out) const{
+	switch(numChannels){
+		case 1:
+			filter<1>(coefficients.data(), numTaps, frames, out);
+			break;
+		case 2:
+			filter<2>(coefficients.data(), numTaps, frames, out);
+			break;
+		default:
+			filter(coefficients.data(), numTaps, frames, numChannels, out);
+			break;
+	}
+}
+
+//------------------------------------------------------------------------------
+void ofSoundResampler::gatherWindow(const ofSoundBuffer & source, long first, bool loop){
+	// copies the frames of the filter window at the edges of the source,
+	// zeros outside of it or the other end of the source when looping
+	long numFrames = source.getNumFrames();
+	std::size_t numChannels = source.getNumChannels();
+	window.resize(numTaps * numChannels);
+	float * dst = window.data();
+	for(std::size_t k = 0; k < numTaps; k++, dst += numChannels){
+		long frame = first + long(k);
+		if(loop){
+			frame %= numFrames;
+			if(frame < 0){
+				frame += numFrames;
+			}
+		}
+		if(frame >= 0 && frame < numFrames){
+			std::memcpy(dst, &source[frame * numChannels], numChannels * sizeof(float));
+		}else{
+			std::memset(dst, 0, numChannels * sizeof(float));
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+void ofSoundResampler::read(const ofSoundBuffer & source, ofSoundBuffer & out, std::size_t numFrames, bool loop){
+	prepare();
+
+	std::size_t numChannels = source.getNumChannels();
+	long sourceFrames = source.getNumFrames();
+	out.setNumChannels(numChannels);
+	out.resize(numFrames * numChannels);
+	out.setSampleRate(source.getSampleRate());
+	if(sourceFrames == 0){
+		out.set(0);
+		return;
+	}
+
+	long half = numTaps / 2;
+	float * dst = out.getBuffer().data();
+	for(std::size_t i = 0; i < numFrames; i++, dst += numChannels){
+		long frame = long(std::floor(position));
+		long first = frame - half + 1;
+		if(!loop && (first >= sourceFrames || frame + half < 0)){
+			std::memset(dst, 0, numChannels * sizeof(float));
+		}else{
+			interpolateCoefficients(position);
+			if(first >= 0 && first + long(numTaps) <= sourceFrames){
+				filterFrame(&source[first * numChannels], numChannels, dst);
+			}else{
+				gatherWindow(source, first, loop);
+				filterFrame(window.data(), numChannels, dst);
+			}
+		}
+		position += speed;
+		if(loop && position >= sourceFrames){
+			position = std::fmod(position, double(sourceFrames));
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+void ofSoundResampler::process(const ofSoundBuffer & in, ofSoundBuffer & out){
+	prepare();
+
+	std::size_t numChannels = in.getNumChannels();
+	if(numChannels != pendingChannels){
+		// start the stream with silence so the first output frame is centered
+		// on the first input one, numTaps/2 frames later
+		pending.assign((numTaps - 1) * numChannels, 0.f);
+		pendingPosition = numTaps / 2 - 1;
+		pendingChannels = numChannels;
+	}
+	pending.insert(pending.end(), in.getBuffer().begin(), in.getBuffer().end());
+
+	// an output frame can be produced when all the frames of its window arrived
+	long half = numTaps / 2;
+	long pendingFrames = pending.size() / numChannels;
+	std::size_t numFrames = 0;
+	for(double p = pendingPosition; long(p) + half < pendingFrames; p += speed){
+		numFrames++;
+	}
+
+	out.setNumChannels(numChannels);
+	out.resize(numFrames * numChannels);
+	out.setSampleRate(std::round(in.getSampleRate() / speed));
+	out.setTickCount(in.getTickCount());
+	out.setDeviceID(in.getDeviceID());
+
+	float * dst = out.getBuffer().data();
+	for(std::size_t i = 0; i < numFrames; i++, dst += numChannels){
+		interpolateCoefficients(pendingPosition);
+		long first = long(pendingPosition) - half + 1;
+		filterFrame(&pending[first * numChannels], numChannels, dst);
+		pendingPosition += speed;
+	}
+
+	// keep only the frames the next output frames still need
+	long consumed = std::min(long(pendingPosition) - half + 1, pendingFrames);
+	if(consumed > 0){
+		pending.erase(pending.begin(), pending.begin() + consumed * numChannels);
+		pendingPosition -= consumed;
+	}
+}
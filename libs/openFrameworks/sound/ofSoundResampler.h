@@ -0,0 +1,94 @@
+#pragma once
+
+#include "ofSoundBuffer.h"
+
+/// \brief Windowed sinc resampler for interleaved sound buffers.
+///
+/// Uses a polyphase table of blackman windowed sinc filters, interpolated
+/// between phases, so the quality doesn't depend on the fractional position
+/// as with linear or hermite interpolation. When playing faster than the
+/// original speed the cutoff of the filter is lowered to avoid aliasing.
+///
+/// The resampler keeps the fractional position between calls so successive
+/// audio callbacks join without discontinuities. It can be used to play a
+/// buffer at a different speed:
+///
+/// ~~~~{.cpp}
+/// void audioOut(ofSoundBuffer & out){
+///     resampler.setSpeed(pitch);
+///     resampler.read(sample, resampled, out.getNumFrames(), true);
+///     resampled.copyTo(out);
+/// }
+/// ~~~~
+///
+/// or to convert a stream to a different sample rate with process(), which
+/// keeps the last input frames so the filter can use them in the next call.
+///
+/// The filter table is built in setup and rebuilt when the speed changes
+/// the cutoff, which is quantized so small pitch changes don't rebuild it.
+/// Call setup() from the app thread, otherwise the first read() allocates
+/// and builds the table in the audio thread. Rebuilding it in read()
+/// computes numPhases * numTaps windowed sincs, over 8000 by default, so
+/// large speed changes in a callback have a cost. Apart from that read() doesn't allocate as long as the output
+/// buffer has enough capacity.
+class ofSoundResampler{
+public:
+	ofSoundResampler();
+
+	/// \brief Builds the filter table.
+	///
+	/// \param numTaps input frames used for each output frame, rounded up
+	/// to a multiple of 8. More taps give a sharper filter.
+	/// \param numPhases fractional positions in the table, the filter is
+	/// interpolated between them
+	void setup(std::size_t numTaps = 32, std::size_t numPhases = 256);
+
+	/// \brief Input frames read for each output frame, ie. the input sample
+	/// rate divided by the output one. 1 plays at the original speed.
+	void setSpeed(double speed);
+	double getSpeed() const;
+
+	/// \brief Position in frames of the source buffer read by read().
+	void setPosition(double frame);
+	double getPosition() const;
+
+	/// \brief Reads numFrames from source into out starting at the current
+	/// position, which advances by the speed for each frame.
+	///
+	/// out is resized to numFrames with the channels and sample rate of
+	/// source. Past the end of the source the output is silent unless loop
+	/// is true, in which case the filter also wraps around.
+	void read(const ofSoundBuffer & source, ofSoundBuffer & out, std::size_t numFrames, bool loop = false);
+
+	/// \brief Resamples a stream, in is consumed completely and out resized
+	/// to the frames that could be produced with it.
+	///
+	/// The output is delayed by half the taps of the filter, the frames
+	/// needed for the following ones are kept until the next call.
+	void process(const ofSoundBuffer & in, ofSoundBuffer & out);
+
+	/// \brief Forgets the position and the frames kept by process().
+	void reset();
+
+	std::size_t getNumTaps() const;
+	std::size_t getNumPhases() const;
+
+private:
+	void prepare();
+	void updateTable(float cutoff);
+	void interpolateCoefficients(double position);
+	void filterFrame(const float * frames, std::size_t numChannels, float * out) const;
+	void gatherWindow(const ofSoundBuffer & source, long first, bool loop);
+
+	std::vector<float> table;
+	std::vector<float> coefficients;
+	std::vector<float> window;
+	std::vector<float> pending;
+	std::size_t pendingChannels;
+	double pendingPosition;
+	std::size_t numTaps;
+	std::size_t numPhases;
+	float tableCutoff;
+	double speed;
+	double position;
+};
@@ -0,0 +1,393 @@
+#include "ofSoundRingBuffer.h"
+#include "ofSoundBuffer.h"
+#include "ofUtils.h"
+#include "ofLog.h"
+#if !defined(GLM_FORCE_CTOR_INIT)
+	#define GLM_FORCE_CTOR_INIT
+#endif
+#if !defined(GLM_ENABLE_EXPERIMENTAL)
+	#define GLM_ENABLE_EXPERIMENTAL
+#endif
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace{
+	// gaps the writer can queue before it has to wait for the reader, each
+	// one is a write that didn't fit so the ring is full long before
+	constexpr std::size_t gapsCapacity = 64;
+
+	// callbacks this late or early are a stall of the stream, not jitter,
+	// the clock restarts from them instead of bending towards them
+	constexpr double maxClockErrorMicros = 250000;
+}
+
+//------------------------------------------------------------------------------
+ofSoundClock::ofSoundClock()
+:sequence(0)
+,frame(0)
+,micros(0)
+,microsPerFrame(0)
+,running(false)
+,sampleRate(44100)
+,bandwidth(1){
+
+}
+
+//------------------------------------------------------------------------------
+void ofSoundClock::setup(double rate, double bw){
+	sampleRate = rate;
+	bandwidth = bw;
+	reset();
+}
+
+//------------------------------------------------------------------------------
+void ofSoundClock::reset(){
+	running.store(false, std::memory_order_release);
+	store({0, 0, 1000000. / sampleRate});
+}
+
+//------------------------------------------------------------------------------
+ofSoundClock::State ofSoundClock::load() const{
+	State state;
+	uint32_t before, after;
+	do{
+		before = sequence.load(std::memory_order_acquire);
+		state.frame = frame.load(std::memory_order_relaxed);
+		state.micros = micros.load(std::memory_order_relaxed);
+		state.microsPerFrame = microsPerFrame.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		after = sequence.load(std::memory_order_relaxed);
+	}while(before != after || (before & 1));
+	return state;
+}
+
+//------------------------------------------------------------------------------
+void ofSoundClock::store(const State & state){
+	auto s = sequence.load(std::memory_order_relaxed);
+	sequence.store(s + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	frame.store(state.frame, std::memory_order_relaxed);
+	micros.store(state.micros, std::memory_order_relaxed);
+	microsPerFrame.store(state.microsPerFrame, std::memory_order_relaxed);
+	sequence.store(s + 2, std::memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+void ofSoundClock::update(uint64_t f, uint64_t now){
+	State state = load();
+	double nominal = 1000000. / sampleRate;
+	if(!running.load(std::memory_order_relaxed) || f <= state.frame){
+		store({f, double(now), running ? state.microsPerFrame : nominal});
+		running.store(true, std::memory_order_release);
+		return;
+	}
+
+	// second order delay locked loop: the time predicted for the frame is
+	// corrected by a part of the error and the period by a smaller one, with
+	// coefficients for a critically damped loop of the given bandwidth
+	double numFrames = double(f - state.frame);
+	double predicted = state.micros + numFrames * state.microsPerFrame;
+	double error = double(now) - predicted;
+	if(std::abs(error) > maxClockErrorMicros){
+		store({f, double(now), state.microsPerFrame});
+		return;
+	}
+	double omega = std::min(0.5, glm::two_pi<double>() * bandwidth * numFrames * state.microsPerFrame / 1000000.);
+	double b = glm::root_two<double>() * omega;
+	double c = omega * omega;
+	double period = state.microsPerFrame + c * error / numFrames;
+	// the device can't be more than a few percent off, this only keeps bad
+	// timings from making the period absurd
+	period = std::max(nominal * 0.9, std::min(nominal * 1.1, period));
+	store({f, predicted + b * error, period});
+}
+
+//------------------------------------------------------------------------------
+uint64_t ofSoundClock::getMicros(uint64_t f) const{
+	if(!isRunning()){
+		return 0;
+	}
+	State state = load();
+	double t = state.micros + double(int64_t(f - state.frame)) * state.microsPerFrame;
+	return t > 0 ? uint64_t(std::round(t)) : 0;
+}
+
+//------------------------------------------------------------------------------
+double ofSoundClock::getMeasuredSampleRate() const{
+	return 1000000. / load().microsPerFrame;
+}
+
+//------------------------------------------------------------------------------
+bool ofSoundClock::isRunning() const{
+	return running.load(std::memory_order_acquire);
+}
+
+//------------------------------------------------------------------------------
+ofSoundRingBuffer::ofSoundRingBuffer()
+:numChannels(0)
+,mask(0)
+,sampleRate(0)
+,writePosition(0)
+,readPosition(0)
+,numOverflows(0)
+,numOverflowFrames(0)
+,numUnderflows(0)
+,numUnderflowFrames(0)
+,unsentGap({0, 0})
+,hasUnsentGap(false)
+,inputStreamFrame(0)
+,nextGap({0, 0})
+,hasNextGap(false)
+,readGapFrames(0)
+,outputStreamFrame(0)
+,outputOffset(0){
+
+}
+
+//------------------------------------------------------------------------------
+void ofSoundRingBuffer::setup(std::size_t channels, std::size_t capacity, std::size_t rate){
+	std::size_t size = 1;
+	while(size < capacity){
+		size *= 2;
+	}
+	numChannels = std::max<std::size_t>(1, channels);
+	mask = size - 1;
+	sampleRate = rate;
+	samples.assign(size * numChannels, 0.f);
+	gaps.reset(new ofLockFreeThreadChannel<Gap>(gapsCapacity));
+	clock.setup(rate);
+	reset();
+}
+
+//------------------------------------------------------------------------------
+void ofSoundRingBuffer::reset(){
+	writePosition.store(0);
+	readPosition.store(0);
+	numOverflows.store(0);
+	numOverflowFrames.store(0);
+	numUnderflows.store(0);
+	numUnderflowFrames.store(0);
+	if(gaps){
+		gaps->clear();
+	}
+	hasUnsentGap = false;
+	inputStreamFrame = 0;
+	hasNextGap = false;
+	readGapFrames = 0;
+	outputStreamFrame = 0;
+	outputOffset.store(0);
+	clock.reset();
+}
+
+//------------------------------------------------------------------------------
+std::size_t ofSoundRingBuffer::write(const float * src, std::size_t numFrames){
+	if(samples.empty()){
+		ofLogError("ofSoundRingBuffer") << "write(): ring not allocated, call setup() first";
+		return 0;
+	}
+	uint64_t w = writePosition.load(std::memory_order_relaxed);
+	uint64_t r = readPosition.load(std::memory_order_acquire);
+	std::size_t numFree = getCapacity() - std::size_t(w - r);
+	std::size_t numWritten = std::min(numFrames, numFree);
+
+	// at most two copies, before and after the end of the ring
+	std::size_t start = std::size_t(w) & mask;
+	std::size_t first = std::min(numWritten, getCapacity() - start);
+	std::memcpy(&samples[start * numChannels], src, first * numChannels * sizeof(float));
+	std::memcpy(samples.data(), src + first * numChannels, (numWritten - first) * numChannels * sizeof(float));
+	writePosition.store(w + numWritten, std::memory_order_release);
+
+	if(numWritten < numFrames){
+		numOverflows.fetch_add(1, std::memory_order_relaxed);
+		numOverflowFrames.fetch_add(numFrames - numWritten, std::memory_order_relaxed);
+	}
+	return numWritten;
+}
+
+//------------------------------------------------------------------------------
+std::size_t ofSoundRingBuffer::write(const ofSoundBuffer & buffer){
+	if(buffer.getNumChannels() != numChannels){
+		ofLogError("ofSoundRingBuffer") << "write(): buffer has " << buffer.getNumChannels()
+			<< " channels, the ring " << numChannels;
+		return 0;
+	}
+	return write(buffer.getBuffer().data(), buffer.getNumFrames());
+}
+
+//------------------------------------------------------------------------------
+void ofSoundRingBuffer::receiveGaps(uint64_t position){
+	if(!gaps){
+		return;
+	}
+	while(true){
+		if(!hasNextGap){
+			if(!gaps->tryReceive(nextGap)){
+				return;
+			}
+			hasNextGap = true;
+		}
+		if(nextGap.position > position){
+			return;
+		}
+		readGapFrames += nextGap.numFrames;
+		hasNextGap = false;
+	}
+}
+
+//------------------------------------------------------------------------------
+std::size_t ofSoundRingBuffer::read(float * dst, std::size_t numFrames){
+	if(samples.empty()){
+		return 0;
+	}
+	// the gaps before a frame are sent before the frame is written, so any
+	// gap up to the write position loaded here can be received
+	uint64_t w = writePosition.load(std::memory_order_acquire);
+	uint64_t r = readPosition.load(std::memory_order_relaxed);
+	receiveGaps(r);
+	std::size_t numRead = std::min(numFrames, std::size_t(w - r));
+	if(hasNextGap){
+		numRead = std::min(numRead, std::size_t(nextGap.position - r));
+	}
+
+	std::size_t start = std::size_t(r) & mask;
+	std::size_t first = std::min(numRead, getCapacity() - start);
+	std::memcpy(dst, &samples[start * numChannels], first * numChannels * sizeof(float));
+	std::memcpy(dst + first * numChannels, samples.data(), (numRead - first) * numChannels * sizeof(float));
+	readPosition.store(r + numRead, std::memory_order_release);
+	receiveGaps(r + numRead);
+	return numRead;
+}
+
+//------------------------------------------------------------------------------
+std::size_t ofSoundRingBuffer::read(ofSoundBuffer & buffer){
+	if(samples.empty()){
+		ofLogError("ofSoundRingBuffer") << "read(): ring not allocated, call setup() first";
+		return 0;
+	}
+	if(buffer.getNumChannels() != numChannels){
+		buffer.setNumChannels(numChannels);
+		buffer.resize(buffer.getNumFrames() * numChannels);
+	}
+	std::size_t numFrames = buffer.getNumFrames();
+	float * dst = buffer.getBuffer().data();
+	std::size_t numRead = 0;
+	while(numRead < numFrames){
+		std::size_t n = read(dst + numRead * numChannels, numFrames - numRead);
+		if(n == 0){
+			break;
+		}
+		numRead += n;
+	}
+	if(numRead < numFrames){
+		std::memset(dst + numRead * numChannels, 0, (numFrames - numRead) * numChannels * sizeof(float));
+		numUnderflows.fetch_add(1, std::memory_order_relaxed);
+		numUnderflowFrames.fetch_add(numFrames - numRead, std::memory_order_relaxed);
+	}
+	return numRead;
+}
+
+//------------------------------------------------------------------------------
+std::size_t ofSoundRingBuffer::getNumFramesAvailable() const{
+	uint64_t w = writePosition.load(std::memory_order_acquire);
+	uint64_t r = readPosition.load(std::memory_order_acquire);
+	return w > r ? std::size_t(w - r) : 0;
+}
+
+//------------------------------------------------------------------------------
+std::size_t ofSoundRingBuffer::getNumFramesFree() const{
+	return samples.empty() ? 0 : getCapacity() - getNumFramesAvailable();
+}
+
+//------------------------------------------------------------------------------
+std::size_t ofSoundRingBuffer::getCapacity() const{
+	return samples.empty() ? 0 : mask + 1;
+}
+
+//------------------------------------------------------------------------------
+std::size_t ofSoundRingBuffer::getNumChannels() const{
+	return numChannels;
+}
+
+//------------------------------------------------------------------------------
+std::size_t ofSoundRingBuffer::getSampleRate() const{
+	return sampleRate;
+}
+
+//------------------------------------------------------------------------------
+uint64_t ofSoundRingBuffer::getNumOverflows() const{
+	return numOverflows.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+uint64_t ofSoundRingBuffer::getNumOverflowFrames() const{
+	return numOverflowFrames.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+uint64_t ofSoundRingBuffer::getNumUnderflows() const{
+	return numUnderflows.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+uint64_t ofSoundRingBuffer::getNumUnderflowFrames() const{
+	return numUnderflowFrames.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+uint64_t ofSoundRingBuffer::getReadStreamFrame(){
+	uint64_t r = readPosition.load(std::memory_order_relaxed);
+	receiveGaps(r);
+	return r + readGapFrames;
+}
+
+//------------------------------------------------------------------------------
+uint64_t ofSoundRingBuffer::getWriteStreamFrame() const{
+	// frames written while the ring isn't empty play right after the ones
+	// before them, only a later underflow could delay them
+	return writePosition.load(std::memory_order_relaxed) + outputOffset.load(std::memory_order_acquire);
+}
+
+//------------------------------------------------------------------------------
+uint64_t ofSoundRingBuffer::getTimeMicros(uint64_t streamFrame) const{
+	return clock.getMicros(streamFrame);
+}
+
+//------------------------------------------------------------------------------
+const ofSoundClock & ofSoundRingBuffer::getClock() const{
+	return clock;
+}
+
+//------------------------------------------------------------------------------
+void ofSoundRingBuffer::audioIn(ofSoundBuffer & buffer){
+	clock.update(inputStreamFrame, ofGetElapsedTimeMicros());
+	std::size_t numFrames = buffer.getNumFrames();
+	inputStreamFrame += numFrames;
+
+	if(hasUnsentGap){
+		hasUnsentGap = !gaps->trySend(unsentGap);
+	}
+	if(hasUnsentGap){
+		// nothing can be written after an unsent gap, it grows instead
+		unsentGap.numFrames += numFrames;
+		numOverflows.fetch_add(1, std::memory_order_relaxed);
+		numOverflowFrames.fetch_add(numFrames, std::memory_order_relaxed);
+		return;
+	}
+
+	std::size_t numWritten = write(buffer);
+	if(numWritten < numFrames){
+		unsentGap = {writePosition.load(std::memory_order_relaxed), numFrames - numWritten};
+		hasUnsentGap = !gaps->trySend(unsentGap);
+	}
+}
+
+//------------------------------------------------------------------------------
+void ofSoundRingBuffer::audioOut(ofSoundBuffer & buffer){
+	clock.update(outputStreamFrame, ofGetElapsedTimeMicros());
+	std::size_t numFrames = buffer.getNumFrames();
+	read(buffer);
+	outputStreamFrame += numFrames;
+	outputOffset.store(outputStreamFrame - readPosition.load(std::memory_order_relaxed), std::memory_order_release);
+}
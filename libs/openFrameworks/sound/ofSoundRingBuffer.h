@@ -0,0 +1,217 @@
+#pragma once
+
+#include "ofSoundBaseTypes.h"
+#include "ofLockFreeThreadChannel.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// \brief Maps frames of a sound stream to times in microseconds, as
+/// returned by ofGetElapsedTimeMicros().
+///
+/// The audio thread calls update() at the start of each callback with the
+/// number of frames the stream has processed so far. The times the
+/// callbacks run at jitter, so they're filtered with a delay locked loop
+/// that also estimates the real sample rate of the device. getMicros() can
+/// then be called from any thread to get the time of any frame, past or
+/// future.
+///
+/// The times are the ones at which the frames are passed to the callbacks,
+/// the latency of the device itself isn't known.
+class ofSoundClock{
+public:
+	ofSoundClock();
+
+	/// \param sampleRate nominal sample rate of the stream
+	/// \param bandwidth in Hz of the filter, lower values smooth more the
+	/// jitter of the callbacks but take longer to follow the device clock
+	void setup(double sampleRate, double bandwidth = 1);
+
+	/// \brief Forgets the previous updates, the next one starts the clock again.
+	void reset();
+
+	/// \brief Called by the audio thread when frame is passed to a callback at
+	/// the time micros.
+	void update(uint64_t frame, uint64_t micros);
+
+	/// \brief The time of a frame in microseconds, 0 before the first update.
+	uint64_t getMicros(uint64_t frame) const;
+
+	/// \brief The sample rate measured from the updates.
+	double getMeasuredSampleRate() const;
+
+	/// \brief True once update() has been called.
+	bool isRunning() const;
+
+private:
+	struct State{
+		uint64_t frame;
+		double micros;
+		double microsPerFrame;
+	};
+	State load() const;
+	void store(const State & state);
+
+	// written by the audio thread only, readers retry while sequence is odd
+	// or changed while they were reading
+	std::atomic<uint32_t> sequence;
+	std::atomic<uint64_t> frame;
+	std::atomic<double> micros;
+	std::atomic<double> microsPerFrame;
+	std::atomic<bool> running;
+	double sampleRate;
+	double bandwidth;
+};
+
+/// \brief Lock-free multichannel ring buffer to pass audio between a sound
+/// stream and the app thread.
+///
+/// One thread writes and another one reads, neither of them ever blocks or
+/// allocates, so the audio thread can't be stalled by the app.
+///
+/// It implements ofBaseSoundInput and ofBaseSoundOutput so it can be set as
+/// the input or output of an ofSoundStream directly. As an input it records
+/// what the stream receives for the app to read() in update:
+///
+/// ~~~~{.cpp}
+/// void ofApp::setup(){
+///     input.setup(2, 44100, 44100);
+///     ofSoundStreamSettings settings;
+///     settings.numInputChannels = 2;
+///     settings.setInListener(&input);
+///     stream.setup(settings);
+/// }
+///
+/// void ofApp::update(){
+///     auto frame = input.getReadStreamFrame();
+///     auto n = input.read(samples.data(), samples.size() / 2);
+///     // frame i < n was received at input.getTimeMicros(frame + i)
+/// }
+/// ~~~~
+///
+/// read() returns fewer frames than requested when it reaches frames the
+/// stream dropped on an overflow, the next call continues after them.
+///
+/// As an output it plays what the app write()s, with silence when there's
+/// nothing left to play.
+///
+/// When the writer finds the ring full the frames that don't fit are
+/// dropped and counted as an overflow; when audioOut finds it empty the
+/// missing frames are silent and counted as an underflow. Stream frames
+/// count every frame the stream processed, including the dropped or silent
+/// ones, so the frames read always map to the time they were received at.
+///
+/// A ring is meant to be either the input or the output of a stream, not
+/// both, since the clock follows the callbacks of the stream.
+class ofSoundRingBuffer: public ofBaseSoundInput, public ofBaseSoundOutput{
+public:
+	ofSoundRingBuffer();
+
+	/// \brief Allocates the ring, not thread safe.
+	///
+	/// \param capacity in frames, rounded up to a power of 2
+	void setup(std::size_t numChannels, std::size_t capacity, std::size_t sampleRate);
+
+	/// \brief Empties the ring and resets the counters and clock, not thread safe.
+	void reset();
+
+	/// \brief Writes up to numFrames frames, returns the frames written.
+	/// The rest are dropped and counted as an overflow.
+	std::size_t write(const float * samples, std::size_t numFrames);
+	std::size_t write(const ofSoundBuffer & buffer);
+
+	/// \brief Reads up to numFrames available frames, returns the frames read.
+	///
+	/// When the ring is a stream input it stops before frames the stream
+	/// dropped, so the frames read always start at getReadStreamFrame() and
+	/// are consecutive, calling it again reads the ones after the gap.
+	std::size_t read(float * samples, std::size_t numFrames);
+
+	/// \brief Fills buffer completely, frames that aren't available are
+	/// silent and counted as an underflow. Returns the frames read.
+	///
+	/// buffer keeps its number of frames, it's only allocated if it doesn't
+	/// have the channels of the ring.
+	std::size_t read(ofSoundBuffer & buffer);
+
+	/// \brief Frames that can be read, approximate outside of the reading thread.
+	std::size_t getNumFramesAvailable() const;
+	/// \brief Frames that can be written, approximate outside of the writing thread.
+	std::size_t getNumFramesFree() const;
+
+	std::size_t getCapacity() const;
+	std::size_t getNumChannels() const;
+	std::size_t getSampleRate() const;
+
+	/// \brief Times writes didn't fit in the ring.
+	uint64_t getNumOverflows() const;
+	/// \brief Frames dropped because they didn't fit.
+	uint64_t getNumOverflowFrames() const;
+	/// \brief Times the ring didn't have enough frames to fill a buffer.
+	uint64_t getNumUnderflows() const;
+	/// \brief Silent frames inserted because there was nothing to read.
+	uint64_t getNumUnderflowFrames() const;
+
+	/// \brief Stream frame of the next frame read, for the reading thread
+	/// when the ring is a stream input.
+	uint64_t getReadStreamFrame();
+	/// \brief Stream frame the next frame written will approximately play
+	/// at, for the writing thread when the ring is a stream output.
+	uint64_t getWriteStreamFrame() const;
+
+	/// \brief The time in microseconds a stream frame was received or
+	/// requested at by the stream, see ofSoundClock.
+	uint64_t getTimeMicros(uint64_t streamFrame) const;
+	const ofSoundClock & getClock() const;
+
+	/// \brief Writes buffer as the stream's input.
+	void audioIn(ofSoundBuffer & buffer) override;
+	/// \brief Fills buffer with the frames written by the app as the stream's output.
+	void audioOut(ofSoundBuffer & buffer) override;
+
+	using ofBaseSoundInput::audioIn;
+	using ofBaseSoundOutput::audioOut;
+
+private:
+	/// \brief Input frames the stream passed to audioIn that were dropped
+	/// before the frame at ring position.
+	struct Gap{
+		uint64_t position;
+		uint64_t numFrames;
+	};
+	void receiveGaps(uint64_t position);
+
+	std::vector<float> samples;
+	std::size_t numChannels;
+	std::size_t mask;
+	std::size_t sampleRate;
+	ofSoundClock clock;
+
+	// positions in frames since setup, kept apart to avoid false sharing
+	alignas(64) std::atomic<uint64_t> writePosition;
+	alignas(64) std::atomic<uint64_t> readPosition;
+
+	alignas(64) std::atomic<uint64_t> numOverflows;
+	std::atomic<uint64_t> numOverflowFrames;
+	std::atomic<uint64_t> numUnderflows;
+	std::atomic<uint64_t> numUnderflowFrames;
+
+	// writer side of the input: gaps are sent to the reader before any frame
+	// after them is written, while one can't be sent every new frame is
+	// dropped into it so stream frames stay exact
+	std::unique_ptr<ofLockFreeThreadChannel<Gap>> gaps;
+	Gap unsentGap;
+	bool hasUnsentGap;
+	uint64_t inputStreamFrame;
+
+	// reader side of the input
+	Gap nextGap;
+	bool hasNextGap;
+	uint64_t readGapFrames;
+
+	// output: stream frame minus ring position of the frames being played,
+	// the silent frames inserted so far
+	uint64_t outputStreamFrame;
+	std::atomic<uint64_t> outputOffset;
+};
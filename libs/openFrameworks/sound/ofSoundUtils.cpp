@@ -0,0 +1,349 @@
+#include "ofSoundUtils.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+// the reductions keep 8 partial results that are combined at the end, that
+// way the compiler can vectorize them without fast math, which it can't do
+// for a single float accumulator since it would change the result.
+// loops over interleaved frames are specialized for mono and stereo so
+// their inner loops have constant bounds.
+
+namespace{
+	constexpr std::size_t lanes = 8;
+
+	// the rms is accumulated in floats in blocks of this many samples and the
+	// blocks are added in a double so long buffers don't lose precision
+	constexpr std::size_t rmsBlock = 4096;
+
+	constexpr float shortScale = std::numeric_limits<short>::max();
+	constexpr float int24Scale = 8388607;
+
+	// the ramps index frames with an int, converting it to float vectorizes
+	// while converting a size_t doesn't on most targets
+	template<std::size_t Channels>
+	void gainRamp(float * samples, std::size_t numFrames, float startGain, float step){
+		for(int i = 0; i < int(numFrames); i++){
+			float gain = startGain + step * i;
+			for(std::size_t c = 0; c < Channels; c++){
+				samples[i * Channels + c] *= gain;
+			}
+		}
+	}
+
+	void gainRamp(float * samples, std::size_t numFrames, std::size_t numChannels, float startGain, float step){
+		for(int i = 0; i < int(numFrames); i++){
+			float gain = startGain + step * i;
+			for(std::size_t c = 0; c < numChannels; c++){
+				samples[i * numChannels + c] *= gain;
+			}
+		}
+	}
+
+	template<std::size_t Channels>
+	void mixRamp(float * out, const float * in, std::size_t numFrames, float startGain, float step){
+		for(int i = 0; i < int(numFrames); i++){
+			float gain = startGain + step * i;
+			for(std::size_t c = 0; c < Channels; c++){
+				out[i * Channels + c] += in[i * Channels + c] * gain;
+			}
+		}
+	}
+
+	void mixRamp(float * out, const float * in, std::size_t numFrames, std::size_t numChannels, float startGain, float step){
+		for(int i = 0; i < int(numFrames); i++){
+			float gain = startGain + step * i;
+			for(std::size_t c = 0; c < numChannels; c++){
+				out[i * numChannels + c] += in[i * numChannels + c] * gain;
+			}
+		}
+	}
+
+	float rampStep(std::size_t numFrames, float startGain, float endGain){
+		return numFrames > 0 ? (endGain - startGain) / numFrames : 0;
+	}
+
+	float sumSquares(const float * samples, std::size_t numSamples){
+		float acc[lanes] = {};
+		std::size_t i = 0;
+		for(; i + lanes <= numSamples; i += lanes){
+			for(std::size_t j = 0; j < lanes; j++){
+				acc[j] += samples[i + j] * samples[i + j];
+			}
+		}
+		for(; i < numSamples; i++){
+			acc[0] += samples[i] * samples[i];
+		}
+		float sum = 0;
+		for(std::size_t j = 0; j < lanes; j++){
+			sum += acc[j];
+		}
+		return sum;
+	}
+
+	template<typename T>
+	void copyChannel(const T * in, std::size_t inChannels, std::size_t inChannel, T * out, std::size_t outChannels, std::size_t outChannel, std::size_t numFrames){
+		in += inChannel;
+		out += outChannel;
+		for(std::size_t i = 0; i < numFrames; i++){
+			out[i * outChannels] = in[i * inChannels];
+		}
+	}
+
+	template<typename T>
+	void interleave(const T * const * channels, T * out, std::size_t numFrames, std::size_t numChannels){
+		if(numChannels == 2){
+			const T * left = channels[0];
+			const T * right = channels[1];
+			for(std::size_t i = 0; i < numFrames; i++){
+				out[i * 2] = left[i];
+				out[i * 2 + 1] = right[i];
+			}
+		}else{
+			for(std::size_t c = 0; c < numChannels; c++){
+				const T * channel = channels[c];
+				for(std::size_t i = 0; i < numFrames; i++){
+					out[i * numChannels + c] = channel[i];
+				}
+			}
+		}
+	}
+
+	template<typename T>
+	void deinterleave(const T * in, T * const * channels, std::size_t numFrames, std::size_t numChannels){
+		if(numChannels == 2){
+			T * left = channels[0];
+			T * right = channels[1];
+			for(std::size_t i = 0; i < numFrames; i++){
+				left[i] = in[i * 2];
+				right[i] = in[i * 2 + 1];
+			}
+		}else{
+			for(std::size_t c = 0; c < numChannels; c++){
+				T * channel = channels[c];
+				for(std::size_t i = 0; i < numFrames; i++){
+					channel[i] = in[i * numChannels + c];
+				}
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+void ofSoundApplyGain(float * samples, std::size_t numSamples, float gain){
+	for(std::size_t i = 0; i < numSamples; i++){
+		samples[i] *= gain;
+	}
+}
+
+//------------------------------------------------------------------------------
+void ofSoundApplyGainRamp(float * samples, std::size_t numFrames, std::size_t numChannels, float startGain, float endGain){
+	if(startGain == endGain){
+		ofSoundApplyGain(samples, numFrames * numChannels, startGain);
+		return;
+	}
+	float step = rampStep(numFrames, startGain, endGain);
+	switch(numChannels){
+		case 1:
+			gainRamp<1>(samples, numFrames, startGain, step);
+			break;
+		case 2:
+			gainRamp<2>(samples, numFrames, startGain, step);
+			break;
+		default:
+			gainRamp(samples, numFrames, numChannels, startGain, step);
+			break;
+	}
+}
+
+//------------------------------------------------------------------------------
+void ofSoundMultiply(float * samples, const float * by, std::size_t numSamples){
+	for(std::size_t i = 0; i < numSamples; i++){
+		samples[i] *= by[i];
+	}
+}
+
+//------------------------------------------------------------------------------
+void ofSoundMix(float * out, const float * in, std::size_t numSamples, float gain){
+	for(std::size_t i = 0; i < numSamples; i++){
+		out[i] += in[i] * gain;
+	}
+}
+
+//------------------------------------------------------------------------------
+void ofSoundMixRamp(float * out, const float * in, std::size_t numFrames, std::size_t numChannels, float startGain, float endGain){
+	if(startGain == endGain){
+		ofSoundMix(out, in, numFrames * numChannels, startGain);
+		return;
+	}
+	float step = rampStep(numFrames, startGain, endGain);
+	switch(numChannels){
+		case 1:
+			mixRamp<1>(out, in, numFrames, startGain, step);
+			break;
+		case 2:
+			mixRamp<2>(out, in, numFrames, startGain, step);
+			break;
+		default:
+			mixRamp(out, in, numFrames, numChannels, startGain, step);
+			break;
+	}
+}
+
+//------------------------------------------------------------------------------
+void ofSoundMix(float * out, const ofSoundMixSource * sources, std::size_t numSources, std::size_t numFrames, std::size_t numChannels){
+	std::fill(out, out + numFrames * numChannels, 0.f);
+	for(std::size_t i = 0; i < numSources; i++){
+		ofSoundMixRamp(out, sources[i].samples, numFrames, numChannels, sources[i].startGain, sources[i].endGain);
+	}
+}
+
+//------------------------------------------------------------------------------
+void ofSoundStereoGain(float * stereo, std::size_t numFrames, float left, float right){
+	for(std::size_t i = 0; i < numFrames; i++){
+		stereo[i * 2] *= left;
+		stereo[i * 2 + 1] *= right;
+	}
+}
+
+//------------------------------------------------------------------------------
+void ofSoundPan(const float * mono, float * stereo, std::size_t numFrames, float volume, float pan){
+	float left, right;
+	ofStereoVolumes(volume, pan, left, right);
+	for(std::size_t i = 0; i < numFrames; i++){
+		stereo[i * 2] = mono[i] * left;
+		stereo[i * 2 + 1] = mono[i] * right;
+	}
+}
+
+//------------------------------------------------------------------------------
+float ofSoundPeak(const float * samples, std::size_t numSamples){
+	// the bits of positive floats sort in the same order as unsigned ints, an
+	// integer max vectorizes while a float one needs fast math. NaNs sort
+	// above infinity and are skipped
+	uint32_t peak = 0;
+	for(std::size_t i = 0; i < numSamples; i++){
+		uint32_t bits;
+		std::memcpy(&bits, samples + i, sizeof(bits));
+		bits &= 0x7fffffff;
+		bits = bits > 0x7f800000 ? 0 : bits;
+		peak = std::max(peak, bits);
+	}
+	float value;
+	std::memcpy(&value, &peak, sizeof(value));
+	return value;
+}
+
+//------------------------------------------------------------------------------
+float ofSoundPeak(const float * samples, std::size_t numFrames, std::size_t numChannels, std::size_t channel){
+	if(numChannels == 1){
+		return ofSoundPeak(samples, numFrames);
+	}
+	float peak = 0;
+	for(std::size_t i = 0; i < numFrames; i++){
+		peak = std::max(peak, std::abs(samples[i * numChannels + channel]));
+	}
+	return peak;
+}
+
+//------------------------------------------------------------------------------
+float ofSoundRMS(const float * samples, std::size_t numSamples){
+	if(numSamples == 0){
+		return 0;
+	}
+	double sum = 0;
+	for(std::size_t i = 0; i < numSamples; i += rmsBlock){
+		sum += sumSquares(samples + i, std::min(rmsBlock, numSamples - i));
+	}
+	return std::sqrt(sum / numSamples);
+}
+
+//------------------------------------------------------------------------------
+float ofSoundRMS(const float * samples, std::size_t numFrames, std::size_t numChannels, std::size_t channel){
+	if(numChannels == 1){
+		return ofSoundRMS(samples, numFrames);
+	}
+	if(numFrames == 0){
+		return 0;
+	}
+	double acc = 0;
+	for(std::size_t i = 0; i < numFrames; i++){
+		float sample = samples[i * numChannels + channel];
+		acc += sample * sample;
+	}
+	return std::sqrt(acc / numFrames);
+}
+
+//------------------------------------------------------------------------------
+void ofSoundShortToFloat(const short * in, float * out, std::size_t numSamples){
+	for(std::size_t i = 0; i < numSamples; i++){
+		out[i] = in[i] / shortScale;
+	}
+}
+
+//------------------------------------------------------------------------------
+void ofSoundFloatToShort(const float * in, short * out, std::size_t numSamples){
+	// clamped before converting, floats out of the range of int can't be
+	// converted. NaN is silent
+	for(std::size_t i = 0; i < numSamples; i++){
+		float value = in[i] * shortScale;
+		value = value == value ? value : 0.f;
+		value = value > 32767.f ? 32767.f : value;
+		value = value < -32768.f ? -32768.f : value;
+		out[i] = short(value);
+	}
+}
+
+//------------------------------------------------------------------------------
+void ofSoundInt24ToFloat(const unsigned char * in, float * out, std::size_t numSamples){
+	for(std::size_t i = 0; i < numSamples; i++, in += 3){
+		// shift into the top of an int so the sign is extended when shifting back
+		int32_t value = int32_t(uint32_t(in[0]) << 8 | uint32_t(in[1]) << 16 | uint32_t(in[2]) << 24) >> 8;
+		out[i] = value / int24Scale;
+	}
+}
+
+//------------------------------------------------------------------------------
+void ofSoundFloatToInt24(const float * in, unsigned char * out, std::size_t numSamples){
+	for(std::size_t i = 0; i < numSamples; i++, out += 3){
+		float sample = in[i] * int24Scale;
+		sample = sample == sample ? sample : 0.f;
+		sample = sample > 8388607.f ? 8388607.f : sample;
+		sample = sample < -8388608.f ? -8388608.f : sample;
+		int32_t value = int32_t(sample);
+		out[0] = value & 0xff;
+		out[1] = (value >> 8) & 0xff;
+		out[2] = (value >> 16) & 0xff;
+	}
+}
+
+//------------------------------------------------------------------------------
+void ofSoundCopyChannel(const float * in, std::size_t inChannels, std::size_t inChannel, float * out, std::size_t outChannels, std::size_t outChannel, std::size_t numFrames){
+	copyChannel(in, inChannels, inChannel, out, outChannels, outChannel, numFrames);
+}
+
+//------------------------------------------------------------------------------
+void ofSoundCopyChannel(const short * in, std::size_t inChannels, std::size_t inChannel, short * out, std::size_t outChannels, std::size_t outChannel, std::size_t numFrames){
+	copyChannel(in, inChannels, inChannel, out, outChannels, outChannel, numFrames);
+}
+
+//------------------------------------------------------------------------------
+void ofSoundInterleave(const float * const * channels, float * out, std::size_t numFrames, std::size_t numChannels){
+	interleave(channels, out, numFrames, numChannels);
+}
+
+//------------------------------------------------------------------------------
+void ofSoundInterleave(const short * const * channels, short * out, std::size_t numFrames, std::size_t numChannels){
+	interleave(channels, out, numFrames, numChannels);
+}
+
+//------------------------------------------------------------------------------
+void ofSoundDeinterleave(const float * in, float * const * channels, std::size_t numFrames, std::size_t numChannels){
+	deinterleave(in, channels, numFrames, numChannels);
+}
+
+//------------------------------------------------------------------------------
+void ofSoundDeinterleave(const short * in, short * const * channels, std::size_t numFrames, std::size_t numChannels){
+	deinterleave(in, channels, numFrames, numChannels);
+}
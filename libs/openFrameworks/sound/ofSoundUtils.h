@@ -15,6 +15,8 @@
 #endif
 #include <glm/gtc/constants.hpp>
 #include <glm/ext/scalar_common.hpp>
+#include <cmath>
+#include <cstddef>
 
 
 inline void ofStereoVolumes(float volume, float pan, float & left, float & right){
@@ -31,3 +33,80 @@ inline void ofStereoVolumes(float volume, float pan, float & left, float & right
 	left  = (cosAngle - sinAngle) * v;
 	right = (cosAngle + sinAngle) * v;
 }
+
+/// \name Sound DSP kernels
+/// \{
+///
+/// Loops over raw interleaved float samples used by ofSoundBuffer and the
+/// sound players. They are written so the compiler can vectorize them and
+/// none of them allocate, so they can be used in audio callbacks.
+
+/// \brief Multiplies numSamples samples by gain.
+void ofSoundApplyGain(float * samples, std::size_t numSamples, float gain);
+
+/// \brief Multiplies each frame by a gain that goes linearly from startGain
+/// to endGain, to change the volume without clicks.
+void ofSoundApplyGainRamp(float * samples, std::size_t numFrames, std::size_t numChannels, float startGain, float endGain);
+
+/// \brief Multiplies samples by the samples in by, eg. a window for an fft.
+void ofSoundMultiply(float * samples, const float * by, std::size_t numSamples);
+
+/// \brief Adds the samples in in multiplied by gain to out.
+void ofSoundMix(float * out, const float * in, std::size_t numSamples, float gain = 1);
+
+/// \brief Adds the frames in in to out with a gain ramp from startGain to endGain.
+void ofSoundMixRamp(float * out, const float * in, std::size_t numFrames, std::size_t numChannels, float startGain, float endGain);
+
+/// \brief A source for ofSoundMix, with the same number of frames and channels as the output.
+struct ofSoundMixSource{
+	const float * samples;
+	float startGain;
+	float endGain;
+};
+
+/// \brief Overwrites out with the sum of numSources sources, each with its own gain ramp.
+void ofSoundMix(float * out, const ofSoundMixSource * sources, std::size_t numSources, std::size_t numFrames, std::size_t numChannels);
+
+/// \brief Multiplies the left and right samples of a stereo signal by left and right.
+void ofSoundStereoGain(float * stereo, std::size_t numFrames, float left, float right);
+
+/// \brief Pans a mono signal to stereo with constant power, see ofStereoVolumes.
+void ofSoundPan(const float * mono, float * stereo, std::size_t numFrames, float volume, float pan);
+
+/// \brief The maximum absolute value of the samples.
+float ofSoundPeak(const float * samples, std::size_t numSamples);
+
+/// \brief The maximum absolute value of channel in interleaved samples.
+float ofSoundPeak(const float * samples, std::size_t numFrames, std::size_t numChannels, std::size_t channel);
+
+/// \brief The root mean square of the samples, 0 if there are none.
+float ofSoundRMS(const float * samples, std::size_t numSamples);
+
+/// \brief The root mean square of channel in interleaved samples.
+float ofSoundRMS(const float * samples, std::size_t numFrames, std::size_t numChannels, std::size_t channel);
+
+/// \brief Converts 16 bit samples to floats between -1 and 1.
+void ofSoundShortToFloat(const short * in, float * out, std::size_t numSamples);
+
+/// \brief Converts floats to 16 bit samples, clamping values outside -1..1.
+void ofSoundFloatToShort(const float * in, short * out, std::size_t numSamples);
+
+/// \brief Converts packed little endian 24 bit samples, 3 bytes each, to floats.
+void ofSoundInt24ToFloat(const unsigned char * in, float * out, std::size_t numSamples);
+
+/// \brief Converts floats to packed little endian 24 bit samples, clamping values outside -1..1.
+void ofSoundFloatToInt24(const float * in, unsigned char * out, std::size_t numSamples);
+
+/// \brief Copies numFrames samples of inChannel in in to outChannel in out.
+void ofSoundCopyChannel(const float * in, std::size_t inChannels, std::size_t inChannel, float * out, std::size_t outChannels, std::size_t outChannel, std::size_t numFrames);
+void ofSoundCopyChannel(const short * in, std::size_t inChannels, std::size_t inChannel, short * out, std::size_t outChannels, std::size_t outChannel, std::size_t numFrames);
+
+/// \brief Interleaves numChannels separate channels into out.
+void ofSoundInterleave(const float * const * channels, float * out, std::size_t numFrames, std::size_t numChannels);
+void ofSoundInterleave(const short * const * channels, short * out, std::size_t numFrames, std::size_t numChannels);
+
+/// \brief Splits interleaved samples into numChannels separate channels.
+void ofSoundDeinterleave(const float * in, float * const * channels, std::size_t numFrames, std::size_t numChannels);
+void ofSoundDeinterleave(const short * in, short * const * channels, std::size_t numFrames, std::size_t numChannels);
+
+/// \}
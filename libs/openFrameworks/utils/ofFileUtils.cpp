@@ -1,11 +1,16 @@
 #include "ofFileUtils.h"
 #include "ofLog.h"
 #include "ofUtils.h"
+#include <cstring>
 
 #ifndef TARGET_WIN32
 	#include <pwd.h>
 	#include <sys/stat.h>
+	#include <sys/mman.h>
+	#include <fcntl.h>
 	#include <unistd.h>
+#else
+	#include <windows.h>
 #endif
 
 #ifdef TARGET_OSX
@@ -73,6 +78,46 @@ namespace of{
 //------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------
 
+//--------------------------------------------------
+struct ofBuffer::Mapping{
+	char * data = nullptr;
+	std::size_t size = 0;
+#ifdef TARGET_WIN32
+	HANDLE file = INVALID_HANDLE_VALUE;
+	HANDLE fileMapping = nullptr;
+#endif
+
+	~Mapping(){
+	#ifdef TARGET_WIN32
+		if(data){
+			UnmapViewOfFile(data);
+		}
+		if(fileMapping){
+			CloseHandle(fileMapping);
+		}
+		if(file != INVALID_HANDLE_VALUE){
+			CloseHandle(file);
+		}
+	#else
+		if(data){
+			munmap(data, size);
+		}
+	#endif
+	}
+
+	void advise(ofBuffer::AccessHint hint){
+	#ifndef TARGET_WIN32
+		int advice = MADV_NORMAL;
+		switch(hint){
+			case ofBuffer::Sequential: advice = MADV_SEQUENTIAL; break;
+			case ofBuffer::Random: advice = MADV_RANDOM; break;
+			case ofBuffer::Normal: break;
+		}
+		madvise(data, size, advice);
+	#endif
+	}
+};
+
 //--------------------------------------------------
 ofBuffer::ofBuffer()
 :currentLine(end(),end()){
@@ -96,7 +141,7 @@ bool ofBuffer::set(istream & stream, std::size_t ioBlockSize){
 		clear();
 		return false;
 	}else{
-		buffer.clear();
+		clear();
 	}
 
 	vector<char> aux_buffer(ioBlockSize);
@@ -107,8 +152,88 @@ bool ofBuffer::set(istream & stream, std::size_t ioBlockSize){
 	return true;
 }
 
+//--------------------------------------------------
+bool ofBuffer::mapFile(const fs::path & path, AccessHint hint){
+	clear();
+	auto mapped = std::make_shared<Mapping>();
+	auto filePath = ofToDataPathFS(path, true);
+#ifdef TARGET_WIN32
+	mapped->file = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if(mapped->file == INVALID_HANDLE_VALUE){
+		ofLogError("ofBuffer") << "mapFile(): couldn't open " << path;
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	if(!GetFileSizeEx(mapped->file, &fileSize)){
+		ofLogError("ofBuffer") << "mapFile(): couldn't get the size of " << path;
+		return false;
+	}
+	if(fileSize.QuadPart == 0){
+		return false;
+	}
+	mapped->fileMapping = CreateFileMappingW(mapped->file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	if(!mapped->fileMapping){
+		ofLogError("ofBuffer") << "mapFile(): couldn't map " << path;
+		return false;
+	}
+	mapped->data = static_cast<char*>(MapViewOfFile(mapped->fileMapping, FILE_MAP_COPY, 0, 0, 0));
+	if(!mapped->data){
+		ofLogError("ofBuffer") << "mapFile(): couldn't map " << path;
+		return false;
+	}
+	mapped->size = fileSize.QuadPart;
+#else
+	int fd = open(filePath.c_str(), O_RDONLY);
+	if(fd < 0){
+		ofLogError("ofBuffer") << "mapFile(): couldn't open " << path << ": " << strerror(errno);
+		return false;
+	}
+	struct stat fileStat;
+	if(fstat(fd, &fileStat) != 0 || fileStat.st_size == 0){
+		::close(fd);
+		return false;
+	}
+	// private and writable so getData() can be written to like a normal
+	// buffer, pages are only copied if they are actually modified
+	void * data = mmap(nullptr, fileStat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if(data == MAP_FAILED){
+		ofLogError("ofBuffer") << "mapFile(): couldn't map " << path << ": " << strerror(errno);
+		return false;
+	}
+	mapped->data = static_cast<char*>(data);
+	mapped->size = fileStat.st_size;
+#endif
+	mapped->advise(hint);
+	mapping = mapped;
+	buffer.clear();
+	buffer.shrink_to_fit();
+	return true;
+}
+
+//--------------------------------------------------
+void ofBuffer::setAccessHint(AccessHint hint){
+	if(mapping){
+		mapping->advise(hint);
+	}
+}
+
+//--------------------------------------------------
+bool ofBuffer::isMapped() const{
+	return mapping != nullptr;
+}
+
+//--------------------------------------------------
+void ofBuffer::unmap(){
+	if(mapping){
+		buffer.assign(mapping->data, mapping->data + mapping->size);
+		mapping.reset();
+	}
+}
+
 //--------------------------------------------------
 void ofBuffer::setall(char mem){
+	unmap();
 	buffer.assign(buffer.size(), mem);
 }
 
@@ -117,13 +242,20 @@ bool ofBuffer::writeTo(ostream & stream) const {
 	if(stream.bad()){
 		return false;
 	}
-	stream.write(buffer.data(), buffer.size());
+	stream.write(getData(), size());
 	return stream.good();
 }
 
 //--------------------------------------------------
 void ofBuffer::set(const char * buffer, std::size_t size){
-	this->buffer.assign(buffer, buffer+size);
+	if(mapping){
+		// buffer could point into the mapping, copy it before unmapping
+		std::vector<char> copy(buffer, buffer + size);
+		this->buffer.swap(copy);
+		mapping.reset();
+	}else{
+		this->buffer.assign(buffer, buffer+size);
+	}
 }
 
 //--------------------------------------------------
@@ -138,16 +270,28 @@ void ofBuffer::append(const std::string& buffer){
 
 //--------------------------------------------------
 void ofBuffer::append(const char * buffer, std::size_t size){
-	this->buffer.insert(this->buffer.end(), buffer, buffer + size);
+	if(mapping){
+		// buffer could point into the mapping, copy it before unmapping
+		std::vector<char> copy;
+		copy.reserve(mapping->size + size);
+		copy.insert(copy.end(), mapping->data, mapping->data + mapping->size);
+		copy.insert(copy.end(), buffer, buffer + size);
+		this->buffer.swap(copy);
+		mapping.reset();
+	}else{
+		this->buffer.insert(this->buffer.end(), buffer, buffer + size);
+	}
 }
 
 //--------------------------------------------------
 void ofBuffer::reserve(std::size_t size){
+	unmap();
 	buffer.reserve(size);
 }
 
 //--------------------------------------------------
 void ofBuffer::clear(){
+	mapping.reset();
 	buffer.clear();
 }
 
@@ -158,18 +302,24 @@ void ofBuffer::allocate(std::size_t size){
 
 //--------------------------------------------------
 void ofBuffer::resize(std::size_t size){
+	unmap();
 	buffer.resize(size);
 }
 
 
 //--------------------------------------------------
 char * ofBuffer::getData(){
-	return buffer.data();
+	// copies share the mapping, one that can be written to gets its own
+	// contents so the others don't see the writes
+	if(mapping && mapping.use_count() > 1){
+		unmap();
+	}
+	return mapping ? mapping->data : buffer.data();
 }
 
 //--------------------------------------------------
 const char * ofBuffer::getData() const{
-	return buffer.data();
+	return mapping ? mapping->data : buffer.data();
 }
 
 //--------------------------------------------------
@@ -184,10 +334,10 @@ const char * ofBuffer::getBinaryBuffer() const {
 
 //--------------------------------------------------
 string ofBuffer::getText() const {
-	if(buffer.empty()){
+	if(size() == 0){
 		return "";
 	}
-	return std::string(buffer.begin(), buffer.end());
+	return std::string(begin(), end());
 }
 
 //--------------------------------------------------
@@ -203,7 +353,7 @@ ofBuffer & ofBuffer::operator=(const std::string & text){
 
 //--------------------------------------------------
 std::size_t ofBuffer::size() const {
-	return buffer.size();
+	return mapping ? mapping->size : buffer.size();
 }
 
 //--------------------------------------------------
@@ -233,47 +383,47 @@ void ofBuffer::resetLineReader(){
 }
 
 //--------------------------------------------------
-vector<char>::iterator ofBuffer::begin(){
-	return buffer.begin();
+ofBuffer::iterator ofBuffer::begin(){
+	return getData();
 }
 
 //--------------------------------------------------
-vector<char>::iterator ofBuffer::end(){
-	return buffer.end();
+ofBuffer::iterator ofBuffer::end(){
+	return getData() + size();
 }
 
 //--------------------------------------------------
-vector<char>::const_iterator ofBuffer::begin() const{
-	return buffer.begin();
+ofBuffer::const_iterator ofBuffer::begin() const{
+	return getData();
 }
 
 //--------------------------------------------------
-vector<char>::const_iterator ofBuffer::end() const{
-	return buffer.end();
+ofBuffer::const_iterator ofBuffer::end() const{
+	return getData() + size();
 }
 
 //--------------------------------------------------
-vector<char>::reverse_iterator ofBuffer::rbegin(){
-	return buffer.rbegin();
+ofBuffer::reverse_iterator ofBuffer::rbegin(){
+	return reverse_iterator(end());
 }
 
 //--------------------------------------------------
-vector<char>::reverse_iterator ofBuffer::rend(){
-	return buffer.rend();
+ofBuffer::reverse_iterator ofBuffer::rend(){
+	return reverse_iterator(begin());
 }
 
 //--------------------------------------------------
-vector<char>::const_reverse_iterator ofBuffer::rbegin() const{
-	return buffer.rbegin();
+ofBuffer::const_reverse_iterator ofBuffer::rbegin() const{
+	return const_reverse_iterator(end());
 }
 
 //--------------------------------------------------
-vector<char>::const_reverse_iterator ofBuffer::rend() const{
-	return buffer.rend();
+ofBuffer::const_reverse_iterator ofBuffer::rend() const{
+	return const_reverse_iterator(begin());
 }
 
 //--------------------------------------------------
-ofBuffer::Line::Line(vector<char>::iterator _begin, vector<char>::iterator _end)
+ofBuffer::Line::Line(iterator _begin, iterator _end)
 	:_current(_begin)
 	,_begin(_begin)
 	,_end(_end){
@@ -284,7 +434,7 @@ ofBuffer::Line::Line(vector<char>::iterator _begin, vector<char>::iterator _end)
 	}
 
 	_current = std::find(_begin, _end, '\n');
-	if(_current - 1 >= _begin && *(_current - 1) == '\r'){
+	if(_current != _begin && *(_current - 1) == '\r'){
 		line = string(_begin, _current - 1);
 	}else{
 		line = string(_begin, _current);
@@ -339,7 +489,7 @@ bool ofBuffer::Line::empty() const{
 
 
 //--------------------------------------------------
-ofBuffer::RLine::RLine(vector<char>::reverse_iterator _rbegin, vector<char>::reverse_iterator _rend)
+ofBuffer::RLine::RLine(reverse_iterator _rbegin, reverse_iterator _rend)
 	:_current(_rbegin)
 	,_rbegin(_rbegin)
 	,_rend(_rend){
@@ -398,7 +548,7 @@ bool ofBuffer::RLine::empty() const{
 }
 
 //--------------------------------------------------
-ofBuffer::Lines::Lines(vector<char>::iterator begin, vector<char>::iterator end)
+ofBuffer::Lines::Lines(iterator begin, iterator end)
 :_begin(begin)
 ,_end(end){}
 
@@ -414,7 +564,7 @@ ofBuffer::Line ofBuffer::Lines::end(){
 
 
 //--------------------------------------------------
-ofBuffer::RLines::RLines(vector<char>::reverse_iterator rbegin, vector<char>::reverse_iterator rend)
+ofBuffer::RLines::RLines(reverse_iterator rbegin, reverse_iterator rend)
 :_rbegin(rbegin)
 ,_rend(rend){}
 
@@ -430,12 +580,16 @@ ofBuffer::RLine ofBuffer::RLines::end(){
 
 //--------------------------------------------------
 ofBuffer::Lines ofBuffer::getLines(){
-	return ofBuffer::Lines(begin(), end());
+	// lines only read the contents, so a shared mapping doesn't need to be
+	// copied like it would through the non const getData()
+	char * data = const_cast<char*>(static_cast<const ofBuffer&>(*this).getData());
+	return ofBuffer::Lines(data, data + size());
 }
 
 //--------------------------------------------------
 ofBuffer::RLines ofBuffer::getReverseLines(){
-	return ofBuffer::RLines(rbegin(), rend());
+	char * data = const_cast<char*>(static_cast<const ofBuffer&>(*this).getData());
+	return ofBuffer::RLines(reverse_iterator(data + size()), reverse_iterator(data));
 }
 
 //--------------------------------------------------
@@ -456,6 +610,15 @@ ofBuffer ofBufferFromFile(const fs::path & path, bool binary){
 	return ofBuffer(f);
 }
 
+//--------------------------------------------------
+ofBuffer ofBufferFromFileMapped(const fs::path & path, ofBuffer::AccessHint hint){
+	ofBuffer buffer;
+	if(!buffer.mapFile(path, hint)){
+		buffer = ofBufferFromFile(path);
+	}
+	return buffer;
+}
+
 //--------------------------------------------------
 bool ofBufferToFile(const fs::path & path, const ofBuffer& buffer, bool binary){
 	ofFile f(path, ofFile::WriteOnly, binary);
@@ -619,7 +782,6 @@ ofBuffer ofFile::readToBuffer(){
 	if(myFile.empty() || !fs::exists(myFile)){
 		return ofBuffer();
 	}
-
 	return ofBuffer(*this);
 }
 
@@ -12,9 +12,27 @@
 ///
 /// A buffer of data which can be accessed as simple bytes or text.
 ///
+/// A buffer can also map a file into memory instead of reading it, see
+/// mapFile(). Mapped buffers have the same interface as normal ones, so
+/// loaders like ofLoadImage, ofMesh::load, ofLoadJson or ofXml::load can
+/// consume large assets without copying them first.
+///
 class ofBuffer {
 
 public:
+	typedef char * iterator;
+	typedef const char * const_iterator;
+	typedef std::reverse_iterator<char *> reverse_iterator;
+	typedef std::reverse_iterator<const char *> const_reverse_iterator;
+
+	/// How a mapped file is going to be accessed, used as a hint for the
+	/// OS to read ahead or not.
+	enum AccessHint{
+		Normal,
+		Sequential,
+		Random,
+	};
+
 	ofBuffer();
 
 	/// Create a buffer and set its contents from a raw byte pointer.
@@ -73,6 +91,33 @@ public:
 	/// \param size number of bytes to reserve space for
 	void reserve(std::size_t size);
 
+	/// Map a file into memory instead of reading it.
+	///
+	/// Pages are only read from disk the first time they are accessed, so
+	/// mapping is much faster than reading for large files, specially if
+	/// only parts of them are used. The buffer keeps the file mapped until
+	/// it's destroyed or modified with set(), append(), resize()... which
+	/// first copy its contents to memory.
+	///
+	/// The mapping is private: writing through getData() never modifies
+	/// the file. Copies of a mapped buffer share the same mapping until one
+	/// of them is accessed through the non const getData() or iterators,
+	/// which copies its contents to memory first, so copies keep behaving
+	/// as separate values. The file shouldn't be truncated by another
+	/// process while it's mapped.
+	///
+	/// \param path file to map, relative to the data folder
+	/// \param hint how the buffer is going to be accessed
+	/// \returns true if the file was mapped, empty files are never mapped
+	bool mapFile(const of::filesystem::path & path, AccessHint hint = Sequential);
+
+	/// Change the access hint of a mapped buffer, does nothing if the
+	/// buffer is not mapped.
+	void setAccessHint(AccessHint hint);
+
+	/// \returns true if the buffer contents are a mapped file.
+	bool isMapped() const;
+
 	/// Write contents of the buffer to an output stream.
 	bool writeTo(std::ostream & stream) const;
 
@@ -96,6 +141,9 @@ public:
 
 	/// Access the buffer's contents using a raw byte pointer.
 	///
+	/// If the buffer shares a mapped file with copies of it, the contents
+	/// are copied to memory first, see mapFile().
+	///
 	/// \warning Do not access bytes at indices beyond size()!
 	/// \returns pointer to internal raw bytes
 	char * getData();
@@ -140,20 +188,20 @@ public:
 	friend std::ostream & operator<<(std::ostream & ostr, const ofBuffer & buf);
 	friend std::istream & operator>>(std::istream & istr, ofBuffer & buf);
 
-	std::vector<char>::iterator begin();
-	std::vector<char>::iterator end();
-	std::vector<char>::const_iterator begin() const;
-	std::vector<char>::const_iterator end() const;
-	std::vector<char>::reverse_iterator rbegin();
-	std::vector<char>::reverse_iterator rend();
-	std::vector<char>::const_reverse_iterator rbegin() const;
-	std::vector<char>::const_reverse_iterator rend() const;
+	iterator begin();
+	iterator end();
+	const_iterator begin() const;
+	const_iterator end() const;
+	reverse_iterator rbegin();
+	reverse_iterator rend();
+	const_reverse_iterator rbegin() const;
+	const_reverse_iterator rend() const;
 
 	/// A line of text in the buffer.
 	///
 
 	struct Line {
-		Line(std::vector<char>::iterator _begin, std::vector<char>::iterator _end);
+		Line(iterator _begin, iterator _end);
 		const std::string & operator*() const;
 		const std::string * operator->() const;
 		const std::string & asString() const;
@@ -178,13 +226,13 @@ public:
 
 	private:
 		std::string line;
-		std::vector<char>::iterator _current, _begin, _end;
+		iterator _current, _begin, _end;
 	};
 
 	/// A line of text in the buffer.
 	///
 	struct RLine {
-		RLine(std::vector<char>::reverse_iterator _begin, std::vector<char>::reverse_iterator _end);
+		RLine(reverse_iterator _begin, reverse_iterator _end);
 		const std::string & operator*() const;
 		const std::string * operator->() const;
 		const std::string & asString() const;
@@ -209,13 +257,13 @@ public:
 
 	private:
 		std::string line;
-		std::vector<char>::reverse_iterator _current, _rbegin, _rend;
+		reverse_iterator _current, _rbegin, _rend;
 	};
 
 	/// A series of text lines in the buffer.
 	///
 	struct Lines {
-		Lines(std::vector<char>::iterator begin, std::vector<char>::iterator end);
+		Lines(iterator begin, iterator end);
 
 		/// Get the first line in the buffer.
 		Line begin();
@@ -227,13 +275,13 @@ public:
 		RLine rend();
 
 	private:
-		std::vector<char>::iterator _begin, _end;
+		iterator _begin, _end;
 	};
 
 	/// A series of text lines in the buffer.
 	///
 	struct RLines {
-		RLines(std::vector<char>::reverse_iterator rbegin, std::vector<char>::reverse_iterator rend);
+		RLines(reverse_iterator rbegin, reverse_iterator rend);
 
 		/// Get the first line in the buffer.
 		RLine begin();
@@ -242,7 +290,7 @@ public:
 		RLine end();
 
 	private:
-		std::vector<char>::reverse_iterator _rbegin, _rend;
+		reverse_iterator _rbegin, _rend;
 	};
 
 	/// Access the contents of the buffer as a series of text lines.
@@ -263,7 +311,13 @@ public:
 	RLines getReverseLines();
 
 private:
+	struct Mapping;
+
+	/// Copies the contents of a mapped file to memory so they can be modified.
+	void unmap();
+
 	std::vector<char> buffer;
+	std::shared_ptr<Mapping> mapping;
 	Line currentLine;
 };
 
@@ -277,6 +331,15 @@ private:
 /// split at endline characters automatically
 ofBuffer ofBufferFromFile(const of::filesystem::path & path, bool binary = true);
 
+//--------------------------------------------------
+/// Map the contents of a file at path into a buffer, see ofBuffer::mapFile().
+///
+/// If the file can't be mapped it's read instead.
+///
+/// \param path file to map
+/// \param hint how the buffer is going to be accessed
+ofBuffer ofBufferFromFileMapped(const of::filesystem::path & path, ofBuffer::AccessHint hint = ofBuffer::Sequential);
+
 //--------------------------------------------------
 /// Write the contents of a buffer to a file at path.
 ///
@@ -745,6 +808,9 @@ public:
 
 	/// Read the contents of a file at the current path into a buffer.
 	///
+	/// The contents are always copied, use ofBufferFromFileMapped() to map
+	/// large files instead.
+	///
 	/// \returns buffer with file contents
 	ofBuffer readToBuffer();
 
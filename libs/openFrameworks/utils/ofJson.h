@@ -15,7 +15,8 @@ inline ofJson ofLoadJson(const of::filesystem::path & filename){
 	ofFile jsonFile(filename);
 	if(jsonFile.exists()){
 		try{
-			jsonFile >> json;
+			ofBuffer buffer = ofBufferFromFileMapped(filename);
+			json = ofJson::parse(buffer.begin(), buffer.end());
 		}catch(std::exception & e){
 			ofLogError("ofLoadJson") << "Error loading json from " << filename << ": " << e.what();
 		}catch(...){
@@ -63,6 +64,280 @@ inline bool ofSavePrettyJson(const of::filesystem::path & filename, const ofJson
     return true;
 }
 
+/// \brief Reads big json documents without building the whole DOM in memory.
+///
+/// The document is parsed as a stream of events and only the values selected
+/// by the filters are built as ofJson and passed to the callback, one at a
+/// time, so the memory used only depends on the size of each selected value.
+///
+/// Filters are json pointers where `*` matches any key or array index:
+///
+/// ~~~~{.cpp}
+///     ofJsonStreamReader reader;
+///     reader.addFilter("/tracks/*/events/*");
+///     reader.load("timeline.json", [&](const std::string & pointer, ofJson && event){
+///         events.push_back(event["time"]);
+///         return true; // false stops reading
+///     });
+/// ~~~~
+///
+/// Without filters the whole document is selected, like ofLoadJson.
+class ofJsonStreamReader{
+public:
+	/// \brief Callback receiving the json pointer of each selected value and
+	/// the value itself, returning false stops parsing.
+	using Callback = std::function<bool(const std::string & pointer, ofJson && value)>;
+
+	/// \brief Select the values at the given json pointer, `*` matches any
+	/// key or array index.
+	void addFilter(const std::string & pointer){
+		std::vector<Segment> filter;
+		if(!pointer.empty()){
+			for(auto & segment: ofSplitString(pointer.substr(pointer[0] == '/' ? 1 : 0), "/")){
+				Segment s;
+				s.any = segment == "*";
+				s.key = unescape(segment);
+				if(!s.key.empty() && std::all_of(s.key.begin(), s.key.end(), [](char c){ return c >= '0' && c <= '9'; })){
+					s.index = ofTo<size_t>(s.key);
+				}
+				filter.push_back(std::move(s));
+			}
+		}
+		filters.push_back(std::move(filter));
+	}
+
+	void clearFilters(){
+		filters.clear();
+	}
+
+	/// \brief Parse a json file, reading it in small chunks.
+	/// \returns false if the file can't be opened or isn't valid json.
+	bool load(const of::filesystem::path & filename, const Callback & callback){
+		ofFile jsonFile(filename);
+		if(!jsonFile.exists()){
+			error = "file doesn't exist";
+			ofLogError("ofJsonStreamReader") << "Error loading json from " << filename << ": " << error;
+			return false;
+		}
+		if(!parse(jsonFile, callback)){
+			ofLogError("ofJsonStreamReader") << "Error loading json from " << filename << ": " << error;
+			return false;
+		}
+		return true;
+	}
+
+	/// \brief Parse json from a stream.
+	/// \returns false if the stream doesn't contain valid json.
+	bool parse(std::istream & stream, const Callback & callback){
+		return parseInput(stream, callback);
+	}
+
+	/// \brief Parse json from a string.
+	/// \returns false if the string isn't valid json.
+	bool parse(const std::string & jsonStr, const Callback & callback){
+		return parseInput(jsonStr, callback);
+	}
+
+	/// \returns the description of the last error.
+	const std::string & getError() const{
+		return error;
+	}
+
+private:
+	struct Segment{
+		std::string key;
+		size_t index = std::numeric_limits<size_t>::max();
+		bool any = false;
+	};
+
+	struct Level{
+		bool array;
+		size_t index;
+		std::string key;
+	};
+
+	// nlohmann::json SAX interface
+	class Handler{
+	public:
+		Handler(ofJsonStreamReader & reader, const Callback & callback)
+		:reader(reader)
+		,callback(callback){}
+
+		bool null(){ return value(nullptr); }
+		bool boolean(bool val){ return value(val); }
+		bool number_integer(ofJson::number_integer_t val){ return value(val); }
+		bool number_unsigned(ofJson::number_unsigned_t val){ return value(val); }
+		bool number_float(ofJson::number_float_t val, const ofJson::string_t &){ return value(val); }
+		bool string(ofJson::string_t & val){ return value(std::move(val)); }
+		bool binary(ofJson::binary_t & val){ return value(std::move(val)); }
+
+		bool start_object(size_t){ return startContainer(false); }
+		bool end_object(){ return endContainer(); }
+		bool start_array(size_t){ return startContainer(true); }
+		bool end_array(){ return endContainer(); }
+
+		bool key(ofJson::string_t & val){
+			if(!stack.empty()){
+				domKey = val;
+			}else{
+				levels.back().key = val;
+			}
+			return true;
+		}
+
+		bool parse_error(size_t, const std::string &, const nlohmann::detail::exception & ex){
+			reader.error = ex.what();
+			return false;
+		}
+
+		bool stopped = false;
+
+	private:
+		template<typename T>
+		bool value(T && val){
+			if(!stack.empty()){
+				add(ofJson(std::forward<T>(val)));
+				return true;
+			}
+			bool keepGoing = true;
+			if(selected()){
+				keepGoing = emit(pointer(), ofJson(std::forward<T>(val)));
+			}
+			nextValue();
+			return keepGoing;
+		}
+
+		bool startContainer(bool array){
+			auto container = array ? ofJson::array() : ofJson::object();
+			if(!stack.empty()){
+				stack.push_back(add(std::move(container)));
+			}else if(selected()){
+				captured = std::move(container);
+				capturedPointer = pointer();
+				stack.push_back(&captured);
+			}else{
+				levels.push_back({array, 0, ""});
+			}
+			return true;
+		}
+
+		bool endContainer(){
+			if(!stack.empty()){
+				stack.pop_back();
+				if(!stack.empty()){
+					return true;
+				}
+				bool keepGoing = emit(capturedPointer, std::move(captured));
+				nextValue();
+				return keepGoing;
+			}
+			levels.pop_back();
+			nextValue();
+			return true;
+		}
+
+		// adds a value to the selected value being built
+		ofJson * add(ofJson && val){
+			auto & parent = *stack.back();
+			if(parent.is_array()){
+				parent.push_back(std::move(val));
+				return &parent.back();
+			}else{
+				auto & element = parent[domKey];
+				element = std::move(val);
+				return &element;
+			}
+		}
+
+		bool emit(const std::string & pointer, ofJson && val){
+			if(!callback(pointer, std::move(val))){
+				stopped = true;
+				return false;
+			}
+			return true;
+		}
+
+		void nextValue(){
+			if(!levels.empty() && levels.back().array){
+				levels.back().index++;
+			}
+		}
+
+		bool selected() const{
+			if(reader.filters.empty()){
+				return levels.empty();
+			}
+			for(auto & filter: reader.filters){
+				if(filter.size() != levels.size()){
+					continue;
+				}
+				bool match = true;
+				for(size_t i = 0; i < levels.size() && match; i++){
+					auto & segment = filter[i];
+					if(segment.any){
+						continue;
+					}
+					match = levels[i].array ? segment.index == levels[i].index : segment.key == levels[i].key;
+				}
+				if(match){
+					return true;
+				}
+			}
+			return false;
+		}
+
+		std::string pointer() const{
+			std::string str;
+			for(auto & level: levels){
+				str += "/";
+				str += level.array ? ofToString(level.index) : escape(level.key);
+			}
+			return str;
+		}
+
+		ofJsonStreamReader & reader;
+		const Callback & callback;
+		std::vector<Level> levels; // containers around the current value outside of selections
+		std::vector<ofJson*> stack; // containers of the selected value being built
+		std::string domKey;
+		ofJson captured;
+		std::string capturedPointer;
+	};
+
+	template<typename Input>
+	bool parseInput(Input && input, const Callback & callback){
+		error.clear();
+		Handler handler(*this, callback);
+		try{
+			bool ok = ofJson::sax_parse(std::forward<Input>(input), &handler);
+			return ok || handler.stopped;
+		}catch(std::exception & e){
+			error = e.what();
+			return false;
+		}
+	}
+
+	static std::string escape(const std::string & key){
+		if(key.find_first_of("~/") == std::string::npos){
+			return key;
+		}
+		std::string escaped = key;
+		ofStringReplace(escaped, "~", "~0");
+		ofStringReplace(escaped, "/", "~1");
+		return escaped;
+	}
+
+	static std::string unescape(const std::string & segment){
+		std::string unescaped = segment;
+		ofStringReplace(unescaped, "~1", "/");
+		ofStringReplace(unescaped, "~0", "~");
+		return unescaped;
+	}
+
+	std::vector<std::vector<Segment>> filters;
+	std::string error;
+};
+
 inline void ofSerialize(ofJson & js, const ofAbstractParameter & parameter){
 	if(!parameter.isSerializable()){
 		return;
@@ -0,0 +1,353 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/// \brief Bounded lock-free alternative to ofThreadChannel.
+///
+/// ofLockFreeThreadChannel has the same send / receive / tryReceive / close
+/// interface as ofThreadChannel but stores the values in a fixed size ring
+/// buffer allocated on construction, so sending and receiving never
+/// allocate and never take a lock while there's data or space available.
+/// It only falls back to a mutex and condition variable when a thread has
+/// to sleep waiting for data, or for space if the channel is full.
+///
+/// By default the channel supports one sending thread and one receiving
+/// thread. Pass true as the second template parameter, or use
+/// ofMPSCThreadChannel, to allow several threads to send at the same time.
+/// In both cases there can only be one receiving thread.
+///
+/// ~~~~{.cpp}
+/// ofLockFreeThreadChannel<ofxOscMessage> messages(4096);
+///
+/// // sending thread
+/// messages.send(std::move(message));
+///
+/// // receiving thread
+/// ofxOscMessage message;
+/// while(messages.tryReceive(message)){
+///		// process message
+/// }
+/// ~~~~
+///
+/// \tparam T The data type sent by the channel.
+/// \tparam MultipleProducers true if more than one thread can send.
+template<typename T, bool MultipleProducers = false>
+class ofLockFreeThreadChannel{
+public:
+	/// \brief Create a channel that can hold up to capacity values.
+	///
+	/// The capacity is rounded up to the next power of 2.
+	ofLockFreeThreadChannel(size_t capacity = 1024)
+	:closed(false)
+	,waitingReceivers(0)
+	,waitingSenders(0){
+		size_t size = 2;
+		while(size < capacity){
+			size *= 2;
+		}
+		mask = size - 1;
+		cells.reset(new Cell[size]);
+		for(size_t i = 0; i < size; i++){
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+		sendPos.store(0, std::memory_order_relaxed);
+		receivePos.store(0, std::memory_order_relaxed);
+	}
+
+	ofLockFreeThreadChannel(const ofLockFreeThreadChannel &) = delete;
+	ofLockFreeThreadChannel & operator=(const ofLockFreeThreadChannel &) = delete;
+
+	/// \brief Block the receiving thread until a new sent value is available.
+	///
+	/// \param sentValue A reference to a sent value.
+	/// \returns True if a new value was received or false if the channel was closed.
+	/// \sa ofThreadChannel::receive
+	bool receive(T & sentValue){
+		while(true){
+			if(closed.load(std::memory_order_acquire)){
+				return false;
+			}
+			if(spinReceive(sentValue)){
+				return true;
+			}
+			std::unique_lock<std::mutex> lock(mutex);
+			waitingReceivers.fetch_add(1);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if(isEmpty() && !closed.load()){
+				notEmpty.wait(lock);
+			}
+			waitingReceivers.fetch_sub(1);
+		}
+	}
+
+	/// \brief If available, receive a new sent value without blocking.
+	///
+	/// \param sentValue A reference to a sent value.
+	/// \returns True if a new value was received, false if there was no data or the channel was closed.
+	/// \sa ofThreadChannel::tryReceive
+	bool tryReceive(T & sentValue){
+		if(closed.load(std::memory_order_acquire)){
+			return false;
+		}
+		return pop(sentValue);
+	}
+
+	/// \brief Receive a value sent before the channel was closed.
+	///
+	/// Like tryReceive but it also returns the values left in a closed
+	/// channel, so the receiving thread can process them before exiting.
+	///
+	/// \param sentValue A reference to a sent value.
+	/// \returns True if a value was received, false if there's no data left.
+	bool tryReceiveRemaining(T & sentValue){
+		return pop(sentValue);
+	}
+
+	/// \brief If available, receive a new sent value or wait for a user-specified duration.
+	///
+	/// \param sentValue A reference to a sent value.
+	/// \param timeoutMs The number of milliseconds to wait for new data before continuing.
+	/// \returns True if a new value was received, false if there was no data or the channel was closed.
+	/// \sa ofThreadChannel::tryReceive
+	bool tryReceive(T & sentValue, int64_t timeoutMs){
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+		while(true){
+			if(closed.load(std::memory_order_acquire)){
+				return false;
+			}
+			if(spinReceive(sentValue)){
+				return true;
+			}
+			std::unique_lock<std::mutex> lock(mutex);
+			waitingReceivers.fetch_add(1);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			bool timedOut = false;
+			if(isEmpty() && !closed.load()){
+				timedOut = notEmpty.wait_until(lock, deadline) == std::cv_status::timeout;
+			}
+			waitingReceivers.fetch_sub(1);
+			if(timedOut){
+				lock.unlock();
+				return tryReceive(sentValue);
+			}
+		}
+	}
+
+	/// \brief Send a value to the receiver by making a copy.
+	///
+	/// If the channel is full this blocks until the receiver makes space.
+	///
+	/// \returns true if the value was sent successfully or false if the channel was closed.
+	bool send(const T & value){
+		T copy(value);
+		return send(std::move(copy));
+	}
+
+	/// \brief Send a value to the receiver without making a copy.
+	///
+	/// If the channel is full this blocks until the receiver makes space.
+	/// Unlike ofThreadChannel the value is only moved from if the send
+	/// succeeds.
+	///
+	/// \returns true if the value was sent successfully or false if the channel was closed.
+	bool send(T && value){
+		while(true){
+			if(closed.load(std::memory_order_acquire)){
+				return false;
+			}
+			for(int i = 0; i < spinCount; i++){
+				if(push(value)){
+					return true;
+				}
+				std::this_thread::yield();
+			}
+			std::unique_lock<std::mutex> lock(mutex);
+			waitingSenders.fetch_add(1);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if(isFull() && !closed.load()){
+				notFull.wait(lock);
+			}
+			waitingSenders.fetch_sub(1);
+		}
+	}
+
+	/// \brief Send a value only if there's space available, without blocking.
+	///
+	/// \returns true if the value was sent or false if the channel was full or closed.
+	bool trySend(const T & value){
+		T copy(value);
+		return trySend(std::move(copy));
+	}
+
+	/// \brief Send a value only if there's space available, without blocking.
+	///
+	/// The value is only moved from if the send succeeds.
+	///
+	/// \returns true if the value was sent or false if the channel was full or closed.
+	bool trySend(T && value){
+		if(closed.load(std::memory_order_acquire)){
+			return false;
+		}
+		return push(value);
+	}
+
+	/// \brief Close the channel.
+	///
+	/// Closing the channel means that no new messages can be sent or received.
+	/// All threads waiting to send or receive will be woken up and return false.
+	void close(){
+		std::unique_lock<std::mutex> lock(mutex);
+		closed = true;
+		notEmpty.notify_all();
+		notFull.notify_all();
+	}
+
+	/// \brief Clear the channel.
+	///
+	/// Can only be called from the receiving thread.
+	void clear(){
+		T value;
+		while(pop(value)){}
+	}
+
+	/// \brief Queries empty channel.
+	///
+	/// This call is only an approximation, since messages come from a different
+	/// thread.
+	bool empty() const{
+		return isEmpty();
+	}
+
+	/// \brief Queries the number of values in the channel.
+	///
+	/// This call is only an approximation, since messages come from a different
+	/// thread.
+	size_t size() const{
+		size_t sent = sendPos.load(std::memory_order_acquire);
+		size_t received = receivePos.load(std::memory_order_acquire);
+		return sent > received ? sent - received : 0;
+	}
+
+	/// \brief The maximum number of values the channel can hold.
+	size_t capacity() const{
+		return mask + 1;
+	}
+
+private:
+	/// \brief A slot in the ring.
+	///
+	/// The sequence number tells producers and the consumer whose turn it
+	/// is to use the slot: it equals the send position when the slot is
+	/// free and the send position + 1 once the value has been written.
+	struct Cell{
+		std::atomic<size_t> sequence;
+		T value;
+	};
+
+	bool push(T & value){
+		size_t pos = sendPos.load(std::memory_order_relaxed);
+		Cell * cell;
+		while(true){
+			cell = &cells[pos & mask];
+			size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			intptr_t diff = intptr_t(sequence) - intptr_t(pos);
+			if(diff == 0){
+				if(!MultipleProducers){
+					sendPos.store(pos + 1, std::memory_order_relaxed);
+					break;
+				}else if(sendPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+					break;
+				}
+			}else if(diff < 0){
+				return false;
+			}else{
+				pos = sendPos.load(std::memory_order_relaxed);
+			}
+		}
+		cell->value = std::move(value);
+		cell->sequence.store(pos + 1, std::memory_order_release);
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if(waitingReceivers.load(std::memory_order_relaxed) > 0){
+			std::unique_lock<std::mutex> lock(mutex);
+			notEmpty.notify_one();
+		}
+		return true;
+	}
+
+	bool pop(T & value){
+		size_t pos = receivePos.load(std::memory_order_relaxed);
+		Cell & cell = cells[pos & mask];
+		size_t sequence = cell.sequence.load(std::memory_order_acquire);
+		if(intptr_t(sequence) - intptr_t(pos + 1) < 0){
+			return false;
+		}
+		value = std::move(cell.value);
+		receivePos.store(pos + 1, std::memory_order_relaxed);
+		cell.sequence.store(pos + mask + 1, std::memory_order_release);
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if(waitingSenders.load(std::memory_order_relaxed) > 0){
+			std::unique_lock<std::mutex> lock(mutex);
+			notFull.notify_all();
+		}
+		return true;
+	}
+
+	bool spinReceive(T & value){
+		for(int i = 0; i < spinCount; i++){
+			if(pop(value)){
+				return true;
+			}
+			std::this_thread::yield();
+		}
+		return false;
+	}
+
+	bool isEmpty() const{
+		size_t pos = receivePos.load(std::memory_order_relaxed);
+		size_t sequence = cells[pos & mask].sequence.load(std::memory_order_acquire);
+		return intptr_t(sequence) - intptr_t(pos + 1) < 0;
+	}
+
+	bool isFull() const{
+		size_t pos = sendPos.load(std::memory_order_relaxed);
+		size_t sequence = cells[pos & mask].sequence.load(std::memory_order_acquire);
+		return intptr_t(sequence) - intptr_t(pos) < 0;
+	}
+
+	/// \brief Times a blocking call retries before going to sleep.
+	static constexpr int spinCount = 64;
+
+	/// \brief The ring of values, its size is always a power of 2.
+	std::unique_ptr<Cell[]> cells;
+	size_t mask;
+
+	/// \brief Next position to write, kept apart from the receive position
+	/// to avoid false sharing between the sending and receiving threads.
+	alignas(64) std::atomic<size_t> sendPos;
+
+	/// \brief Next position to read.
+	alignas(64) std::atomic<size_t> receivePos;
+
+	/// \brief True if the channel is closed.
+	alignas(64) std::atomic<bool> closed;
+
+	/// \brief Number of threads sleeping in receive or send, the mutex and
+	/// conditions are only touched when these are not 0.
+	std::atomic<int> waitingReceivers;
+	std::atomic<int> waitingSenders;
+	std::mutex mutex;
+	std::condition_variable notEmpty;
+	std::condition_variable notFull;
+};
+
+/// \brief Lock-free channel with several sending threads and one receiver.
+template<typename T>
+using ofMPSCThreadChannel = ofLockFreeThreadChannel<T, true>;
@@ -1,6 +1,9 @@
 #include "ofLog.h"
+#include "ofLockFreeThreadChannel.h"
 #include <ofUtils.h>
 #include <map>
+#include <future>
+#include <cstring>
 #ifdef TARGET_ANDROID
 	#include "ofxAndroidLogChannel.h"
 #endif
@@ -241,6 +244,10 @@ void ofConsoleLoggerChannel::log(ofLogLevel level, const string & module, const
 	out << message << std::endl;
 }
 
+void ofConsoleLoggerChannel::flush(){
+	std::cout.flush();
+}
+
 
 #ifdef TARGET_WIN32
 #include <array>
@@ -288,3 +295,125 @@ void ofFileLoggerChannel::log(ofLogLevel level, const string & module, const str
 	file << message << std::endl;
 }
 
+void ofFileLoggerChannel::flush(){
+	file.flush();
+}
+
+//--------------------------------------------------
+struct ofAsyncLoggerChannel::Impl{
+	struct Record{
+		ofLogLevel level = OF_LOG_NOTICE;
+		size_t moduleSize = 0;
+		size_t messageSize = 0;
+		// module followed by message, in longText if they don't fit in text
+		char text[240];
+		std::string longText;
+		// set for the records sent by flush() instead of a message
+		std::shared_ptr<std::promise<void>> flushed;
+	};
+
+	Impl(shared_ptr<ofBaseLoggerChannel> channel, size_t capacity)
+	:channel(channel)
+	,records(capacity)
+	,dropped(0){}
+
+	void write(Record & record);
+	void threadedFunction();
+
+	shared_ptr<ofBaseLoggerChannel> channel;
+	ofMPSCThreadChannel<Record> records;
+	std::atomic<uint64_t> dropped;
+	std::thread thread;
+
+	// only used by the background thread, they keep their capacity
+	string module;
+	string message;
+};
+
+void ofAsyncLoggerChannel::Impl::write(Record & record){
+	if(record.flushed){
+		channel->flush();
+		record.flushed->set_value();
+		record.flushed.reset();
+		return;
+	}
+	const char * text = record.longText.empty() ? record.text : record.longText.data();
+	module.assign(text, record.moduleSize);
+	message.assign(text + record.moduleSize, record.messageSize);
+	channel->log(record.level, module, message);
+}
+
+void ofAsyncLoggerChannel::Impl::threadedFunction(){
+	Record record;
+	while(records.receive(record)){
+		// write everything that's already queued before flushing the
+		// wrapped channel and going back to sleep
+		do{
+			write(record);
+		}while(records.tryReceive(record));
+		channel->flush();
+	}
+
+	// closed on destruction, the records sent before still have to be written
+	while(records.tryReceiveRemaining(record)){
+		write(record);
+	}
+	channel->flush();
+}
+
+ofAsyncLoggerChannel::ofAsyncLoggerChannel(shared_ptr<ofBaseLoggerChannel> channel, size_t capacity)
+:impl(std::make_unique<Impl>(channel, capacity)){
+	impl->thread = std::thread(&Impl::threadedFunction, impl.get());
+}
+
+ofAsyncLoggerChannel::~ofAsyncLoggerChannel(){
+	// nothing can be sent once it's closed, so the thread can write every
+	// record left without missing any logged while it does
+	impl->records.close();
+	impl->thread.join();
+}
+
+void ofAsyncLoggerChannel::log(ofLogLevel level, const string & module, const string & message){
+	// copied into the record instead of a new string, the queue slots are
+	// already allocated
+	Impl::Record record;
+	record.level = level;
+	record.moduleSize = module.size();
+	record.messageSize = message.size();
+	if(module.size() + message.size() <= sizeof(record.text)){
+		memcpy(record.text, module.data(), module.size());
+		memcpy(record.text + module.size(), message.data(), message.size());
+	}else{
+		record.longText.reserve(module.size() + message.size());
+		record.longText.append(module).append(message);
+	}
+	// never block the thread that logs, if the queue is full the message
+	// is lost
+	if(!impl->records.trySend(std::move(record))){
+		impl->dropped++;
+	}
+}
+
+void ofAsyncLoggerChannel::flush(){
+	// the records are written in order so once this one is processed
+	// every record sent before it has been written. messages logged by
+	// the wrapped channel would wait for themselves
+	if(std::this_thread::get_id() == impl->thread.get_id()){
+		return;
+	}
+	Impl::Record record;
+	record.flushed = std::make_shared<std::promise<void>>();
+	auto flushed = record.flushed->get_future();
+	if(impl->records.send(std::move(record))){
+		flushed.wait();
+	}
+}
+
+uint64_t ofAsyncLoggerChannel::getNumDropped() const{
+	return impl->dropped;
+}
+
+shared_ptr<ofBaseLoggerChannel> ofAsyncLoggerChannel::getChannel() const{
+	return impl->channel;
+}
+
@@ -702,6 +702,11 @@ public:
 	void log(ofLogLevel level, const std::string & module, const char* format, Args&& ... args){
 		log(level, module, ofVAArgsToString(format, args...));
 	}
+
+	/// \brief Write any message the channel might be buffering.
+	///
+	/// Called when the application exits.
+	virtual void flush(){}
 };
 
 /// \brief A logger channel that logs its messages to the console.
@@ -710,6 +715,9 @@ public:
 	/// \brief Destroy the console logger channel.
 	virtual ~ofConsoleLoggerChannel(){};
 	void log(ofLogLevel level, const std::string & module, const std::string & message);
+
+	/// \brief Flush the standard output.
+	void flush();
 };
 
 #ifdef TARGET_WIN32
@@ -743,6 +751,9 @@ public:
 
 	void log(ofLogLevel level, const std::string & module, const std::string & message);
 
+	/// \brief Flush the log file.
+	void flush();
+
 	/// \brief CLose the log file.
 	void close();
 
@@ -750,4 +761,51 @@ private:
 	ofFile file; ///< The location of the log file.
 };
 
+/// \brief A logger channel that writes the messages to another channel
+/// from a background thread.
+///
+/// Logging only queues the message, so threads that log a lot, or a slow
+/// channel like a file on a network drive, don't stall the thread that
+/// logs. The queue is lock-free and has a fixed capacity, if it's full
+/// the message is dropped instead of blocking and counted in
+/// getNumDropped(). The background thread writes every queued message
+/// in a batch before waiting for more.
+///
+/// The queue is allocated once with room for short messages in every
+/// slot, so logging them doesn't allocate. Longer messages are still
+/// copied to the heap.
+///
+/// Messages still in the queue are written when the application exits.
+///
+/// ~~~~{.cpp}
+/// ofSetLoggerChannel(std::make_shared<ofAsyncLoggerChannel>(ofGetLoggerChannel()));
+/// ~~~~
+class ofAsyncLoggerChannel: public ofBaseLoggerChannel{
+public:
+	/// \brief Create an ofAsyncLoggerChannel.
+	/// \param channel The channel the messages are written to.
+	/// \param capacity Maximum number of messages waiting to be written.
+	ofAsyncLoggerChannel(std::shared_ptr<ofBaseLoggerChannel> channel, size_t capacity = 4096);
+
+	/// \brief Write the pending messages and stop the background thread.
+	virtual ~ofAsyncLoggerChannel();
+
+	void log(ofLogLevel level, const std::string & module, const std::string & message);
+
+	/// \brief Block until every message logged before this call has been
+	/// written to the wrapped channel.
+	void flush();
+
+	/// \returns The number of messages dropped because the queue was full.
+	uint64_t getNumDropped() const;
+
+	/// \returns The channel the messages are written to.
+	std::shared_ptr<ofBaseLoggerChannel> getChannel() const;
+
+private:
+	// the queue and background thread, kept out of the header
+	struct Impl;
+	std::unique_ptr<Impl> impl;
+};
+
 /// \endcond
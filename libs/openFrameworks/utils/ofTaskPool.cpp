@@ -0,0 +1,249 @@
+#include "ofTaskPool.h"
+#include "ofAppRunner.h"
+#include "ofMainLoop.h"
+#include "ofLog.h"
+
+namespace{
+	// pool and worker index of the calling thread, so tasks submitted from
+	// a worker go to its own queue
+	thread_local ofTaskPool * currentPool = nullptr;
+	thread_local size_t currentWorker = 0;
+}
+
+//-------------------------------------------------
+ofTaskPool::ofTaskPool(size_t numThreads)
+:nextWorker(0)
+,pendingTasks(0)
+,stopping(false)
+,sleepingWorkers(0){
+	for(size_t i = 0; i < numThreads; i++){
+		workers.emplace_back(std::make_unique<Worker>());
+	}
+	for(size_t i = 0; i < numThreads; i++){
+		threads.emplace_back(&ofTaskPool::workerLoop, this, i);
+	}
+}
+
+//-------------------------------------------------
+ofTaskPool::~ofTaskPool(){
+	{
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		stopping = true;
+		wakeUp.notify_all();
+	}
+	for(auto & thread: threads){
+		thread.join();
+	}
+}
+
+//-------------------------------------------------
+size_t ofTaskPool::getNumThreads() const{
+	return threads.size();
+}
+
+//-------------------------------------------------
+size_t ofTaskPool::getNumPendingTasks() const{
+	return pendingTasks;
+}
+
+//-------------------------------------------------
+void ofTaskPool::push(Task && task){
+	if(threads.empty()){
+		task();
+		return;
+	}
+
+	// counted before it's visible so a worker that steals it right away
+	// can't decrement the counter first
+	pendingTasks.fetch_add(1);
+	size_t index = currentPool == this ? currentWorker : nextWorker.fetch_add(1) % workers.size();
+	{
+		std::unique_lock<std::mutex> lock(workers[index]->mutex);
+		workers[index]->tasks.push_back(std::move(task));
+	}
+	if(sleepingWorkers.load() > 0){
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		wakeUp.notify_one();
+	}
+}
+
+//-------------------------------------------------
+bool ofTaskPool::pop(Task & task){
+	size_t numWorkers = workers.size();
+	if(numWorkers == 0){
+		return false;
+	}
+
+	// newest task from our own queue first, it's the most likely to
+	// still be in cache
+	size_t own = 0;
+	if(currentPool == this){
+		own = currentWorker;
+		auto & worker = *workers[own];
+		std::unique_lock<std::mutex> lock(worker.mutex);
+		if(!worker.tasks.empty()){
+			task = std::move(worker.tasks.back());
+			worker.tasks.pop_back();
+			pendingTasks.fetch_sub(1);
+			return true;
+		}
+	}
+
+	// then steal the oldest task of any other worker
+	for(size_t i = 1; i <= numWorkers; i++){
+		auto & worker = *workers[(own + i) % numWorkers];
+		std::unique_lock<std::mutex> lock(worker.mutex);
+		if(!worker.tasks.empty()){
+			task = std::move(worker.tasks.front());
+			worker.tasks.pop_front();
+			pendingTasks.fetch_sub(1);
+			return true;
+		}
+	}
+	return false;
+}
+
+//-------------------------------------------------
+bool ofTaskPool::runPendingTask(){
+	Task task;
+	if(pop(task)){
+		task();
+		return true;
+	}
+	return false;
+}
+
+//-------------------------------------------------
+void ofTaskPool::workerLoop(size_t index){
+	currentPool = this;
+	currentWorker = index;
+	Task task;
+	while(true){
+		if(pop(task)){
+			try{
+				task();
+			}catch(const std::exception & e){
+				ofLogError("ofTaskPool") << "uncaught exception in task: " << e.what();
+			}catch(...){
+				ofLogError("ofTaskPool") << "uncaught exception in task";
+			}
+			task = nullptr;
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		if(stopping && pendingTasks == 0){
+			break;
+		}
+		sleepingWorkers.fetch_add(1);
+		wakeUp.wait(lock, [this]{
+			return pendingTasks.load() > 0 || stopping.load();
+		});
+		sleepingWorkers.fetch_sub(1);
+	}
+}
+
+//-------------------------------------------------
+void ofTaskPool::parallelForRanges(size_t begin, size_t end, const std::function<void(size_t, size_t)> & function, size_t grainSize){
+	if(end <= begin){
+		return;
+	}
+	grainSize = std::max(size_t(1), grainSize);
+	size_t size = end - begin;
+	size_t numChunks = (size + grainSize - 1) / grainSize;
+	size_t numHelpers = std::min(threads.size(), numChunks - 1);
+	if(numHelpers == 0){
+		function(begin, end);
+		return;
+	}
+
+	// a few chunks per thread so threads that finish early can help
+	// with the rest
+	size_t chunkSize = std::max(grainSize, size / ((numHelpers + 1) * 4));
+
+	// helpers can start after the call returned, when the range is already
+	// done, so they share the state with it instead of using the stack
+	struct State{
+		std::atomic<size_t> next;
+		size_t end;
+		size_t chunkSize;
+		const std::function<void(size_t, size_t)> * function;
+		size_t activeHelpers = 0;
+		std::mutex mutex;
+		std::condition_variable done;
+		std::exception_ptr exception;
+
+		void work(){
+			while(true){
+				size_t chunkBegin = next.fetch_add(chunkSize);
+				if(chunkBegin >= end){
+					break;
+				}
+				size_t chunkEnd = std::min(end, chunkBegin + chunkSize);
+				try{
+					(*function)(chunkBegin, chunkEnd);
+				}catch(...){
+					std::unique_lock<std::mutex> lock(mutex);
+					if(!exception){
+						exception = std::current_exception();
+					}
+				}
+			}
+		}
+	};
+	auto state = std::make_shared<State>();
+	state->next = begin;
+	state->end = end;
+	state->chunkSize = chunkSize;
+	state->function = &function;
+
+	for(size_t i = 0; i < numHelpers; i++){
+		push([state]{
+			// a helper is only waited for once it's active. One that starts
+			// after the caller saw no active helpers finds the range done,
+			// since the caller only looks once it ran out of chunks, and
+			// returns without calling the function
+			{
+				std::unique_lock<std::mutex> lock(state->mutex);
+				state->activeHelpers++;
+			}
+			state->work();
+			std::unique_lock<std::mutex> lock(state->mutex);
+			if(--state->activeHelpers == 0){
+				state->done.notify_all();
+			}
+		});
+	}
+
+	state->work();
+
+	// wait only for the helpers still running a chunk, the ones that didn't
+	// start yet, maybe queued behind unrelated long tasks, have nothing left
+	// to do
+	std::unique_lock<std::mutex> lock(state->mutex);
+	state->done.wait(lock, [&state]{
+		return state->activeHelpers == 0;
+	});
+
+	if(state->exception){
+		std::rethrow_exception(state->exception);
+	}
+}
+
+//-------------------------------------------------
+void ofTaskPool::postToMainThread(std::function<void()> && function){
+	auto mainLoop = ofGetMainLoop();
+	if(mainLoop){
+		mainLoop->post(std::move(function));
+	}
+}
+
+//-------------------------------------------------
+ofTaskPool & ofGetTaskPool(){
+#ifdef TARGET_NO_THREADS
+	static ofTaskPool pool(0);
+#else
+	static ofTaskPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+#endif
+	return pool;
+}
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/// \brief A shared pool of worker threads to run short tasks in parallel.
+///
+/// Unlike ofThread, which owns one OS thread per object, an ofTaskPool
+/// keeps a fixed number of workers, usually one per core, that run any
+/// task submitted to them. Each worker has its own queue: tasks submitted
+/// from a worker go to that worker's queue and idle workers steal tasks
+/// from the others, so tasks that spawn more tasks keep every core busy
+/// without contending on a single queue.
+///
+/// Most code should use the pool shared by the whole application,
+/// returned by ofGetTaskPool(), rather than creating its own.
+///
+/// ~~~~{.cpp}
+/// // run a task and wait for its result later
+/// std::future<ofPixels> pixels = ofGetTaskPool().submit([path]{
+/// 	ofPixels pixels;
+/// 	ofLoadImage(pixels, path);
+/// 	return pixels;
+/// });
+///
+/// // run a task and get its result back in the main thread, before update
+/// ofGetTaskPool().submitThenOnMainThread([path]{
+/// 	ofPixels pixels;
+/// 	ofLoadImage(pixels, path);
+/// 	return pixels;
+/// }, [this](ofPixels & pixels){
+/// 	image.setFromPixels(pixels);
+/// });
+///
+/// // split a loop across every core
+/// ofGetTaskPool().parallelFor(0, particles.size(), [&](size_t i){
+/// 	particles[i].update();
+/// });
+/// ~~~~
+///
+/// Tasks shouldn't block waiting for other threads for long periods, for
+/// that kind of work use an ofThread instead.
+class ofTaskPool{
+public:
+	/// \brief Create a pool with numThreads workers.
+	///
+	/// With 0 threads every task runs immediately in the thread that
+	/// submits it.
+	ofTaskPool(size_t numThreads);
+
+	/// \brief Waits for every queued task to finish and stops the workers.
+	~ofTaskPool();
+
+	ofTaskPool(const ofTaskPool &) = delete;
+	ofTaskPool & operator=(const ofTaskPool &) = delete;
+
+	/// \brief Queue a function to run in one of the workers.
+	///
+	/// \returns a future that will hold the function's result, or the
+	/// exception it threw.
+	template<typename Function>
+	auto submit(Function && function) -> std::future<std::invoke_result_t<std::decay_t<Function>>>{
+		using Result = std::invoke_result_t<std::decay_t<Function>>;
+		auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Function>(function));
+		auto future = task->get_future();
+		push([task]{ (*task)(); });
+		return future;
+	}
+
+	/// \brief Queue a function and call continuation with its result in
+	/// the same worker once it finishes.
+	///
+	/// continuation receives the result by reference, or no arguments if
+	/// the function returns void.
+	template<typename Function, typename Continuation>
+	void submitThen(Function && function, Continuation && continuation){
+		push(makeContinuation(std::forward<Function>(function), std::forward<Continuation>(continuation), false));
+	}
+
+	/// \brief Queue a function and call continuation with its result in
+	/// the main thread, right before the next update event.
+	///
+	/// This is the usual way of doing the slow part of some work, like
+	/// decoding an image, in the background and then uploading the result
+	/// to the GPU, which can only be done from the main thread.
+	template<typename Function, typename Continuation>
+	void submitThenOnMainThread(Function && function, Continuation && continuation){
+		push(makeContinuation(std::forward<Function>(function), std::forward<Continuation>(continuation), true));
+	}
+
+	/// \brief Call function(i) for every i in [begin, end) using every worker.
+	///
+	/// The calling thread also processes part of the range and this
+	/// method only returns once the whole range is done. If any call
+	/// throws, the first exception is rethrown here once the rest of the
+	/// calls have finished.
+	///
+	/// \param grainSize Minimum number of consecutive indices processed
+	/// by a worker at a time, increase it if function is very cheap.
+	template<typename Function>
+	void parallelFor(size_t begin, size_t end, Function && function, size_t grainSize = 1){
+		parallelForRanges(begin, end, [&function](size_t rangeBegin, size_t rangeEnd){
+			for(size_t i = rangeBegin; i < rangeEnd; i++){
+				function(i);
+			}
+		}, grainSize);
+	}
+
+	/// \brief Call function(rangeBegin, rangeEnd) on consecutive subranges
+	/// of [begin, end) using every worker.
+	///
+	/// Same as parallelFor but lets the function amortize any setup, like
+	/// allocating temporary buffers, over a whole subrange.
+	void parallelForRanges(size_t begin, size_t end, const std::function<void(size_t, size_t)> & function, size_t grainSize = 1);
+
+	/// \brief Run one queued task in the calling thread if there's any.
+	///
+	/// Useful while waiting for tasks submitted to this pool from one of
+	/// its workers, so the worker keeps doing useful work instead of
+	/// blocking.
+	///
+	/// \returns true if a task was run.
+	bool runPendingTask();
+
+	/// \brief Number of worker threads in the pool.
+	size_t getNumThreads() const;
+
+	/// \brief Number of tasks waiting to run.
+	size_t getNumPendingTasks() const;
+
+private:
+	typedef std::function<void()> Task;
+
+	struct Worker{
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	template<typename Function, typename Continuation>
+	Task makeContinuation(Function && function, Continuation && continuation, bool onMainThread){
+		using Result = std::invoke_result_t<std::decay_t<Function>>;
+		return [function = std::forward<Function>(function), continuation = std::forward<Continuation>(continuation), onMainThread]() mutable{
+			if constexpr(std::is_void<Result>::value){
+				function();
+				if(onMainThread){
+					postToMainThread(std::move(continuation));
+				}else{
+					continuation();
+				}
+			}else{
+				auto result = std::make_shared<Result>(function());
+				if(onMainThread){
+					postToMainThread([result, continuation = std::move(continuation)]() mutable{
+						continuation(*result);
+					});
+				}else{
+					continuation(*result);
+				}
+			}
+		};
+	}
+
+	static void postToMainThread(std::function<void()> && function);
+
+	void push(Task && task);
+	bool pop(Task & task);
+	void workerLoop(size_t index);
+
+	std::vector<std::unique_ptr<Worker>> workers;
+	std::vector<std::thread> threads;
+	std::atomic<size_t> nextWorker;
+	std::atomic<size_t> pendingTasks;
+	std::atomic<bool> stopping;
+
+	std::mutex sleepMutex;
+	std::condition_variable wakeUp;
+	std::atomic<size_t> sleepingWorkers;
+};
+
+/// \brief The task pool shared by the whole application.
+///
+/// It's created the first time it's used with one worker per core minus
+/// one, since the main thread also takes part in parallelFor.
+ofTaskPool & ofGetTaskPool();
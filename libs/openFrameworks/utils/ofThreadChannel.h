@@ -23,6 +23,9 @@
 /// If multiple threads attempt to send data using the same ofThreadChannel, the
 /// send method will block the calling thread until it is free.
 ///
+/// For high message rates see ofLockFreeThreadChannel, a bounded variant
+/// that doesn't lock or allocate when sending or receiving.
+///
 /// \sa https://github.com/openframeworks/ofBook/blob/master/chapters/threads/chapter.md
 /// \tparam T The data type sent by the ofThreadChannel.
 template<typename T>
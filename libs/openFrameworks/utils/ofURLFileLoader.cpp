@@ -23,6 +23,7 @@ using std::string;
 	#include <openssl/err.h>
 	#include <iostream>
 	#include <fstream>
+	#include <atomic>
 
 	#define CERTIFICATE_FILE "cacert.pem"
 	#define PRIVATE_KEY_FILE "cacert.key"
@@ -38,6 +39,24 @@ ofEvent<ofHttpResponse> & ofURLResponseEvent() {
 
 #if !defined(TARGET_IMPLEMENTS_URL_LOADER)
 std::mutex responseMutex;
+
+namespace {
+// the state of a single transfer, only accessed from the thread running it
+struct ofHttpTransfer {
+	ofHttpTransfer(const ofHttpRequest & request)
+		: response(request, 0, "") { }
+	~ofHttpTransfer() {
+		if (headers) {
+			curl_slist_free_all(headers);
+		}
+	}
+	ofHttpResponse response;
+	curl_slist * headers = nullptr;
+	size_t bodySent = 0;
+	std::unique_ptr<ofFile> file;
+};
+}
+
 class ofURLFileLoaderImpl : public ofThread, public ofBaseURLFileLoader {
 public:
 	ofURLFileLoaderImpl();
@@ -49,6 +68,8 @@ public:
 	void remove(int id);
 	void clear();
 	void stop();
+	void setMaxConcurrentRequests(size_t maxRequests);
+	size_t getMaxConcurrentRequests() const;
 	bool checkValidCertifcate(const std::string& cert_file);
 	void createSSLCertificate();
 	ofHttpResponse handleRequest(const ofHttpRequest & request);
@@ -62,17 +83,35 @@ protected:
 
 private:
 	// perform the requests on the thread
+	void startTransfer(const ofHttpRequest & request);
+	void finishTransfer(CURL * curl, CURLcode result);
+	void cancelTransfers(const set<int> & ids, bool all);
+	void releaseHandle(CURL * curl);
+
+	// only accessed from the thread
+	std::map<CURL *, std::unique_ptr<ofHttpTransfer>> transfers;
+	std::vector<CURL *> idleHandles;
+
+	// protected by requestsMutex, the multi handle is only used to wake
+	// up the thread from outside of it
+	std::mutex requestsMutex;
+	std::multimap<int, ofHttpRequest, std::greater<int>> requests;
+	set<int> cancelledRequests;
+	bool cancelAll = false;
+	CURLM * multi;
 
-	ofThreadChannel<ofHttpRequest> requests;
+	std::atomic<size_t> maxConcurrentRequests;
 	ofThreadChannel<ofHttpResponse> responses;
-	ofThreadChannel<int> cancelRequestQueue;
-	set<int> cancelledRequests;
 };
 
-ofURLFileLoaderImpl::ofURLFileLoaderImpl() {
+ofURLFileLoaderImpl::ofURLFileLoaderImpl()
+	: maxConcurrentRequests(6) {
 	if (!curlInited) {
 		curl_global_init(CURL_GLOBAL_ALL);
 	}
+	multi = curl_multi_init();
+	// allows several requests to the same HTTP/2 host over one connection
+	curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
 }
 
 ofURLFileLoaderImpl::~ofURLFileLoaderImpl() {
@@ -86,10 +125,9 @@ ofHttpResponse ofURLFileLoaderImpl::get(const string & url) {
 }
 
 int ofURLFileLoaderImpl::getAsync(const string & url, const string & name) {
-	ofHttpRequest request(url, name.empty() ? url : name);
-	requests.send(request);
-	start();
-	return request.getId();
+	// keep the connection alive so other requests to the same host can reuse it
+	ofHttpRequest request(url, name.empty() ? url : name, false, false);
+	return handleRequestAsync(request);
 }
 
 ofHttpResponse ofURLFileLoaderImpl::saveTo(const string & url, const of::filesystem::path & path) {
@@ -98,20 +136,36 @@ ofHttpResponse ofURLFileLoaderImpl::saveTo(const string & url, const of::filesys
 }
 
 int ofURLFileLoaderImpl::saveAsync(const string & url, const of::filesystem::path & path) {
-	ofHttpRequest request(url, path.string(), true);
-	requests.send(request);
-	start();
-	return request.getId();
+	ofHttpRequest request(url, path.string(), true, false);
+	return handleRequestAsync(request);
 }
 
 void ofURLFileLoaderImpl::remove(int id) {
-	cancelRequestQueue.send(id);
+	std::unique_lock<std::mutex> lock(requestsMutex);
+	for (auto it = requests.begin(); it != requests.end();) {
+		if (it->second.getId() == id) {
+			it = requests.erase(it);
+		} else {
+			++it;
+		}
+	}
+	// might be in flight already
+	cancelledRequests.insert(id);
+	if (multi) {
+		curl_multi_wakeup(multi);
+	}
 }
 
 void ofURLFileLoaderImpl::clear() {
+	{
+		std::unique_lock<std::mutex> lock(requestsMutex);
+		requests.clear();
+		cancelAll = true;
+		if (multi) {
+			curl_multi_wakeup(multi);
+		}
+	}
 	ofHttpResponse resp;
-	ofHttpRequest req;
-	while (requests.tryReceive(req)) { }
 	while (responses.tryReceive(resp)) { }
 }
 
@@ -124,12 +178,38 @@ void ofURLFileLoaderImpl::start() {
 
 void ofURLFileLoaderImpl::stop() {
 	stopThread();
-	requests.close();
+	{
+		std::unique_lock<std::mutex> lock(requestsMutex);
+		if (multi) {
+			curl_multi_wakeup(multi);
+		}
+	}
 	responses.close();
 	waitForThread();
-	curl_global_cleanup();
+
+	std::unique_lock<std::mutex> lock(requestsMutex);
+	if (multi) {
+		for (auto curl : idleHandles) {
+			curl_easy_cleanup(curl);
+		}
+		idleHandles.clear();
+		curl_multi_cleanup(multi);
+		multi = nullptr;
+		curl_global_cleanup();
+	}
 }
 
+void ofURLFileLoaderImpl::setMaxConcurrentRequests(size_t maxRequests) {
+	maxConcurrentRequests = std::max(size_t(1), maxRequests);
+	std::unique_lock<std::mutex> lock(requestsMutex);
+	if (multi) {
+		curl_multi_wakeup(multi);
+	}
+}
+
+size_t ofURLFileLoaderImpl::getMaxConcurrentRequests() const {
+	return maxConcurrentRequests;
+}
 
 bool ofURLFileLoaderImpl::checkValidCertifcate(const std::string & cert_file) {
 #if !defined(NO_OPENSSL)
@@ -237,98 +317,114 @@ void ofURLFileLoaderImpl::createSSLCertificate() {
 
 
 
+// Keeps up to maxConcurrentRequests transfers running in a single curl multi
+// handle, which also keeps a cache of open connections so requests to the
+// same host don't need to connect again.
 void ofURLFileLoaderImpl::threadedFunction() {
 	setThreadName("ofURLFileLoader " + ofToString(getThreadId()));
+	std::vector<ofHttpRequest> toStart;
+	set<int> toCancel;
 	while (isThreadRunning()) {
-		int cancelled = 0;
-		while (cancelRequestQueue.tryReceive(cancelled)) {
-			cancelledRequests.insert(cancelled);
+		bool all;
+		{
+			std::unique_lock<std::mutex> lock(requestsMutex);
+			toCancel.swap(cancelledRequests);
+			all = cancelAll;
+			cancelAll = false;
+			size_t maxTransfers = maxConcurrentRequests;
+			while (transfers.size() + toStart.size() < maxTransfers && !requests.empty()) {
+				toStart.push_back(std::move(requests.begin()->second));
+				requests.erase(requests.begin());
+			}
+		}
+
+		cancelTransfers(toCancel, all);
+		toCancel.clear();
+		for (auto & request : toStart) {
+			startTransfer(request);
 		}
-		ofHttpRequest request;
-		if (requests.receive(request)) {
-			if (cancelledRequests.find(request.getId()) == cancelledRequests.end()) {
-				ofHttpResponse response(handleRequest(request));
-				int status = response.status;
-				if (!responses.send(std::move(response))) {
-					break;
-				}
-				if (status == -1) {
-					// retry
-					requests.send(request);
-				}
-			} else {
-				cancelledRequests.erase(cancelled);
+		toStart.clear();
+
+		int running = 0;
+		curl_multi_perform(multi, &running);
+		int remaining = 0;
+		bool finished = false;
+		while (CURLMsg * msg = curl_multi_info_read(multi, &remaining)) {
+			if (msg->msg == CURLMSG_DONE) {
+				finishTransfer(msg->easy_handle, msg->data.result);
+				finished = true;
 			}
-		} else {
-			break;
+		}
+
+		// sleeps until there's network activity or remove, clear, stop
+		// or a new request wake us up. if some transfer finished, start
+		// the next waiting ones first
+		if (!finished) {
+			curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
 		}
 	}
+
+	for (auto & transfer : transfers) {
+		curl_multi_remove_handle(multi, transfer.first);
+		curl_easy_cleanup(transfer.first);
+	}
+	transfers.clear();
 }
 
 namespace {
 size_t saveToFile_cb(void * buffer, size_t size, size_t nmemb, void * userdata) {
-	std::lock_guard<std::mutex> lock(responseMutex);
-	auto saveTo = (ofFile *)userdata;
-	saveTo->write((const char *)buffer, size * nmemb);
+	auto transfer = (ofHttpTransfer *)userdata;
+	transfer->file->write((const char *)buffer, size * nmemb);
 	return size * nmemb;
 }
 
 size_t saveToMemory_cb(void * buffer, size_t size, size_t nmemb, void * userdata) {
-	std::lock_guard<std::mutex> lock(responseMutex);
-	auto response = (ofHttpResponse *)userdata;
-	response->data.append((const char *)buffer, size * nmemb);
+	auto transfer = (ofHttpTransfer *)userdata;
+	transfer->response.data.append((const char *)buffer, size * nmemb);
 	return size * nmemb;
 }
 
 size_t readBody_cb(void * ptr, size_t size, size_t nmemb, void * userdata) {
-	std::lock_guard<std::mutex> lock(responseMutex);
-	auto body = (std::string *)userdata;
-	if (size * nmemb < 1) {
-		return 0;
-	}
-	if (!body->empty()) {
-		auto sent = std::min(size * nmemb, body->size());
-		memcpy(ptr, body->c_str(), sent);
-		*body = body->substr(sent);
-		return sent;
-	}
-	return 0; /* no more data left to deliver */
-}
-}
-
-ofHttpResponse ofURLFileLoaderImpl::handleRequest(const ofHttpRequest & request) {
-	std::unique_ptr<CURL, void (*)(CURL *)> curl = std::unique_ptr<CURL, void (*)(CURL *)>(curl_easy_init(), curl_easy_cleanup);
-	if (!curl) {
-		ofLogError("ofURLFileLoader") << "curl_easy_init() failed!";
-		return ofHttpResponse(request, -1, "CURL initialization failed");
-	}
-	curl_slist * headers = nullptr;
+	auto transfer = (ofHttpTransfer *)userdata;
+	const auto & body = transfer->response.request.body;
+	auto sent = std::min(size * nmemb, body.size() - transfer->bodySent);
+	memcpy(ptr, body.data() + transfer->bodySent, sent);
+	transfer->bodySent += sent;
+	return sent; /* 0 when there's no more data left to deliver */
+}
+
+// configures a curl easy handle to run the request in transfer, used both by
+// the blocking requests and the transfers in the multi handle
+void setupTransfer(CURL * curl, ofHttpTransfer & transfer) {
+	const ofHttpRequest & request = transfer.response.request;
 	curl_version_info_data *version = curl_version_info( CURLVERSION_NOW );
 	if(request.verbose) {
-		CURLcode ret = curl_easy_setopt(curl.get(), CURLOPT_VERBOSE, 1L);
+		CURLcode ret = curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
 		if (ret != CURLE_OK) {
 			ofLogWarning() << "cURL error: " << curl_easy_strerror(ret);
 		}
 		if (version) {
 			std::string userAgent = std::string("curl/") + version->version;
-			curl_easy_setopt(curl.get(), CURLOPT_USERAGENT, userAgent.c_str());
+			curl_easy_setopt(curl, CURLOPT_USERAGENT, userAgent.c_str());
 		} else {
-			curl_easy_setopt(curl.get(), CURLOPT_USERAGENT, "curl/unknown");
+			curl_easy_setopt(curl, CURLOPT_USERAGENT, "curl/unknown");
 		}
 	}
 	if(version->features & CURL_VERSION_SSL) {
-		curl_easy_setopt(curl.get(), CURLOPT_SSL_VERIFYPEER, false);
-		curl_easy_setopt(curl.get(), CURLOPT_SSL_VERIFYHOST, 2L);
+		curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, false);
+		curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
 	}
-	curl_easy_setopt(curl.get(), CURLOPT_URL, request.url.c_str());
-	curl_easy_setopt(curl.get(), CURLOPT_FOLLOWLOCATION, 1L);
-	curl_easy_setopt(curl.get(), CURLOPT_MAXREDIRS, 20L);
+	curl_easy_setopt(curl, CURLOPT_URL, request.url.c_str());
+	curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+	curl_easy_setopt(curl, CURLOPT_MAXREDIRS, 20L);
+	curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
 
 	if (request.contentType != "") {
-		headers = curl_slist_append(headers, ("Content-Type: " + request.contentType).c_str());
+		transfer.headers = curl_slist_append(transfer.headers, ("Content-Type: " + request.contentType).c_str());
 	}
 	if(request.close) {
-		headers = curl_slist_append(headers, "Connection: close");
+		transfer.headers = curl_slist_append(transfer.headers, "Connection: close");
+		curl_easy_setopt(curl, CURLOPT_FORBID_REUSE, 1L);
 	}
 	// https://curl.se/libcurl/c/CURLOPT_ACCEPT_ENCODING.html
 	// the following is used for requesting specific compression encodings
@@ -350,95 +446,173 @@ ofHttpResponse ofURLFileLoaderImpl::handleRequest(const ofHttpRequest & request)
 	//		ofLogVerbose("ofURLFileLoader :: encodings") << encodings;
 	//		headers = curl_slist_append(headers, encodings.c_str());
 	//	} else {
-	//		curl_easy_setopt(curl.get(), CURLOPT_ACCEPT_ENCODING, "");
+	//		curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "");
 	//	}
 	/* enable all supported built-in compressions */
-	curl_easy_setopt(curl.get(), CURLOPT_ACCEPT_ENCODING, "");
+	curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "");
 	
 	for (map<string, string>::const_iterator it = request.headers.cbegin(); it != request.headers.cend(); it++) {
-		headers = curl_slist_append(headers, (it->first + ": " + it->second).c_str());
+		transfer.headers = curl_slist_append(transfer.headers, (it->first + ": " + it->second).c_str());
 	}
 
-	if (headers) {
-		curl_easy_setopt(curl.get(), CURLOPT_HTTPHEADER, headers);
+	if (transfer.headers) {
+		curl_easy_setopt(curl, CURLOPT_HTTPHEADER, transfer.headers);
 	}
 	if (request.method == ofHttpRequest::GET) {
-		curl_easy_setopt(curl.get(), CURLOPT_HTTPGET, 1L);
-		curl_easy_setopt(curl.get(), CURLOPT_POST, 0L);
-		curl_easy_setopt(curl.get(), CURLOPT_UPLOAD, 0L);
+		curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
+		curl_easy_setopt(curl, CURLOPT_POST, 0L);
+		curl_easy_setopt(curl, CURLOPT_UPLOAD, 0L);
 	}
 	else if (request.method == ofHttpRequest::PUT) {
-		curl_easy_setopt(curl.get(), CURLOPT_UPLOAD, 1L);
-		curl_easy_setopt(curl.get(), CURLOPT_POST, 0L);
-		curl_easy_setopt(curl.get(), CURLOPT_HTTPGET, 0L);
+		curl_easy_setopt(curl, CURLOPT_UPLOAD, 1L);
+		curl_easy_setopt(curl, CURLOPT_POST, 0L);
+		curl_easy_setopt(curl, CURLOPT_HTTPGET, 0L);
 	}
 	else if (request.method == ofHttpRequest::POST) {
-		curl_easy_setopt(curl.get(), CURLOPT_POST, 1L);
-		curl_easy_setopt(curl.get(), CURLOPT_UPLOAD, 0L);
-		curl_easy_setopt(curl.get(), CURLOPT_HTTPGET, 0L);
+		curl_easy_setopt(curl, CURLOPT_POST, 1L);
+		curl_easy_setopt(curl, CURLOPT_UPLOAD, 0L);
+		curl_easy_setopt(curl, CURLOPT_HTTPGET, 0L);
 	}
 	if (request.method != ofHttpRequest::GET) {
-		std::string body = request.body;
 		if (!request.body.empty()) {
 			if (request.method == ofHttpRequest::PUT || request.body.size() > MAX_POSTFIELDS_SIZE) { // If request is an upload (e.g., file upload)
-				curl_easy_setopt(curl.get(), CURLOPT_UPLOAD, 1L);
-				curl_easy_setopt(curl.get(), CURLOPT_READFUNCTION, readBody_cb);
-				curl_easy_setopt(curl.get(), CURLOPT_READDATA, &body);
-				curl_easy_setopt(curl.get(), CURLOPT_POSTFIELDSIZE, 0L);
+				curl_easy_setopt(curl, CURLOPT_UPLOAD, 1L);
+				curl_easy_setopt(curl, CURLOPT_READFUNCTION, readBody_cb);
+				curl_easy_setopt(curl, CURLOPT_READDATA, &transfer);
+				curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, 0L);
 			} else { // If request is a normal POST
-				curl_easy_setopt(curl.get(), CURLOPT_POSTFIELDSIZE, request.body.size());
-				curl_easy_setopt(curl.get(), CURLOPT_POSTFIELDS, request.body.c_str());
+				curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, long(request.body.size()));
+				curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.body.c_str());
 			}
 		} else {
-			curl_easy_setopt(curl.get(), CURLOPT_POSTFIELDSIZE, 0L);
-			curl_easy_setopt(curl.get(), CURLOPT_POSTFIELDS, "");
-			curl_easy_setopt(curl.get(), CURLOPT_READFUNCTION, nullptr);
-			curl_easy_setopt(curl.get(), CURLOPT_READDATA, nullptr);
+			curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, 0L);
+			curl_easy_setopt(curl, CURLOPT_POSTFIELDS, "");
+			curl_easy_setopt(curl, CURLOPT_READFUNCTION, nullptr);
+			curl_easy_setopt(curl, CURLOPT_READDATA, nullptr);
 		}
 	}
 
 	if (request.timeoutSeconds > 0) {
-		curl_easy_setopt(curl.get(), CURLOPT_TIMEOUT, request.timeoutSeconds);
+		curl_easy_setopt(curl, CURLOPT_TIMEOUT, long(request.timeoutSeconds));
 	}
 	if (request.headerOnly) {
-		curl_easy_setopt(curl.get(), CURLOPT_NOBODY, 1L);
+		curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
 	}
 
-	// start request and receive response
-	ofHttpResponse response(request, 0, "");
-	CURLcode err = CURLE_OK;
 	if (request.saveTo) {
-		ofFile saveTo(request.name, ofFile::WriteOnly, true);
-		curl_easy_setopt(curl.get(), CURLOPT_WRITEDATA, &saveTo);
-		curl_easy_setopt(curl.get(), CURLOPT_WRITEFUNCTION, saveToFile_cb);
-		err = curl_easy_perform(curl.get());
+		transfer.file = std::make_unique<ofFile>(request.name, ofFile::WriteOnly, true);
+		curl_easy_setopt(curl, CURLOPT_WRITEDATA, &transfer);
+		curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, saveToFile_cb);
 	} else {
-		curl_easy_setopt(curl.get(), CURLOPT_WRITEDATA, &response);
-		curl_easy_setopt(curl.get(), CURLOPT_WRITEFUNCTION, saveToMemory_cb);
-		err = curl_easy_perform(curl.get());
+		curl_easy_setopt(curl, CURLOPT_WRITEDATA, &transfer);
+		curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, saveToMemory_cb);
 	}
+}
+
+void setTransferResult(CURL * curl, ofHttpTransfer & transfer, CURLcode err) {
+	transfer.file.reset();
 	if (err == CURLE_OK) {
 		long http_code = 0;
-		curl_easy_getinfo(curl.get(), CURLINFO_RESPONSE_CODE, &http_code);
-		response.status = http_code;
+		curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+		transfer.response.status = http_code;
 	} else {
-		response.error = curl_easy_strerror(err);
-		response.status = -1;
+		transfer.response.error = curl_easy_strerror(err);
+		transfer.response.status = -1;
 	}
+}
+}
 
-	if (headers) {
-		curl_slist_free_all(headers);
+ofHttpResponse ofURLFileLoaderImpl::handleRequest(const ofHttpRequest & request) {
+	std::unique_ptr<CURL, void (*)(CURL *)> curl = std::unique_ptr<CURL, void (*)(CURL *)>(curl_easy_init(), curl_easy_cleanup);
+	if (!curl) {
+		ofLogError("ofURLFileLoader") << "curl_easy_init() failed!";
+		return ofHttpResponse(request, -1, "CURL initialization failed");
 	}
 
-	return response;
+	// start request and receive response
+	ofHttpTransfer transfer(request);
+	setupTransfer(curl.get(), transfer);
+	CURLcode err = curl_easy_perform(curl.get());
+	setTransferResult(curl.get(), transfer, err);
+	return std::move(transfer.response);
 }
 
 int ofURLFileLoaderImpl::handleRequestAsync(const ofHttpRequest & request) {
-	requests.send(request);
+	{
+		std::unique_lock<std::mutex> lock(requestsMutex);
+		if (!multi) {
+			ofLogError("ofURLFileLoader") << "can't handle request " << request.url << ", the loader is stopped";
+			return request.getId();
+		}
+		requests.emplace(request.priority, request);
+		curl_multi_wakeup(multi);
+	}
 	start();
 	return request.getId();
 }
 
+void ofURLFileLoaderImpl::startTransfer(const ofHttpRequest & request) {
+	CURL * curl;
+	if (idleHandles.empty()) {
+		curl = curl_easy_init();
+	} else {
+		curl = idleHandles.back();
+		idleHandles.pop_back();
+	}
+	if (!curl) {
+		ofLogError("ofURLFileLoader") << "curl_easy_init() failed!";
+		responses.send(ofHttpResponse(request, -1, "CURL initialization failed"));
+		return;
+	}
+	auto transfer = std::make_unique<ofHttpTransfer>(request);
+	setupTransfer(curl, *transfer);
+	curl_multi_add_handle(multi, curl);
+	transfers[curl] = std::move(transfer);
+}
+
+void ofURLFileLoaderImpl::finishTransfer(CURL * curl, CURLcode result) {
+	auto it = transfers.find(curl);
+	if (it == transfers.end()) {
+		return;
+	}
+	auto transfer = std::move(it->second);
+	transfers.erase(it);
+	setTransferResult(curl, *transfer, result);
+	curl_multi_remove_handle(multi, curl);
+	releaseHandle(curl);
+
+	int status = transfer->response.status;
+	if (status == -1) {
+		// retry
+		std::unique_lock<std::mutex> lock(requestsMutex);
+		requests.emplace(transfer->response.request.priority, transfer->response.request);
+	}
+	responses.send(std::move(transfer->response));
+}
+
+void ofURLFileLoaderImpl::cancelTransfers(const set<int> & ids, bool all) {
+	for (auto it = transfers.begin(); it != transfers.end();) {
+		if (all || ids.find(it->second->response.request.getId()) != ids.end()) {
+			curl_multi_remove_handle(multi, it->first);
+			releaseHandle(it->first);
+			it = transfers.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+// keeps the easy handles around to avoid allocating them again for every
+// request, the connections themselves are cached by the multi handle
+void ofURLFileLoaderImpl::releaseHandle(CURL * curl) {
+	if (idleHandles.size() < maxConcurrentRequests) {
+		curl_easy_reset(curl);
+		idleHandles.push_back(curl);
+	} else {
+		curl_easy_cleanup(curl);
+	}
+}
+
 void ofURLFileLoaderImpl::update(ofEventArgs & args) {
 	ofHttpResponse response;
 	while (responses.tryReceive(response)) {
@@ -498,6 +672,14 @@ void ofURLFileLoader::stop() {
 	impl->stop();
 }
 
+void ofURLFileLoader::setMaxConcurrentRequests(size_t maxRequests) {
+	impl->setMaxConcurrentRequests(maxRequests);
+}
+
+size_t ofURLFileLoader::getMaxConcurrentRequests() const {
+	return impl->getMaxConcurrentRequests();
+}
+
 ofHttpResponse ofURLFileLoader::handleRequest(const ofHttpRequest & request) {
 	return impl->handleRequest(request);
 }
@@ -515,6 +697,8 @@ static ofURLFileLoader & getFileLoader() {
 
 ofHttpRequest::ofHttpRequest()
 	: saveTo(false)
+	, close(true)
+	, verbose(false)
 	, method(GET)
 	, id(nextID++) {
 }
@@ -586,6 +770,10 @@ void ofStopURLLoader() {
 	getFileLoader().stop();
 }
 
+void ofSetURLLoaderMaxConcurrentRequests(size_t maxRequests) {
+	getFileLoader().setMaxConcurrentRequests(maxRequests);
+}
+
 void ofURLFileLoaderShutdown() {
 	if (initialized) {
 		ofRemoveAllURLRequests();
@@ -17,7 +17,7 @@ public:
 	std::string url; ///< request url
 	std::string name; ///< optional name key for sorting
 	bool saveTo; ///< save to a file once the request is finished?
-	bool close; // auto close connection at each request - default true 
+	bool close; // auto close connection at each request, disables connection reuse - default true
 	bool verbose; // verbose packet logs
 	std::map<std::string, std::string> headers; ///< HTTP header keys & values
 	std::string body; ///< POST body data
@@ -25,6 +25,7 @@ public:
 	std::function<void(const ofHttpResponse &)> done;
 	size_t timeoutSeconds = 0;
 	bool headerOnly = false;
+	int priority = 0; ///< asynchronous requests with higher priority are started first
 
 	/// \return the unique id for this request
 	int getId() const;
@@ -109,6 +110,11 @@ void ofRemoveAllURLRequests();
 /// \brief Stop & remove all active and waiting HTTP requests.
 void ofStopURLLoader();
 
+/// \brief Set how many asynchronous HTTP requests can be in flight at the
+/// same time. Defaults to 6.
+/// \param maxRequests maximum number of concurrent transfers
+void ofSetURLLoaderMaxConcurrentRequests(size_t maxRequests);
+
 ofEvent<ofHttpResponse> & ofURLResponseEvent();
 
 template <class T>
@@ -174,6 +180,19 @@ public:
 	/// \brief Stop & remove all active and waiting HTTP requests.
 	void stop();
 
+	/// \brief Set how many asynchronous requests can be in flight at the
+	/// same time.
+	///
+	/// Waiting requests are started in priority order, see
+	/// ofHttpRequest::priority, and connections to the same host are kept
+	/// alive and reused between requests that don't set ofHttpRequest::close.
+	///
+	/// \param maxRequests maximum number of concurrent transfers
+	void setMaxConcurrentRequests(size_t maxRequests);
+
+	/// \return the maximum number of concurrent asynchronous transfers
+	size_t getMaxConcurrentRequests() const;
+
 	/// \brief Low level HTTP request implementation.
 	///
 	/// Blocks until a response is returned or the request times out.
@@ -244,6 +263,14 @@ public:
 	/// \brief Stop & remove all active and waiting HTTP requests.
 	virtual void stop() = 0;
 
+	/// \brief Set how many asynchronous requests can be in flight at the
+	/// same time. Implementations that run one request at a time ignore it.
+	/// \param maxRequests maximum number of concurrent transfers
+	virtual void setMaxConcurrentRequests(size_t /*maxRequests*/) { }
+
+	/// \return the maximum number of concurrent asynchronous transfers
+	virtual size_t getMaxConcurrentRequests() const { return 1; }
+
 	/// \brief Low level HTTP request implementation.
 	///
 	/// Blocks until a response is returned or the request times out.
@@ -500,7 +500,17 @@ string ofToHex(const char * value) {
 
 //----------------------------------------
 int ofToInt(const string & intString) {
-	return ofTo<int>(intString);
+	return of::priv::fromChars<int>(intString);
+}
+
+//----------------------------------------
+int ofToInt(std::string_view intString) {
+	return of::priv::fromChars<int>(intString);
+}
+
+//----------------------------------------
+int ofToInt(const char * intString) {
+	return of::priv::fromChars<int>(intString);
 }
 
 //----------------------------------------
@@ -554,17 +564,55 @@ string ofHexToString(const string & stringHexString) {
 
 //----------------------------------------
 float ofToFloat(const string & floatString) {
-	return ofTo<float>(floatString);
+	return ofToFloat(std::string_view(floatString));
+}
+
+//----------------------------------------
+float ofToFloat(std::string_view floatString) {
+	if constexpr (of::priv::hasFloatCharconv) {
+		return of::priv::fromChars<float>(floatString);
+	} else {
+		return ofTo<float>(string(floatString));
+	}
+}
+
+//----------------------------------------
+float ofToFloat(const char * floatString) {
+	return ofToFloat(std::string_view(floatString));
 }
 
 //----------------------------------------
 double ofToDouble(const string & doubleString) {
-	return ofTo<double>(doubleString);
+	return ofToDouble(std::string_view(doubleString));
+}
+
+//----------------------------------------
+double ofToDouble(std::string_view doubleString) {
+	if constexpr (of::priv::hasFloatCharconv) {
+		return of::priv::fromChars<double>(doubleString);
+	} else {
+		return ofTo<double>(string(doubleString));
+	}
+}
+
+//----------------------------------------
+double ofToDouble(const char * doubleString) {
+	return ofToDouble(std::string_view(doubleString));
 }
 
 //----------------------------------------
 int64_t ofToInt64(const string & intString) {
-	return ofTo<int64_t>(intString);
+	return of::priv::fromChars<int64_t>(intString);
+}
+
+//----------------------------------------
+int64_t ofToInt64(std::string_view intString) {
+	return of::priv::fromChars<int64_t>(intString);
+}
+
+//----------------------------------------
+int64_t ofToInt64(const char * intString) {
+	return of::priv::fromChars<int64_t>(intString);
 }
 
 //----------------------------------------
@@ -651,22 +699,96 @@ vector<string> ofSplitString(const string & source, const string & delimiter, bo
 		result.push_back(source);
 		return result;
 	}
-	string::const_iterator substart = source.begin(), subend;
+	for (auto token : ofStringTokenizer(source, delimiter, ignoreEmpty, trim)) {
+		result.emplace_back(token);
+	}
+	return result;
+}
+
+//--------------------------------------------------
+vector<std::string_view> ofSplitStringView(std::string_view source, std::string_view delimiter, bool ignoreEmpty, bool trim) {
+	vector<std::string_view> result;
+	if (delimiter.empty()) {
+		result.push_back(source);
+		return result;
+	}
+	for (auto token : ofStringTokenizer(source, delimiter, ignoreEmpty, trim)) {
+		result.push_back(token);
+	}
+	return result;
+}
+
+//--------------------------------------------------
+ofStringTokenizer::ofStringTokenizer(std::string_view source, std::string_view delimiter, bool ignoreEmpty, bool trim)
+	: source(source)
+	, delimiter(delimiter)
+	, ignoreEmpty(ignoreEmpty)
+	, trim(trim) {
+}
+
+//--------------------------------------------------
+ofStringTokenizer::iterator ofStringTokenizer::begin() const {
+	return iterator(this, 0);
+}
+
+//--------------------------------------------------
+ofStringTokenizer::iterator ofStringTokenizer::end() const {
+	return iterator();
+}
+
+//--------------------------------------------------
+ofStringTokenizer::iterator::iterator(const ofStringTokenizer * tokenizer, std::size_t start)
+	: tokenizer(tokenizer)
+	, start(start) {
+	findToken();
+}
+
+//--------------------------------------------------
+void ofStringTokenizer::iterator::findToken() {
+	auto isSpace = [](char c) {
+		return c == ' ' || (c >= '\t' && c <= '\r');
+	};
+	const auto & source = tokenizer->source;
+	const auto & delimiter = tokenizer->delimiter;
 	while (true) {
-		subend = search(substart, source.end(), delimiter.begin(), delimiter.end());
-		string sub(substart, subend);
-		if (trim) {
-			sub = ofTrim(sub);
+		end = delimiter.empty() ? std::string_view::npos : source.find(delimiter, start);
+		token = source.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start);
+		if (tokenizer->trim) {
+			while (!token.empty() && isSpace(token.front())) {
+				token.remove_prefix(1);
+			}
+			while (!token.empty() && isSpace(token.back())) {
+				token.remove_suffix(1);
+			}
 		}
-		if (!ignoreEmpty || !sub.empty()) {
-			result.push_back(sub);
+		if (!tokenizer->ignoreEmpty || !token.empty()) {
+			return;
 		}
-		if (subend == source.end()) {
-			break;
+		if (end == std::string_view::npos) {
+			start = std::string_view::npos;
+			return;
 		}
-		substart = subend + delimiter.size();
+		start = end + delimiter.size();
 	}
-	return result;
+}
+
+//--------------------------------------------------
+ofStringTokenizer::iterator & ofStringTokenizer::iterator::operator++() {
+	if (end == std::string_view::npos) {
+		start = std::string_view::npos;
+		token = std::string_view();
+	} else {
+		start = end + tokenizer->delimiter.size();
+		findToken();
+	}
+	return *this;
+}
+
+//--------------------------------------------------
+ofStringTokenizer::iterator ofStringTokenizer::iterator::operator++(int) {
+	auto previous = *this;
+	++(*this);
+	return previous;
 }
 
 //--------------------------------------------------
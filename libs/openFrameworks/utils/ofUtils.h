@@ -11,10 +11,13 @@
 
 #include <algorithm>
 #include <bitset> // For ofToBinary.
+#include <charconv> // For ofToString / ofToInt... without streams.
 #include <chrono>
 #include <iomanip> //for setprecision
+#include <iterator>
 #include <optional>
 #include <sstream>
+#include <string_view>
 
 #include "ofRandomDistributions.h"
 #include "ofRandomEngine.h"
@@ -409,6 +412,81 @@ bool ofContains(const std::vector<T> & values, const T & target) {
 /// \returns A vector of strings split with the delimiter.
 std::vector<std::string> ofSplitString(const std::string & source, const std::string & delimiter, bool ignoreEmpty = false, bool trim = false);
 
+/// \brief Splits a string using a delimiter without copying the tokens.
+///
+/// Works like ofSplitString but the returned tokens are views into source,
+/// so source has to outlive them. Trimming only removes ASCII whitespace.
+///
+/// \param source The string to split.
+/// \param delimiter The delimiter string.
+/// \param ignoreEmpty Set to true to remove empty tokens.
+/// \param trim Set to true to trim the resulting tokens.
+/// \returns A vector of views of the tokens in source.
+std::vector<std::string_view> ofSplitStringView(std::string_view source, std::string_view delimiter, bool ignoreEmpty = false, bool trim = false);
+
+/// \brief Iterates through the tokens of a string split by a delimiter.
+///
+/// Unlike ofSplitString it doesn't allocate any memory, each token is a view
+/// into the original string, which makes it suitable to parse big files or
+/// network protocols line by line:
+///
+/// ~~~~{.cpp}
+///     for(std::string_view field: ofStringTokenizer(line, ",", false, true)){
+///         sum += ofToFloat(field);
+///     }
+/// ~~~~
+///
+/// The source string has to outlive the tokenizer and its tokens.
+class ofStringTokenizer {
+public:
+	/// \brief Create a tokenizer for a given string.
+	///
+	/// \param source The string to split.
+	/// \param delimiter The delimiter string, if empty the whole source is one token.
+	/// \param ignoreEmpty Set to true to skip empty tokens.
+	/// \param trim Set to true to remove ASCII whitespace around each token.
+	ofStringTokenizer(std::string_view source, std::string_view delimiter, bool ignoreEmpty = false, bool trim = false);
+
+	class iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = std::string_view;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const std::string_view *;
+		using reference = const std::string_view &;
+
+		iterator() = default;
+		reference operator*() const { return token; }
+		pointer operator->() const { return &token; }
+		iterator & operator++();
+		iterator operator++(int);
+		bool operator==(const iterator & other) const { return start == other.start; }
+		bool operator!=(const iterator & other) const { return start != other.start; }
+
+	private:
+		friend class ofStringTokenizer;
+		iterator(const ofStringTokenizer * tokenizer, std::size_t start);
+		void findToken();
+
+		const ofStringTokenizer * tokenizer = nullptr;
+		std::size_t start = std::string_view::npos; ///< npos for the end iterator
+		std::size_t end = std::string_view::npos; ///< position of the delimiter after the token
+		std::string_view token;
+	};
+
+	/// \returns A forward iterator that points to the first token.
+	iterator begin() const;
+
+	/// \returns A forward iterator that points past the last token.
+	iterator end() const;
+
+private:
+	std::string_view source;
+	std::string_view delimiter;
+	bool ignoreEmpty;
+	bool trim;
+};
+
 /// \brief Join a vector of strings together into one string.
 /// \param stringElements The vector of strings to join.
 /// \param delimiter The delimiter to put betweeen each string.
@@ -623,6 +701,116 @@ std::string ofUTF8ToString(uint32_t codepoint);
 size_t ofUTF8Length(const std::string & utf8);
 
 
+/*! \cond PRIVATE */
+namespace of {
+namespace priv {
+#if defined(__cpp_lib_to_chars)
+constexpr bool hasFloatCharconv = true;
+#else
+// some standard libraries only implement std::to_chars / from_chars for integers
+constexpr bool hasFloatCharconv = false;
+#endif
+
+// std::to_chars / from_chars produce the same results as the streams for
+// numbers. chars and bools are excluded since streams treat them as text.
+template <typename T>
+constexpr bool isCharconvNumber() {
+	using U = std::remove_cv_t<T>;
+	if constexpr (std::is_same_v<U, bool> || std::is_same_v<U, char> || std::is_same_v<U, signed char> || std::is_same_v<U, unsigned char> || std::is_same_v<U, wchar_t> || std::is_same_v<U, char16_t> || std::is_same_v<U, char32_t>) {
+		return false;
+	} else if constexpr (std::is_integral_v<U>) {
+		return true;
+	} else {
+		return std::is_floating_point_v<U> && hasFloatCharconv;
+	}
+}
+
+// parses a number like operator>> does: leading whitespace and a + sign are
+// skipped, anything after the number is ignored, on failure returns 0 and
+// numbers out of range are clamped to the limits of T. Like the streams,
+// negative numbers wrap around for unsigned types and inf or nan aren't
+// accepted.
+template <typename T>
+T fromChars(std::string_view str) {
+	auto first = str.data();
+	auto last = first + str.size();
+	while (first != last && (*first == ' ' || (*first >= '\t' && *first <= '\r'))) {
+		++first;
+	}
+	if (first != last && *first == '+' && last - first > 1 && first[1] != '-') {
+		++first;
+	}
+	bool negative = first != last && *first == '-';
+	if constexpr (std::is_floating_point_v<T>) {
+		auto digits = negative ? first + 1 : first;
+		if (digits == last || !((*digits >= '0' && *digits <= '9') || *digits == '.')) {
+			return 0;
+		}
+	}
+	if constexpr (std::is_unsigned_v<T>) {
+		if (negative) {
+			T magnitude = 0;
+			auto result = std::from_chars(first + 1, last, magnitude);
+			if (result.ec == std::errc::result_out_of_range) {
+				return std::numeric_limits<T>::max();
+			}
+			return T(T(0) - magnitude);
+		}
+	}
+	T value = 0;
+	auto result = std::from_chars(first, last, value);
+	if (result.ec == std::errc::result_out_of_range) {
+		if constexpr (std::is_integral_v<T>) {
+			return negative ? std::numeric_limits<T>::lowest() : std::numeric_limits<T>::max();
+		} else {
+			// overflows give the largest value and underflows the closest
+			// one, which from_chars doesn't return, let the streams find it
+			std::istringstream stream(std::string(first, last));
+			stream >> value;
+			return value;
+		}
+	}
+	return value;
+}
+
+// prints a number like operator<< does, with std::fixed if precision is
+// specified.
+template <typename T>
+std::string toChars(const T & value, int precision = -1) {
+	char buffer[128];
+	std::to_chars_result result;
+	if constexpr (std::is_floating_point_v<T>) {
+		if (precision < 0) {
+			result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::general, 6);
+		} else {
+			result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, precision);
+		}
+	} else {
+		result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+	}
+	if (result.ec == std::errc()) {
+		return std::string(buffer, result.ptr);
+	}
+	// huge numbers with fixed precision don't fit in the buffer
+	std::ostringstream out;
+	if (precision >= 0) {
+		out << std::fixed << std::setprecision(precision);
+	}
+	out << value;
+	return out.str();
+}
+
+// right aligns str in width characters like std::setw
+inline std::string pad(std::string && str, int width, char fill) {
+	if (width > 0 && str.size() < std::size_t(width)) {
+		str.insert(0, width - str.size(), fill);
+	}
+	return std::move(str);
+}
+}
+}
+/*! \endcond */
+
 /// \section String Conversion
 /// \brief Convert a value to a string.
 ///
@@ -641,9 +829,13 @@ size_t ofUTF8Length(const std::string & utf8);
 /// \returns A string representing the value or an empty string on failure.
 template <class T>
 std::string ofToString(const T & value) {
-	std::ostringstream out;
-	out << value;
-	return out.str();
+	if constexpr (of::priv::isCharconvNumber<T>()) {
+		return of::priv::toChars(value);
+	} else {
+		std::ostringstream out;
+		out << value;
+		return out.str();
+	}
 }
 
 /// \brief Convert a value to a string with a specific precision.
@@ -656,9 +848,13 @@ std::string ofToString(const T & value) {
 /// \returns The string representation of the value.
 template <class T>
 std::string ofToString(const T & value, int precision) {
-	std::ostringstream out;
-	out << std::fixed << std::setprecision(precision) << value;
-	return out.str();
+	if constexpr (of::priv::isCharconvNumber<T>()) {
+		return of::priv::toChars(value, precision < 0 ? 6 : precision);
+	} else {
+		std::ostringstream out;
+		out << std::fixed << std::setprecision(precision) << value;
+		return out.str();
+	}
 }
 
 /// \brief Convert a value to a string with a specific width and fill
@@ -672,9 +868,13 @@ std::string ofToString(const T & value, int precision) {
 /// \returns The string representation of the value.
 template <class T>
 std::string ofToString(const T & value, int width, char fill) {
-	std::ostringstream out;
-	out << std::fixed << std::setfill(fill) << std::setw(width) << value;
-	return out.str();
+	if constexpr (of::priv::isCharconvNumber<T>()) {
+		return of::priv::pad(of::priv::toChars(value, 6), width, fill);
+	} else {
+		std::ostringstream out;
+		out << std::fixed << std::setfill(fill) << std::setw(width) << value;
+		return out.str();
+	}
 }
 
 /// \brief Convert a value to a string with a specific precision, width and filll
@@ -689,9 +889,13 @@ std::string ofToString(const T & value, int width, char fill) {
 /// \returns The string representation of the value.
 template <class T>
 std::string ofToString(const T & value, int precision, int width, char fill) {
-	std::ostringstream out;
-	out << std::fixed << std::setfill(fill) << std::setw(width) << std::setprecision(precision) << value;
-	return out.str();
+	if constexpr (of::priv::isCharconvNumber<T>()) {
+		return of::priv::pad(of::priv::toChars(value, precision < 0 ? 6 : precision), width, fill);
+	} else {
+		std::ostringstream out;
+		out << std::fixed << std::setfill(fill) << std::setw(width) << std::setprecision(precision) << value;
+		return out.str();
+	}
 }
 
 /// \brief Convert a vector of values to a comma-delimited string.
@@ -726,11 +930,15 @@ std::string ofToString(const std::vector<T> & values) {
 /// \returns the string converted to the target data type T.
 template <class T>
 T ofFromString(const std::string & value) {
-	T data;
-	std::stringstream ss;
-	ss << value;
-	ss >> data;
-	return data;
+	if constexpr (of::priv::isCharconvNumber<T>()) {
+		return of::priv::fromChars<T>(value);
+	} else {
+		T data;
+		std::stringstream ss;
+		ss << value;
+		ss >> data;
+		return data;
+	}
 }
 
 /// \brief Convert a string represetnation to another string.
@@ -754,10 +962,14 @@ const char * ofFromString(const std::string & value);
 /// \returns the string converted to the type.
 template <typename T>
 T ofTo(const std::string & str) {
-	T x;
-	std::istringstream cur(str);
-	cur >> x;
-	return x;
+	if constexpr (of::priv::isCharconvNumber<T>()) {
+		return of::priv::fromChars<T>(str);
+	} else {
+		T x;
+		std::istringstream cur(str);
+		cur >> x;
+		return x;
+	}
 }
 
 /// \section Number Conversion
@@ -770,6 +982,15 @@ T ofTo(const std::string & str) {
 /// \returns the integer represented by the string or 0 on failure.
 int ofToInt(const std::string & intString);
 
+/// \brief Same as ofToInt(const std::string &) for string views, like the
+/// tokens returned by ofSplitStringView, without copying them.
+int ofToInt(std::string_view intString);
+
+/*! \cond PRIVATE */
+// disambiguates string literals between the string and string_view versions
+int ofToInt(const char * intString);
+/*! \endcond */
+
 /// \brief Convert a string to a int64_t.
 ///
 /// Converts a `std::string` representation of a long integer
@@ -779,6 +1000,15 @@ int ofToInt(const std::string & intString);
 /// \returns the long integer represented by the string or 0 on failure.
 int64_t ofToInt64(const std::string & intString);
 
+/// \brief Same as ofToInt64(const std::string &) for string views, like the
+/// tokens returned by ofSplitStringView, without copying them.
+int64_t ofToInt64(std::string_view intString);
+
+/*! \cond PRIVATE */
+// disambiguates string literals between the string and string_view versions
+int64_t ofToInt64(const char * intString);
+/*! \endcond */
+
 /// \brief Convert a string to a float.
 ///
 /// Converts a std::string representation of a float (e.g., `"3.14"`) to an
@@ -788,6 +1018,15 @@ int64_t ofToInt64(const std::string & intString);
 /// \returns the float represented by the string or 0 on failure.
 float ofToFloat(const std::string & floatString);
 
+/// \brief Same as ofToFloat(const std::string &) for string views, like the
+/// tokens returned by ofSplitStringView, without copying them.
+float ofToFloat(std::string_view floatString);
+
+/*! \cond PRIVATE */
+// disambiguates string literals between the string and string_view versions
+float ofToFloat(const char * floatString);
+/*! \endcond */
+
 /// \brief Convert a string to a double.
 ///
 /// Converts a std::string representation of a double (e.g., `"3.14"`) to an
@@ -797,6 +1036,15 @@ float ofToFloat(const std::string & floatString);
 /// \returns the double represented by the string or 0 on failure.
 double ofToDouble(const std::string & doubleString);
 
+/// \brief Same as ofToDouble(const std::string &) for string views, like the
+/// tokens returned by ofSplitStringView, without copying them.
+double ofToDouble(std::string_view doubleString);
+
+/*! \cond PRIVATE */
+// disambiguates string literals between the string and string_view versions
+double ofToDouble(const char * doubleString);
+/*! \endcond */
+
 /// \brief Convert a string to a boolean.
 ///
 /// Converts a std::string representation of a boolean (e.g., `"TRUE"`) to an
@@ -1,6 +1,8 @@
 #include "ofXml.h"
 #include "ofUtils.h"
 #include <clocale>
+#include <cstring>
+#include <fstream>
 
 using std::string;
 
@@ -29,7 +31,14 @@ bool ofXml::load(const of::filesystem::path & file){
 }
 
 bool ofXml::load(const ofBuffer & buffer){
-	return parse(buffer.getText());
+	auto auxDoc = std::make_shared<pugi::xml_document>();
+	if(auxDoc->load_buffer(buffer.getData(), buffer.size())){
+		doc = auxDoc;
+		xml = doc->root();
+		return true;
+	}else{
+		return false;
+	}
 }
 
 bool ofXml::parse(const std::string & xmlStr){
@@ -438,6 +447,228 @@ ofXmlSearchIterator ofXmlSearchIterator::operator--(int){
 	}
 }
 
+//----------------------------------------------------
+// StreamReader
+
+// position right after the markup that begins at start, or npos if the
+// buffer doesn't contain the whole markup yet
+static size_t markupEnd(const std::string & buffer, size_t start, bool eof){
+	// enough data to recognize the longest prefix, <![CDATA[
+	if(!eof && buffer.size() - start < 9){
+		return std::string::npos;
+	}
+	auto startsWith = [&](const char * prefix){
+		return buffer.compare(start, strlen(prefix), prefix) == 0;
+	};
+	auto findEnd = [&](const char * delimiter, size_t from){
+		auto end = buffer.find(delimiter, from);
+		return end == std::string::npos ? end : end + strlen(delimiter);
+	};
+	if(startsWith("<!--")){
+		return findEnd("-->", start + 4);
+	}else if(startsWith("<![CDATA[")){
+		return findEnd("]]>", start + 9);
+	}else if(startsWith("<?")){
+		return findEnd("?>", start + 2);
+	}
+
+	// tags and doctype, > can appear inside quotes and the doctype internal subset
+	char quote = 0;
+	int brackets = 0;
+	for(size_t i = start + 1; i < buffer.size(); i++){
+		char c = buffer[i];
+		if(quote){
+			if(c == quote){
+				quote = 0;
+			}
+		}else if(c == '"' || c == '\''){
+			quote = c;
+		}else if(c == '['){
+			brackets++;
+		}else if(c == ']'){
+			brackets--;
+		}else if(c == '>' && brackets <= 0){
+			return i + 1;
+		}
+	}
+	return std::string::npos;
+}
+
+void ofXmlStreamReader::addFilter(const std::string & path){
+	filters.push_back(ofSplitString(path, "/", true));
+}
+
+void ofXmlStreamReader::clearFilters(){
+	filters.clear();
+}
+
+void ofXmlStreamReader::setChunkSize(size_t chunkSize){
+	this->chunkSize = std::max(chunkSize, size_t(16));
+}
+
+const std::string & ofXmlStreamReader::getError() const{
+	return error;
+}
+
+bool ofXmlStreamReader::load(const of::filesystem::path & file, const Callback & callback){
+	std::ifstream stream(ofToDataPath(file), std::ios::binary);
+	if(!stream){
+		error = "file doesn't exist";
+		ofLogWarning("ofXml") << "Cannot load file " << file << ": " << error;
+		return false;
+	}
+	if(!parse(stream, callback)){
+		ofLogWarning("ofXml") << "Cannot load file " << file << ": " << error;
+		return false;
+	}
+	return true;
+}
+
+bool ofXmlStreamReader::parse(const std::string & xmlStr, const Callback & callback){
+	std::istringstream stream(xmlStr);
+	return parse(stream, callback);
+}
+
+bool ofXmlStreamReader::parse(std::istream & stream, const Callback & callback){
+	error.clear();
+	std::string buffer;
+	size_t pos = 0;
+	bool eof = false;
+	std::vector<std::string> path;
+	size_t selectionStart = std::string::npos;
+	size_t selectionDepth = 0;
+	bool foundRoot = false;
+	bool keepGoing = true;
+	auto encoding = pugi::encoding_auto;
+
+	// discards the data already scanned, except for the selected element
+	// being read, and appends the next chunk. Reads at least as much as it
+	// keeps so markup bigger than a chunk isn't rescanned too many times.
+	auto readChunk = [&]{
+		auto keep = std::min(pos, selectionStart);
+		buffer.erase(0, keep);
+		pos -= keep;
+		if(selectionStart != std::string::npos){
+			selectionStart -= keep;
+		}
+		auto size = buffer.size();
+		auto toRead = std::max(chunkSize, size);
+		buffer.resize(size + toRead);
+		stream.read(&buffer[size], toRead);
+		buffer.resize(size + stream.gcount());
+		eof = stream.gcount() == 0;
+		return !eof;
+	};
+
+	while(keepGoing){
+		auto start = buffer.find('<', pos);
+		if(start == std::string::npos){
+			pos = buffer.size();
+			if(!readChunk()){
+				break;
+			}
+			continue;
+		}
+		pos = start;
+		auto end = markupEnd(buffer, start, eof);
+		if(end == std::string::npos){
+			if(eof){
+				error = "unexpected end of document";
+				return false;
+			}
+			readChunk();
+			continue;
+		}
+		pos = end;
+
+		if(buffer.compare(start, 5, "<?xml") == 0 && !foundRoot){
+			// subtrees are parsed without the declaration so keep its encoding
+			auto declaration = ofToLower(buffer.substr(start, end - start));
+			if(declaration.find("8859-1") != std::string::npos || declaration.find("latin1") != std::string::npos){
+				encoding = pugi::encoding_latin1;
+			}
+		}else if(buffer[start + 1] == '/'){
+			auto nameEnd = buffer.find_first_of(" \t\r\n>", start + 2);
+			auto name = buffer.substr(start + 2, nameEnd - start - 2);
+			if(path.empty() || path.back() != name){
+				error = "mismatched end tag </" + name + ">";
+				return false;
+			}
+			if(selectionStart != std::string::npos && path.size() == selectionDepth){
+				if(!emit(path, buffer.data() + selectionStart, end - selectionStart, encoding, callback, keepGoing)){
+					return false;
+				}
+				selectionStart = std::string::npos;
+			}
+			path.pop_back();
+		}else if(buffer[start + 1] != '!' && buffer[start + 1] != '?'){
+			auto nameEnd = buffer.find_first_of(" \t\r\n/>", start + 1);
+			if(nameEnd == start + 1){
+				error = "invalid start tag";
+				return false;
+			}
+			foundRoot = true;
+			path.push_back(buffer.substr(start + 1, nameEnd - start - 1));
+			if(selectionStart == std::string::npos && selected(path)){
+				selectionStart = start;
+				selectionDepth = path.size();
+			}
+			if(buffer[end - 2] == '/'){
+				if(selectionStart != std::string::npos && path.size() == selectionDepth){
+					if(!emit(path, buffer.data() + selectionStart, end - selectionStart, encoding, callback, keepGoing)){
+						return false;
+					}
+					selectionStart = std::string::npos;
+				}
+				path.pop_back();
+			}
+		}
+	}
+
+	if(keepGoing){
+		if(!foundRoot){
+			error = "no document element found";
+			return false;
+		}
+		if(!path.empty()){
+			error = "unexpected end of document, missing </" + path.back() + ">";
+			return false;
+		}
+	}
+	return true;
+}
+
+bool ofXmlStreamReader::selected(const std::vector<std::string> & path) const{
+	if(filters.empty()){
+		return path.size() == 1;
+	}
+	for(auto & filter: filters){
+		if(filter.size() != path.size()){
+			continue;
+		}
+		bool match = true;
+		for(size_t i = 0; i < path.size() && match; i++){
+			match = filter[i] == "*" || filter[i] == path[i];
+		}
+		if(match){
+			return true;
+		}
+	}
+	return false;
+}
+
+bool ofXmlStreamReader::emit(const std::vector<std::string> & path, const char * data, size_t size, pugi::xml_encoding encoding, const Callback & callback, bool & keepGoing){
+	auto doc = std::make_shared<pugi::xml_document>();
+	auto elementPath = "/" + ofJoinString(path, "/");
+	auto res = doc->load_buffer(data, size, pugi::parse_default, encoding);
+	if(!res){
+		error = elementPath + ": " + res.description();
+		return false;
+	}
+	keepGoing = callback(elementPath, ofXml(doc, doc->first_child()));
+	return true;
+}
+
 void ofSerialize(ofXml & xml, const ofAbstractParameter & parameter){
 	if(!parameter.isSerializable()){
 		return;
@@ -216,6 +216,7 @@ private:
 	friend class ofXmlIterator;
 	friend class ofXmlAttributeIterator;
 	friend class ofXmlSearchIterator;
+	friend class ofXmlStreamReader;
 };
 
 template<typename It>
@@ -403,6 +404,63 @@ private:
 	mutable ofXml xml;
 	friend ofXml::Search;
 };
+/// \brief Reads big xml documents without building the whole DOM in memory.
+///
+/// The file is read in chunks and scanned for the elements selected by the
+/// filters, only those elements are parsed as independent ofXml documents
+/// and passed to the callback, one at a time, so the memory used only
+/// depends on the size of each selected element.
+///
+/// Filters are paths of element names from the root, where `*` matches any
+/// element:
+///
+/// ~~~~{.cpp}
+///     ofXmlStreamReader reader;
+///     reader.addFilter("/timeline/track/event");
+///     reader.load("timeline.xml", [&](const std::string & path, ofXml && event){
+///         times.push_back(event.getAttribute("time").getFloatValue());
+///         return true; // false stops reading
+///     });
+/// ~~~~
+///
+/// Without filters the root element is selected, like ofXml::load.
+class ofXmlStreamReader{
+public:
+	/// \brief Callback receiving the path of each selected element and the
+	/// element itself, returning false stops parsing.
+	using Callback = std::function<bool(const std::string & path, ofXml && element)>;
+
+	/// \brief Select the elements at the given path, `*` matches any element.
+	void addFilter(const std::string & path);
+	void clearFilters();
+
+	/// \brief Size of the blocks read from the file or stream, 64KB by default.
+	void setChunkSize(size_t chunkSize);
+
+	/// \brief Parse an xml file, reading it in chunks.
+	/// \returns false if the file can't be opened or isn't well formed.
+	bool load(const of::filesystem::path & file, const Callback & callback);
+
+	/// \brief Parse xml from a stream.
+	/// \returns false if the stream doesn't contain well formed xml.
+	bool parse(std::istream & stream, const Callback & callback);
+
+	/// \brief Parse xml from a string.
+	/// \returns false if the string isn't well formed xml.
+	bool parse(const std::string & xmlStr, const Callback & callback);
+
+	/// \returns the description of the last error.
+	const std::string & getError() const;
+
+private:
+	bool selected(const std::vector<std::string> & path) const;
+	bool emit(const std::vector<std::string> & path, const char * data, size_t size, pugi::xml_encoding encoding, const Callback & callback, bool & keepGoing);
+
+	std::vector<std::vector<std::string>> filters;
+	size_t chunkSize = 64 * 1024;
+	std::string error;
+};
+
 // serializer
 void ofSerialize(ofXml & xml, const ofAbstractParameter & parameter);
 void ofDeserialize(const ofXml & xml, ofAbstractParameter & parameter);
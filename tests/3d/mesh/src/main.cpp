@@ -0,0 +1,274 @@
+#include "ofMesh.h"
+#include "ofPly.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+#include "ofAppRunner.h"
+#include <clocale>
+#include <chrono>
+
+class ofApp: public ofxUnitTestsApp{
+	ofMesh makeMesh(size_t numVertices){
+		ofMesh mesh;
+		for(size_t i = 0; i < numVertices; i++){
+			mesh.addVertex({i * 0.5f, -float(i), 3.25f});
+			mesh.addNormal({0, 1, 0});
+			mesh.addColor(ofFloatColor(1, 0, 0.5f, 1));
+			mesh.addTexCoord({0.25f, 0.75f});
+		}
+		for(size_t i = 0; i + 2 < numVertices; i += 3){
+			mesh.addTriangle(i, i + 1, i + 2);
+		}
+		return mesh;
+	}
+
+	bool equal(const ofMesh & mesh, const ofMesh & loaded){
+		if(mesh.getNumVertices() != loaded.getNumVertices() || mesh.getNumIndices() != loaded.getNumIndices()){
+			return false;
+		}
+		bool equal = true;
+		for(size_t i = 0; i < mesh.getNumVertices(); i++){
+			equal &= mesh.getVertex(i) == loaded.getVertex(i);
+			equal &= mesh.getNormal(i) == loaded.getNormal(i);
+			equal &= mesh.getTexCoord(i) == loaded.getTexCoord(i);
+			equal &= std::abs(mesh.getColor(i).b - loaded.getColor(i).b) < 0.01f;
+		}
+		equal &= mesh.getIndices() == loaded.getIndices();
+		return equal;
+	}
+
+	void run(){
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "save and load ascii and binary";
+			auto mesh = makeMesh(3000);
+			mesh.save("ascii.ply");
+			ofMesh loaded;
+			loaded.load("ascii.ply");
+			ofxTest(equal(mesh, loaded), "ascii round trip");
+
+			mesh.save("binary.ply", true);
+			loaded.clear();
+			loaded.load("binary.ply");
+			ofxTest(equal(mesh, loaded), "binary round trip");
+
+			ofPlyReader reader;
+			ofxTest(reader.open("binary.ply"), "reader open");
+			ofxTestEq(reader.getFormat(), OF_PLY_BINARY_LITTLE_ENDIAN, "binary format");
+			ofxTestEq(reader.getNumVertices(), 3000, "num vertices");
+			ofxTestEq(reader.getNumFaces(), 1000, "num faces");
+			ofxTest(reader.hasNormals() && reader.hasColors() && reader.hasTexCoords(), "attributes");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "streaming";
+			ofMesh points;
+			for(int i = 0; i < 1000; i++){
+				points.addVertex({float(i), 1, 2});
+			}
+			ofPlyWriter writer;
+			ofxTest(writer.open("points.ply", OF_PLY_BINARY_BIG_ENDIAN, 2000, 0, false, false, false), "writer open");
+			ofxTest(writer.writeVertices(points), "write first chunk");
+			ofxTest(writer.writeVertices(points), "write second chunk");
+			ofxTest(writer.close(), "writer close");
+
+			ofPlyReader reader;
+			ofxTest(reader.open("points.ply"), "reader open");
+			ofMesh chunk;
+			size_t total = 0;
+			size_t numChunks = 0;
+			bool correct = true;
+			while(size_t read = reader.readVertices(chunk, 300)){
+				for(size_t i = 0; i < read; i++){
+					correct &= chunk.getVertex(i).x == float((total + i) % 1000);
+				}
+				total += read;
+				numChunks++;
+			}
+			ofxTestEq(total, 2000, "read every vertex");
+			ofxTestEq(numChunks, 7, "read in chunks");
+			ofxTest(correct, "big endian data is correct");
+			ofxTest(reader.getError().empty(), "no errors");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "polygons and unknown elements";
+			ofBuffer buffer;
+			buffer.set("ply\n"
+				"format ascii 1.0\n"
+				"comment quad\n"
+				"element vertex 4\n"
+				"property double x\n"
+				"property double y\n"
+				"property double z\n"
+				"property uchar red\n"
+				"property uchar green\n"
+				"property uchar blue\n"
+				"element face 1\n"
+				"property list uchar int vertex_indices\n"
+				"element edge 1\n"
+				"property int vertex1\n"
+				"property int vertex2\n"
+				"end_header\n"
+				"0 0 0 255 0 0\n"
+				"1 0 0 0 255 0\n"
+				"1 1 0 0 0 255\n"
+				"0 1 0 255 255 255\n"
+				"4 0 1 2 3\n"
+				"0 1\n");
+			ofPlyReader reader;
+			ofxTest(reader.open(buffer), "open from buffer");
+			ofMesh quad;
+			ofxTest(reader.read(quad), "read");
+			ofxTestEq(quad.getNumVertices(), 4, "num vertices");
+			ofxTestEq(quad.getNumIndices(), 6, "quad split in 2 triangles");
+			ofxTestEq(quad.getColor(1), ofFloatColor(0, 1, 0, 1), "uchar colors");
+			ofxTestEq(quad.getIndex(5), 3, "fan indices");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "errors";
+			ofBuffer truncated;
+			truncated.set("ply\nformat ascii 1.0\nelement vertex 4\nproperty float x\nend_header\n0\n1\n");
+			ofBufferToFile("truncated.ply", truncated);
+			ofMesh mesh;
+			mesh.addVertex({5, 5, 5});
+			mesh.load("truncated.ply");
+			ofxTestEq(mesh.getNumVertices(), 1, "the mesh is untouched if loading fails");
+
+			ofBuffer negative;
+			negative.set("ply\nformat ascii 1.0\nelement vertex 1\nproperty float x\n"
+				"element face 1\nproperty list uchar int vertex_indices\nend_header\n0\n-1 0 0 0\n");
+			ofPlyReader reader;
+			ofxTest(reader.open(negative), "open with a negative list size");
+			ofMesh faces;
+			ofxTest(!reader.read(faces), "negative list sizes are rejected");
+			ofxTest(!reader.getError().empty(), "negative list size error");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "ascii in other locales";
+			ofMesh mesh;
+			mesh.addVertex({0.5f, -1.25f, 1e-7f});
+			auto previous = std::setlocale(LC_NUMERIC, nullptr);
+			std::string previousLocale = previous ? previous : "C";
+			// a locale with a decimal comma, if the system has one
+			if(std::setlocale(LC_NUMERIC, "de_DE.UTF-8") || std::setlocale(LC_NUMERIC, "fr_FR.UTF-8")){
+				mesh.save("locale.ply");
+				ofMesh loaded;
+				loaded.load("locale.ply");
+				std::setlocale(LC_NUMERIC, previousLocale.c_str());
+				ofxTestEq(loaded.getNumVertices(), 1, "read with a decimal comma locale");
+				ofxTestEq(loaded.getVertex(0), mesh.getVertex(0), "exact values with a decimal comma locale");
+				auto text = ofBufferFromFile("locale.ply").getText();
+				ofxTest(text.find("0.5") != std::string::npos, "written with a decimal point");
+			}else{
+				ofLogNotice() << "no decimal comma locale available, skipped";
+			}
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "merge duplicate vertices";
+			ofMesh grid;
+			for(float y = 0; y < 4; y++){
+				for(float x = 0; x < 4; x++){
+					auto i = grid.getNumVertices();
+					grid.addVertex({x, y, 0});
+					grid.addVertex({x + 1, y, 0});
+					grid.addVertex({x + 1, y + 1, 0});
+					grid.addVertex({x, y + 1, 0});
+					grid.addTriangle(i, i + 1, i + 2);
+					grid.addTriangle(i, i + 2, i + 3);
+				}
+			}
+			grid.mergeDuplicateVertices();
+			ofxTestEq(grid.getNumVertices(), 25, "shared corners merged");
+			ofxTestEq(grid.getNumIndices(), 96, "indices kept");
+
+			ofMesh close;
+			close.addVertex({0, 0, 0});
+			close.addVertex({0.0009f, 0, 0});
+			close.addVertex({0.02f, 0, 0});
+			close.addVertex({-0.0009f, -0.0003f, 0.0001f});
+			close.addVertex({-0.f, 0, 0});
+			auto exact = close;
+			exact.mergeDuplicateVertices();
+			ofxTestEq(exact.getNumVertices(), 4, "exact merge treats -0 as 0");
+			close.mergeDuplicateVertices(0.001f);
+			ofxTestEq(close.getNumVertices(), 2, "merge with epsilon");
+			ofxTestEq(close.getIndex(3), 0, "index remapped to the merged vertex");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "smooth normals";
+			ofMesh mesh;
+			mesh.addVertex({0, 0, 0});
+			mesh.addVertex({1, 0, 0});
+			mesh.addVertex({1, 1, 0});
+			mesh.addVertex({0, 0, 0});
+			mesh.addVertex({1, 0, 0});
+			mesh.addVertex({0, 0, -1});
+			auto faceNormals = mesh.getFaceNormals();
+			ofxTestEq(faceNormals.size(), 2, "one normal per face");
+			ofxTestEq(mesh.getFaceNormals(true).size(), 6, "one normal per vertex");
+			ofxTestEq(faceNormals[0], glm::vec3(0, 0, 1), "face normal");
+			ofxTestEq(mesh.getUniqueFaces().size(), 0, "unique faces need indices");
+
+			auto flipped = mesh;
+			flipped.setupIndicesAuto();
+			ofxTestEq(flipped.getUniqueFaces()[0].getFaceNormal(), faceNormals[0], "unique face normal");
+			flipped.setVertex(2, {1, -1, 0});
+			ofxTestEq(flipped.getFaceNormals()[0], glm::vec3(0, 0, -1), "face normals follow changes");
+			ofxTestEq(flipped.getUniqueFaces()[0].getVertex(2), glm::vec3(1, -1, 0), "unique faces follow changes");
+
+			auto smooth = mesh;
+			smooth.smoothNormals(100);
+			auto normal = smooth.getNormal(0);
+			ofxTest(std::abs(glm::length(normal) - 1) < 0.0001f, "smoothed normal is normalized");
+			ofxTest(std::abs(normal.y - normal.z) < 0.0001f && normal.x == 0, "smoothed across the edge");
+			ofxTestEq(smooth.getNormal(2), faceNormals[0], "corner without neighbours keeps the face normal");
+
+			auto hard = mesh;
+			hard.smoothNormals(45);
+			ofxTest(hard.getNormal(0) == faceNormals[0] && hard.getNormal(3) == faceNormals[1], "edges sharper than the angle stay hard");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "ascii vs binary throughput";
+			auto mesh = makeMesh(1000000);
+			for(auto binary: {false, true}){
+				auto start = std::chrono::steady_clock::now();
+				mesh.save("throughput.ply", binary);
+				auto saved = std::chrono::steady_clock::now();
+				ofMesh loaded;
+				loaded.load("throughput.ply");
+				auto end = std::chrono::steady_clock::now();
+				auto size = ofFile("throughput.ply").getSize() / (1024. * 1024.);
+				auto saveTime = std::chrono::duration<double>(saved - start).count();
+				auto loadTime = std::chrono::duration<double>(end - saved).count();
+				ofLogNotice() << (binary ? "binary: " : "ascii: ") << size << "MB, "
+					<< "save " << saveTime * 1000 << "ms (" << size / saveTime << "MB/s), "
+					<< "load " << loadTime * 1000 << "ms (" << size / loadTime << "MB/s)";
+				ofxTestEq(loaded.getNumVertices(), mesh.getNumVertices(), std::string(binary ? "binary" : "ascii") + " throughput mesh loaded");
+			}
+		}
+
+		for(auto file: {"ascii.ply", "binary.ply", "points.ply", "truncated.ply", "throughput.ply", "locale.ply"}){
+			ofFile::removeFile(file);
+		}
+	}
+};
+
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
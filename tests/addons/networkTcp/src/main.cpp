@@ -2,6 +2,7 @@
 #include "ofAppNoWindow.h"
 #include "ofxUnitTests.h"
 #include "ofxNetwork.h"
+#include <chrono>
 
 class ofApp: public ofxUnitTestsApp{
 public:
@@ -264,6 +265,183 @@ public:
 		ofxTestEq(received, str, "received max size message == sent message");
 	}
 
+#ifndef TARGET_WIN32
+	// polls the reactor events until done returns true or timeout
+	bool waitReactorEvents(ofxTCPReactorServer & server, std::vector<ofxTCPReactorEvent> & events, std::function<bool()> done, int timeoutMs = 5000){
+		auto start = ofGetElapsedTimeMillis();
+		ofxTCPReactorEvent event;
+		while(!done() && ofGetElapsedTimeMillis() - start < uint64_t(timeoutMs)){
+			while(server.getNextEvent(event)){
+				events.push_back(event);
+			}
+			ofSleepMillis(1);
+		}
+		return done();
+	}
+
+	void testReactorMessages(){
+		ofLogNotice() << "";
+		ofLogNotice() << "---------------------------------------";
+		ofLogNotice() << "testReactorMessages";
+
+		ofxTCPReactorSettings settings(0);
+		settings.notifyInUpdate = false;
+		ofxTCPReactorServer server;
+		ofxTest(server.setup(settings), "reactor server");
+
+		ofxTCPClient client;
+		ofxTest(client.setup("127.0.0.1", server.getPort(), true), "blocking client");
+		ofxTest(client.send("hello") && client.send("world"), "send from client");
+
+		std::vector<ofxTCPReactorEvent> events;
+		std::vector<std::string> messages;
+		ofxTest(waitReactorEvents(server, events, [&]{
+			messages.clear();
+			for(auto & event: events){
+				if(event.type == ofxTCPReactorEvent::MESSAGE){
+					messages.push_back(event.message);
+				}
+			}
+			return messages.size() == 2;
+		}), "messages received");
+		ofxTestEq(events.front().type, ofxTCPReactorEvent::CONNECTED, "connected event first");
+		ofxTestEq(messages.front(), "hello", "first message");
+		ofxTestEq(messages.back(), "world", "second message");
+		ofxTestEq(server.getNumClients(), 1, "one client");
+
+		int clientID = events.front().clientID;
+		ofxTest(server.send(clientID, "reply"), "send from server");
+		ofxTestEq(client.receive(), "reply", "receive from server");
+
+		client.close();
+		ofxTest(waitReactorEvents(server, events, [&]{
+			return events.back().type == ofxTCPReactorEvent::DISCONNECTED;
+		}), "disconnection detected");
+		ofxTest(!server.isClientConnected(clientID), "client removed");
+	}
+
+	void testReactorRawData(){
+		ofLogNotice() << "";
+		ofLogNotice() << "---------------------------------------";
+		ofLogNotice() << "testReactorRawData";
+
+		// a small buffer so the data wraps around and the server has to
+		// stop reading until we consume it
+		ofxTCPReactorSettings settings(0);
+		settings.notifyInUpdate = false;
+		settings.delimitedMessages = false;
+		settings.receiveBufferSize = 100;
+		ofxTCPReactorServer server;
+		ofxTest(server.setup(settings), "reactor server");
+
+		ofxTCPClient client;
+		ofxTest(client.setup("127.0.0.1", server.getPort(), true), "blocking client");
+		std::string sent;
+		for(int i = 0; i < 10000; i++){
+			sent += char('a' + i % 26);
+		}
+		ofxTest(client.sendRawBytes(sent.c_str(), sent.size()), "send from client");
+
+		std::vector<ofxTCPReactorEvent> events;
+		std::string received;
+		ofxTest(waitReactorEvents(server, events, [&]{
+			for(auto & event: events){
+				if(event.type == ofxTCPReactorEvent::DATA){
+					// read in small pieces, in place
+					while(server.receive(event.clientID, [&](const char * data, size_t size){
+						size = std::min(size, size_t(33));
+						received.append(data, size);
+						return size;
+					}) > 0){}
+				}
+			}
+			events.clear();
+			return received.size() == sent.size();
+		}), "all data received");
+		ofxTest(received == sent, "received data is correct");
+	}
+
+	void benchmarkReactor(){
+		ofLogNotice() << "";
+		ofLogNotice() << "---------------------------------------";
+		ofLogNotice() << "benchmarkReactor";
+
+		size_t numMessages = 100;
+		auto message = std::string(64, 'x');
+
+		// the polling server is limited to TCP_MAX_CLIENTS and only returns
+		// buffered messages when more data arrives, so it doesn't always get
+		// every message, just measure how many it gets in a couple of seconds
+		{
+			int port = ofRandom(15000, 65535);
+			ofxTCPServer server;
+			ofxTest(server.setup(port, false), "polling server");
+			std::vector<std::unique_ptr<ofxTCPClient>> clients;
+			for(int i = 0; i < TCP_MAX_CLIENTS - 1; i++){
+				clients.emplace_back(new ofxTCPClient);
+				clients.back()->setup("127.0.0.1", port, false);
+			}
+			while(server.getNumClients() < int(clients.size())){
+				server.waitConnectedClient(100);
+			}
+			auto start = std::chrono::steady_clock::now();
+			for(size_t i = 0; i < numMessages; i++){
+				for(auto & client: clients){
+					client->send(message);
+				}
+			}
+			size_t received = 0;
+			size_t total = numMessages * clients.size();
+			while(received < total && std::chrono::steady_clock::now() - start < std::chrono::seconds(2)){
+				for(int i = 0; i < server.getLastID(); i++){
+					if(server.isClientConnected(i)){
+						while(!server.receive(i).empty()){
+							received++;
+						}
+					}
+				}
+			}
+			auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			ofLogNotice() << "polling server, " << clients.size() << " clients: " << received / seconds << " messages/s, "
+				<< received << " of " << total << " messages received";
+			ofxTestGt(received, size_t(0), "polling server received messages");
+		}
+
+		for(size_t numClients: {size_t(TCP_MAX_CLIENTS - 1), size_t(400)}){
+			ofxTCPReactorSettings settings(0);
+			settings.notifyInUpdate = false;
+			ofxTCPReactorServer server;
+			ofxTest(server.setup(settings), "reactor server");
+			std::vector<std::unique_ptr<ofxTCPClient>> clients;
+			for(size_t i = 0; i < numClients; i++){
+				clients.emplace_back(new ofxTCPClient);
+				clients.back()->setup("127.0.0.1", server.getPort(), false);
+			}
+			std::vector<ofxTCPReactorEvent> events;
+			waitReactorEvents(server, events, [&]{
+				return server.getNumClients() == numClients;
+			});
+			auto start = std::chrono::steady_clock::now();
+			for(size_t i = 0; i < numMessages; i++){
+				for(auto & client: clients){
+					client->send(message);
+				}
+			}
+			size_t received = 0;
+			size_t total = numMessages * clients.size();
+			ofxTCPReactorEvent event;
+			while(received < total && std::chrono::steady_clock::now() - start < std::chrono::seconds(10)){
+				while(server.getNextEvent(event)){
+					received += event.type == ofxTCPReactorEvent::MESSAGE;
+				}
+			}
+			auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			ofLogNotice() << "reactor server, " << clients.size() << " clients: " << received / seconds << " messages/s";
+			ofxTestEq(received, total, "reactor server received all messages from " + ofToString(numClients) + " clients");
+		}
+	}
+#endif
+
 	void run(){
 		testNonBlocking();
 		testBlocking();
@@ -273,6 +451,11 @@ public:
 		testWrongConnect();
 		testReceiveTimeout();
 		testSendMaxSize();
+#ifndef TARGET_WIN32
+		testReactorMessages();
+		testReactorRawData();
+		benchmarkReactor();
+#endif
 	}
 };
 
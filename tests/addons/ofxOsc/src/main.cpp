@@ -2,6 +2,8 @@
 #include "ofAppNoWindow.h"
 #include "ofxUnitTests.h"
 #include "ofxOsc.h"
+#include "ofxOscParameterSync.h"
+#include <chrono>
 
 class ofApp: public ofxUnitTestsApp {
 	void test_messages_constructors(){
@@ -40,8 +42,271 @@ class ofApp: public ofxUnitTestsApp {
 		
 	}
 
+	void test_message_args(){
+		ofLogNotice() << "---------------------------------------";
+		ofLogNotice() << "test_message_args";
+
+		char blob[] = {1, 0, 2, 3, 4};
+		ofxOscMessage m{"/args"};
+		m.addInt32Arg(-5).addInt64Arg(1ll << 40).addFloatArg(0.5f).addDoubleArg(0.25)
+			.addStringArg("a string longer than the small string optimization")
+			.addSymbolArg("sym").addCharArg('c').addMidiMessageArg(0x90407f00)
+			.addBoolArg(true).addBoolArg(false).addNoneArg().addTriggerArg()
+			.addTimetagArg(123456789ull).addBlobArg(blob, sizeof(blob)).addRgbaColorArg(0xff00ff80);
+		ofxTestEq(m.getNumArgs(), 15, "num args");
+		ofxTestEq(m.getTypeString(), std::string("ihfdsScmTFNItbr"), "type string");
+		ofxTestEq(m.getArgTypeName(5), std::string("S"), "type name");
+
+		auto check = [&](const ofxOscMessage & m, const std::string & name){
+			bool ok = m.getArgAsInt32(0) == -5;
+			ok &= m.getArgAsInt64(1) == 1ll << 40;
+			ok &= m.getArgAsFloat(2) == 0.5f;
+			ok &= m.getArgAsDouble(3) == 0.25;
+			ok &= m.getArgAsString(4) == "a string longer than the small string optimization";
+			ok &= m.getArgAsSymbol(5) == "sym";
+			ok &= m.getArgAsChar(6) == 'c';
+			ok &= m.getArgAsMidiMessage(7) == 0x90407f00;
+			ok &= m.getArgAsBool(8) && !m.getArgAsBool(9);
+			ok &= m.getArgAsNone(10) && m.getArgAsTrigger(11);
+			ok &= m.getArgAsTimetag(12) == 123456789ull;
+			ok &= m.getArgAsBlob(13).size() == sizeof(blob) && m.getArgAsBlob(13).getData()[3] == 3;
+			ok &= m.getArgAsRgbaColor(14) == 0xff00ff80;
+			ofxTest(ok, name + " args");
+			ofxTestEq(m.getAddress(), std::string("/args"), name + " address");
+		};
+		check(m, "original");
+
+		ofxOscMessage copied = m;
+		check(copied, "copied");
+		ofxOscMessage moved = std::move(copied);
+		check(moved, "moved");
+
+		ofxTestEq(m.getArgAsInt32(2), 0, "float to int conversion");
+		ofxTest(ofxOscMessage().addStringArg("true").getArgAsBool(0), "string to bool conversion");
+
+		m.clear();
+		ofxTestEq(m.getNumArgs(), 0, "cleared");
+		m.setAddress("/reused");
+		m.addStringArg("reused").addFloatArg(1);
+		ofxTestEq(m.getArgAsString(0), std::string("reused"), "reused message string");
+		ofxTestEq(m.getArgAsFloat(1), 1.f, "reused message float");
+		check(moved, "unchanged after reusing the original");
+	}
+
+	bool waitMessages(ofxOscReceiver & receiver, std::vector<ofxOscMessage> & messages, size_t numMessages, int timeoutMs = 1000){
+		auto start = ofGetElapsedTimeMillis();
+		ofxOscMessage m;
+		while(messages.size() < numMessages && ofGetElapsedTimeMillis() - start < timeoutMs){
+			if(receiver.getNextMessage(m)){
+				messages.push_back(std::move(m));
+			}else{
+				ofSleepMillis(1);
+			}
+		}
+		return messages.size() == numMessages;
+	}
+
+	void test_send_receive(){
+		ofLogNotice() << "---------------------------------------";
+		ofLogNotice() << "test_send_receive";
+
+		int port = ofRandom(15000, 65535);
+		ofxOscReceiver receiver;
+		ofxTest(receiver.setup(port), "receiver setup");
+		ofxOscSender sender;
+		ofxTest(sender.setup("127.0.0.1", port), "sender setup");
+
+		char blob[] = {9, 8, 7};
+		ofxOscMessage m{"/all/types"};
+		m.add(1, 2.5f, 3.5, "string", true).addSymbolArg("symbol").addBlobArg(blob, sizeof(blob)).addTriggerArg();
+		ofxTest(sender.sendMessage(m), "send message");
+		std::vector<ofxOscMessage> received;
+		ofxTest(waitMessages(receiver, received, 1), "message received");
+		if(received.size() == 1){
+			auto & r = received[0];
+			ofxTestEq(r.getAddress(), m.getAddress(), "address");
+			ofxTestEq(r.getTypeString(), m.getTypeString(), "types");
+			ofxTestEq(r.getArgAsString(3), std::string("string"), "string");
+			ofxTestEq(r.getArgAsSymbol(5), std::string("symbol"), "symbol");
+			ofxTestEq(r.getArgAsBlob(6).size(), sizeof(blob), "blob size");
+			ofxTestEq(r.getArgAsBlob(6).getData()[2], 7, "blob data");
+			ofxTestEq(r.getRemotePort() > 0, true, "remote port");
+		}
+
+		// 500 messages of 32 bytes fit in 12 bundles of 1472 bytes
+		std::vector<ofxOscMessage> batch(500);
+		for(size_t i = 0; i < batch.size(); i++){
+			batch[i].setAddress("/batch");
+			batch[i].addIntArg(i).addFloatArg(i * 0.5f).addStringArg("ab");
+		}
+		ofxTest(sender.sendMessages(batch), "send batch");
+		received.clear();
+		ofxTest(waitMessages(receiver, received, batch.size()), "batch received");
+		bool inOrder = true;
+		for(size_t i = 0; i < received.size(); i++){
+			inOrder &= received[i].getArgAsInt32(0) == int(i) && received[i].getArgAsString(2) == "ab";
+		}
+		ofxTest(inOrder, "batch received in order");
+
+		// a message bigger than maxPacketSize is still sent on its own
+		ofxOscMessage big{"/big"};
+		big.addBlobArg(std::vector<char>(4000, 1).data(), 4000);
+		ofxTest(sender.sendMessages({batch[0], big, batch[1]}), "send batch with a big message");
+		received.clear();
+		ofxTest(waitMessages(receiver, received, 3), "batch with a big message received");
+		if(received.size() == 3){
+			ofxTestEq(received[1].getArgAsBlob(0).size(), 4000, "big message");
+		}
+	}
+
+	void benchmark(){
+		ofLogNotice() << "---------------------------------------";
+		ofLogNotice() << "benchmark";
+
+		int port = ofRandom(15000, 65535);
+		ofxOscReceiver receiver;
+		receiver.setup(port);
+		ofxOscSender sender;
+		sender.setup("127.0.0.1", port);
+
+		// like a motion capture frame: 30 joints with a position each
+		size_t numFrames = 200;
+		std::vector<ofxOscMessage> frame(30);
+		for(size_t i = 0; i < frame.size(); i++){
+			frame[i].setAddress("/skeleton/joint/" + ofToString(i));
+			frame[i].add(float(i), 1.f, 2.f);
+		}
+
+		ofxOscMessage m;
+		for(auto batched: {false, true}){
+			size_t received = 0;
+			auto start = std::chrono::steady_clock::now();
+			for(size_t i = 0; i < numFrames; i++){
+				if(batched){
+					sender.sendMessages(frame);
+				}else{
+					for(auto & message: frame){
+						sender.sendMessage(message);
+					}
+				}
+				while(receiver.getNextMessage(m)){
+					received++;
+				}
+			}
+			auto end = start + std::chrono::seconds(1);
+			while(received < numFrames * frame.size() && std::chrono::steady_clock::now() < end){
+				if(receiver.getNextMessage(m)){
+					received++;
+				}
+			}
+			auto time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			ofLogNotice() << (batched ? "batched: " : "one by one: ") << received << " of "
+				<< numFrames * frame.size() << " messages received, " << received / time << " messages/s";
+			ofxTestGt(received, 0, std::string(batched ? "batched" : "one by one") + " benchmark received messages");
+		}
+
+		double totalLatency = 0;
+		double maxLatency = 0;
+		size_t numRoundTrips = 0;
+		for(int i = 0; i < 200; i++){
+			ofxOscMessage ping{"/ping"};
+			ping.addInt64Arg(ofGetElapsedTimeMicros());
+			sender.sendMessage(ping);
+			auto start = ofGetElapsedTimeMillis();
+			while(ofGetElapsedTimeMillis() - start < 100){
+				if(receiver.getNextMessage(m)){
+					double latency = ofGetElapsedTimeMicros() - m.getArgAsInt64(0);
+					totalLatency += latency;
+					maxLatency = std::max(maxLatency, latency);
+					numRoundTrips++;
+					break;
+				}
+			}
+		}
+		ofLogNotice() << "latency: " << totalLatency / std::max(numRoundTrips, size_t(1)) << "us mean, " << maxLatency << "us max";
+		ofxTestGt(numRoundTrips, 0, "latency messages received");
+	}
+
+	void test_parameter_sync(){
+		ofLogNotice() << "---------------------------------------";
+		ofLogNotice() << "test_parameter_sync";
+
+		int portA = ofRandom(15000, 40000);
+		int portB = portA + 1;
+		ofParameterGroup groupA, groupB;
+		std::vector<ofParameter<float>> paramsA(500), paramsB(500);
+		groupA.setName("group");
+		groupB.setName("group");
+		for(size_t i = 0; i < paramsA.size(); i++){
+			groupA.add(paramsA[i].set("param" + ofToString(i), 0, 0, 1000));
+			groupB.add(paramsB[i].set("param" + ofToString(i), 0, 0, 1000));
+		}
+		ofxOscParameterSync syncA, syncB;
+		syncA.setup(groupA, portA, "127.0.0.1", portB);
+		syncB.setup(groupB, portB, "127.0.0.1", portA);
+		syncA.setBatched(true);
+		ofxTest(syncA.isBatched(), "batched");
+
+		size_t numChanges = 0;
+		ofEventListener listener = groupB.parameterChangedE().newListener([&](ofAbstractParameter &){
+			numChanges++;
+		});
+		auto waitChanges = [&](size_t expected){
+			auto start = ofGetElapsedTimeMillis();
+			while(numChanges < expected && ofGetElapsedTimeMillis() - start < 1000){
+				syncB.update();
+				ofSleepMillis(1);
+			}
+			ofSleepMillis(20);
+			syncB.update();
+		};
+
+		// like dragging every slider, each one changes several times in a frame
+		for(int value = 1; value <= 10; value++){
+			for(auto & param: paramsA){
+				param = value;
+			}
+		}
+		ofxTestEq(numChanges, 0, "nothing sent until update");
+		syncA.update();
+		waitChanges(paramsA.size());
+		ofxTestEq(numChanges, paramsA.size(), "repeated changes coalesced");
+		ofxTestEq(paramsB.front().get(), 10.f, "first parameter synced with its last value");
+		ofxTestEq(paramsB.back().get(), 10.f, "last parameter synced with its last value");
+
+		// only 1 send every 100ms
+		syncA.setBatched(true, 10);
+		ofSleepMillis(110);
+		numChanges = 0;
+		paramsA[0] = 20;
+		syncA.update();
+		paramsA[0] = 30;
+		syncA.update();
+		waitChanges(2);
+		ofxTestEq(numChanges, 1, "rate limited");
+		ofSleepMillis(110);
+		syncA.update();
+		waitChanges(2);
+		ofxTestEq(numChanges, 2, "sent after the period");
+		ofxTestEq(paramsB[0].get(), 30.f, "rate limited value");
+
+		// disabling batching sends the pending changes and then every change
+		paramsA[1] = 40;
+		syncA.setBatched(false);
+		paramsA[2] = 50;
+		numChanges = 0;
+		waitChanges(2);
+		ofxTestEq(numChanges, 2, "not batched");
+		ofxTestEq(paramsB[1].get(), 40.f, "pending change sent");
+		ofxTestEq(paramsB[2].get(), 50.f, "change sent right away");
+	}
+
 	void run(){
 		test_messages_constructors();
+		test_message_args();
+		test_send_receive();
+		test_parameter_sync();
+		benchmark();
 	}
 };
 
@@ -1,6 +1,7 @@
 #include "ofMain.h"
 #include "ofAppNoWindow.h"
 #include "ofxUnitTests.h"
+#include <chrono>
 
 namespace {
 	int lastIntFromCFunc = 0;
@@ -177,6 +178,60 @@ class ofApp: public ofxUnitTestsApp{
 
 			});
 		}
+
+		{
+			ofEvent<int> e;
+			std::vector<int> order;
+			ofEventListener first = e.newListener([&](int &){ order.push_back(1); }, 10);
+			ofEventListener last = e.newListener([&](int &){ order.push_back(3); }, 300);
+			ofEventListener once;
+			once = e.newListener([&](int &){
+				order.push_back(2);
+				once.unsubscribe();
+			}, 100);
+			int value = 0;
+			e.notify(value);
+			e.notify(value);
+			ofxTest(order == std::vector<int>({1, 2, 3, 1, 3}), "Listeners called by priority and removed while notifying");
+
+			auto copy = e;
+			first.unsubscribe();
+			ofxTestEq(e.size(), 1, "Removing a listener");
+			ofxTestEq(copy.size(), 2, "Copies keep their own listeners");
+			ofEvent<int> moved(std::move(copy));
+			ofxTestEq(moved.size(), 2, "Moved event keeps the listeners");
+			ofxTestEq(copy.size(), 0, "Moved from event is empty");
+			copy.notify(value);
+		}
+
+		{
+			ofLogNotice() << "notify benchmark";
+			for(size_t numListeners: {1, 10, 100}){
+				ofEvent<int> event;
+				ofFastEvent<int> fastEvent;
+				int sum = 0;
+				ofEventListeners listeners;
+				for(size_t i = 0; i < numListeners; i++){
+					listeners.push(event.newListener([&](int & v){ sum += v; }));
+					listeners.push(fastEvent.newListener([&](int & v){ sum += v; }));
+				}
+				int iterations = 100000;
+				int value = 1;
+				auto start = std::chrono::steady_clock::now();
+				for(int i = 0; i < iterations; i++){
+					event.notify(value);
+				}
+				auto eventEnd = std::chrono::steady_clock::now();
+				for(int i = 0; i < iterations; i++){
+					fastEvent.notify(nullptr, value);
+				}
+				auto fastEventEnd = std::chrono::steady_clock::now();
+				ofLogNotice() << numListeners << " listeners, ofEvent: "
+					<< std::chrono::duration<double, std::nano>(eventEnd - start).count() / iterations << "ns, ofFastEvent: "
+					<< std::chrono::duration<double, std::nano>(fastEventEnd - eventEnd).count() / iterations << "ns per notify";
+				ofxTestEq(sum, int(numListeners) * iterations * 2, "Every listener notified");
+			}
+		}
 	}
 };
 
@@ -0,0 +1,148 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofGLDrawBatch.h"
+#include "ofGLProgrammableRenderer.h"
+#include <chrono>
+
+class ofApp: public ofxUnitTestsApp{
+	std::vector<glm::vec3> circle(float x, float y, float radius, int resolution){
+		std::vector<glm::vec3> vertices;
+		for(int i = 0; i < resolution; i++){
+			float angle = glm::two_pi<float>() * i / resolution;
+			vertices.emplace_back(x + cos(angle) * radius, y + sin(angle) * radius, 0.f);
+		}
+		return vertices;
+	}
+
+	void run(){
+		// the batch doesn't need GL, the flush function stands for the
+		// renderer drawing the mesh
+		ofGLDrawBatch batch;
+		std::vector<ofMesh> flushed;
+		batch.setFlushFunction([&](const ofMesh & mesh){
+			flushed.push_back(mesh);
+			batch.countDrawCall();
+		});
+
+		std::vector<glm::vec3> rect{{0, 0, 0}, {10, 0, 0}, {10, 10, 0}, {0, 10, 0}};
+		auto translation = glm::translate(glm::mat4(1.f), glm::vec3(5, 6, 0));
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "filled shapes";
+			batch.addTriangles(rect.data(), rect.size(), OF_PRIMITIVE_TRIANGLE_FAN, glm::mat4(1.f), ofFloatColor::red);
+			batch.addTriangles(rect.data(), rect.size(), OF_PRIMITIVE_TRIANGLE_FAN, translation, ofFloatColor::blue);
+			ofxTest(flushed.empty(), "color and matrix changes don't flush");
+			batch.flush();
+			ofxTestEq(flushed.size(), 1, "flushed once");
+			auto & mesh = flushed.back();
+			ofxTestEq(mesh.getMode(), OF_PRIMITIVE_TRIANGLES, "fans become triangles");
+			ofxTestEq(mesh.getNumIndices(), 12, "2 triangles per rectangle");
+			ofxTestEq(mesh.getIndex(6), 4, "indices of the second rectangle");
+			ofxTestEq(mesh.getVertex(6), glm::vec3(15, 16, 0), "vertices transformed");
+			ofxTestEq(mesh.getColor(6), ofFloatColor::blue, "vertices colored");
+			ofxTest(batch.isEmpty(), "empty after flushing");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "lines";
+			flushed.clear();
+			batch.addTriangles(rect.data(), rect.size(), OF_PRIMITIVE_TRIANGLE_FAN, glm::mat4(1.f), ofFloatColor::red);
+			batch.addLines(rect.data(), 2, OF_PRIMITIVE_LINES, glm::mat4(1.f), ofFloatColor::white, 1);
+			ofxTestEq(flushed.size(), 1, "lines after shapes flush the shapes");
+			batch.addLines(rect.data(), rect.size(), OF_PRIMITIVE_LINE_LOOP, glm::mat4(1.f), ofFloatColor::white, 1);
+			ofxTestEq(batch.getNumVertices(), 10, "loops split in segments");
+			batch.addLines(rect.data(), 2, OF_PRIMITIVE_LINES, glm::mat4(1.f), ofFloatColor::white, 2);
+			ofxTestEq(flushed.size(), 2, "a different line width flushes");
+			ofxTestEq(flushed.back().getMode(), OF_PRIMITIVE_LINES, "lines mode");
+			ofxTestEq(flushed.back().getNumIndices(), 0, "lines without indices");
+			batch.clear();
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "frame counters";
+			flushed.clear();
+			batch.newFrame();
+			size_t numCircles = 50000;
+			auto vertices = circle(0, 0, 10, 22);
+			auto start = std::chrono::steady_clock::now();
+			for(size_t i = 0; i < numCircles; i++){
+				auto matrix = glm::translate(glm::mat4(1.f), glm::vec3(i % 100, i / 100, 0));
+				batch.addTriangles(vertices.data(), vertices.size(), OF_PRIMITIVE_TRIANGLE_FAN, matrix, ofFloatColor(i % 256 / 255.f));
+			}
+			batch.flush();
+			auto end = std::chrono::steady_clock::now();
+			batch.newFrame();
+
+			auto & stats = batch.getLastFrameStats();
+			ofLogNotice() << numCircles << " circles: " << stats.drawCalls << " draw calls, " << stats.flushes << " flushes, "
+				<< stats.batchedVertices << " vertices, recorded in "
+				<< std::chrono::duration<double, std::milli>(end - start).count() << "ms";
+			ofxTestEq(stats.batchedPrimitives, numCircles, "all circles batched");
+			ofxTestEq(stats.batchedVertices, numCircles * vertices.size(), "all vertices drawn");
+			ofxTestEq(stats.flushes, stats.drawCalls, "one draw call per flush");
+			ofxTest(stats.flushes <= numCircles * vertices.size() / batch.getMaxVertices() + 1, "flushed only when full");
+			for(auto & mesh: flushed){
+				if(mesh.getNumVertices() > batch.getMaxVertices()){
+					ofxTest(false, "batch bigger than the maximum");
+				}
+			}
+			ofxTestEq(batch.getCurrentFrameStats().flushes, 0, "new frame counters");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "renderer";
+			// the batch is drawn through the same vbo as meshes, a mesh drawn
+			// after a batched shape has to flush the batch before it's uploaded
+			auto renderer = std::dynamic_pointer_cast<ofGLProgrammableRenderer>(ofGetCurrentRenderer());
+			ofxTest(renderer != nullptr, "programmable renderer");
+			if(renderer){
+				ofMesh mesh;
+				mesh.setMode(OF_PRIMITIVE_TRIANGLE_FAN);
+				mesh.addVertices({{20, 0, 0}, {40, 0, 0}, {40, 20, 0}, {20, 20, 0}});
+				ofVboMesh vboMesh = mesh;
+				for(auto & vertex: vboMesh.getVertices()){
+					vertex.x += 40;
+				}
+
+				ofFbo fbo;
+				fbo.allocate(80, 20, GL_RGBA);
+				renderer->setBatchingEnabled(true);
+				fbo.begin();
+				ofClear(0, 0, 0, 255);
+				ofSetColor(255, 0, 0);
+				ofDrawRectangle(0, 0, 20, 20);
+				ofSetColor(0, 255, 0);
+				mesh.draw();
+				ofSetColor(255, 0, 0);
+				ofDrawRectangle(60, 0, 20, 20);
+				ofSetColor(0, 0, 255);
+				vboMesh.draw();
+				fbo.end();
+				renderer->setBatchingEnabled(false);
+
+				ofPixels pixels;
+				fbo.readToPixels(pixels);
+				ofxTestEq(pixels.getColor(10, 10), ofColor(255, 0, 0), "batched shape");
+				ofxTestEq(pixels.getColor(30, 10), ofColor(0, 255, 0), "mesh after a batched shape");
+				ofxTestEq(pixels.getColor(50, 10), ofColor(0, 0, 255), "vbo mesh after a batched shape");
+				ofxTestEq(pixels.getColor(70, 10), ofColor(0, 0, 255), "vbo mesh drawn over the batched shape before it");
+			}
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	// the renderer test draws into an fbo, the batch alone doesn't need GL
+	ofGLFWWindowSettings settings;
+	settings.setGLVersion(3, 2);
+	settings.visible = false;
+	ofCreateWindow(settings);
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(app);
+	return ofRunMainLoop();
+}
@@ -309,6 +309,132 @@ class ofApp: public ofxUnitTestsApp{
                 ofxTestEq((uint64_t)&pixels.getLine(0).getPixel(10)[0], (uint64_t)pixels.getData()+(10*bpp/8),"getLine(0).getPixel(10)[0]==pixels.getData()+(10*bpp/8)");
 			}
 		}
+
+		// 4x4 gradient, every 2x2 block averages to a known value
+		ofPixels src;
+		src.allocate(4,4,OF_PIXELS_RGB);
+		for(size_t i=0;i<src.size();i++){
+			src[i] = (i/3)*10;
+		}
+		for(auto interpMethod: {OF_INTERPOLATE_BILINEAR, OF_INTERPOLATE_AREA}){
+			ofPixels dst;
+			dst.allocate(2,2,OF_PIXELS_RGB);
+			string method = interpMethod == OF_INTERPOLATE_AREA ? "area" : "bilinear";
+			ofxTest(src.resizeTo(dst,interpMethod),"resizeTo() " + method);
+			ofxTestEq(dst.getColor(0,0),ofColor(25),"resizeTo() " + method + " 0,0");
+			ofxTestEq(dst.getColor(1,0),ofColor(45),"resizeTo() " + method + " 1,0");
+			ofxTestEq(dst.getColor(0,1),ofColor(105),"resizeTo() " + method + " 0,1");
+			ofxTestEq(dst.getColor(1,1),ofColor(125),"resizeTo() " + method + " 1,1");
+		}
+
+		// views share memory with the pixels they were created from
+		auto roi = src.getView().getROI(1,1,2,2);
+		ofxTestEq(roi.getWidth(),2u,"view roi width");
+		ofxTestEq(roi.getStride(),src.getWidth()*3,"view roi stride");
+		ofxTestEq((uint64_t)roi.getData(),(uint64_t)(src.getData()+src.getPixelIndex(1,1)),"view roi data");
+		ofxTest(!roi.isContinuous(),"view roi not continuous");
+		ofPixels roiCopy;
+		roi.copyTo(roiCopy);
+		ofPixels cropped;
+		src.cropTo(cropped,1,1,2,2);
+		ofxTest(std::equal(roiCopy.begin(),roiCopy.end(),cropped.begin()),"view roi copy == cropTo");
+
+		auto green = roi.getChannel(1);
+		ofxTestEq(green.getNumChannels(),1u,"view channel num channels");
+		ofxTestEq(green.getPixelStep(),3u,"view channel pixel step");
+		ofxTestEq(*green.getPixel(1,1),src.getColor(2,2).g,"view channel value");
+
+		ofPixels nv12;
+		nv12.allocate(w,h,OF_PIXELS_NV12);
+		auto uv = nv12.getPlaneView(1);
+		ofxTestEq(uv.getPixelFormat(),OF_PIXELS_UV,"view plane format");
+		ofxTestEq((uint64_t)uv.getData(),(uint64_t)(nv12.getData()+w*h),"view plane data");
+
+		ofFloatPixels constant;
+		constant.allocate(1920,1080,OF_PIXELS_RGBA);
+		constant.set(0.5f);
+		for(auto interpMethod: {OF_INTERPOLATE_BILINEAR, OF_INTERPOLATE_AREA, OF_INTERPOLATE_LANCZOS}){
+			for(auto size: {glm::vec2(321,177), glm::vec2(2500,1500)}){
+				ofFloatPixels dst;
+				dst.allocate(size.x,size.y,OF_PIXELS_RGBA);
+				constant.resizeTo(dst,interpMethod);
+				auto minmax = std::minmax_element(dst.begin(),dst.end());
+				ofxTestLt(std::abs(*minmax.first - 0.5f),0.0001f,"resizeTo() constant image min " + ofToString(interpMethod) + " " + ofToString(size));
+				ofxTestLt(std::abs(*minmax.second - 0.5f),0.0001f,"resizeTo() constant image max " + ofToString(interpMethod) + " " + ofToString(size));
+			}
+		}
+
+		ofPixels rgb;
+		rgb.allocate(8,4,OF_PIXELS_RGB);
+		ofColor colors[] = {ofColor::red, ofColor::green, ofColor::blue, ofColor(128)};
+		for(size_t y=0;y<rgb.getHeight();y++){
+			for(size_t x=0;x<rgb.getWidth();x++){
+				rgb.setColor(x,y,colors[x/2]);
+			}
+		}
+
+		ofPixels bgra;
+		ofxTest(rgb.convertTo(bgra,OF_PIXELS_BGRA),"convertTo() RGB -> BGRA");
+		ofxTestEq(bgra.getPixelFormat(),OF_PIXELS_BGRA,"convertTo() BGRA format");
+		ofxTestEq(bgra[0],0,"convertTo() BGRA b");
+		ofxTestEq(bgra[2],255,"convertTo() BGRA r");
+		ofxTestEq(bgra[3],255,"convertTo() BGRA alpha");
+
+		ofPixels gray;
+		ofxTest(rgb.convertTo(gray,OF_PIXELS_GRAY),"convertTo() RGB -> GRAY");
+		ofxTestEq(gray.getColor(0,0),ofColor(76),"convertTo() GRAY red luma");
+		ofxTestEq(gray.getColor(6,0),ofColor(128),"convertTo() GRAY gray luma");
+
+		ofPixels swapped = rgb;
+		swapped.swapRgb();
+		ofxTestEq(swapped.getPixelFormat(),OF_PIXELS_BGR,"swapRgb() format");
+		ofxTestEq(swapped[0],0,"swapRgb() b");
+		ofxTestEq(swapped[2],255,"swapRgb() r");
+
+		for(auto pixelFormat: {OF_PIXELS_NV12, OF_PIXELS_NV21, OF_PIXELS_I420, OF_PIXELS_YV12, OF_PIXELS_YUY2, OF_PIXELS_UYVY}){
+			for(auto matrix: {OF_YUV_MATRIX_BT601, OF_YUV_MATRIX_BT709, OF_YUV_MATRIX_JPEG}){
+				auto name = ofToString(pixelFormat) + " " + ofToString(matrix);
+				ofPixels yuv, back;
+				ofxTest(rgb.convertTo(yuv,pixelFormat,matrix),"convertTo() RGB -> " + name);
+				ofxTest(yuv.convertTo(back,OF_PIXELS_RGB,matrix),"convertTo() " + name + " -> RGB");
+				int maxDiff = 0;
+				for(size_t i=0;i<rgb.size();i++){
+					maxDiff = std::max(maxDiff, std::abs(int(rgb[i]) - int(back[i])));
+				}
+				ofxTestLt(maxDiff,2,"convertTo() round trip " + name);
+			}
+		}
+
+		ofPixels rgb565, back565;
+		ofxTest(rgb.convertTo(rgb565,OF_PIXELS_RGB565),"convertTo() RGB -> RGB565");
+		ofxTestEq(rgb565.getTotalBytes(),rgb.getWidth()*rgb.getHeight()*2,"convertTo() RGB565 size");
+		ofxTest(rgb565.convertTo(back565,OF_PIXELS_RGB),"convertTo() RGB565 -> RGB");
+		ofxTestEq(back565.getColor(0,0),ofColor::red,"convertTo() RGB565 red");
+		ofxTestEq(back565.getColor(2,0),ofColor::green,"convertTo() RGB565 green");
+		ofxTestEq(back565.getColor(4,0),ofColor::blue,"convertTo() RGB565 blue");
+		ofxTestLt(std::abs(int(back565.getColor(6,0).r) - 128),5,"convertTo() RGB565 gray");
+
+		ofPixels nv12;
+		nv12.allocate(8,4,OF_PIXELS_NV12);
+		ofxTestEq(nv12.size(),nv12.getTotalBytes(),"NV12 allocates the chroma plane");
+
+		ofPixels typeChange = rgb;
+		typeChange.setImageType(OF_IMAGE_GRAYSCALE);
+		ofxTestEq(typeChange.getPixelFormat(),OF_PIXELS_GRAY,"setImageType() gray");
+		ofxTestEq(typeChange.getColor(0,0),ofColor(76),"setImageType() converts to luma");
+		typeChange = swapped;
+		typeChange.setNumChannels(4);
+		ofxTestEq(typeChange.getPixelFormat(),OF_PIXELS_RGBA,"setNumChannels() RGBA");
+		ofxTestEq(typeChange.getColor(0,0),ofColor::red,"setNumChannels() keeps the colors of BGR pixels");
+
+		ofFloatPixels floatBGR;
+		floatBGR = swapped;
+		ofxTestEq(floatBGR.getPixelFormat(),OF_PIXELS_BGR,"copyFrom() keeps the pixel format");
+
+		ofPixels odd;
+		odd.allocate(3,3,OF_PIXELS_RGB);
+		ofPixels oddYUV;
+		ofxTest(!odd.convertTo(oddYUV,OF_PIXELS_NV12),"convertTo() YUV fails with odd size");
 	}
 };
 
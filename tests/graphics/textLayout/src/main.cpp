@@ -0,0 +1,158 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+#include <chrono>
+
+class ofApp: public ofxUnitTestsApp{
+	bool sameMesh(const ofMesh & m1, const ofMesh & m2){
+		if(m1.getNumVertices() != m2.getNumVertices() || m1.getIndices() != m2.getIndices()){
+			return false;
+		}
+		for(size_t i = 0; i < m1.getNumVertices(); i++){
+			// the cached meshes are offset after generating them so the
+			// positions can differ in the last bits
+			if(glm::distance(m1.getVertex(i), m2.getVertex(i)) > 0.001f){
+				return false;
+			}
+			if(m1.getTexCoord(i) != m2.getTexCoord(i)){
+				return false;
+			}
+		}
+		return true;
+	}
+
+	ofMesh uncachedMesh(ofTrueTypeFont & font, const std::string & text, float x, float y, bool vflip = true){
+		auto cacheSize = font.getLayoutCacheSize();
+		font.setLayoutCacheSize(0);
+		ofMesh mesh = font.getStringMesh(text, x, y, vflip);
+		font.setLayoutCacheSize(cacheSize);
+		return mesh;
+	}
+
+	ofMesh cachedMesh(ofTrueTypeFont & font, const std::string & text, float x, float y, bool vflip = true){
+		// strings are cached the second time they are drawn
+		font.getStringMesh(text, x, y, vflip);
+		return font.getStringMesh(text, x, y, vflip);
+	}
+
+	template<typename F>
+	double timeMs(F f){
+		auto start = std::chrono::steady_clock::now();
+		f();
+		auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::milli>(end - start).count();
+	}
+
+	void run(){
+		std::string text = "Hello World\nsecond line {[()]}";
+		ofTrueTypeFont font;
+		ofxTest(font.load(OF_TTF_SANS, 14), "load without a GL context");
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "layout cache";
+			ofxTestEq(font.getLayoutCacheSize(), 256, "default cache size");
+			ofxTest(sameMesh(cachedMesh(font, text, 0, 0), uncachedMesh(font, text, 0, 0)), "same mesh");
+			ofxTest(sameMesh(cachedMesh(font, text, 10, 20), uncachedMesh(font, text, 10, 20)), "same mesh at a different position");
+			ofxTest(sameMesh(cachedMesh(font, text, 10, 20, false), uncachedMesh(font, text, 10, 20, false)), "same mesh not flipped");
+			ofxTest(sameMesh(cachedMesh(font, "other", 10, 20), uncachedMesh(font, "other", 10, 20)), "same mesh after drawing another string");
+			ofxTest(sameMesh(cachedMesh(font, text, 10, 20), uncachedMesh(font, text, 10, 20)), "same mesh drawn again");
+
+			font.setLayoutCacheSize(2);
+			cachedMesh(font, "a", 0, 0);
+			cachedMesh(font, "b", 0, 0);
+			cachedMesh(font, "c", 0, 0);
+			ofxTest(sameMesh(cachedMesh(font, text, 5, 5), uncachedMesh(font, text, 5, 5)), "same mesh after eviction");
+
+			auto mesh = &font.getStringMesh(text, 0, 0);
+			for(int i = 0; i < 100; i++){
+				font.getStringMesh(ofToString(i), 10, 10);
+			}
+			ofxTest(&font.getStringMesh(text, 0, 0) == mesh, "strings drawn once don't evict the cache");
+
+			ofMesh before = font.getStringMesh(text, 0, 0);
+			font.setLetterSpacing(1.5);
+			ofxTest(!sameMesh(font.getStringMesh(text, 0, 0), before), "letter spacing invalidates the cache");
+			ofxTest(sameMesh(cachedMesh(font, text, 0, 0), uncachedMesh(font, text, 0, 0)), "same mesh after changing the spacing");
+			font.setLetterSpacing(1);
+			font.setLayoutCacheSize(256);
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "ofTextLayout";
+			ofTextLayout layout;
+			ofxTest(!layout.isSetup(), "not setup by default");
+			layout.setup(font, text);
+			ofxTest(sameMesh(layout.getMesh(), uncachedMesh(font, text, 0, 0)), "same mesh");
+			ofxTestEq(layout.getBoundingBox(), font.getStringBoundingBox(text, 0, 0), "same bounding box");
+
+			font.setLineHeight(font.getLineHeight() * 2);
+			ofxTest(sameMesh(layout.getMesh(), uncachedMesh(font, text, 0, 0)), "updated after changing the line height");
+			ofxTestEq(layout.getBoundingBox(), font.getStringBoundingBox(text, 0, 0), "bounding box updated");
+
+			layout.setText("other");
+			ofxTestEq(layout.getText(), std::string("other"), "set text");
+			ofxTest(sameMesh(layout.getMesh(), uncachedMesh(font, "other", 0, 0)), "mesh updated with the text");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "static labels benchmark";
+			std::vector<std::string> labels;
+			for(int i = 0; i < 2000; i++){
+				labels.push_back("label " + ofToString(i) + ": value");
+			}
+			int frames = 20;
+			auto perFrame = [&](auto layoutLabel){
+				return timeMs([&]{
+					for(int frame = 0; frame < frames; frame++){
+						for(size_t i = 0; i < labels.size(); i++){
+							layoutLabel(i);
+						}
+					}
+				}) / frames;
+			};
+
+			font.setLayoutCacheSize(0);
+			auto uncached = perFrame([&](size_t i){ font.getStringMesh(labels[i], 10, i * 20); });
+			font.setLayoutCacheSize(labels.size());
+			auto cached = perFrame([&](size_t i){ font.getStringMesh(labels[i], 10, i * 20); });
+			std::vector<ofTextLayout> layouts;
+			for(auto & label: labels){
+				layouts.emplace_back(font, label);
+			}
+			auto prebuilt = perFrame([&](size_t i){ layouts[i].getMesh(); });
+
+			ofLogNotice() << labels.size() << " labels per frame";
+			ofLogNotice() << "uncached: " << uncached << "ms";
+			ofLogNotice() << "layout cache: " << cached << "ms";
+			ofLogNotice() << "ofTextLayout: " << prebuilt << "ms";
+			ofxTest(cached < uncached, "the layout cache is faster");
+			ofxTest(prebuilt < cached, "prebuilt layouts are faster");
+
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "changing text benchmark";
+			int frame = 0;
+			auto counters = [&](size_t i){ font.getStringMesh("fps: " + ofToString(frame++), 10, i * 20); };
+			font.setLayoutCacheSize(0);
+			uncached = perFrame(counters);
+			font.setLayoutCacheSize(labels.size());
+			cached = perFrame(counters);
+			ofLogNotice() << "uncached: " << uncached << "ms";
+			ofLogNotice() << "layout cache: " << cached << "ms";
+			ofxTest(cached < uncached * 1.5, "text that changes every frame isn't slower with the cache");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	// layouts don't need a GL context, the font texture is only uploaded
+	// when it's used
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,199 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include <chrono>
+
+class ofApp: public ofxUnitTestsApp{
+	ofTrueTypeFontSettings fontSettings(int size){
+		ofTrueTypeFontSettings settings(OF_TTF_SANS, size);
+		settings.addRange(ofUnicode::Latin1Supplement);
+		return settings;
+	}
+
+	bool sameMesh(const ofMesh & m1, const ofMesh & m2, const ofTexture & tex1, const ofTexture & tex2){
+		if(m1.getNumVertices() != m2.getNumVertices()){
+			return false;
+		}
+		for(size_t i = 0; i < m1.getNumVertices(); i++){
+			if(m1.getVertex(i) != m2.getVertex(i)){
+				return false;
+			}
+		}
+		// compare the glyphs size in the atlas, the position can be different
+		for(size_t i = 0; i + 2 < m1.getNumTexCoords(); i += 4){
+			auto size1 = (m1.getTexCoord(i + 2) - m1.getTexCoord(i)) * glm::vec2(tex1.getWidth(), tex1.getHeight());
+			auto size2 = (m2.getTexCoord(i + 2) - m2.getTexCoord(i)) * glm::vec2(tex2.getWidth(), tex2.getHeight());
+			if(glm::distance(size1, size2) > 0.001f){
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename F>
+	double timeMs(F f){
+		auto start = std::chrono::steady_clock::now();
+		f();
+		auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::milli>(end - start).count();
+	}
+
+	void run(){
+		std::string text = "Hello World\näöü ÿ {[()]}";
+		if(ofDirectory::doesDirectoryExist("fontcache")){
+			ofDirectory::removeDirectory("fontcache", true);
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "glyphs on demand";
+			ofTrueTypeFont font;
+			ofxTest(font.load(fontSettings(14)), "load all glyphs");
+
+			auto lazySettings = fontSettings(14);
+			lazySettings.loadGlyphsOnDemand = true;
+			ofTrueTypeFont lazy;
+			ofxTest(lazy.load(lazySettings), "load on demand");
+			ofxTestEq(lazy.getNumCharacters(), 1, "only the space is loaded");
+			ofxTestEq(lazy.getStringBoundingBox(text, 10, 20), font.getStringBoundingBox(text, 10, 20), "same bounding box");
+			ofxTestEq(lazy.stringWidth(text), font.stringWidth(text), "same width");
+			ofxTest(lazy.getNumCharacters() > 1 && lazy.getNumCharacters() < 30, "measuring loads the used glyphs");
+			ofxTest(sameMesh(lazy.getStringMesh(text, 0, 0), font.getStringMesh(text, 0, 0), lazy.getFontTexture(), font.getFontTexture()), "same mesh");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "atlas grows";
+			auto settings = fontSettings(64);
+			settings.loadGlyphsOnDemand = true;
+			ofTrueTypeFont font;
+			font.load(settings);
+			font.getStringMesh("A", 0, 0);
+			ofTrueTypeFont copy = font;
+			copy.getStringMesh("B", 0, 0);
+			ofxTestEq(copy.getNumCharacters(), font.getNumCharacters() + 1, "copies load their own glyphs");
+			ofxTest(copy.getFontTexture().getTextureData().textureID != font.getFontTexture().getTextureData().textureID, "copies don't share the atlas texture");
+
+			auto texCoord = font.getStringMesh("A", 0, 0).getTexCoord(0);
+			auto atlasSize = glm::vec2(font.getFontTexture().getWidth(), font.getFontTexture().getHeight());
+			auto version = font.getLayoutVersion();
+			std::string all;
+			for(uint32_t c = 33; c < 256; c++){
+				ofUTF8Append(all, c);
+			}
+			font.getStringMesh(all, 0, 0);
+			ofxTest(font.getLayoutVersion() != version, "growing the atlas invalidates the meshes");
+			auto newAtlasSize = glm::vec2(font.getFontTexture().getWidth(), font.getFontTexture().getHeight());
+			ofxTest(newAtlasSize.x * newAtlasSize.y > atlasSize.x * atlasSize.y, "the atlas is bigger");
+			auto newTexCoord = font.getStringMesh("A", 0, 0).getTexCoord(0);
+			ofxTestEq(newTexCoord * newAtlasSize, texCoord * atlasSize, "glyphs keep their position in the atlas");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "glyph cache";
+			auto settings = fontSettings(20);
+			settings.cacheDirectory = "fontcache";
+			ofTrueTypeFont font;
+			font.load(settings);
+			ofDirectory cache("fontcache");
+			ofxTestEq(cache.listDir(), 1, "cache saved on load");
+
+			ofTrueTypeFont cached;
+			cached.load(settings);
+			ofxTestEq(cached.getNumCharacters(), font.getNumCharacters(), "same number of glyphs");
+			ofxTestEq(cached.getFontTexture().getWidth(), font.getFontTexture().getWidth(), "same atlas");
+			ofxTest(sameMesh(cached.getStringMesh(text, 0, 0), font.getStringMesh(text, 0, 0), cached.getFontTexture(), font.getFontTexture()), "same mesh");
+
+			settings.fontSize = 21;
+			ofTrueTypeFont otherSize;
+			otherSize.load(settings);
+			ofxTestEq(cache.listDir(), 2, "different settings use a different cache");
+
+			settings.loadGlyphsOnDemand = true;
+			{
+				ofTrueTypeFont lazy;
+				lazy.load(settings);
+				lazy.getStringMesh(text, 0, 0);
+			}
+			ofxTestEq(cache.listDir(), 2, "on demand cache not saved on destruction");
+			{
+				ofTrueTypeFont lazy;
+				lazy.load(settings);
+				lazy.getStringMesh(text, 0, 0);
+				ofxTest(lazy.saveGlyphCache(), "on demand cache saved explicitly");
+			}
+			ofxTestEq(cache.listDir(), 3, "on demand cache saved");
+			ofTrueTypeFont lazy;
+			lazy.load(settings);
+			auto numCharacters = lazy.getNumCharacters();
+			ofxTest(numCharacters > 1, "on demand cache loaded");
+			lazy.getStringMesh(text, 0, 0);
+			ofxTestEq(lazy.getNumCharacters(), numCharacters, "no new glyphs loaded");
+
+			cache.listDir();
+			for(auto & file: cache){
+				auto buffer = ofBufferFromFile(file.getAbsolutePath(), true);
+				buffer.resize(buffer.size() / 2);
+				ofBufferToFile(file.getAbsolutePath(), buffer, true);
+			}
+			settings.fontSize = 20;
+			settings.loadGlyphsOnDemand = false;
+			ofTrueTypeFont reloaded;
+			ofxTest(reloaded.load(settings), "corrupted caches are ignored");
+			ofxTestEq(reloaded.getNumCharacters(), font.getNumCharacters(), "glyphs rasterized again");
+
+			// atlas size and number of shelves after the magic, version and key
+			cache.listDir();
+			for(auto & file: cache){
+				auto buffer = ofBufferFromFile(file.getAbsolutePath(), true);
+				uint32_t keySize;
+				std::memcpy(&keySize, buffer.getData() + 12, sizeof(keySize));
+				std::memset(buffer.getData() + 16 + keySize, 0xff, 3 * sizeof(uint32_t));
+				ofBufferToFile(file.getAbsolutePath(), buffer, true);
+			}
+			ofTrueTypeFont huge;
+			ofxTest(huge.load(settings), "caches with huge sizes are ignored");
+			ofxTestEq(huge.getNumCharacters(), font.getNumCharacters(), "glyphs rasterized instead");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "CJK load time";
+			ofTrueTypeFontSettings settings(OF_TTF_SANS, 16);
+			settings.addRanges(ofAlphabet::Latin);
+			settings.addRanges(ofAlphabet::Japanese);
+			settings.cacheDirectory = "fontcache";
+
+			ofTrueTypeFont font;
+			auto all = timeMs([&]{ font.load(settings); });
+			ofTrueTypeFont cached;
+			auto fromCache = timeMs([&]{ cached.load(settings); });
+			settings.loadGlyphsOnDemand = true;
+			settings.cacheDirectory.clear();
+			ofTrueTypeFont lazy;
+			auto onDemand = timeMs([&]{ lazy.load(settings); });
+			auto firstDraw = timeMs([&]{ lazy.getStringMesh("日本語のテキスト", 0, 0); });
+
+			ofLogNotice() << font.getNumCharacters() << " glyphs, atlas " << font.getFontTexture().getWidth() << "x" << font.getFontTexture().getHeight();
+			ofLogNotice() << "load all glyphs: " << all << "ms";
+			ofLogNotice() << "load from cache: " << fromCache << "ms";
+			ofLogNotice() << "load on demand: " << onDemand << "ms, first string " << firstDraw << "ms, atlas "
+				<< lazy.getFontTexture().getWidth() << "x" << lazy.getFontTexture().getHeight();
+			ofxTest(fromCache < all, "loading from the cache is faster");
+			ofxTest(onDemand < all, "loading on demand is faster");
+		}
+
+		ofDirectory::removeDirectory("fontcache", true);
+	}
+};
+
+//========================================================================
+int main( ){
+	// fonts need a GL context for the atlas texture
+	ofGLFWWindowSettings settings;
+	settings.visible = false;
+	ofCreateWindow(settings);
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(app);
+	return ofRunMainLoop();
+}
@@ -1,6 +1,7 @@
 #include "ofMain.h"
 #include "ofxUnitTests.h"
 #include "ofAppNoWindow.h"
+#include <chrono>
 
 
 bool aprox_eq(const glm::vec3 & v1, const glm::vec3 & v2){
@@ -145,6 +146,76 @@ public:
 			ofLogNotice() << "end add / clear parent and keep global transform";
 		}
 
+		{
+			ofLogNotice() << "cached global transform start";
+			ofNode n1, n2, n3;
+			n2.setParent(n1);
+			n3.setParent(n2);
+			n3.setPosition({ 0.f, 10.f, 0.f });
+			ofxTest(aprox_eq(n3.getGlobalPosition(), { 0.f, 10.f, 0.f }), "\tglobal position");
+			n1.move({ 5.f, 0.f, 0.f });
+			ofxTest(aprox_eq(n3.getGlobalPosition(), { 5.f, 10.f, 0.f }), "\tgrandparent move invalidates the cache");
+			n2.setScale(2.f);
+			n1.updateGlobalTransforms();
+			ofxTest(aprox_eq(n3.getGlobalPosition(), { 5.f, 20.f, 0.f }), "\tupdate the whole hierarchy");
+			n3.clearParent();
+			ofxTest(aprox_eq(n3.getGlobalPosition(), { 0.f, 10.f, 0.f }), "\tclear parent invalidates the cache");
+
+			n3.setParent(n2);
+			ofNode moved(std::move(n2));
+			moved.move({ 1.f, 0.f, 0.f });
+			ofxTest(n3.getParent() == &moved, "\tmoved node keeps its children");
+			ofxTest(aprox_eq(n3.getGlobalPosition(), { 6.f, 20.f, 0.f }), "\tmoved node keeps its parent");
+			ofLogNotice() << "cached global transform end";
+		}
+
+		{
+			ofLogNotice() << "children notifications start";
+			struct Listener: public ofNode{
+				int positionChanged = 0;
+				int orientationChanged = 0;
+				void onPositionChanged(){ positionChanged++; }
+				void onOrientationChanged(){ orientationChanged++; }
+			};
+			ofNode parent;
+			Listener child;
+			child.setParent(parent);
+			parent.move({ 1.f, 0.f, 0.f });
+			parent.panDeg(10);
+			ofxTestEq(child.positionChanged, 1, "\tposition changed");
+			ofxTestEq(child.orientationChanged, 1, "\torientation changed");
+			child.clearParent();
+			parent.move({ 1.f, 0.f, 0.f });
+			ofxTestEq(child.positionChanged, 1, "\tno notifications after clear parent");
+			ofLogNotice() << "children notifications end";
+		}
+
+		{
+			ofLogNotice() << "hierarchy update benchmark";
+			for(size_t numNodes: {1000, 10000, 100000}){
+				// a tree with 4 children per node, like a skeleton
+				std::vector<ofNode> nodes(numNodes);
+				for(size_t i = 1; i < numNodes; i++){
+					nodes[i].setParent(nodes[(i - 1) / 4]);
+					nodes[i].setPosition({ 1.f, 0.f, 0.f });
+				}
+				nodes[0].updateGlobalTransforms();
+
+				int frames = 20;
+				auto start = std::chrono::steady_clock::now();
+				for(int frame = 0; frame < frames; frame++){
+					nodes[0].panDeg(1);
+					nodes[0].updateGlobalTransforms();
+				}
+				auto end = std::chrono::steady_clock::now();
+				auto perFrame = std::chrono::duration<double, std::milli>(end - start).count() / frames;
+				ofLogNotice() << numNodes << " nodes: " << perFrame << "ms per update, "
+					<< perFrame * 1000000 / numNodes << "ns per node";
+				ofxTest(aprox_eq(nodes.back().getGlobalTransformMatrix() * glm::vec4(0,0,0,1),
+					glm::vec4(nodes.back().getGlobalPosition(), 1)), "\tglobal matrices updated");
+			}
+		}
+
 
     }
 };
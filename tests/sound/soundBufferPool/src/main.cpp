@@ -0,0 +1,126 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+OF_SOUND_CHECK_ALLOCATIONS()
+
+class ofApp: public ofxUnitTestsApp{
+	// runs f as the sound stream runs audioOut and returns the number of
+	// allocations it made, the tests can't log from inside it
+	template<typename F>
+	uint64_t allocationsInCallback(F f){
+		ofResetAudioCallbackAllocations();
+		{
+			ofAudioCallbackScope scope;
+			f();
+		}
+		return ofGetAudioCallbackAllocations();
+	}
+
+	void run(){
+		size_t bufferSize = 256;
+		ofSoundBuffer sample;
+		sample.allocate(44100, 2);
+		sample.fillWithTone(440);
+		ofSoundBuffer out;
+		out.allocate(bufferSize, 2);
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "allocation check";
+			ofxTestEq(allocationsInCallback([&]{ auto copy = sample * 0.5f; }), 1, "allocations counted in the callback");
+			auto outside = sample * 0.5f;
+			ofxTestEq(ofGetAudioCallbackAllocations(), 1, "allocations outside the callback not counted");
+			ofxTest(!ofIsInAudioCallback(), "scope ended");
+			struct alignas(64) Aligned{ float samples[16]; };
+			ofxTestEq(allocationsInCallback([&]{ auto aligned = std::make_unique<Aligned>(); }), 1, "over-aligned allocations counted");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "pool";
+			ofSoundBufferPool pool(2, bufferSize * 2, 2);
+			ofxTestEq(pool.getNumAvailable(), 2, "all buffers available");
+			{
+				auto a = pool.acquire();
+				auto b = pool.acquire(bufferSize, 1);
+				ofxTest(a && b, "acquired");
+				ofxTestEq(a->getNumFrames(), bufferSize * 2, "pool size");
+				ofxTestEq(b->getNumChannels(), 1, "requested channels");
+				ofxTest(!pool.acquire(), "empty when there are no buffers left");
+				b.release();
+				ofxTestEq(pool.getNumAvailable(), 1, "released");
+				ofxTest(!pool.acquire(bufferSize * 4, 2), "empty if bigger than the capacity");
+			}
+			ofxTestEq(pool.getNumAvailable(), 2, "returned to the pool on destruction");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "audio callback";
+			ofSoundBufferPool pool(4, bufferSize * 2, 2);
+			size_t position = 0;
+
+			auto naive = allocationsInCallback([&]{
+				ofSoundBuffer resampled;
+				sample.resampleTo(resampled, position, out.getNumFrames(), 1.5f);
+				ofSoundBuffer left;
+				resampled.getChannel(left, 0);
+				auto quieter = resampled * 0.5f;
+				quieter.addTo(out);
+			});
+
+			auto pooled = allocationsInCallback([&]{
+				auto resampled = pool.acquire();
+				sample.resampleTo(*resampled, position, out.getNumFrames(), 1.5f);
+				auto left = pool.acquire();
+				resampled->getChannel(*left, 0);
+				resampled->mixTo(out, 0.5f);
+				auto scratch = pool.acquire();
+				resampled->resample(0.5f, *scratch);
+			});
+
+			ofLogNotice() << "naive callback: " << naive << " allocations, pooled: " << pooled;
+			ofxTest(naive > 0, "the naive callback allocates");
+			ofxTestEq(pooled, 0, "the pooled callback doesn't allocate");
+			ofxTestEq(allocationsInCallback([&]{ out.resize(out.size()); }), 0, "resizing to the same size doesn't allocate");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "mixTo";
+			ofSoundBuffer a, b;
+			a.allocate(4, 2);
+			a.set(1);
+			b.allocate(4, 2);
+			b.set(0.5f);
+			a.mixTo(b, 0.25f);
+			ofxTestEq(b[0], 0.75f, "mixed with gain");
+			a.addTo(b);
+			ofxTestEq(b[7], 1.75f, "addTo mixes with gain 1");
+
+			ofSoundBuffer mono;
+			mono.allocate(4, 1);
+			mono.set(0);
+			a.mixTo(mono, 2);
+			ofxTestEq(mono[3], 2.f, "mixed to fewer channels");
+
+			ofSoundBuffer scratch;
+			a.getBuffer().reserve(16);
+			auto data = a.getBuffer().data();
+			a.resample(0.5f, scratch);
+			ofxTestEq(a.getNumFrames(), 8, "resampled in place");
+			ofxTest(a.getBuffer().data() == data, "keeps its own storage");
+			ofxTest(scratch.getBuffer().data() != data, "the scratch buffer keeps its own storage");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,151 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+#include <chrono>
+
+double millisSince(std::chrono::steady_clock::time_point start){
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// maximum difference with a sine of the given frequency sampled at frame
+// position start + i * step of each output frame
+float sineError(const ofSoundBuffer & buffer, float pitchHz, double start, double step){
+	float error = 0;
+	for(size_t i = 0; i < buffer.getNumFrames(); i++){
+		double t = start + i * step;
+		float expected = std::sin(glm::two_pi<double>() * pitchHz * t / buffer.getSampleRate());
+		for(size_t c = 0; c < buffer.getNumChannels(); c++){
+			error = std::max(error, std::abs(buffer.getSample(i, c) - expected));
+		}
+	}
+	return error;
+}
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		ofSoundBuffer sample;
+		sample.setSampleRate(44100);
+		sample.allocate(44100, 2);
+		sample.fillWithTone(440);
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "read";
+			ofSoundBuffer out;
+			sample.resampleTo(out, 1000, 512, 1, false, ofSoundBuffer::Sinc);
+			bool equal = true;
+			for(size_t i = 0; i < out.size(); i++){
+				equal &= out[i] == sample[2000 + i];
+			}
+			ofxTest(equal, "speed 1 copies the input");
+			ofxTestEq(out.getNumChannels(), 2, "channels");
+
+			sample.resampleTo(out, 1000, 512, 0.5f, false, ofSoundBuffer::Sinc);
+			ofxTest(sineError(out, 440, 1000, 0.5) < 0.005f, "half speed follows the sine");
+
+			sample.resampleTo(out, 44000, 512, 1, false, ofSoundBuffer::Sinc);
+			ofxTestEq(out.getSample(511, 0), 0.f, "silent past the end");
+			sample.resampleTo(out, 44000, 512, 1, true, ofSoundBuffer::Sinc);
+			ofxTestEq(out.getSample(200, 0), sample.getSample(100, 0), "loops");
+
+			ofSoundBuffer high;
+			high.setSampleRate(44100);
+			high.allocate(8192, 1);
+			high.fillWithTone(15000);
+			high.resampleTo(out, 100, 2000, 2, false, ofSoundBuffer::Hermite);
+			auto hermiteRMS = out.getRMSAmplitude();
+			high.resampleTo(out, 100, 2000, 2, false, ofSoundBuffer::Sinc);
+			auto sincRMS = out.getRMSAmplitude();
+			ofLogNotice() << "15KHz at speed 2, hermite rms: " << hermiteRMS << ", sinc rms: " << sincRMS;
+			ofxTest(sincRMS < 0.01f, "frequencies over the new nyquist are filtered");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "stateful read";
+			ofSoundResampler resampler;
+			resampler.setSpeed(1.5);
+			ofSoundBuffer whole, part, joined;
+			resampler.read(sample, whole, 1024);
+			resampler.setPosition(0);
+			joined.setNumChannels(2);
+			for(int i = 0; i < 4; i++){
+				resampler.read(sample, part, 256);
+				joined.append(part);
+			}
+			ofxTest(joined.getBuffer() == whole.getBuffer(), "successive reads join");
+			ofxTestEq(resampler.getPosition(), 1536., "position advances by the speed");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "process";
+			ofSoundResampler resampler;
+			resampler.setSpeed(44100. / 48000.);
+			ofSoundBuffer whole;
+			resampler.process(sample, whole);
+			ofxTestEq(whole.getSampleRate(), 48000, "output sample rate");
+			auto delay = resampler.getNumTaps() / 2;
+			ofSoundBuffer start;
+			whole.copyTo(start, 1000, 2, 100);
+			ofxTest(sineError(start, 440, 100 * resampler.getSpeed() - delay, resampler.getSpeed()) < 0.005f, "converted with a delay of half the taps");
+
+			resampler.reset();
+			ofSoundBuffer chunk, part, joined;
+			joined.setNumChannels(2);
+			for(size_t frame = 0; frame < sample.getNumFrames(); frame += 300){
+				sample.copyTo(chunk, std::min<size_t>(300, sample.getNumFrames() - frame), 2, frame);
+				resampler.process(chunk, part);
+				joined.append(part);
+			}
+			ofxTestEq(joined.getNumFrames(), whole.getNumFrames(), "same frames in chunks");
+			float difference = 0;
+			for(size_t i = 0; i < joined.size(); i++){
+				difference = std::max(difference, std::abs(joined[i] - whole[i]));
+			}
+			ofxTest(difference < 1e-5f, "chunks join without discontinuities");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "benchmark";
+			// 64 voices of 512 frames at different speeds, as for pitch shifted playback
+			ofSoundBuffer out;
+			out.reserve(512 * 2);
+			for(auto algorithm: {ofSoundBuffer::Linear, ofSoundBuffer::Hermite, ofSoundBuffer::Sinc}){
+				auto start = std::chrono::steady_clock::now();
+				for(int callback = 0; callback < 100; callback++){
+					for(int voice = 0; voice < 64; voice++){
+						float speed = 0.5f + voice / 32.f;
+						sample.resampleTo(out, (callback * 512) % 40000, 512, speed, true, algorithm);
+					}
+				}
+				auto time = millisSince(start) / 100;
+				std::string name = algorithm == ofSoundBuffer::Linear ? "linear" : algorithm == ofSoundBuffer::Hermite ? "hermite" : "sinc";
+				ofLogNotice() << name << ": " << time << "ms per callback of 64 stereo voices";
+			}
+			for(size_t taps: {8, 16, 32, 64}){
+				ofSoundResampler resampler;
+				resampler.setup(taps);
+				auto start = std::chrono::steady_clock::now();
+				for(int callback = 0; callback < 100; callback++){
+					for(int voice = 0; voice < 64; voice++){
+						resampler.setSpeed(0.5 + voice / 32.);
+						resampler.setPosition((callback * 512) % 40000);
+						resampler.read(sample, out, 512, true);
+					}
+				}
+				ofLogNotice() << "sinc " << taps << " taps: " << millisSince(start) / 100 << "ms per callback of 64 stereo voices";
+			}
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,354 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// a sound stream without a device: a thread calls the callbacks in real time
+// with buffers where every sample is the stream frame it belongs to, and
+// checks the output is the sequence the app writes
+class OfflineSoundStream: public ofBaseSoundStream{
+public:
+	~OfflineSoundStream(){
+		close();
+	}
+
+	bool setup(const ofSoundStreamSettings & s) override{
+		settings = s;
+		callbackMicros.assign(maxCallbacks, 0);
+		start();
+		return true;
+	}
+	void setInput(ofBaseSoundInput * input) override{
+		settings.setInListener(input);
+	}
+	void setOutput(ofBaseSoundOutput * output) override{
+		settings.setOutListener(output);
+	}
+	std::vector<ofSoundDevice> getDeviceList(ofSoundDevice::Api) const override{
+		return {};
+	}
+	void start() override{
+		if(running){
+			return;
+		}
+		running = true;
+		thread = std::thread([this]{ run(); });
+	}
+	void stop() override{
+		running = false;
+		if(thread.joinable()){
+			thread.join();
+		}
+	}
+	void close() override{
+		stop();
+	}
+	uint64_t getTickCount() const override{
+		return tickCount;
+	}
+	int getNumInputChannels() const override{
+		return settings.numInputChannels;
+	}
+	int getNumOutputChannels() const override{
+		return settings.numOutputChannels;
+	}
+	int getSampleRate() const override{
+		return settings.sampleRate;
+	}
+	int getBufferSize() const override{
+		return settings.bufferSize;
+	}
+	ofSoundDevice getInDevice() const override{
+		return ofSoundDevice();
+	}
+	ofSoundDevice getOutDevice() const override{
+		return ofSoundDevice();
+	}
+
+	static constexpr std::size_t maxCallbacks = 1 << 16;
+	// time each callback ran at, read after stop()
+	std::vector<uint64_t> callbackMicros;
+	std::atomic<uint64_t> tickCount{0};
+	std::atomic<uint64_t> outputErrors{0};
+	std::atomic<uint64_t> outputFrames{0};
+
+private:
+	void run(){
+		ofSoundBuffer in, out;
+		in.allocate(settings.bufferSize, settings.numInputChannels);
+		out.allocate(settings.bufferSize, settings.numOutputChannels);
+		in.setSampleRate(settings.sampleRate);
+		out.setSampleRate(settings.sampleRate);
+		auto period = std::chrono::microseconds(1000000 * settings.bufferSize / settings.sampleRate);
+		auto next = std::chrono::steady_clock::now();
+		float expected = 1;
+		while(running){
+			std::this_thread::sleep_until(next);
+			next += period;
+			auto tick = tickCount.load();
+			if(tick < maxCallbacks){
+				callbackMicros[tick] = ofGetElapsedTimeMicros();
+			}
+			uint64_t frame = tick * settings.bufferSize;
+			if(settings.inCallback){
+				for(std::size_t i = 0; i < in.getNumFrames(); i++){
+					for(std::size_t c = 0; c < in.getNumChannels(); c++){
+						in[i * in.getNumChannels() + c] = float(frame + i);
+					}
+				}
+				in.setTickCount(tick);
+				settings.inCallback(in);
+			}
+			if(settings.outCallback){
+				out.setTickCount(tick);
+				settings.outCallback(out);
+				// the output can be silent but never skip or repeat frames
+				for(std::size_t i = 0; i < out.size(); i++){
+					if(out[i] != 0){
+						if(out[i] != expected){
+							outputErrors++;
+						}
+						if(i % out.getNumChannels() == 0){
+							outputFrames++;
+						}
+						expected = out[i] + ((i + 1) % out.getNumChannels() == 0 ? 1 : 0);
+					}
+				}
+			}
+			tickCount = tick + 1;
+		}
+	}
+
+	ofSoundStreamSettings settings;
+	std::thread thread;
+	std::atomic<bool> running{false};
+};
+
+class ofApp: public ofxUnitTestsApp{
+	// reads all the frames available in chunks, returns false if a chunk
+	// doesn't start at the stream frame reported or skips frames
+	bool readConsecutive(ofSoundRingBuffer & ring, std::vector<float> & samples, std::vector<int64_t> & latencies){
+		bool ok = true;
+		std::size_t numChannels = ring.getNumChannels();
+		while(true){
+			auto frame = ring.getReadStreamFrame();
+			auto n = ring.read(samples.data(), samples.size() / numChannels);
+			if(n == 0){
+				return ok;
+			}
+			latencies.push_back(int64_t(ofGetElapsedTimeMicros()) - int64_t(ring.getTimeMicros(frame)));
+			for(std::size_t i = 0; i < n; i++){
+				ok &= samples[i * numChannels] == float(frame + i);
+				ok &= samples[i * numChannels + numChannels - 1] == float(frame + i);
+			}
+		}
+	}
+
+	void run(){
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "ring";
+			ofSoundRingBuffer ring;
+			ring.setup(2, 100, 44100);
+			ofxTestEq(ring.getCapacity(), 128, "capacity rounded to a power of 2");
+
+			std::vector<float> in(400), out(400);
+			for(std::size_t i = 0; i < in.size(); i++){
+				in[i] = i;
+			}
+			ofxTestEq(ring.write(in.data(), 100), 100, "write");
+			ofxTestEq(ring.read(out.data(), 60), 60, "read");
+			ofxTestEq(ring.write(in.data() + 200, 80), 80, "write across the end");
+			ofxTestEq(ring.getNumFramesAvailable(), 120, "available frames");
+			ofxTestEq(ring.read(out.data() + 120, 120), 120, "read across the end");
+			ofxTestEq(out[2 * 100], 200.f, "frames after the end");
+			ofxTestEq(out[2 * 100 - 1], 199.f, "frames before the end");
+			ofxTestEq(out[359], 359.f, "last frame");
+			ofxTestEq(ring.getNumOverflows() + ring.getNumUnderflows(), 0, "no overflows or underflows");
+
+			ofxTestEq(ring.write(in.data(), 200), 128, "write only what fits");
+			ofxTestEq(ring.getNumOverflows(), 1, "overflow counted");
+			ofxTestEq(ring.getNumOverflowFrames(), 72, "overflow frames counted");
+
+			ofSoundBuffer buffer;
+			buffer.allocate(200, 2);
+			buffer.set(1);
+			ofxTestEq(ring.read(buffer), 128, "read buffer");
+			ofxTestEq(buffer[2 * 127], 254.f, "frames read");
+			ofxTestEq(buffer[2 * 128], 0.f, "missing frames are silent");
+			ofxTestEq(ring.getNumUnderflows(), 1, "underflow counted");
+			ofxTestEq(ring.getNumUnderflowFrames(), 72, "underflow frames counted");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "input stream frames";
+			ofSoundRingBuffer ring;
+			ring.setup(1, 64, 44100);
+			ofSoundBuffer buffer;
+			buffer.allocate(48, 1);
+			uint64_t streamFrame = 0;
+			auto audioIn = [&]{
+				for(std::size_t i = 0; i < buffer.getNumFrames(); i++){
+					buffer[i] = streamFrame + i;
+				}
+				ring.audioIn(buffer);
+				streamFrame += buffer.getNumFrames();
+			};
+			std::vector<float> samples(64);
+			audioIn();
+			audioIn();
+			audioIn();
+			ofxTestEq(ring.getNumOverflowFrames(), 80, "frames dropped");
+			ofxTestEq(ring.getReadStreamFrame(), 0, "stream frame before the gap");
+			ofxTestEq(ring.read(samples.data(), 64), 64, "read up to the gap");
+			ofxTestEq(samples[63], 63.f, "last frame before the gap");
+			ofxTestEq(ring.getReadStreamFrame(), 144, "stream frame after the gap");
+			audioIn();
+			ofxTestEq(ring.read(samples.data(), 64), 48, "read after the gap");
+			ofxTestEq(samples[0], 144.f, "first frame after the gap");
+
+			audioIn();
+			audioIn();
+			ofxTestEq(ring.getNumFramesAvailable(), 64, "ring full again");
+			ofxTestEq(ring.read(samples.data(), 32), 32, "read before the gap");
+			audioIn();
+			ofxTestEq(ring.getNumFramesAvailable(), 64, "written after the gap");
+			ofxTestEq(ring.read(samples.data(), 64), 32, "read stops at the gap");
+			ofxTestEq(samples[31], 255.f, "last frame before the gap");
+			ofxTestEq(ring.getReadStreamFrame(), 288, "stream frame at the gap");
+			ofxTestEq(ring.read(samples.data(), 64), 32, "read after the gap");
+			ofxTestEq(samples[0], 288.f, "first frame after the gap");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "clock";
+			// callbacks of a device a bit faster than nominal, with up to
+			// 1.5ms of jitter, the clock should follow the device without it
+			const double sampleRate = 44100;
+			const double deviceRate = sampleRate * 1.002;
+			const uint64_t bufferSize = 256;
+			const std::size_t numCallbacks = 4000;
+			ofSoundClock clock;
+			clock.setup(sampleRate);
+			ofxTest(!clock.isRunning(), "not running before the first update");
+			ofSetRandomSeed(1);
+			double error = 0;
+			double jitter = 0;
+			for(std::size_t i = 0; i < numCallbacks; i++){
+				uint64_t frame = i * bufferSize;
+				double time = 1000000 + frame * 1000000 / deviceRate;
+				double delay = ofRandom(-1500, 1500);
+				clock.update(frame, uint64_t(time + delay));
+				if(i >= numCallbacks / 2){
+					error += std::abs(double(clock.getMicros(frame)) - time);
+					jitter += std::abs(delay);
+				}
+			}
+			error /= numCallbacks / 2;
+			jitter /= numCallbacks / 2;
+			ofLogNotice() << "mean clock error " << error << "us, mean jitter " << jitter << "us";
+			ofxTest(clock.isRunning(), "running");
+			ofxTest(error < jitter / 3, "clock filters the jitter");
+			ofxTest(std::abs(clock.getMeasuredSampleRate() - deviceRate) < deviceRate * 0.005, "measured sample rate");
+
+			uint64_t frame = numCallbacks * bufferSize;
+			uint64_t stalled = clock.getMicros(frame) + 1000000;
+			clock.update(frame, stalled);
+			ofxTestEq(clock.getMicros(frame), stalled, "clock jumps after a stall");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "offline stream";
+			const int sampleRate = 44100;
+			const int bufferSize = 256;
+			ofSoundRingBuffer input, output;
+			input.setup(2, 4096, sampleRate);
+			output.setup(2, 4096, sampleRate);
+
+			auto offline = std::make_shared<OfflineSoundStream>();
+			ofSoundStream stream;
+			stream.setSoundStream(offline);
+			ofSoundStreamSettings settings;
+			settings.numInputChannels = 2;
+			settings.numOutputChannels = 2;
+			settings.sampleRate = sampleRate;
+			settings.bufferSize = bufferSize;
+			settings.setInListener(&input);
+			settings.setOutListener(&output);
+
+			// the app runs at about 100fps, reading the input and keeping
+			// the output a few buffers ahead, and stalls for a while in
+			// the middle so both overflow and underflow
+			std::vector<float> samples(bufferSize * 2);
+			std::vector<int64_t> latencies;
+			std::vector<float> outSamples(4 * bufferSize * 2);
+			float nextOut = 1;
+			bool consecutive = true;
+			auto writeOutput = [&]{
+				std::size_t n = std::min<std::size_t>(output.getNumFramesFree(), 4 * bufferSize - output.getNumFramesAvailable());
+				for(std::size_t i = 0; i < n; i++){
+					outSamples[i * 2] = outSamples[i * 2 + 1] = nextOut++;
+				}
+				output.write(outSamples.data(), n);
+			};
+
+			stream.setup(settings);
+			auto start = ofGetElapsedTimeMillis();
+			while(ofGetElapsedTimeMillis() - start < 1500){
+				auto elapsed = ofGetElapsedTimeMillis() - start;
+				if(elapsed > 500 && elapsed < 700){
+					ofSleepMillis(200);
+				}
+				consecutive &= readConsecutive(input, samples, latencies);
+				writeOutput();
+				ofSleepMillis(10);
+			}
+			stream.stop();
+			consecutive &= readConsecutive(input, samples, latencies);
+
+			ofxTest(consecutive, "input frames match the stream frames");
+			ofxTest(input.getNumOverflows() > 0, "input overflowed");
+			ofxTestEq(input.getReadStreamFrame(), offline->getTickCount() * bufferSize, "every stream frame accounted for");
+			ofxTestEq(offline->outputErrors.load(), 0, "output frames in order");
+			ofxTest(output.getNumUnderflows() > 0, "output underflowed");
+			ofxTestEq(offline->outputFrames.load() + output.getNumUnderflowFrames(), offline->getTickCount() * bufferSize,
+				"every output frame played or silent");
+
+			// real time, only logged since it depends on the scheduler
+			double error = 0;
+			auto numCallbacks = std::min<uint64_t>(offline->getTickCount(), OfflineSoundStream::maxCallbacks);
+			std::size_t first = numCallbacks / 2;
+			for(std::size_t i = first; i < numCallbacks; i++){
+				error += std::abs(double(input.getTimeMicros(i * bufferSize)) - double(offline->callbackMicros[i]));
+			}
+			error /= numCallbacks - first;
+			ofLogNotice() << "mean clock error " << error << "us";
+			ofLogNotice() << "measured sample rate " << input.getClock().getMeasuredSampleRate();
+
+			int64_t maxLatency = 0;
+			double meanLatency = 0;
+			for(auto latency: latencies){
+				maxLatency = std::max(maxLatency, latency);
+				meanLatency += latency;
+			}
+			meanLatency /= std::max<std::size_t>(1, latencies.size());
+			ofLogNotice() << "input latency mean " << meanLatency / 1000 << "ms, max " << maxLatency / 1000. << "ms";
+			ofLogNotice() << "input overflows " << input.getNumOverflows() << " (" << input.getNumOverflowFrames() << " frames)";
+			ofLogNotice() << "output underflows " << output.getNumUnderflows() << " (" << output.getNumUnderflowFrames() << " frames)";
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
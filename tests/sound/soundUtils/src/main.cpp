@@ -0,0 +1,232 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+#include "ofSoundUtils.h"
+#include <chrono>
+
+// runs f repetitions times and returns the throughput in millions of samples per second
+template<typename F>
+double megaSamplesPerSecond(std::size_t numSamples, F f){
+	const int repetitions = 2000;
+	auto start = std::chrono::steady_clock::now();
+	for(int i = 0; i < repetitions; i++){
+		f();
+	}
+	auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return numSamples * repetitions / seconds / 1000000;
+}
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		const std::size_t numFrames = 4096;
+		ofSoundBuffer a, b;
+		a.allocate(numFrames, 2);
+		a.fillWithNoise(1);
+		b.allocate(numFrames, 2);
+		b.fillWithTone(440);
+		const float * in = a.getBuffer().data();
+		std::size_t numSamples = a.size();
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "gain and mixing";
+			std::vector<float> out(b.getBuffer());
+			ofSoundApplyGain(out.data(), numSamples, 0.5f);
+			ofxTestEq(out[11], b[11] * 0.5f, "gain");
+
+			out = b.getBuffer();
+			ofSoundApplyGainRamp(out.data(), numFrames, 2, 0, 1);
+			ofxTestEq(out[0], 0.f, "ramp starts at startGain");
+			ofxTestEq(out[2049 * 2 + 1], b[2049 * 2 + 1] * (2049.f / numFrames), "ramp is linear per frame");
+
+			out = b.getBuffer();
+			ofSoundMix(out.data(), in, numSamples, 0.25f);
+			ofxTestEq(out[7], b[7] + a[7] * 0.25f, "mix");
+
+			ofSoundMixSource sources[] = {{in, 1, 1}, {b.getBuffer().data(), 0, 2}};
+			ofSoundMix(out.data(), sources, 2, numFrames, 2);
+			ofxTestEq(out[0], a[0], "mix sources starts at the start gains");
+			ofxTestEq(out[101], a[101] + b[101] * (2 * 50.f / numFrames), "mix sources ramps each source");
+
+			out.assign(numSamples, 0);
+			ofSoundPan(b.getBuffer().data(), out.data(), numFrames, 1, -1);
+			ofxTest(std::abs(out[1]) < 1e-6f, "pan left");
+			ofSoundPan(b.getBuffer().data(), out.data(), numFrames, 1, 0);
+			ofxTest(std::abs(out[10] * out[10] + out[11] * out[11] - b[5] * b[5]) < 1e-6f, "pan keeps the power");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "metering";
+			float peak = 0;
+			double squares = 0;
+			for(std::size_t i = 0; i < numSamples; i++){
+				peak = std::max(peak, std::abs(in[i]));
+				squares += in[i] * in[i];
+			}
+			ofxTestEq(ofSoundPeak(in, numSamples), peak, "peak");
+			ofxTest(std::abs(ofSoundRMS(in, numSamples) - std::sqrt(squares / numSamples)) < 1e-6, "rms");
+			ofxTestEq(a.getRMSAmplitude(), ofSoundRMS(in, numSamples), "ofSoundBuffer rms");
+			ofxTestEq(ofSoundRMS(in, 0), 0.f, "rms of nothing");
+			float withNaN[] = {0.25f, std::numeric_limits<float>::quiet_NaN(), -0.5f};
+			ofxTestEq(ofSoundPeak(withNaN, 3), 0.5f, "peak skips NaN");
+
+			ofSoundBuffer loud = b;
+			loud.normalize(0.5f);
+			ofxTest(std::abs(ofSoundPeak(loud.getBuffer().data(), loud.size()) - 0.5f) < 1e-6f, "normalize");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "conversion";
+			std::vector<short> shorts;
+			a.toShortPCM(shorts);
+			ofSoundBuffer converted;
+			converted.copyFrom(shorts, 2, 44100);
+			ofxTest(std::abs(converted[3] - a[3]) < 1.f / 32767, "short round trip");
+
+			float outside[] = {2, -2, 1e10f, -1e10f, std::numeric_limits<float>::quiet_NaN()};
+			short clamped[5];
+			ofSoundFloatToShort(outside, clamped, 5);
+			ofxTestEq(clamped[0], 32767, "clamps to the max");
+			ofxTestEq(clamped[1], -32768, "clamps to the min");
+			ofxTestEq(clamped[2], 32767, "clamps values out of the int range");
+			ofxTestEq(clamped[3], -32768, "clamps negative values out of the int range");
+			ofxTestEq(clamped[4], 0, "NaN is silent");
+
+			std::vector<unsigned char> int24(numSamples * 3);
+			std::vector<float> floats(numSamples);
+			ofSoundFloatToInt24(in, int24.data(), numSamples);
+			ofSoundInt24ToFloat(int24.data(), floats.data(), numSamples);
+			ofxTest(std::abs(floats[5] - a[5]) < 1.f / 8388607, "24 bit round trip");
+			float negative = -1;
+			ofSoundFloatToInt24(&negative, int24.data(), 1);
+			ofxTestEq(int(int24[2]), 0x80, "24 bit is little endian");
+			float huge = 1e10f;
+			ofSoundFloatToInt24(&huge, int24.data(), 1);
+			ofxTest(int24[0] == 0xff && int24[1] == 0xff && int24[2] == 0x7f, "24 bit clamps values out of the int range");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "interleaving";
+			std::vector<float> left(numFrames), right(numFrames), interleaved(numSamples);
+			float * channels[] = {left.data(), right.data()};
+			ofSoundDeinterleave(in, channels, numFrames, 2);
+			ofxTestEq(right[9], a.getSample(9, 1), "deinterleave");
+			const float * constChannels[] = {left.data(), right.data()};
+			ofSoundInterleave(constChannels, interleaved.data(), numFrames, 2);
+			ofxTest(interleaved == a.getBuffer(), "interleave");
+
+			ofSoundBuffer channel, withChannel;
+			a.getChannel(channel, 1);
+			withChannel.allocate(numFrames, 3);
+			withChannel.setChannel(channel, 2);
+			ofxTestEq(withChannel.getSample(100, 2), a.getSample(100, 1), "getChannel and setChannel");
+		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "benchmark";
+			// the plain loops the buffer used before, to compare with the kernels
+			std::vector<float> out(numSamples);
+			std::vector<short> shorts(numSamples);
+			std::vector<unsigned char> int24(numSamples * 3);
+			std::vector<float> left(numFrames), right(numFrames);
+			float * channels[] = {left.data(), right.data()};
+			volatile float result = 0;
+			auto log = [](const std::string & kernel, double scalar, double kernelSpeed){
+				if(scalar > 0){
+					ofLogNotice() << kernel << ": loop " << scalar << " Msamples/s, kernel " << kernelSpeed << " Msamples/s";
+				}else{
+					ofLogNotice() << kernel << ": " << kernelSpeed << " Msamples/s";
+				}
+			};
+
+			log("gain", megaSamplesPerSecond(numSamples, [&]{
+				for(std::size_t i = 0; i < numSamples; i++) out[i] *= 0.999f;
+			}), megaSamplesPerSecond(numSamples, [&]{
+				ofSoundApplyGain(out.data(), numSamples, 0.999f);
+			}));
+
+			log("gain ramp", megaSamplesPerSecond(numSamples, [&]{
+				for(std::size_t i = 0; i < numFrames; i++){
+					float gain = 1 - 0.001f * i / numFrames;
+					out[i * 2] *= gain;
+					out[i * 2 + 1] *= gain;
+				}
+			}), megaSamplesPerSecond(numSamples, [&]{
+				ofSoundApplyGainRamp(out.data(), numFrames, 2, 1, 0.999f);
+			}));
+
+			log("mix", megaSamplesPerSecond(numSamples, [&]{
+				for(std::size_t i = 0; i < numSamples; i++) out[i] += in[i] * 0.5f;
+			}), megaSamplesPerSecond(numSamples, [&]{
+				ofSoundMix(out.data(), in, numSamples, 0.5f);
+			}));
+
+			log("stereo pan", megaSamplesPerSecond(numSamples, [&]{
+				float * ptr = out.data();
+				for(std::size_t i = 0; i < numFrames; i++){
+					*ptr++ *= 0.99f;
+					*ptr++ *= 0.98f;
+				}
+			}), megaSamplesPerSecond(numSamples, [&]{
+				ofSoundStereoGain(out.data(), numFrames, 0.99f, 0.98f);
+			}));
+
+			log("peak", megaSamplesPerSecond(numSamples, [&]{
+				float peak = 0;
+				for(std::size_t i = 0; i < numSamples; i++) peak = std::max(peak, std::abs(in[i]));
+				result = peak;
+			}), megaSamplesPerSecond(numSamples, [&]{
+				result = ofSoundPeak(in, numSamples);
+			}));
+
+			log("rms", megaSamplesPerSecond(numSamples, [&]{
+				double acc = 0;
+				for(std::size_t i = 0; i < numSamples; i++) acc += in[i] * in[i];
+				result = std::sqrt(acc / numSamples);
+			}), megaSamplesPerSecond(numSamples, [&]{
+				result = ofSoundRMS(in, numSamples);
+			}));
+
+			log("short to float", megaSamplesPerSecond(numSamples, [&]{
+				for(std::size_t i = 0; i < numSamples; i++) out[i] = shorts[i] / 32767.f;
+			}), megaSamplesPerSecond(numSamples, [&]{
+				ofSoundShortToFloat(shorts.data(), out.data(), numSamples);
+			}));
+
+			log("float to short", megaSamplesPerSecond(numSamples, [&]{
+				for(std::size_t i = 0; i < numSamples; i++) shorts[i] = in[i] * 32767.f;
+			}), megaSamplesPerSecond(numSamples, [&]{
+				ofSoundFloatToShort(in, shorts.data(), numSamples);
+			}));
+
+			log("float to int24", 0, megaSamplesPerSecond(numSamples, [&]{
+				ofSoundFloatToInt24(in, int24.data(), numSamples);
+			}));
+
+			log("int24 to float", 0, megaSamplesPerSecond(numSamples, [&]{
+				ofSoundInt24ToFloat(int24.data(), out.data(), numSamples);
+			}));
+
+			log("deinterleave", megaSamplesPerSecond(numSamples, [&]{
+				for(std::size_t c = 0; c < 2; c++){
+					for(std::size_t i = 0; i < numFrames; i++) channels[c][i] = in[i * 2 + c];
+				}
+			}), megaSamplesPerSecond(numSamples, [&]{
+				ofSoundDeinterleave(in, channels, numFrames, 2);
+			}));
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -212,6 +212,74 @@ class ofApp: public ofxUnitTestsApp{
 			ofxTest(allLinesEqual, "all lines are correct");
 			ofxTestEq(numLines,lines.size(),"lines iterator correct numLines");
 		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "mapped file";
+			std::string text;
+			for(int i=0;i<1000;i++){
+				text += "line " + ofToString(i) + "\r\n";
+			}
+			ofBufferToFile("mapped.txt", ofBuffer(text.c_str(), text.size()));
+
+			ofBuffer buffer;
+			ofxTest(buffer.mapFile("mapped.txt"), "mapFile");
+			ofxTest(buffer.isMapped(), "isMapped");
+			ofxTestEq(buffer.size(), text.size(), "mapped size");
+			ofxTestEq(buffer.getText(), text, "mapped getText");
+			ofxTest(buffer.end() == buffer.begin() + text.size(), "correct boundaries");
+
+			auto numLines = 0;
+			auto allLinesEqual = true;
+			for(auto line: buffer.getLines()){
+				allLinesEqual &= line == "line " + ofToString(numLines);
+				++numLines;
+			}
+			ofxTest(allLinesEqual, "mapped lines are correct");
+			ofxTestEq(numLines, 1000, "mapped lines iterator correct numLines");
+
+			buffer.setAccessHint(ofBuffer::Random);
+			ofBuffer copy = buffer;
+			const ofBuffer & constCopy = copy;
+			const ofBuffer & constBuffer = buffer;
+			ofxTest(copy.isMapped() && constCopy.getData() == constBuffer.getData(), "copies share the mapping");
+
+			buffer.getData()[0] = 'L';
+			ofxTest(!buffer.isMapped() && copy.isMapped(), "writing to a shared mapping copies it");
+			ofxTestEq(copy.getText(), text, "copies don't see each other's writes");
+			ofxTestEq(ofBufferFromFile("mapped.txt").getText(), text, "writing to a mapped buffer doesn't modify the file");
+
+			copy.getData()[0] = 'L';
+			ofxTest(copy.isMapped(), "writing to a mapping that isn't shared doesn't copy it");
+			ofxTestEq(ofBufferFromFile("mapped.txt").getText(), text, "writing to a mapped buffer doesn't modify the file");
+
+			ofBuffer appended = copy;
+			appended.append(constCopy.getData(), 4);
+			ofxTest(!appended.isMapped(), "append copies the mapped contents");
+			ofxTestEq(appended.getText(), "L" + text.substr(1) + "Line", "append from the mapping itself");
+
+			copy.set(constCopy.getData() + 5, 10);
+			ofxTest(!copy.isMapped(), "set replaces the mapping");
+			ofxTestEq(copy.getText(), text.substr(5, 10), "set from the mapping itself");
+
+			std::string large(2 * 1024 * 1024, 'a');
+			ofBufferToFile("large.bin", ofBuffer(large.c_str(), large.size()));
+			ofBuffer read = ofFile("large.bin", ofFile::ReadOnly, true).readToBuffer();
+			ofxTest(!read.isMapped(), "readToBuffer copies large files");
+			ofxTest(!ofBufferFromFile("large.bin").isMapped(), "ofBufferFromFile copies large files");
+			ofBufferToFile("large.bin", ofBuffer("b", 1));
+			ofxTestEq(read.size(), large.size(), "a read buffer survives rewriting its file");
+			ofxTestEq(read.getData()[large.size() - 1], 'a', "a read buffer keeps its contents");
+
+			ofBuffer empty;
+			ofBufferToFile("empty.txt", empty);
+			ofxTest(!empty.mapFile("empty.txt"), "empty files are not mapped");
+			ofxTestEq(empty.size(), 0, "empty mapped size");
+
+			ofFile::removeFile("mapped.txt");
+			ofFile::removeFile("empty.txt");
+			ofFile::removeFile("large.bin");
+		}
 	}
 };
 
@@ -0,0 +1,130 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+#include <chrono>
+#ifndef TARGET_WIN32
+#include <sys/resource.h>
+#endif
+
+// peak resident memory of the process in MB
+double peakMemoryMB(){
+#ifndef TARGET_WIN32
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	#ifdef TARGET_OSX
+	return usage.ru_maxrss / (1024. * 1024.);
+	#else
+	return usage.ru_maxrss / 1024.;
+	#endif
+#else
+	return 0;
+#endif
+}
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		std::string timeline = R"({
+			"meta": {"version": 2, "a/b": "slash"},
+			"tracks": [
+				{"name": "camera", "events": [{"time": 1.5}, {"time": 2}]},
+				{"name": "lights", "events": [{"time": 3, "tags": ["on", "red"]}]}
+			]
+		})";
+
+		{
+			ofLogNotice() << "filters";
+			ofJsonStreamReader reader;
+			reader.addFilter("/tracks/*/events/*");
+			std::vector<std::string> pointers;
+			float totalTime = 0;
+			ofxTest(reader.parse(timeline, [&](const std::string & pointer, ofJson && event){
+				pointers.push_back(pointer);
+				totalTime += event["time"].get<float>();
+				return true;
+			}), "parse");
+			ofxTestEq(pointers.size(), 3u, "selected every event");
+			ofxTestEq(pointers[2], "/tracks/1/events/0", "json pointer of the value");
+			ofxTestEq(totalTime, 6.5f, "selected values are complete");
+
+			reader.clearFilters();
+			reader.addFilter("/tracks/1/name");
+			reader.addFilter("/meta/a~1b");
+			std::vector<ofJson> values;
+			reader.parse(timeline, [&](const std::string & pointer, ofJson && value){
+				values.push_back(value);
+				return true;
+			});
+			ofxTestEq(values.size(), 2u, "array index and escaped key filters");
+			ofxTestEq(values[0], "slash", "escaped key");
+			ofxTestEq(values[1], "lights", "array index");
+
+			reader.clearFilters();
+			ofJson whole;
+			reader.parse(timeline, [&](const std::string & pointer, ofJson && value){
+				whole = value;
+				return pointer.empty();
+			});
+			ofxTestEq(whole, ofJson::parse(timeline), "no filters selects the whole document");
+
+			reader.addFilter("/tracks/*");
+			size_t numTracks = 0;
+			ofxTest(reader.parse(timeline, [&](const std::string &, ofJson &&){
+				numTracks++;
+				return false;
+			}), "stopping is not an error");
+			ofxTestEq(numTracks, 1u, "stop after the first value");
+
+			ofxTest(!reader.parse("{\"tracks\": [1, 2", [](const std::string &, ofJson &&){ return true; }), "invalid json");
+			ofxTest(!reader.getError().empty(), "error description");
+		}
+
+		{
+			ofLogNotice() << "dom vs streaming benchmark";
+			// written as text so generating it doesn't raise the peak memory
+			{
+				ofFile file("timeline.json", ofFile::WriteOnly);
+				file << "{\"meta\": {\"version\": 2}, \"annotations\": [";
+				for(int i = 0; i < 500000; i++){
+					file << (i ? ", " : "") << "{\"id\": " << i << ", \"start\": " << i * 0.04
+						<< ", \"end\": " << i * 0.04 + 1 << ", \"label\": \"annotation " << i
+						<< "\", \"tags\": [\"person\", \"walking\"], \"box\": [10, 20, 30, 40]}";
+				}
+				file << "]}";
+			}
+			auto size = ofFile("timeline.json").getSize() / (1024. * 1024.);
+
+			auto memoryBefore = peakMemoryMB();
+			auto start = std::chrono::steady_clock::now();
+			ofJsonStreamReader reader;
+			reader.addFilter("/annotations/*/label");
+			size_t numLabels = 0;
+			reader.load("timeline.json", [&](const std::string &, ofJson && label){
+				numLabels++;
+				return true;
+			});
+			auto streamTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			auto streamMemory = peakMemoryMB() - memoryBefore;
+
+			memoryBefore = peakMemoryMB();
+			start = std::chrono::steady_clock::now();
+			auto json = ofLoadJson("timeline.json");
+			size_t numAnnotations = json["annotations"].size();
+			auto domTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			auto domMemory = peakMemoryMB() - memoryBefore;
+
+			ofLogNotice() << size << "MB file, dom: " << domTime << "ms, peak memory +" << domMemory << "MB";
+			ofLogNotice() << size << "MB file, streaming: " << streamTime << "ms, peak memory +" << streamMemory << "MB";
+			ofxTestEq(numLabels, numAnnotations, "streaming selects the same values");
+			ofFile::removeFile("timeline.json");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -45,6 +45,46 @@ class ofApp: public ofxUnitTestsApp{
 		ofSetLoggerChannel(testLogger);
 		ofxTestEq(stringLogger->getStdOut(),"[ notice ] logging: Hello World!\n","logging a notice message with printf syntax");
 		ofxTestEq(stringLogger->getStdErr(),"[  error ] logging: error 0 : error description\n","logging an error message with printf syntax");
+
+		stringLogger->reset();
+		auto asyncLogger = std::make_shared<ofAsyncLoggerChannel>(stringLogger);
+		ofSetLoggerChannel(asyncLogger);
+		ofLogNotice("logging") << "first";
+		std::thread thread([]{
+			ofLogNotice("logging") << "from a thread";
+		});
+		thread.join();
+		ofLogNotice("logging") << "last";
+		asyncLogger->flush();
+		ofSetLoggerChannel(testLogger);
+		ofxTestEq(stringLogger->getStdOut(),"[ notice ] logging: first\n[ notice ] logging: from a thread\n[ notice ] logging: last\n","async logger writes the messages in order after flush");
+		ofxTestEq(asyncLogger->getNumDropped(),0,"async logger doesn't drop messages if the queue has space");
+
+		stringLogger->reset();
+		auto smallLogger = std::make_shared<ofAsyncLoggerChannel>(stringLogger, 4);
+		ofSetLoggerChannel(smallLogger);
+		for(int i = 0; i < 10000; i++){
+			ofLogNotice("logging") << i;
+		}
+		ofSetLoggerChannel(testLogger);
+		smallLogger->flush();
+		auto written = ofSplitString(stringLogger->getStdOut(), "\n", true).size();
+		ofxTestEq(written + smallLogger->getNumDropped(), 10000, "async logger counts the dropped messages");
+
+		stringLogger->reset();
+		{
+			ofAsyncLoggerChannel scopedLogger(stringLogger);
+			std::thread thread([&]{
+				for(int i = 0; i < 1000; i++){
+					scopedLogger.log(OF_LOG_NOTICE, "logging", ofToString(i));
+				}
+			});
+			thread.join();
+			scopedLogger.log(OF_LOG_NOTICE, "logging", std::string(1000, 'x'));
+		}
+		auto lines = ofSplitString(stringLogger->getStdOut(), "\n", true);
+		ofxTestEq(lines.size(), 1001, "async logger writes the queued messages on destruction");
+		ofxTestEq(lines.back(), "[ notice ] logging: " + std::string(1000, 'x'), "async logger writes long messages");
 	}
 	std::shared_ptr<ofStringLoggerChannel> stringLogger{new ofStringLoggerChannel};
 };
@@ -1,6 +1,26 @@
 #include "ofMain.h"
 #include "ofAppNoWindow.h"
 #include "ofxUnitTests.h"
+#include <chrono>
+
+template<typename T>
+std::string streamToString(const T & value){
+	std::ostringstream out;
+	out << value;
+	return out.str();
+}
+
+template<typename T>
+T streamTo(const std::string & str){
+	T value;
+	std::istringstream in(str);
+	in >> value;
+	return value;
+}
+
+double millisSince(std::chrono::steady_clock::time_point start){
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
 
 class ofApp: public ofxUnitTestsApp{
 	void run(){
@@ -73,6 +93,136 @@ class ofApp: public ofxUnitTestsApp{
 		ofxTestEq(ofVAArgsToString("Hello %s !","world"),"Hello world !","ofVAArgsToString");
 		setlocale (LC_ALL,"C"); //To make sure decimal separator is a '.'
 		ofxTestEq(ofVAArgsToString("writing some floats %+4.2f %g %E !",1.2345, -10., 1526.4),"writing some floats +1.23 -10 1.526400E+03 !","ofVAArgsToString");
+
+		ofLogNotice() << "number conversions";
+		ofxTestEq(ofToInt("42"), 42, "ofToInt");
+		ofxTestEq(ofToInt("  -7 apples"), -7, "ofToInt skips whitespace and ignores trailing text");
+		ofxTestEq(ofToInt("+123.4"), 123, "ofToInt plus sign");
+		ofxTestEq(ofToInt("apples"), 0, "ofToInt invalid");
+		ofxTestEq(ofToInt(""), 0, "ofToInt empty");
+		ofxTestEq(ofToInt("99999999999"), std::numeric_limits<int>::max(), "ofToInt out of range");
+		ofxTestEq(ofToInt64("-9223372036854775807"), -9223372036854775807ll, "ofToInt64");
+		ofxTestEq(ofToFloat("3.25"), 3.25f, "ofToFloat");
+		ofxTestEq(ofToFloat("-1.5e3f"), -1500.f, "ofToFloat exponent");
+		ofxTestEq(ofToFloat("123."), 123.f, "ofToFloat trailing point");
+		ofxTestEq(ofToDouble(" 0.1"), 0.1, "ofToDouble");
+		ofxTestEq(ofToDouble(std::string_view("2.5,7").substr(0, 3)), 2.5, "ofToDouble string_view");
+		ofxTestEq(ofFromString<int>("12"), 12, "ofFromString int");
+		ofxTestEq(ofTo<unsigned short>("65535"), 65535, "ofTo unsigned short");
+		ofxTestEq(ofTo<char>("c"), 'c', "ofTo char is still parsed as a character");
+		ofxTestEq(ofTo<unsigned int>("-1"), std::numeric_limits<unsigned int>::max(), "ofTo unsigned wraps negative numbers like streams");
+		ofxTestEq(ofTo<unsigned short>("-65536"), 65535, "ofTo unsigned negative out of range");
+		ofxTestEq(ofToFloat("1e40"), std::numeric_limits<float>::max(), "ofToFloat out of range");
+		ofxTestEq(ofToDouble("-1e400"), -std::numeric_limits<double>::max(), "ofToDouble negative out of range");
+		ofxTestEq(ofToFloat("1e-40"), streamTo<float>("1e-40"), "ofToFloat underflow");
+		ofxTestEq(ofToFloat("inf"), 0.f, "ofToFloat doesn't accept inf");
+		ofxTestEq(ofToDouble("-nan"), 0.0, "ofToDouble doesn't accept nan");
+
+		ofxTestEq(ofToString(42), "42", "ofToString int");
+		ofxTestEq(ofToString(-3.14159265), "-3.14159", "ofToString double");
+		ofxTestEq(ofToString(0.1f), "0.1", "ofToString float");
+		ofxTestEq(ofToString(1e6), "1e+06", "ofToString scientific");
+		ofxTestEq(ofToString(3.14159, 2), "3.14", "ofToString precision");
+		ofxTestEq(ofToString(7, 3, '0'), "007", "ofToString width");
+		ofxTestEq(ofToString(-2.5, 1, 6, ' '), "  -2.5", "ofToString precision and width");
+		ofxTestEq(ofToString('a'), "a", "ofToString char");
+
+		bool sameAsStreams = true;
+		ofSetRandomSeed(1);
+		for(int i = 0; i < 10000; i++){
+			auto f = ofRandom(-1000, 1000) * std::pow(10.f, ofRandom(-10, 10));
+			auto d = double(f) * ofRandom(0.5, 2);
+			auto n = int(ofRandom(-1e9, 1e9));
+			sameAsStreams &= ofToString(f) == streamToString(f);
+			sameAsStreams &= ofToString(d) == streamToString(d);
+			sameAsStreams &= ofToString(n) == streamToString(n);
+			sameAsStreams &= ofToFloat(streamToString(f)) == streamTo<float>(streamToString(f));
+			sameAsStreams &= ofToDouble(ofToString(d, 12)) == streamTo<double>(ofToString(d, 12));
+			sameAsStreams &= ofToInt(streamToString(n)) == n;
+		}
+		ofxTest(sameAsStreams, "conversions match the streams");
+
+		ofLogNotice() << "split views";
+		auto view0 = ofSplitStringView(" hi,  this,,is ,a view ", ",");
+		ofxTestEq(view0.size(), 5u, "split view size");
+		ofxTestEq(view0[1], "  this", "split view no trim");
+		ofxTestEq(view0[2], "", "split view empty token");
+		auto view1 = ofSplitStringView(" hi,  this,,is ,a view ", ",", true, true);
+		ofxTestEq(view1.size(), 4u, "split view trim size");
+		ofxTestEq(view1[0], "hi", "split view trim 0");
+		ofxTestEq(view1[2], "is", "split view trim 2");
+		ofxTestEq(view1[3], "a view", "split view trim 3");
+		ofxTestEq(ofSplitStringView("", ",").size(), 1u, "split view empty string");
+		ofxTestEq(ofSplitStringView(",,", ",", true).size(), 0u, "split view only delimiters");
+		ofxTestEq(ofSplitStringView("a<>b<>", "<>").back(), "", "split view multi char delimiter");
+
+		std::string csv = "1.5; 2.5 ;3;;4";
+		float sum = 0;
+		size_t numTokens = 0;
+		for(auto token: ofStringTokenizer(csv, ";", true, true)){
+			sum += ofToFloat(token);
+			numTokens++;
+		}
+		ofxTestEq(numTokens, 4u, "tokenizer ignores empty");
+		ofxTestEq(sum, 11.f, "tokenizer tokens");
+		ofStringTokenizer tokenizer("a b", " ");
+		ofxTestEq(std::distance(tokenizer.begin(), tokenizer.end()), 2, "tokenizer is a forward range");
+
+		ofLogNotice() << "benchmark";
+		std::string log;
+		for(int i = 0; i < 100000; i++){
+			log += ofToString(i) + ", " + ofToString(i * 0.25f) + ", " + ofToString(i * -0.5) + ", sensor\n";
+		}
+		double streamSum = 0;
+		auto start = std::chrono::steady_clock::now();
+		for(auto & line: ofSplitString(log, "\n", true)){
+			std::istringstream lineStream(line);
+			std::string field;
+			while(std::getline(lineStream, field, ',')){
+				streamSum += streamTo<double>(field);
+			}
+		}
+		auto streamTime = millisSince(start);
+		double viewSum = 0;
+		start = std::chrono::steady_clock::now();
+		for(auto line: ofStringTokenizer(log, "\n", true)){
+			for(auto field: ofStringTokenizer(line, ",")){
+				viewSum += ofToDouble(field);
+			}
+		}
+		auto viewTime = millisSince(start);
+		ofLogNotice() << "parse csv, streams: " << streamTime << "ms, tokenizer: " << viewTime << "ms";
+		ofxTestEq(viewSum, streamSum, "tokenizer parses the same values as streams");
+
+		std::vector<std::string> strings(1000000);
+		start = std::chrono::steady_clock::now();
+		for(size_t i = 0; i < strings.size(); i++){
+			strings[i] = streamToString(i * 0.001f);
+		}
+		streamTime = millisSince(start);
+		start = std::chrono::steady_clock::now();
+		bool equal = true;
+		for(size_t i = 0; i < strings.size(); i++){
+			equal &= ofToString(i * 0.001f) == strings[i];
+		}
+		viewTime = millisSince(start);
+		ofLogNotice() << "float to string, streams: " << streamTime << "ms, ofToString: " << viewTime << "ms";
+		ofxTest(equal, "ofToString prints the same as streams");
+
+		start = std::chrono::steady_clock::now();
+		int64_t streamInts = 0;
+		for(size_t i = 0; i < strings.size(); i++){
+			streamInts += streamTo<int>(strings[i]);
+		}
+		streamTime = millisSince(start);
+		start = std::chrono::steady_clock::now();
+		int64_t ints = 0;
+		for(size_t i = 0; i < strings.size(); i++){
+			ints += ofToInt(strings[i]);
+		}
+		viewTime = millisSince(start);
+		ofLogNotice() << "string to int, streams: " << streamTime << "ms, ofToInt: " << viewTime << "ms";
+		ofxTestEq(ints, streamInts, "ofToInt parses the same as streams");
 	}
 };
 
@@ -0,0 +1,183 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofxNetwork.h"
+#include "ofAppNoWindow.h"
+#include <chrono>
+
+// A minimal HTTP/1.1 server with keep-alive that answers every GET with
+// the requested path as body after some latency, like a remote server would.
+class HttpStandIn{
+public:
+	HttpStandIn(int latencyMs)
+	:latency(latencyMs){
+		port = ofRandom(15000, 65535);
+		server.setup(port, false);
+		thread = std::thread([this]{
+			while(running){
+				update();
+				ofSleepMillis(1);
+			}
+		});
+	}
+
+	~HttpStandIn(){
+		running = false;
+		thread.join();
+		server.close();
+	}
+
+	std::string url(const std::string & path) const{
+		return "http://127.0.0.1:" + ofToString(port) + path;
+	}
+
+	int getNumConnections(){
+		return server.getLastID();
+	}
+
+private:
+	struct Client{
+		std::string received;
+		std::deque<std::pair<std::chrono::steady_clock::time_point, std::string>> responses;
+	};
+
+	void update(){
+		auto now = std::chrono::steady_clock::now();
+		char buffer[4096];
+		for(int id = 0; id < server.getLastID(); id++){
+			if(!server.isClientConnected(id)){
+				clients.erase(id);
+				continue;
+			}
+			auto & client = clients[id];
+			int received;
+			while((received = server.receiveRawBytes(id, buffer, sizeof(buffer))) > 0){
+				client.received.append(buffer, received);
+			}
+			size_t end;
+			while((end = client.received.find("\r\n\r\n")) != std::string::npos){
+				auto path = client.received.substr(4, client.received.find(' ', 4) - 4);
+				client.received.erase(0, end + 4);
+				client.responses.emplace_back(now + std::chrono::milliseconds(latency), path);
+			}
+			while(!client.responses.empty() && client.responses.front().first <= now){
+				auto & body = client.responses.front().second;
+				std::string response = "HTTP/1.1 200 OK\r\nContent-Length: " + ofToString(body.size()) + "\r\n\r\n" + body;
+				server.sendRawBytes(id, response.c_str(), response.size());
+				client.responses.pop_front();
+			}
+		}
+	}
+
+	ofxTCPServer server;
+	int port;
+	int latency;
+	std::map<int, Client> clients;
+	std::atomic<bool> running{true};
+	std::thread thread;
+};
+
+class ofApp: public ofxUnitTestsApp{
+	std::vector<ofHttpResponse> responses;
+
+	void urlResponse(ofHttpResponse & response){
+		responses.push_back(response);
+	}
+
+	bool waitForResponses(size_t numResponses, int timeoutMs = 10000){
+		auto start = ofGetElapsedTimeMillis();
+		while(responses.size() < numResponses && ofGetElapsedTimeMillis() - start < uint64_t(timeoutMs)){
+			// responses are delivered in the update event
+			ofEvents().notifyUpdate();
+			ofSleepMillis(1);
+		}
+		return responses.size() >= numResponses;
+	}
+
+	void run(){
+		ofRegisterURLNotification(this);
+		HttpStandIn server(20);
+		ofURLFileLoader loader;
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "blocking request";
+			auto response = loader.get(server.url("/blocking"));
+			ofxTestEq(response.status, 200, "status");
+			ofxTestEq(response.data.getText(), "/blocking", "body");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "concurrent requests throughput";
+			size_t numRequests = 100;
+			for(size_t maxRequests: {1, 4, 16}){
+				loader.setMaxConcurrentRequests(maxRequests);
+				responses.clear();
+				auto connections = server.getNumConnections();
+				auto start = std::chrono::steady_clock::now();
+				for(size_t i = 0; i < numRequests; i++){
+					loader.getAsync(server.url("/" + ofToString(i)), ofToString(i));
+				}
+				ofxTest(waitForResponses(numRequests), ofToString(maxRequests) + " concurrent, all responses received");
+				auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+				bool correct = true;
+				for(auto & response: responses){
+					correct &= response.status == 200 && response.data.getText() == "/" + response.request.name;
+				}
+				auto newConnections = server.getNumConnections() - connections;
+				ofLogNotice() << maxRequests << " concurrent: " << numRequests / seconds << " requests/s, "
+					<< newConnections << " new connections";
+				ofxTest(correct, ofToString(maxRequests) + " concurrent, responses match the requests");
+				ofxTest(size_t(newConnections) <= maxRequests, ofToString(maxRequests) + " concurrent, connections are reused");
+			}
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "priority and cancel";
+			loader.setMaxConcurrentRequests(1);
+			responses.clear();
+			ofHttpRequest busy(server.url("/busy"), "busy", false, false);
+			ofHttpRequest low(server.url("/low"), "low", false, false);
+			low.priority = -1;
+			ofHttpRequest high(server.url("/high"), "high", false, false);
+			high.priority = 10;
+			ofHttpRequest canceled(server.url("/canceled"), "canceled", false, false);
+			canceled.priority = 20;
+			loader.handleRequestAsync(busy);
+			loader.handleRequestAsync(low);
+			loader.handleRequestAsync(high);
+			loader.remove(loader.handleRequestAsync(canceled));
+			ofxTest(waitForResponses(3), "responses received");
+			waitForResponses(4, 200);
+			std::vector<std::string> names;
+			for(auto & response: responses){
+				names.push_back(response.request.name);
+			}
+			auto lowPosition = std::find(names.begin(), names.end(), "low");
+			auto highPosition = std::find(names.begin(), names.end(), "high");
+			ofxTest(highPosition < lowPosition, "higher priority first");
+			ofxTest(std::find(names.begin(), names.end(), "canceled") == names.end(), "canceled request not delivered");
+
+			responses.clear();
+			loader.setMaxConcurrentRequests(4);
+			auto inFlight = loader.getAsync(server.url("/inflight"));
+			ofSleepMillis(5);
+			loader.remove(inFlight);
+			waitForResponses(1, 200);
+			ofxTestEq(responses.size(), 0, "canceled in flight request not delivered");
+		}
+
+		loader.stop();
+		ofUnregisterURLNotification(this);
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -1,8 +1,43 @@
 #include "utils/ofUtils.h"
+#include "utils/ofThreadChannel.h"
+#include "utils/ofLockFreeThreadChannel.h"
+#include "utils/ofTaskPool.h"
 #include "ofxUnitTests.h"
+#include <numeric>
 
 
 class ofApp: public ofxUnitTestsApp{
+	template<typename Channel>
+	bool sendAndReceive(Channel & channel, int producers, int numValues, std::string name){
+		auto start = std::chrono::steady_clock::now();
+		std::vector<std::thread> threads;
+		for(int p = 0; p < producers; p++){
+			threads.emplace_back([&channel, numValues]{
+				for(int i = 0; i < numValues; i++){
+					channel.send(i);
+				}
+			});
+		}
+		bool ordered = true;
+		int64_t sum = 0;
+		int last = -1;
+		int value = 0;
+		for(int i = 0; i < producers * numValues; i++){
+			if(!channel.receive(value)){
+				break;
+			}
+			ordered &= producers > 1 || value == last + 1;
+			last = value;
+			sum += value;
+		}
+		for(auto & thread: threads){
+			thread.join();
+		}
+		auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		ofLogNotice() << name << ": " << producers * numValues << " values from " << producers << " threads in " << elapsed << "ms";
+		return ordered && sum == int64_t(producers) * numValues * (numValues - 1) / 2;
+	}
+
 	void run(){
 		ofLogNotice() << "testing utils/ofUtils";
 		ofLogNotice() << "testing ofGetEnv() on unset environment variable";
@@ -12,6 +47,106 @@ class ofApp: public ofxUnitTestsApp{
 		ofxTest(ofGetEnv("PATH")!="", "it should return a (non empty) string when called with no default value.");
 		ofxTest(ofGetEnv("DUMMY","default")!="", "it should return a (non empty) string when a default value is provided.");
 		ofxTest(ofGetEnv("DUMMY","default")!="defautl", "it should not return the default value.");
+
+		ofLogNotice() << "testing ofLockFreeThreadChannel";
+		{
+			ofLockFreeThreadChannel<int> channel(16);
+			ofxTestEq(channel.capacity(), 16u, "capacity is a power of 2");
+			for(int i = 0; i < 16; i++){
+				channel.trySend(i);
+			}
+			ofxTest(!channel.trySend(16), "trySend fails when full");
+			ofxTestEq(channel.size(), 16u, "size when full");
+			int value;
+			ofxTest(channel.tryReceive(value) && value == 0, "values are received in order");
+			channel.clear();
+			ofxTest(channel.empty(), "clear empties the channel");
+			ofxTest(!channel.tryReceive(value, 10), "tryReceive with timeout fails on an empty channel");
+		}
+		{
+			ofLockFreeThreadChannel<int> channel(64);
+			ofxTest(sendAndReceive(channel, 1, 1000000, "ofLockFreeThreadChannel"), "spsc receives every value in order");
+			ofThreadChannel<int> locked;
+			ofxTest(sendAndReceive(locked, 1, 1000000, "ofThreadChannel"), "ofThreadChannel receives every value in order");
+		}
+		{
+			ofMPSCThreadChannel<int> channel(1024);
+			ofxTest(sendAndReceive(channel, 4, 250000, "ofMPSCThreadChannel"), "mpsc receives every value");
+			ofThreadChannel<int> locked;
+			ofxTest(sendAndReceive(locked, 4, 250000, "ofThreadChannel"), "ofThreadChannel receives every value from several threads");
+		}
+		{
+			ofLockFreeThreadChannel<int> channel;
+			std::thread closer([&channel]{
+				std::this_thread::sleep_for(std::chrono::milliseconds(20));
+				channel.close();
+			});
+			int value;
+			ofxTest(!channel.receive(value), "close wakes up a blocked receiver");
+			closer.join();
+			ofxTest(!channel.send(1), "send fails on a closed channel");
+		}
+
+		ofLogNotice() << "testing ofTaskPool";
+		{
+			ofTaskPool pool(4);
+			ofxTestEq(pool.getNumThreads(), 4u, "creates the requested number of threads");
+			auto result = pool.submit([]{ return 42; });
+			ofxTestEq(result.get(), 42, "submit returns the result through a future");
+
+			auto failed = pool.submit([]() -> int{ throw std::runtime_error("task failed"); });
+			bool threw = false;
+			try{
+				failed.get();
+			}catch(const std::runtime_error &){
+				threw = true;
+			}
+			ofxTest(threw, "exceptions are delivered through the future");
+
+			std::vector<int> values(1000000);
+			pool.parallelFor(0, values.size(), [&values](size_t i){
+				values[i] = int(i % 7);
+			}, 1024);
+			int64_t sum = std::accumulate(values.begin(), values.end(), int64_t(0));
+			ofxTestEq(sum, int64_t(2999997), "parallelFor visits every index once");
+
+			std::atomic<int64_t> nestedSum(0);
+			pool.parallelFor(0, 64, [&](size_t){
+				pool.parallelFor(0, 1000, [&](size_t j){
+					nestedSum += j;
+				});
+			});
+			ofxTestEq(nestedSum.load(), int64_t(64 * 999 * 1000 / 2), "nested parallelFor doesn't deadlock");
+
+			std::promise<int> continued;
+			pool.submitThen([]{ return 3; }, [&continued](int & value){
+				continued.set_value(value * 2);
+			});
+			ofxTestEq(continued.get_future().get(), 6, "submitThen calls the continuation with the result");
+
+			// every worker busy: the caller does the whole range itself and
+			// doesn't wait for the helpers queued behind the busy tasks
+			std::promise<void> release;
+			std::shared_future<void> released = release.get_future().share();
+			std::vector<std::future<void>> busy;
+			for(size_t i = 0; i < pool.getNumThreads(); i++){
+				busy.push_back(pool.submit([released]{ released.wait(); }));
+			}
+			std::atomic<int> visited(0);
+			pool.parallelFor(0, 100, [&visited](size_t){
+				visited++;
+			});
+			ofxTestEq(visited.load(), 100, "parallelFor doesn't wait for helpers that didn't start");
+			release.set_value();
+			for(auto & task: busy){
+				task.get();
+			}
+		}
+		{
+			ofTaskPool inlinePool(0);
+			auto id = inlinePool.submit([]{ return std::this_thread::get_id(); });
+			ofxTest(id.get() == std::this_thread::get_id(), "a pool without threads runs tasks inline");
+		}
 	}
 };
 
@@ -1,9 +1,27 @@
 #include "utils/ofXml.h"
 #include "ofxUnitTests.h"
 #include <locale>
+#include <chrono>
+#ifndef TARGET_WIN32
+#include <sys/resource.h>
+#endif
 
 using namespace std;
 
+// peak resident memory of the process in MB
+double peakMemoryMB(){
+#ifndef TARGET_WIN32
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	#ifdef TARGET_OSX
+	return usage.ru_maxrss / (1024. * 1024.);
+	#else
+	return usage.ru_maxrss / 1024.;
+	#endif
+#else
+	return 0;
+#endif
+}
 
 class ofApp: public ofxUnitTestsApp{
 	void run(){
@@ -178,6 +196,111 @@ class ofApp: public ofxUnitTestsApp{
 			// set back locale
 			current_locale.global( saved_loc );
 		}
+
+		{
+			ofLogNotice() << "Testing the stream reader";
+			std::string timeline =
+				"<?xml version=\"1.0\"?>"
+				"<!-- <event> in a comment -->"
+				"<timeline>"
+				"<track name='camera'><event time='1.5'/><event time='2'><note><![CDATA[<event/>]]></note></event></track>"
+				"<track name='lights'><event time='3'/></track>"
+				"<markers><event time='10'/></markers>"
+				"</timeline>";
+
+			ofXmlStreamReader reader;
+			reader.setChunkSize(16);
+			reader.addFilter("/timeline/track/event");
+			float totalTime = 0;
+			std::vector<std::string> paths;
+			ofxTest(reader.parse(timeline, [&](const std::string & path, ofXml && event){
+				totalTime += event.getAttribute("time").getFloatValue();
+				paths.push_back(path);
+				return true;
+			}), "\tparse");
+			ofxTestEq(paths.size(), 3u, "\tselected every event in a track");
+			ofxTestEq(paths[0], "/timeline/track/event", "\tpath of the element");
+			ofxTestEq(totalTime, 6.5f, "\tselected elements are independent documents");
+
+			reader.clearFilters();
+			reader.addFilter("/timeline/*/event");
+			std::string note;
+			size_t numEvents = 0;
+			reader.parse(timeline, [&](const std::string &, ofXml && event){
+				if(event.getChild("note")){
+					note = event.getChild("note").getValue();
+				}
+				numEvents++;
+				return true;
+			});
+			ofxTestEq(numEvents, 4u, "\twildcard filter");
+			ofxTestEq(note, "<event/>", "\tcdata is kept");
+
+			reader.clearFilters();
+			std::string rootName;
+			reader.parse(timeline, [&](const std::string &, ofXml && root){
+				rootName = root.getName();
+				return true;
+			});
+			ofxTestEq(rootName, "timeline", "\tno filters selects the root element");
+
+			reader.addFilter("/timeline/track");
+			size_t numTracks = 0;
+			ofxTest(reader.parse(timeline, [&](const std::string &, ofXml &&){
+				numTracks++;
+				return false;
+			}), "\tstopping is not an error");
+			ofxTestEq(numTracks, 1u, "\tstop after the first element");
+
+			ofxTest(!reader.parse("<timeline><track></timeline>", [](const std::string &, ofXml &&){ return true; }), "\tmismatched tags");
+			ofxTest(!reader.parse("<timeline><track>", [](const std::string &, ofXml &&){ return true; }), "\tunexpected end");
+			ofxTest(!reader.getError().empty(), "\terror description");
+		}
+
+		{
+			ofLogNotice() << "DOM vs stream reader benchmark";
+			// written as text so generating it doesn't raise the peak memory
+			{
+				ofFile file("timeline.xml", ofFile::WriteOnly);
+				file << "<?xml version=\"1.0\"?>\n<annotations version=\"2\">\n";
+				for(int i = 0; i < 500000; i++){
+					file << "\t<annotation id=\"" << i << "\" start=\"" << i * 0.04 << "\" end=\"" << i * 0.04 + 1 << "\">"
+						<< "<label>annotation " << i << "</label><tag>person</tag><tag>walking</tag>"
+						<< "<box x=\"10\" y=\"20\" w=\"30\" h=\"40\"/></annotation>\n";
+				}
+				file << "</annotations>\n";
+			}
+			auto size = ofFile("timeline.xml").getSize() / (1024. * 1024.);
+
+			auto memoryBefore = peakMemoryMB();
+			auto start = std::chrono::steady_clock::now();
+			ofXmlStreamReader reader;
+			reader.addFilter("/annotations/annotation");
+			size_t numStreamed = 0;
+			reader.load("timeline.xml", [&](const std::string &, ofXml && annotation){
+				numStreamed += annotation.getChild("label") ? 1 : 0;
+				return true;
+			});
+			auto streamTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			auto streamMemory = peakMemoryMB() - memoryBefore;
+
+			memoryBefore = peakMemoryMB();
+			start = std::chrono::steady_clock::now();
+			ofXml dom;
+			dom.load("timeline.xml");
+			size_t numLoaded = 0;
+			for(auto & annotation: dom.getChild("annotations").getChildren("annotation")){
+				numLoaded += annotation.getChild("label") ? 1 : 0;
+			}
+			auto domTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			auto domMemory = peakMemoryMB() - memoryBefore;
+
+			ofLogNotice() << size << "MB file, DOM: " << domTime << "ms, peak memory +" << domMemory << "MB";
+			ofLogNotice() << size << "MB file, stream reader: " << streamTime << "ms, peak memory +" << streamMemory << "MB";
+			ofxTestEq(numStreamed, numLoaded, "\tthe stream reader selects the same elements");
+			ofFile::removeFile("timeline.xml");
+		}
+
 		ofLogNotice()<<"\n";
 	}
 };